@@ -0,0 +1,70 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+/**
+ * @file
+ *
+ * @ingroup traffic
+ * @brief Converts a text packet trace into the binary trace file format read
+ *        by TraceReplayApplication.
+ *
+ * Each line of the input holds a timestamp in seconds and a packet size in
+ * bytes, separated by a comma or white space. Such a text trace can be
+ * extracted from a pcap file, for example:
+ *
+ *     $ tshark -r capture.pcap -T fields -e frame.time_relative -e frame.len > trace.txt
+ *     $ ./waf --run="trace-replay-convert --input=trace.txt --output=trace.bin"
+ *
+ * The resulting `trace.bin` can be given to TraceReplayHelper or to the
+ * `TraceFile` attribute of TraceReplayApplication.
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/traffic-module.h"
+
+#include <fstream>
+#include <iostream>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("TraceReplayConvert");
+
+int
+main(int argc, char* argv[])
+{
+    std::string input;
+    std::string output = "trace.bin";
+
+    // read command line arguments given by the user
+    CommandLine cmd;
+    cmd.AddValue("input", "Path to the text trace to be converted", input);
+    cmd.AddValue("output", "Path to the binary trace file to be written", output);
+    cmd.Parse(argc, argv);
+
+    std::ifstream inputStream(input.c_str());
+    if (!inputStream.is_open())
+    {
+        NS_FATAL_ERROR("Unable to open the text trace '" << input << "'");
+    }
+
+    const uint64_t n = TraceReplayFile::ConvertFromText(inputStream, output);
+    std::cout << "Wrote " << n << " records to " << output << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,160 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "admission-ramp-controller.h"
+
+#include "ns3/application.h"
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE("AdmissionRampController");
+
+namespace ns3
+{
+
+NS_OBJECT_ENSURE_REGISTERED(AdmissionRampController);
+
+AdmissionRampController::AdmissionRampController()
+    : m_startTime(Seconds(0)),
+      m_admissionRate(100.0),
+      m_targetSessions(0),
+      m_settleTime(Seconds(0)),
+      m_nAdmitted(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TypeId
+AdmissionRampController::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::AdmissionRampController")
+            .SetParent<Object>()
+            .AddConstructor<AdmissionRampController>()
+            .AddAttribute("StartTime",
+                          "Simulation time when the first client is admitted.",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&AdmissionRampController::m_startTime),
+                          MakeTimeChecker())
+            .AddAttribute("AdmissionRate",
+                          "Number of clients admitted per second. Zero admits every client "
+                          "at once at the start time.",
+                          DoubleValue(100.0),
+                          MakeDoubleAccessor(&AdmissionRampController::m_admissionRate),
+                          MakeDoubleChecker<double>(0.0))
+            .AddAttribute("TargetSessions",
+                          "Number of admitted clients which marks the end of the ramp. "
+                          "Zero means every admitted client.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&AdmissionRampController::m_targetSessions),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("SettleTime",
+                          "Additional time after the end of the ramp before the warm-up "
+                          "period is considered complete.",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&AdmissionRampController::m_settleTime),
+                          MakeTimeChecker())
+            .AddTraceSource("WarmUpComplete",
+                            "The target number of clients has been admitted and "
+                            "the settle time has elapsed.",
+                            MakeTraceSourceAccessor(
+                                &AdmissionRampController::m_warmUpCompleteTrace),
+                            "ns3::AdmissionRampController::WarmUpCompleteCallback");
+    return tid;
+}
+
+void
+AdmissionRampController::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_eventWarmUpComplete.Cancel();
+    Object::DoDispose();
+}
+
+void
+AdmissionRampController::Admit(ApplicationContainer apps)
+{
+    NS_LOG_FUNCTION(this << apps.GetN());
+
+    for (ApplicationContainer::Iterator it = apps.Begin(); it != apps.End(); ++it)
+    {
+        (*it)->SetStartTime(GetAdmissionTime(m_nAdmitted));
+        m_nAdmitted++;
+    }
+
+    const Time warmUpTime = GetWarmUpTime();
+    NS_LOG_INFO(this << " " << m_nAdmitted << " clients admitted,"
+                     << " warm-up complete at " << warmUpTime.GetSeconds() << "s");
+
+    // Admitting more clients may move the end of the warm-up period.
+    m_eventWarmUpComplete.Cancel();
+    m_eventWarmUpComplete =
+        Simulator::Schedule(std::max(warmUpTime - Simulator::Now(), Seconds(0)),
+                            &AdmissionRampController::WarmUpComplete,
+                            this);
+
+} // end of `void Admit (ApplicationContainer)`
+
+uint32_t
+AdmissionRampController::GetNAdmitted() const
+{
+    return m_nAdmitted;
+}
+
+Time
+AdmissionRampController::GetAdmissionTime(uint32_t index) const
+{
+    if (m_admissionRate <= 0.0)
+    {
+        return m_startTime;
+    }
+
+    return m_startTime + Seconds(static_cast<double>(index) / m_admissionRate);
+}
+
+Time
+AdmissionRampController::GetWarmUpTime() const
+{
+    uint32_t n = m_nAdmitted;
+    if ((m_targetSessions > 0) && (m_targetSessions < n))
+    {
+        n = m_targetSessions;
+    }
+
+    if (n == 0)
+    {
+        return m_startTime + m_settleTime;
+    }
+
+    return GetAdmissionTime(n - 1) + m_settleTime;
+}
+
+void
+AdmissionRampController::WarmUpComplete()
+{
+    NS_LOG_FUNCTION(this);
+    NS_LOG_INFO(this << " warm-up complete with " << m_nAdmitted << " clients admitted");
+    m_warmUpCompleteTrace();
+}
+
+} // end of `namespace ns3`
@@ -0,0 +1,153 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef ADMISSION_RAMP_CONTROLLER_H
+#define ADMISSION_RAMP_CONTROLLER_H
+
+#include "ns3/application-container.h"
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+#include "ns3/traced-callback.h"
+
+#include <stdint.h>
+
+namespace ns3
+{
+
+/**
+ * @ingroup traffic
+ * @brief Spreads the start times of a large client population over a ramp,
+ *        and announces when the population has settled.
+ *
+ * Starting thousands of clients (e.g., NrtvTcpClient or
+ * ThreeGppHttpSatelliteClient) at the same instant causes a storm of
+ * connection setups, which is expensive to simulate and produces results
+ * which do not represent the steady state of the network anyway. Instead of
+ * setting the start time of each client by hand, the client applications are
+ * handed over to Admit(), which overwrites their start times so that the
+ * clients are admitted one after another at the rate given by the
+ * `AdmissionRate` attribute, beginning at the `StartTime` attribute:
+ * @code
+ *     ApplicationContainer clientApps = clientHelper.Install (clientNodes);
+ *     Ptr<AdmissionRampController> ramp = CreateObject<AdmissionRampController> ();
+ *     ramp->SetAttribute ("AdmissionRate", DoubleValue (200.0));
+ *     ramp->SetAttribute ("SettleTime", TimeValue (Seconds (5)));
+ *     ramp->Admit (clientApps);
+ *
+ *     Ptr<ApplicationStatsHelperContainer> stat
+ *         = CreateObject<ApplicationStatsHelperContainer> ();
+ *     stat->SetWarmUpTime (ramp->GetWarmUpTime ());
+ *     // ... (add statistics) ...
+ * @endcode
+ *
+ * The warm-up period is complete when `TargetSessions` clients (or every
+ * client given to Admit(), if the attribute is zero) have been admitted and a
+ * further `SettleTime` has elapsed. Note that the controller counts admitted
+ * clients, not open sessions. NrtvTcpClient closes its connection after
+ * every video (unless `KeepAlive` is enabled) and the HTTP clients pause for
+ * a reading time between web pages, so fewer sessions than admitted clients
+ * are active at any moment. `SettleTime` should hence cover a few of these
+ * on-off cycles, so that the population has settled into its steady mix of
+ * active and idle clients. At that moment the
+ * `WarmUpComplete` trace source is fired. The same moment is also known in
+ * advance through GetWarmUpTime(), which allows the statistics helpers (see
+ * ApplicationStatsHelperContainer::SetWarmUpTime()) to skip the transient
+ * entirely.
+ *
+ * The attributes must be set before calling Admit(), because the start times
+ * are computed immediately.
+ */
+class AdmissionRampController : public Object
+{
+  public:
+    /// Creates a new instance of controller.
+    AdmissionRampController();
+
+    /**
+     * @brief Returns the object TypeId.
+     * @return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * @brief Admit the given applications after the clients admitted so far.
+     * @param apps the client applications, in the order of admission.
+     *
+     * The start time of every application in the container is overwritten.
+     * Calling this method again appends more clients to the same ramp.
+     */
+    void Admit(ApplicationContainer apps);
+
+    /**
+     * @return the number of clients admitted so far through Admit().
+     */
+    uint32_t GetNAdmitted() const;
+
+    /**
+     * @param index the position of a client in the order of admission.
+     * @return the simulation time when the client is admitted.
+     */
+    Time GetAdmissionTime(uint32_t index) const;
+
+    /**
+     * @return the simulation time when the warm-up period is complete, based
+     *         on the clients admitted so far.
+     */
+    Time GetWarmUpTime() const;
+
+    /**
+     * @brief Common callback signature for the `WarmUpComplete` trace source.
+     */
+    typedef void (*WarmUpCompleteCallback)();
+
+  protected:
+    // Inherited from Object base class
+    virtual void DoDispose();
+
+  private:
+    /// Invoked when the warm-up period is complete. Fires `WarmUpComplete`.
+    void WarmUpComplete();
+
+    /// `StartTime` attribute.
+    Time m_startTime;
+
+    /// `AdmissionRate` attribute, in clients per second.
+    double m_admissionRate;
+
+    /// `TargetSessions` attribute.
+    uint32_t m_targetSessions;
+
+    /// `SettleTime` attribute.
+    Time m_settleTime;
+
+    /// Number of clients admitted so far.
+    uint32_t m_nAdmitted;
+
+    /// Pending invocation of WarmUpComplete().
+    EventId m_eventWarmUpComplete;
+
+    /// `WarmUpComplete` trace source.
+    TracedCallback<> m_warmUpCompleteTrace;
+
+}; // end of `class AdmissionRampController`
+
+} // end of `namespace ns3`
+
+#endif /* ADMISSION_RAMP_CONTROLLER_H */
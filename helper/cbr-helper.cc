@@ -20,6 +20,7 @@
 
 #include "cbr-helper.h"
 
+#include "ns3/boolean.h"
 #include "ns3/data-rate.h"
 #include "ns3/inet-socket-address.h"
 #include "ns3/names.h"
@@ -81,6 +82,43 @@ CbrHelper::InstallPriv(Ptr<Node> node) const
     return app;
 }
 
+ApplicationContainer
+CbrHelper::InstallFluid(NodeContainer c, uint32_t numOfFlows) const
+{
+    // Read the CBR settings back from a prototype CbrApplication.
+    Ptr<Application> prototype = m_factory.Create<Application>();
+    AddressValue remote;
+    UintegerValue tos;
+    TimeValue interval;
+    UintegerValue packetSize;
+    BooleanValue isStatisticsTagsEnabled;
+    prototype->GetAttribute("Remote", remote);
+    prototype->GetAttribute("Tos", tos);
+    prototype->GetAttribute("Interval", interval);
+    prototype->GetAttribute("PacketSize", packetSize);
+    prototype->GetAttribute("EnableStatisticsTags", isStatisticsTagsEnabled);
+    prototype->Dispose();
+
+    ObjectFactory factory;
+    factory.SetTypeId("ns3::CbrFluidSource");
+    factory.Set("Remote", remote);
+    factory.Set("Tos", tos);
+    factory.Set("Interval", interval);
+    factory.Set("PacketSize", packetSize);
+    factory.Set("EnableStatisticsTags", isStatisticsTagsEnabled);
+    factory.Set("NumOfFlows", UintegerValue(numOfFlows));
+
+    ApplicationContainer apps;
+    for (NodeContainer::Iterator i = c.Begin(); i != c.End(); ++i)
+    {
+        Ptr<Application> app = factory.Create<Application>();
+        (*i)->AddApplication(app);
+        apps.Add(app);
+    }
+
+    return apps;
+}
+
 void
 CbrHelper::SetConstantTraffic(Time interval, uint32_t packetSize)
 {
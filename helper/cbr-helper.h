@@ -99,6 +99,23 @@ class CbrHelper
      */
     ApplicationContainer Install(std::string nodeName) const;
 
+    /**
+     * Install an ns3::CbrFluidSource on each node of the input container,
+     * representing the given number of flows which would otherwise be
+     * installed as CbrApplications with the same attributes (e.g., those set
+     * by SetConstantTraffic()).
+     *
+     * @param c NodeContainer of the set of nodes on which a CbrFluidSource
+     * will be installed.
+     * @param numOfFlows number of CBR flows represented by each application.
+     * @returns Container of Ptr to the applications installed.
+     *
+     * The address given to the constructor must be an IPv4 socket address.
+     * The attributes of CbrApplication which CbrFluidSource does not have,
+     * such as Protocol, are ignored.
+     */
+    ApplicationContainer InstallFluid(NodeContainer c, uint32_t numOfFlows) const;
+
   private:
     /**
      * @internal
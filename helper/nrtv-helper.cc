@@ -26,6 +26,8 @@
 
 #include "nrtv-helper.h"
 
+#include "traffic-helper-utils.h"
+
 #include "ns3/inet-socket-address.h"
 #include "ns3/ipv4.h"
 #include "ns3/names.h"
@@ -159,7 +161,8 @@ NrtvServerHelper::InstallPriv(Ptr<Node> node) const
 // NRTV HELPER ////////////////////////////////////////////////////////////////
 
 NrtvHelper::NrtvHelper(TypeId protocolTid)
-    : m_protocolTid(protocolTid)
+    : m_numOfLiveChannels(0),
+      m_protocolTid(protocolTid)
 {
     NS_ASSERT_MSG(m_protocolTid == TypeId::LookupByName("ns3::TcpSocketFactory") ||
                       m_protocolTid == TypeId::LookupByName("ns3::UdpSocketFactory"),
@@ -196,62 +199,74 @@ NrtvHelper::SetVariablesAttribute(std::string name, const AttributeValue& value)
     m_nrtvVariables->SetAttribute(name, value);
 }
 
+void
+NrtvHelper::SetLiveChannels(uint32_t numOfChannels)
+{
+    m_numOfLiveChannels = numOfChannels;
+}
+
 ApplicationContainer
 NrtvHelper::InstallUsingIpv4(Ptr<Node> serverNode, NodeContainer clientNodes)
 {
     ApplicationContainer ret; // the return value of the function
     bool tcpInUse = m_protocolTid == TypeId::LookupByName("ns3::TcpSocketFactory");
 
-    Ptr<Ipv4> ipv4 = serverNode->GetObject<Ipv4>();
-    if (ipv4 == nullptr)
+    const Ipv4Address serverAddress = GetFirstIpv4Address(serverNode);
+
+    if (tcpInUse)
+    {
+        m_serverHelper->SetAttribute("LocalAddress", AddressValue(serverAddress));
+    }
+
+    m_lastInstalledServer = m_serverHelper->Install(serverNode);
+    ret.Add(m_lastInstalledServer);
+
+    if (tcpInUse)
     {
-        NS_FATAL_ERROR("No IPv4 object is found within the server node " << serverNode);
+        // If TCP server is used, installation is straightforward.
+        m_clientHelper->SetAttribute("RemoteServerAddress", AddressValue(serverAddress));
+        m_lastInstalledClients = m_clientHelper->Install(clientNodes);
     }
     else
     {
-        /// Still unclear if the hard-coded indices below will work in any possible cases.
-        const Ipv4InterfaceAddress interfaceAddress = ipv4->GetAddress(1, 0);
-        const Ipv4Address serverAddress = interfaceAddress.GetLocal();
-
-        if (tcpInUse)
+        /*
+         * If UDP is used, the PacketSink "Local" attribute of each client is
+         * set in the factory before the client is created, and the server only
+         * records the client until it starts.
+         */
+        m_lastInstalledClients = ApplicationContainer();
+        Ptr<NrtvUdpServer> serverApp = m_lastInstalledServer.Get(0)->GetObject<NrtvUdpServer>();
+        const uint16_t remotePort = serverApp->GetRemotePort();
+        uint32_t clientIndex = 0;
+
+        if (m_numOfLiveChannels == 0)
         {
-            m_serverHelper->SetAttribute("LocalAddress", AddressValue(serverAddress));
+            serverApp->ReserveClients(clientNodes.GetN());
         }
 
-        m_lastInstalledServer = m_serverHelper->Install(serverNode);
-        ret.Add(m_lastInstalledServer);
-
-        if (tcpInUse)
-        {
-            // If TCP server is used, installation is straightforward.
-            m_clientHelper->SetAttribute("RemoteServerAddress", AddressValue(serverAddress));
-            m_lastInstalledClients = m_clientHelper->Install(clientNodes);
-        }
-        else
+        for (auto it = clientNodes.Begin(); it != clientNodes.End(); it++, clientIndex++)
         {
-            // If UDP is used, we need to configure PacketSink "Local" attribute
-            // for each client node after installation.
-            m_lastInstalledClients = ApplicationContainer();
-            Ptr<NrtvUdpServer> serverApp = m_lastInstalledServer.Get(0)->GetObject<NrtvUdpServer>();
-            for (auto it = clientNodes.Begin(); it != clientNodes.End(); it++)
+            const Ipv4Address clientAddress = GetFirstIpv4Address(*it);
+            const InetSocketAddress localAddress(clientAddress, remotePort);
+            m_clientHelper->SetAttribute("Local", AddressValue(localAddress));
+            m_lastInstalledClients.Add(m_clientHelper->Install(*it));
+
+            if (m_numOfLiveChannels > 0)
+            {
+                serverApp->AddLiveChannelViewer(clientIndex % m_numOfLiveChannels,
+                                                clientAddress);
+            }
+            else
             {
-                Ptr<Ipv4> clientIpv4 = (*it)->GetObject<Ipv4>();
-                const Ipv4InterfaceAddress clientInterfaceAddress = clientIpv4->GetAddress(1, 0);
-                const Ipv4Address clientAddress = clientInterfaceAddress.GetLocal();
-                ApplicationContainer apps = m_clientHelper->Install((*it));
-                for (auto it2 = apps.Begin(); it2 != apps.End(); it2++)
-                {
-                    (*it2)->SetAttribute(
-                        "Local",
-                        AddressValue(InetSocketAddress(clientAddress, serverApp->GetRemotePort())));
-                }
-                m_lastInstalledClients.Add(apps);
                 serverApp->AddClient(clientAddress, m_nrtvVariables->GetNumOfVideos());
             }
         }
-        ret.Add(m_lastInstalledClients);
+
+        // Do not leave the address of the last client for the next installation.
+        m_clientHelper->SetAttribute("Local", AddressValue(Address()));
     }
 
+    ret.Add(m_lastInstalledClients);
     return ret;
 }
 
@@ -236,6 +236,20 @@ class NrtvHelper
      */
     void SetVariablesAttribute(std::string name, const AttributeValue& value);
 
+    /**
+     * @brief Let the clients installed by InstallUsingIpv4() watch live TV
+     *        channels instead of videos of their own.
+     *
+     * @param numOfChannels the number of live channels, or zero (the default)
+     *                      to disable live TV
+     *
+     * Only applies to UDP. The clients are distributed among the channels in
+     * turn, i.e., client i watches channel i modulo \p numOfChannels (see
+     * NrtvUdpServer::AddLiveChannelViewer()). Group addresses, if any, may be
+     * set afterwards on the server returned by GetServer().
+     */
+    void SetLiveChannels(uint32_t numOfChannels);
+
     /**
      * @brief Install an Nrtv Server application and several Nrtv client
      *        applications, in which each client is connected using IPv4 to the
@@ -253,6 +267,11 @@ class NrtvHelper
      * with SetClientAttribute() and SetServerAttribute(). Pointers to these
      * applications can be retrieved afterwards by calling GetClients() and
      * GetServer() methods separately.
+     *
+     * The method is meant for installing large numbers of clients at once.
+     * The address of every node is resolved once, and in UDP mode the server
+     * only records the clients, leaving their sockets and video workers to
+     * be created when their videos start (see NrtvUdpServer::AddClient()).
      */
     ApplicationContainer InstallUsingIpv4(Ptr<Node> serverNode, NodeContainer clientNodes);
 
@@ -299,6 +318,7 @@ class NrtvHelper
     Ptr<NrtvVariables> m_nrtvVariables;
     ApplicationContainer m_lastInstalledClients;
     ApplicationContainer m_lastInstalledServer;
+    uint32_t m_numOfLiveChannels; ///< Zero if live TV is disabled.
 
     /**
      * TypeId of the protocol to be used
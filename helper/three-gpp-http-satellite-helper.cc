@@ -29,6 +29,8 @@
 
 #include "three-gpp-http-satellite-helper.h"
 
+#include "traffic-helper-utils.h"
+
 #include "ns3/ipv4.h"
 #include "ns3/names.h"
 
@@ -101,6 +103,12 @@ ThreeGppHttpSatelliteServerHelper::SetAttribute(const std::string& name,
     m_factory.Set(name, value);
 }
 
+void
+ThreeGppHttpSatelliteServerHelper::SetServerTypeId(const std::string& typeId)
+{
+    m_factory.SetTypeId(typeId);
+}
+
 ApplicationContainer
 ThreeGppHttpSatelliteServerHelper::Install(Ptr<Node> node) const
 {
@@ -163,6 +171,12 @@ ThreeGppHttpHelper::SetServerAttribute(std::string name, const AttributeValue& v
     m_serverHelper->SetAttribute(name, value);
 }
 
+void
+ThreeGppHttpHelper::SetServerTypeId(std::string typeId)
+{
+    m_serverHelper->SetServerTypeId(typeId);
+}
+
 void
 ThreeGppHttpHelper::SetVariablesAttribute(std::string name, const AttributeValue& value)
 {
@@ -174,26 +188,15 @@ ThreeGppHttpHelper::InstallUsingIpv4(Ptr<Node> serverNode, NodeContainer clientN
 {
     ApplicationContainer ret; // the return value of the function
 
-    Ptr<Ipv4> ipv4 = serverNode->GetObject<Ipv4>();
-    if (ipv4 == nullptr)
-    {
-        NS_FATAL_ERROR("No IPv4 object is found within the server node " << serverNode);
-    }
-    else
-    {
-        /// Still unclear if the hard-coded indices below will work in any possible cases.
-        const Ipv4InterfaceAddress interfaceAddress = ipv4->GetAddress(1, 0);
-        const Ipv4Address serverAddress = interfaceAddress.GetLocal();
-
-        m_serverHelper->SetAttribute("LocalAddress", AddressValue(serverAddress));
+    const Ipv4Address serverAddress = GetFirstIpv4Address(serverNode);
+    m_serverHelper->SetAttribute("LocalAddress", AddressValue(serverAddress));
 
-        m_lastInstalledServer = m_serverHelper->Install(serverNode);
-        ret.Add(m_lastInstalledServer);
+    m_lastInstalledServer = m_serverHelper->Install(serverNode);
+    ret.Add(m_lastInstalledServer);
 
-        m_clientHelper->SetAttribute("RemoteServerAddress", AddressValue(serverAddress));
-        m_lastInstalledClients = m_clientHelper->Install(clientNodes);
-        ret.Add(m_lastInstalledClients);
-    }
+    m_clientHelper->SetAttribute("RemoteServerAddress", AddressValue(serverAddress));
+    m_lastInstalledClients = m_clientHelper->Install(clientNodes);
+    ret.Add(m_lastInstalledClients);
 
     return ret;
 }
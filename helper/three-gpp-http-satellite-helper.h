@@ -31,6 +31,7 @@
 #define THREE_GPP_HTTP_SATELLITE_HELPER_H
 
 #include "ns3/application-container.h"
+#include "ns3/ipv4-address.h"
 #include "ns3/node-container.h"
 #include "ns3/object-factory.h"
 #include "ns3/three-gpp-http-helper.h"
@@ -126,6 +127,14 @@ class ThreeGppHttpSatelliteServerHelper
      */
     void SetAttribute(const std::string& name, const AttributeValue& value);
 
+    /**
+     * Select the type of the server application to be installed. The default
+     * is `ns3::ThreeGppHttpServer`. Use `ns3::ThreeGppHttpSatelliteServer` for
+     * clients which pipeline their requests.
+     * @param typeId The name of the TypeId of the server application.
+     */
+    void SetServerTypeId(const std::string& typeId);
+
     /**
      * Install an ThreeGppHttpServer on each node of the input container
      * configured with all the attributes set with SetAttribute().
@@ -206,6 +215,14 @@ class ThreeGppHttpHelper
      */
     void SetServerAttribute(std::string name, const AttributeValue& value);
 
+    /**
+     * @brief Select the type of the server application to be installed, see
+     *        ThreeGppHttpSatelliteServerHelper::SetServerTypeId().
+     *
+     * @param typeId the name of the TypeId of the server application
+     */
+    void SetServerTypeId(std::string typeId);
+
     /**
      * @brief Helper function used to set the ThreeGppHttpVariables attributes
      *        used by this helper instance. Currently, only number of videos
@@ -0,0 +1,106 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "trace-replay-helper.h"
+
+#include "ns3/string.h"
+#include "ns3/trace-replay-application.h"
+#include "ns3/uinteger.h"
+
+namespace ns3
+{
+
+TraceReplayHelper::TraceReplayHelper(std::string protocol, Address address, std::string traceFile)
+    : m_file(TraceReplayFile::Open(traceFile)),
+      m_recordStep(0),
+      m_timeShiftStep(Seconds(0)),
+      m_nInstalled(0)
+{
+    m_factory.SetTypeId("ns3::TraceReplayApplication");
+    m_factory.Set("Protocol", StringValue(protocol));
+    m_factory.Set("Remote", AddressValue(address));
+    m_factory.Set("TraceFile", StringValue(traceFile));
+}
+
+void
+TraceReplayHelper::SetAttribute(std::string name, const AttributeValue& value)
+{
+    m_factory.Set(name, value);
+}
+
+void
+TraceReplayHelper::SetStagger(uint64_t recordStep, Time timeShiftStep)
+{
+    m_recordStep = recordStep;
+    m_timeShiftStep = timeShiftStep;
+}
+
+Ptr<TraceReplayFile>
+TraceReplayHelper::GetTraceFile() const
+{
+    return m_file;
+}
+
+ApplicationContainer
+TraceReplayHelper::Install(Ptr<Node> node)
+{
+    return ApplicationContainer(InstallPriv(node));
+}
+
+ApplicationContainer
+TraceReplayHelper::Install(NodeContainer c)
+{
+    ApplicationContainer apps;
+    for (NodeContainer::Iterator i = c.Begin(); i != c.End(); ++i)
+    {
+        apps.Add(InstallPriv(*i));
+    }
+
+    return apps;
+}
+
+Ptr<Application>
+TraceReplayHelper::InstallPriv(Ptr<Node> node)
+{
+    Ptr<TraceReplayApplication> app = m_factory.Create<TraceReplayApplication>();
+    app->SetTraceFile(m_file);
+
+    if (m_nInstalled > 0)
+    {
+        UintegerValue firstRecord;
+        TimeValue timeShift;
+        app->GetAttribute("FirstRecord", firstRecord);
+        app->GetAttribute("TimeShift", timeShift);
+
+        const uint64_t nRecords = m_file->GetNRecords();
+        if (nRecords > 0)
+        {
+            const uint64_t record = firstRecord.Get() + m_nInstalled * m_recordStep;
+            app->SetAttribute("FirstRecord", UintegerValue(record % nRecords));
+        }
+        app->SetAttribute("TimeShift", TimeValue(timeShift.Get() + m_timeShiftStep * m_nInstalled));
+    }
+
+    node->AddApplication(app);
+    m_nInstalled++;
+
+    return app;
+}
+
+} // namespace ns3
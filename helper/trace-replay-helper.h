@@ -0,0 +1,126 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef TRACE_REPLAY_HELPER_H
+#define TRACE_REPLAY_HELPER_H
+
+#include "ns3/address.h"
+#include "ns3/application-container.h"
+#include "ns3/attribute.h"
+#include "ns3/node-container.h"
+#include "ns3/nstime.h"
+#include "ns3/object-factory.h"
+#include "ns3/trace-replay-file.h"
+
+#include <stdint.h>
+#include <string>
+
+namespace ns3
+{
+
+/**
+ * @ingroup traffic
+ * @brief A helper to make it easier to instantiate an ns3::TraceReplayApplication
+ *        on a set of nodes.
+ *
+ * The trace file is mapped once, when the helper is created, and every
+ * application installed by the helper shares the mapping. To avoid all the
+ * applications sending the same packets at the same time, each application
+ * can be given its own position in the trace and its own time shift:
+ * the n-th application installed by the helper replays from record
+ * `FirstRecord + n * recordStep` (wrapped around the end of the trace) with a
+ * time shift of `TimeShift + n * timeShiftStep` (see SetStagger()).
+ */
+class TraceReplayHelper
+{
+  public:
+    /**
+     * Create a TraceReplayHelper to make it easier to work with
+     * TraceReplayApplications.
+     *
+     * @param protocol the name of the protocol to use to send traffic
+     *        by the applications, e.g., ns3::UdpSocketFactory.
+     * @param address the address of the remote node to send traffic to.
+     * @param traceFile path to the binary trace file to be replayed.
+     */
+    TraceReplayHelper(std::string protocol, Address address, std::string traceFile);
+
+    /**
+     * Helper function used to set the underlying application attributes.
+     *
+     * @param name the name of the application attribute to set
+     * @param value the value of the application attribute to set
+     */
+    void SetAttribute(std::string name, const AttributeValue& value);
+
+    /**
+     * Give each installed application a different part of the trace.
+     *
+     * @param recordStep number of records between the first records of
+     *        consecutively installed applications.
+     * @param timeShiftStep difference in time shift between consecutively
+     *        installed applications.
+     */
+    void SetStagger(uint64_t recordStep, Time timeShiftStep);
+
+    /**
+     * @return the shared mapping of the trace file.
+     */
+    Ptr<TraceReplayFile> GetTraceFile() const;
+
+    /**
+     * Install an ns3::TraceReplayApplication on each node of the input
+     * container configured with all the attributes set with SetAttribute.
+     *
+     * @param c NodeContainer of the set of nodes on which a
+     *          TraceReplayApplication will be installed.
+     * @returns Container of Ptr to the applications installed.
+     */
+    ApplicationContainer Install(NodeContainer c);
+
+    /**
+     * Install an ns3::TraceReplayApplication on the node configured with all
+     * the attributes set with SetAttribute.
+     *
+     * @param node The node on which a TraceReplayApplication will be installed.
+     * @returns Container of Ptr to the applications installed.
+     */
+    ApplicationContainer Install(Ptr<Node> node);
+
+  private:
+    /**
+     * @internal
+     * Install an ns3::TraceReplayApplication on the node and advance the
+     * stagger.
+     *
+     * @param node The node on which a TraceReplayApplication will be installed.
+     * @returns Ptr to the application installed.
+     */
+    Ptr<Application> InstallPriv(Ptr<Node> node);
+
+    ObjectFactory m_factory;
+    Ptr<TraceReplayFile> m_file;
+    uint64_t m_recordStep;
+    Time m_timeShiftStep;
+    uint32_t m_nInstalled;
+};
+
+} // namespace ns3
+
+#endif /* TRACE_REPLAY_HELPER_H */
@@ -0,0 +1,59 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+
+#include "traffic-helper-utils.h"
+
+#include "ns3/ipv4.h"
+#include "ns3/log.h"
+#include "ns3/node.h"
+
+NS_LOG_COMPONENT_DEFINE("TrafficHelperUtils");
+
+namespace ns3
+{
+
+Ipv4Address
+GetFirstIpv4Address(Ptr<Node> node)
+{
+    NS_LOG_FUNCTION(node);
+
+    Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
+    if (ipv4 == nullptr)
+    {
+        NS_FATAL_ERROR("No IPv4 object is found within the node " << node);
+    }
+
+    for (uint32_t i = 0; i < ipv4->GetNInterfaces(); i++)
+    {
+        for (uint32_t j = 0; j < ipv4->GetNAddresses(i); j++)
+        {
+            const Ipv4Address address = ipv4->GetAddress(i, j).GetLocal();
+            if (address != Ipv4Address::GetLoopback())
+            {
+                return address;
+            }
+        }
+    }
+
+    NS_FATAL_ERROR("No IPv4 address is assigned to the node " << node);
+    return Ipv4Address();
+}
+
+} // namespace ns3
@@ -0,0 +1,44 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+
+#ifndef TRAFFIC_HELPER_UTILS_H
+#define TRAFFIC_HELPER_UTILS_H
+
+#include "ns3/ipv4-address.h"
+#include "ns3/ptr.h"
+
+namespace ns3
+{
+
+class Node;
+
+/**
+ * @ingroup traffic
+ * @brief Find the address of a node to be used by the traffic helpers.
+ * @param node a node with Internet stack installed
+ * @return the first IPv4 address of the node which is not a loopback address
+ *
+ * A fatal error is raised if the node has no IPv4 object or no such address.
+ */
+Ipv4Address GetFirstIpv4Address(Ptr<Node> node);
+
+} // namespace ns3
+
+#endif /* TRAFFIC_HELPER_UTILS_H */
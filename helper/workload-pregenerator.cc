@@ -0,0 +1,273 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "workload-pregenerator.h"
+
+#include "ns3/integer.h"
+#include "ns3/log.h"
+#include "ns3/nrtv-tcp-client.h"
+#include "ns3/pointer.h"
+#include "ns3/simulator.h"
+#include "ns3/three-gpp-http-satellite-client.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+NS_LOG_COMPONENT_DEFINE("WorkloadPregenerator");
+
+namespace ns3
+{
+
+NS_OBJECT_ENSURE_REGISTERED(WorkloadPregenerator);
+
+WorkloadPregenerator::WorkloadPregenerator()
+    : m_threads(0),
+      m_stream(-1)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TypeId
+WorkloadPregenerator::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::WorkloadPregenerator")
+            .SetParent<Object>()
+            .AddConstructor<WorkloadPregenerator>()
+            .AddAttribute("Threads",
+                          "Maximum number of threads used by Generate(). Zero uses one "
+                          "thread per available processor core.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&WorkloadPregenerator::m_threads),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("Stream",
+                          "First stream number assigned to the registered variables "
+                          "objects before generating. A negative value keeps the streams "
+                          "which have been assigned to them.",
+                          IntegerValue(-1),
+                          MakeIntegerAccessor(&WorkloadPregenerator::m_stream),
+                          MakeIntegerChecker<int64_t>());
+    return tid;
+}
+
+void
+WorkloadPregenerator::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_jobs.clear();
+    m_jobIndex.clear();
+    Object::DoDispose();
+}
+
+void
+WorkloadPregenerator::Add(Ptr<NrtvVariables> variables,
+                          NrtvVariables::WorkloadChannel_t channel,
+                          uint32_t count)
+{
+    NS_LOG_FUNCTION(this << variables << channel << count);
+    NS_ASSERT(variables != nullptr);
+    GetJob(PeekPointer(variables), channel, count).nrtv = variables;
+}
+
+void
+WorkloadPregenerator::Add(Ptr<ThreeGppHttpSatelliteVariables> variables,
+                          ThreeGppHttpSatelliteVariables::WorkloadChannel_t channel,
+                          uint32_t count)
+{
+    NS_LOG_FUNCTION(this << variables << channel << count);
+    NS_ASSERT(variables != nullptr);
+    GetJob(PeekPointer(variables), channel, count).http = variables;
+}
+
+void
+WorkloadPregenerator::AddClients(ApplicationContainer apps, uint32_t sessions)
+{
+    NS_LOG_FUNCTION(this << apps.GetN() << sessions);
+
+    for (ApplicationContainer::Iterator it = apps.Begin(); it != apps.End(); ++it)
+    {
+        PointerValue pointer;
+
+        if (DynamicCast<NrtvTcpClient>(*it) != nullptr)
+        {
+            (*it)->GetAttribute("NrtvConfigurationVariables", pointer);
+            Ptr<NrtvVariables> variables = pointer.Get<NrtvVariables>();
+            Add(variables, NrtvVariables::WORKLOAD_CONNECTION_OPEN_DELAY, 1);
+            Add(variables, NrtvVariables::WORKLOAD_IDLE_TIME, sessions);
+        }
+        else if (DynamicCast<ThreeGppHttpSatelliteClient>(*it) != nullptr)
+        {
+            (*it)->GetAttribute("Variables", pointer);
+            Ptr<ThreeGppHttpSatelliteVariables> variables =
+                pointer.Get<ThreeGppHttpSatelliteVariables>();
+            Add(variables, ThreeGppHttpSatelliteVariables::WORKLOAD_PARSING_TIME, sessions);
+            Add(variables,
+                ThreeGppHttpSatelliteVariables::WORKLOAD_NUM_OF_EMBEDDED_OBJECTS,
+                sessions);
+            Add(variables, ThreeGppHttpSatelliteVariables::WORKLOAD_READING_TIME, sessions);
+        }
+        else
+        {
+            NS_LOG_LOGIC(this << " ignoring application " << *it);
+        }
+    }
+
+} // end of `void AddClients (ApplicationContainer, uint32_t)`
+
+void
+WorkloadPregenerator::Generate()
+{
+    NS_LOG_FUNCTION(this << m_jobs.size());
+    NS_ASSERT_MSG(Simulator::Now().IsZero(), "Generate() must be called before Simulator::Run()");
+
+    if (m_stream >= 0)
+    {
+        int64_t stream = m_stream;
+        for (Job& job : m_jobs)
+        {
+            if (job.nrtv != nullptr)
+            {
+                job.nrtv->SetStream(stream);
+                stream++;
+            }
+            else
+            {
+                stream += job.http->AssignStreams(stream);
+            }
+        }
+    }
+
+    uint32_t nThreads = m_threads;
+    if (nThreads == 0)
+    {
+        nThreads = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+    nThreads = static_cast<uint32_t>(std::min<std::size_t>(nThreads, m_jobs.size()));
+
+    /*
+     * Each job touches only the random variable streams of its own variables
+     * object, so the jobs are independent and may be taken by the threads in
+     * any order. The values are handed over to the variables objects only
+     * after every thread has finished.
+     */
+    std::atomic<std::size_t> nextJob(0);
+    auto worker = [this, &nextJob]() {
+        std::size_t i;
+        while ((i = nextJob.fetch_add(1)) < m_jobs.size())
+        {
+            RunJob(m_jobs[i]);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (uint32_t t = 1; t < nThreads; t++)
+    {
+        threads.emplace_back(worker);
+    }
+    worker(); // The calling thread takes part as well.
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    uint64_t nValues = 0;
+    for (Job& job : m_jobs)
+    {
+        for (std::size_t c = 0; c < job.counts.size(); c++)
+        {
+            const uint8_t channel = job.counts[c].first;
+            if (job.nrtv != nullptr)
+            {
+                job.nrtv->AppendPregeneratedWorkload(
+                    static_cast<NrtvVariables::WorkloadChannel_t>(channel),
+                    job.values[c]);
+            }
+            else
+            {
+                job.http->AppendPregeneratedWorkload(
+                    static_cast<ThreeGppHttpSatelliteVariables::WorkloadChannel_t>(channel),
+                    job.values[c]);
+            }
+            nValues += job.values[c].size();
+        }
+    }
+
+    NS_LOG_INFO(this << " generated " << nValues << " values for " << m_jobs.size()
+                     << " variables objects using " << std::max(nThreads, 1U) << " threads");
+
+    m_jobs.clear();
+    m_jobIndex.clear();
+
+} // end of `void Generate ()`
+
+WorkloadPregenerator::Job&
+WorkloadPregenerator::GetJob(const Object* key, uint8_t channel, uint32_t count)
+{
+    std::map<const Object*, std::size_t>::iterator it = m_jobIndex.find(key);
+    if (it == m_jobIndex.end())
+    {
+        it = m_jobIndex.insert(std::make_pair(key, m_jobs.size())).first;
+        m_jobs.push_back(Job());
+    }
+
+    Job& job = m_jobs[it->second];
+    for (std::pair<uint8_t, uint32_t>& entry : job.counts)
+    {
+        if (entry.first == channel)
+        {
+            entry.second += count;
+            return job;
+        }
+    }
+
+    job.counts.push_back(std::make_pair(channel, count));
+    return job;
+}
+
+void
+WorkloadPregenerator::RunJob(Job& job)
+{
+    job.values.resize(job.counts.size());
+
+    for (std::size_t c = 0; c < job.counts.size(); c++)
+    {
+        const uint8_t channel = job.counts[c].first;
+        std::vector<int64_t>& values = job.values[c];
+        values.reserve(job.counts[c].second);
+
+        for (uint32_t n = 0; n < job.counts[c].second; n++)
+        {
+            if (job.nrtv != nullptr)
+            {
+                values.push_back(job.nrtv->DrawWorkloadValue(
+                    static_cast<NrtvVariables::WorkloadChannel_t>(channel)));
+            }
+            else
+            {
+                values.push_back(job.http->DrawWorkloadValue(
+                    static_cast<ThreeGppHttpSatelliteVariables::WorkloadChannel_t>(channel)));
+            }
+        }
+    }
+
+} // end of `void RunJob (Job&)`
+
+} // end of `namespace ns3`
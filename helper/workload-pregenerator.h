@@ -0,0 +1,168 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef WORKLOAD_PREGENERATOR_H
+#define WORKLOAD_PREGENERATOR_H
+
+#include "ns3/application-container.h"
+#include "ns3/nrtv-variables.h"
+#include "ns3/object.h"
+#include "ns3/ptr.h"
+#include "ns3/three-gpp-http-satellite-variables.h"
+
+#include <map>
+#include <stdint.h>
+#include <utility>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup traffic
+ * @brief Draws the session parameters of many clients in parallel threads
+ *        before the simulation starts.
+ *
+ * Every NrtvVariables and ThreeGppHttpSatelliteVariables instance owns its random
+ * variable streams, one stream for each kind of parameter. The values which
+ * a client is going to draw during the simulation therefore depend only on
+ * its own streams, and can be drawn in advance, in any order and in any
+ * thread, without changing them. This class does exactly that: the number of
+ * values needed from each channel (see NrtvVariables::WorkloadChannel_t and
+ * ThreeGppHttpSatelliteVariables::WorkloadChannel_t) is registered with Add() or
+ * AddClients(), and Generate() draws them using up to `Threads` threads. The
+ * values are stored inside each variables object, which hands them out from
+ * its getters before drawing any new value. Once they run out, the getters
+ * continue drawing from the same streams, so the simulation results are
+ * bit-identical to a run without pre-generation:
+ * @code
+ *     ApplicationContainer clientApps = nrtvHelper.Install (clientNodes);
+ *     Ptr<WorkloadPregenerator> pregen = CreateObject<WorkloadPregenerator> ();
+ *     pregen->SetAttribute ("Stream", IntegerValue (100));
+ *     pregen->AddClients (clientApps, 4);
+ *     pregen->Generate ();
+ *     Simulator::Run ();
+ * @endcode
+ *
+ * If the `Stream` attribute is non-negative, Generate() first assigns fixed
+ * stream numbers to the registered variables objects, in the order in which
+ * they were registered. Otherwise the streams assigned automatically by the
+ * simulator are kept.
+ *
+ * Only variables objects which exist before the simulation starts can be
+ * covered. The server side of the applications (e.g., NrtvVideoWorker) creates
+ * its variables objects at run time, so its values are still drawn in the
+ * event loop.
+ */
+class WorkloadPregenerator : public Object
+{
+  public:
+    /// Creates a new instance of pre-generator.
+    WorkloadPregenerator();
+
+    /**
+     * @brief Returns the object TypeId.
+     * @return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * @brief Request values of an NRTV channel to be drawn by Generate().
+     * @param variables the variables object.
+     * @param channel the channel.
+     * @param count the number of values, added to any earlier request for the
+     *              same channel.
+     */
+    void Add(Ptr<NrtvVariables> variables,
+             NrtvVariables::WorkloadChannel_t channel,
+             uint32_t count);
+
+    /**
+     * @brief Request values of an HTTP channel to be drawn by Generate().
+     * @param variables the variables object.
+     * @param channel the channel.
+     * @param count the number of values, added to any earlier request for the
+     *              same channel.
+     */
+    void Add(Ptr<ThreeGppHttpSatelliteVariables> variables,
+             ThreeGppHttpSatelliteVariables::WorkloadChannel_t channel,
+             uint32_t count);
+
+    /**
+     * @brief Request the values drawn by the given clients in their first
+     *        sessions to be drawn by Generate().
+     * @param apps NrtvTcpClient and ThreeGppHttpSatelliteClient applications;
+     *             other applications are ignored.
+     * @param sessions the number of sessions (videos or web pages) per client.
+     */
+    void AddClients(ApplicationContainer apps, uint32_t sessions);
+
+    /**
+     * @brief Draw every requested value and store it in its variables object.
+     *
+     * Must be called before Simulator::Run(). The requests are cleared
+     * afterwards, so further values may be requested and generated again.
+     */
+    void Generate();
+
+  protected:
+    // Inherited from Object base class
+    virtual void DoDispose();
+
+  private:
+    /// The values requested from a single variables object.
+    struct Job
+    {
+        Ptr<NrtvVariables> nrtv;                           ///< Null for HTTP jobs.
+        Ptr<ThreeGppHttpSatelliteVariables> http;          ///< Null for NRTV jobs.
+        std::vector<std::pair<uint8_t, uint32_t>> counts;  ///< (channel, count).
+        std::vector<std::vector<int64_t>> values;          ///< Same order as counts.
+    };
+
+    /**
+     * @param key the variables object.
+     * @param channel the channel.
+     * @param count the number of values to add to the request.
+     * @return the job of the variables object, created if necessary.
+     */
+    Job& GetJob(const Object* key, uint8_t channel, uint32_t count);
+
+    /**
+     * @brief Draw the values of a job. Runs in a worker thread.
+     * @param job the job.
+     */
+    static void RunJob(Job& job);
+
+    /// `Threads` attribute.
+    uint32_t m_threads;
+
+    /// `Stream` attribute.
+    int64_t m_stream;
+
+    /// Requests, one job per variables object, in the order of registration.
+    std::vector<Job> m_jobs;
+
+    /// Index of each variables object's job in #m_jobs.
+    std::map<const Object*, std::size_t> m_jobIndex;
+
+}; // end of `class WorkloadPregenerator`
+
+} // end of `namespace ns3`
+
+#endif /* WORKLOAD_PREGENERATOR_H */
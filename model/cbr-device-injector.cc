@@ -0,0 +1,289 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "cbr-device-injector.h"
+
+#include "traffic-time-tag.h"
+
+#include "ns3/boolean.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/ipv4-queue-disc-item.h"
+#include "ns3/ipv4.h"
+#include "ns3/log.h"
+#include "ns3/net-device.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/pointer.h"
+#include "ns3/simulator.h"
+#include "ns3/trace-source-accessor.h"
+#include "ns3/traffic-control-layer.h"
+#include "ns3/udp-header.h"
+#include "ns3/uinteger.h"
+
+NS_LOG_COMPONENT_DEFINE("CbrDeviceInjector");
+
+namespace ns3
+{
+
+NS_OBJECT_ENSURE_REGISTERED(CbrDeviceInjector);
+
+/// Protocol number of IPv4 in the link layer.
+static const uint16_t IPV4_PROT_NUMBER = 0x0800;
+
+/// Protocol number of UDP in the IPv4 header.
+static const uint8_t UDP_PROT_NUMBER = 17;
+
+TypeId
+CbrDeviceInjector::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::CbrDeviceInjector")
+            .SetParent<Application>()
+            .AddConstructor<CbrDeviceInjector>()
+            .AddAttribute("Device",
+                          "The device to inject the packets to. If not set, the first "
+                          "device of the node is used.",
+                          PointerValue(),
+                          MakePointerAccessor(&CbrDeviceInjector::m_device),
+                          MakePointerChecker<NetDevice>())
+            .AddAttribute("Remote",
+                          "The IPv4 address and port of the destination",
+                          AddressValue(),
+                          MakeAddressAccessor(&CbrDeviceInjector::m_peer),
+                          MakeAddressChecker())
+            .AddAttribute("NextHop",
+                          "The link-layer address the packets are sent to. If not set, the "
+                          "broadcast address of the device is used.",
+                          AddressValue(),
+                          MakeAddressAccessor(&CbrDeviceInjector::m_nextHop),
+                          MakeAddressChecker())
+            .AddAttribute("Tos",
+                          "The Type of Service of the IPv4 header. "
+                          "All 8 bits of the TOS byte are set (including ECN bits).",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&CbrDeviceInjector::m_tos),
+                          MakeUintegerChecker<uint8_t>())
+            .AddAttribute("PacketSize",
+                          "The size of the payload of the constant packets sent.",
+                          UintegerValue(512),
+                          MakeUintegerAccessor(&CbrDeviceInjector::m_pktSize),
+                          MakeUintegerChecker<uint32_t>(1, 65507))
+            .AddAttribute(
+                "Interval",
+                "Interval to send constant packets. The value zero means that no sending.",
+                TimeValue(Seconds(1)),
+                MakeTimeAccessor(&CbrDeviceInjector::m_interval),
+                MakeTimeChecker())
+            .AddAttribute("UseTrafficControl",
+                          "If true and the node has a traffic control layer, the packets "
+                          "are enqueued in the queue disc of the device instead of being "
+                          "given to the device directly",
+                          BooleanValue(true),
+                          MakeBooleanAccessor(&CbrDeviceInjector::m_isTrafficControlEnabled),
+                          MakeBooleanChecker())
+            .AddAttribute("EnableStatisticsTags",
+                          "If true, some tags will be added to each transmitted packet to assist "
+                          "with statistics computation",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&CbrDeviceInjector::m_isStatisticsTagsEnabled),
+                          MakeBooleanChecker())
+            .AddTraceSource("Tx",
+                            "A new packet, including its UDP header, is sent",
+                            MakeTraceSourceAccessor(&CbrDeviceInjector::m_txTrace),
+                            "ns3::Packet::TracedCallback");
+    return tid;
+}
+
+CbrDeviceInjector::CbrDeviceInjector()
+    : m_pktSize(512),
+      m_tos(0),
+      m_isTrafficControlEnabled(true),
+      m_isStatisticsTagsEnabled(false),
+      m_totTxBytes(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+CbrDeviceInjector::SetDevice(Ptr<NetDevice> device)
+{
+    NS_LOG_FUNCTION(this << device);
+    m_device = device;
+}
+
+Ptr<NetDevice>
+CbrDeviceInjector::GetDevice() const
+{
+    return m_device;
+}
+
+uint64_t
+CbrDeviceInjector::GetSent() const
+{
+    return m_totTxBytes;
+}
+
+void
+CbrDeviceInjector::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_device = nullptr;
+    m_tc = nullptr;
+    m_template = nullptr;
+    Application::DoDispose();
+}
+
+void
+CbrDeviceInjector::StartApplication()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (!InetSocketAddress::IsMatchingType(m_peer))
+    {
+        NS_FATAL_ERROR("CbrDeviceInjector supports only an IPv4 remote address");
+    }
+
+    if (m_device == nullptr)
+    {
+        NS_ASSERT_MSG(GetNode()->GetNDevices() > 0, "The node has no devices");
+        m_device = GetNode()->GetDevice(0);
+    }
+
+    const InetSocketAddress remote = InetSocketAddress::ConvertFrom(m_peer);
+    Ipv4Address source = Ipv4Address::GetAny();
+    Ptr<Ipv4> ipv4 = GetNode()->GetObject<Ipv4>();
+    if (ipv4 != nullptr)
+    {
+        const int32_t interface = ipv4->GetInterfaceForDevice(m_device);
+        if (interface >= 0 && ipv4->GetNAddresses(interface) > 0)
+        {
+            source = ipv4->GetAddress(interface, 0).GetLocal();
+        }
+    }
+
+    // The headers are built once; every packet is a copy of the template.
+    m_udpHeader.SetSourcePort(remote.GetPort());
+    m_udpHeader.SetDestinationPort(remote.GetPort());
+    if (Node::ChecksumEnabled())
+    {
+        m_udpHeader.EnableChecksums();
+        m_udpHeader.InitializeChecksum(source, remote.GetIpv4(), UDP_PROT_NUMBER);
+    }
+    m_template = Create<Packet>(m_pktSize);
+    m_template->AddHeader(m_udpHeader);
+
+    m_ipv4Header.SetSource(source);
+    m_ipv4Header.SetDestination(remote.GetIpv4());
+    m_ipv4Header.SetProtocol(UDP_PROT_NUMBER);
+    m_ipv4Header.SetPayloadSize(m_template->GetSize());
+    m_ipv4Header.SetTtl(64);
+    m_ipv4Header.SetTos(m_tos);
+    m_ipv4Header.SetDontFragment();
+    if (Node::ChecksumEnabled())
+    {
+        m_ipv4Header.EnableChecksum();
+    }
+
+    m_destination = m_nextHop.IsInvalid() ? m_device->GetBroadcast() : m_nextHop;
+    m_tc = m_isTrafficControlEnabled ? GetNode()->GetObject<TrafficControlLayer>() : nullptr;
+
+    if (m_tc == nullptr)
+    {
+        // The queue disc item carries the IPv4 header separately.
+        m_template->AddHeader(m_ipv4Header);
+    }
+
+    NS_LOG_INFO(this << " injecting " << m_template->GetSize() << "-byte packets to device "
+                     << m_device << (m_tc == nullptr ? "" : " through traffic control")
+                     << " every " << m_interval.GetSeconds() << " s");
+
+    StartSending();
+
+} // end of `void StartApplication ()`
+
+void
+CbrDeviceInjector::StartSending()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (!m_interval.IsZero())
+    {
+        m_sendEvent = Simulator::Schedule(m_interval, &CbrDeviceInjector::SendPacket, this);
+    }
+}
+
+void
+CbrDeviceInjector::StopApplication()
+{
+    NS_LOG_FUNCTION(this);
+    Simulator::Cancel(m_sendEvent);
+}
+
+void
+CbrDeviceInjector::SendPacket()
+{
+    Inject(m_pktSize);
+    m_sendEvent = Simulator::Schedule(m_interval, &CbrDeviceInjector::SendPacket, this);
+}
+
+void
+CbrDeviceInjector::Inject(uint32_t payloadSize)
+{
+    Ptr<Packet> packet;
+    Ipv4Header ipv4Header = m_ipv4Header;
+
+    if (payloadSize == m_pktSize)
+    {
+        packet = m_template->Copy();
+    }
+    else
+    {
+        packet = Create<Packet>(payloadSize);
+        packet->AddHeader(m_udpHeader);
+        ipv4Header.SetPayloadSize(packet->GetSize());
+        if (m_tc == nullptr)
+        {
+            packet->AddHeader(ipv4Header);
+        }
+    }
+
+    if (m_isStatisticsTagsEnabled)
+    {
+        packet->AddPacketTag(TrafficTimeTag(Simulator::Now()));
+    }
+
+    m_txTrace(packet);
+
+    if (m_tc == nullptr)
+    {
+        m_device->Send(packet, m_destination, IPV4_PROT_NUMBER);
+    }
+    else
+    {
+        m_tc->Send(m_device,
+                   Create<Ipv4QueueDiscItem>(packet, m_destination, IPV4_PROT_NUMBER,
+                                             ipv4Header));
+    }
+
+    m_totTxBytes += payloadSize;
+    NS_LOG_INFO(this << " sent " << payloadSize << " bytes, total Tx " << m_totTxBytes
+                     << " bytes");
+}
+
+} // end of `namespace ns3`
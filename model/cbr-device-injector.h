@@ -0,0 +1,148 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef CBR_DEVICE_INJECTOR_H
+#define CBR_DEVICE_INJECTOR_H
+
+#include "ns3/address.h"
+#include "ns3/application.h"
+#include "ns3/event-id.h"
+#include "ns3/ipv4-header.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/traced-callback.h"
+#include "ns3/udp-header.h"
+
+#include <stdint.h>
+
+namespace ns3
+{
+
+class NetDevice;
+class Packet;
+class TrafficControlLayer;
+
+/**
+ * @ingroup traffic
+ * @brief Generate CBR background load by handing pre-built IPv4/UDP packets
+ *        directly to a NetDevice.
+ *
+ * CbrApplication sends every packet through a socket, UDP and IPv4, which is
+ * wasted effort when the only purpose of the traffic is to occupy a link.
+ * This application builds the UDP and IPv4 headers of its packets once when
+ * it starts, and then sends a copy of the same packet every `Interval`,
+ * bypassing the socket and the IP stack of the sending node:
+ * - if the node has a TrafficControlLayer and `UseTrafficControl` is true, the
+ *   packet is enqueued in the queue disc of the device, where it competes with
+ *   the foreground traffic of the node;
+ * - otherwise, the packet is given to NetDevice::Send() of the device.
+ *
+ * The packets are addressed to the IPv4 address and port in `Remote`, so the
+ * receiving side and the routers on the path process them as ordinary UDP
+ * packets, and a PacketSink at the destination can receive them. They are
+ * sent to the link-layer address in `NextHop`, or to the broadcast address of
+ * the device if `NextHop` is not set; the latter suits point-to-point links.
+ * The source address is the first IPv4 address of the device, if any.
+ *
+ * Like CbrApplication, the first packet is sent one interval after the
+ * application has started, and a TrafficTimeTag is attached to each packet if
+ * `EnableStatisticsTags` is true. Only IPv4 is supported.
+ */
+class CbrDeviceInjector : public Application
+{
+  public:
+    /**
+     * @brief Returns the object TypeId.
+     * @return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /// Creates a new instance of injector.
+    CbrDeviceInjector();
+
+    /**
+     * @param device the device to inject the packets to. Overrides the
+     *               `Device` attribute.
+     */
+    void SetDevice(Ptr<NetDevice> device);
+
+    /**
+     * @return the device which the packets are injected to, which is the
+     *         first device of the node if none has been given, once the
+     *         application has started
+     */
+    Ptr<NetDevice> GetDevice() const;
+
+    /**
+     * @brief Get the number of sent bytes
+     * @return the number of sent payload bytes, excluding the headers
+     */
+    uint64_t GetSent() const;
+
+  protected:
+    // Inherited from Object base class
+    virtual void DoDispose();
+
+    // Inherited from Application base class
+    virtual void StartApplication();
+    virtual void StopApplication();
+
+    /**
+     * @brief Schedule the first transmission. Invoked by StartApplication()
+     *        after the headers have been built.
+     */
+    virtual void StartSending();
+
+    /**
+     * @brief Build a packet with the given payload size and inject it.
+     * @param payloadSize payload size in bytes, excluding the headers.
+     *
+     * A packet of `PacketSize` bytes is a copy of the template packet.
+     */
+    void Inject(uint32_t payloadSize);
+
+    Time m_interval;     ///< `Interval` attribute.
+    uint32_t m_pktSize;  ///< `PacketSize` attribute.
+    EventId m_sendEvent; ///< Pending transmission event.
+
+  private:
+    /// Send a copy of the template packet and schedule the next one.
+    void SendPacket();
+
+    Ptr<NetDevice> m_device;            ///< `Device` attribute.
+    Address m_peer;                     ///< `Remote` attribute.
+    Address m_nextHop;                  ///< `NextHop` attribute.
+    uint8_t m_tos;                      ///< `Tos` attribute.
+    bool m_isTrafficControlEnabled;     ///< `UseTrafficControl` attribute.
+    bool m_isStatisticsTagsEnabled;     ///< `EnableStatisticsTags` attribute.
+    uint64_t m_totTxBytes;              ///< Total payload bytes sent so far.
+    Ptr<TrafficControlLayer> m_tc;      ///< Traffic control of the node, or null.
+    Ptr<Packet> m_template;             ///< The packet copied for every transmission.
+    UdpHeader m_udpHeader;              ///< UDP header of every packet.
+    Ipv4Header m_ipv4Header;            ///< IPv4 header of a `PacketSize` packet.
+    Address m_destination;              ///< Link-layer destination of the packets.
+
+    /// `Tx` trace source.
+    TracedCallback<Ptr<const Packet>> m_txTrace;
+
+}; // end of `class CbrDeviceInjector`
+
+} // end of `namespace ns3`
+
+#endif /* CBR_DEVICE_INJECTOR_H */
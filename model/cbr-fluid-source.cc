@@ -0,0 +1,133 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "cbr-fluid-source.h"
+
+#include "ns3/ipv4-header.h"
+#include "ns3/log.h"
+#include "ns3/net-device.h"
+#include "ns3/simulator.h"
+#include "ns3/udp-header.h"
+#include "ns3/uinteger.h"
+
+#include <cmath>
+
+NS_LOG_COMPONENT_DEFINE("CbrFluidSource");
+
+namespace ns3
+{
+
+NS_OBJECT_ENSURE_REGISTERED(CbrFluidSource);
+
+TypeId
+CbrFluidSource::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::CbrFluidSource")
+            .SetParent<CbrDeviceInjector>()
+            .AddConstructor<CbrFluidSource>()
+            .AddAttribute("NumOfFlows",
+                          "The number of CBR flows represented by the application.",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&CbrFluidSource::m_numOfFlows),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("UpdatePeriod",
+                          "Time between the injections of the accumulated load.",
+                          TimeValue(MilliSeconds(10)),
+                          MakeTimeAccessor(&CbrFluidSource::m_updatePeriod),
+                          MakeTimeChecker())
+            .AddAttribute("MaxAggregateSize",
+                          "The maximum payload size of an aggregate packet. "
+                          "The default value of 0 means the MTU of the device "
+                          "minus the IPv4 and UDP headers.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&CbrFluidSource::m_maxAggregateSize),
+                          MakeUintegerChecker<uint32_t>(0, 65507));
+    return tid;
+}
+
+CbrFluidSource::CbrFluidSource()
+    : m_numOfFlows(1),
+      m_maxAggregateSize(0),
+      m_aggregateSize(0),
+      m_backlog(0.0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+double
+CbrFluidSource::GetRate() const
+{
+    if (m_interval.IsZero())
+    {
+        return 0.0;
+    }
+    return static_cast<double>(m_numOfFlows) * m_pktSize / m_interval.GetSeconds();
+}
+
+void
+CbrFluidSource::StartSending()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT_MSG(m_updatePeriod.IsStrictlyPositive(), "UpdatePeriod must be positive");
+
+    m_backlog = 0.0;
+    m_aggregateSize = m_maxAggregateSize;
+    if (m_aggregateSize == 0)
+    {
+        const uint32_t headerSize =
+            Ipv4Header().GetSerializedSize() + UdpHeader().GetSerializedSize();
+        NS_ASSERT_MSG(GetDevice()->GetMtu() > headerSize,
+                      "The MTU of the device cannot fit the IPv4 and UDP headers");
+        m_aggregateSize = GetDevice()->GetMtu() - headerSize;
+    }
+    NS_LOG_INFO(this << " " << m_numOfFlows << " flows make " << GetRate() * 8.0
+                     << " bps, injected every " << m_updatePeriod.GetSeconds() << " s"
+                     << " in packets of up to " << m_aggregateSize << " bytes");
+
+    if (GetRate() > 0.0)
+    {
+        m_sendEvent = Simulator::Schedule(m_updatePeriod, &CbrFluidSource::Update, this);
+    }
+}
+
+void
+CbrFluidSource::Update()
+{
+    NS_LOG_FUNCTION(this);
+
+    m_backlog += GetRate() * m_updatePeriod.GetSeconds();
+
+    while (m_backlog >= m_aggregateSize)
+    {
+        Inject(m_aggregateSize);
+        m_backlog -= m_aggregateSize;
+    }
+
+    if (m_backlog >= 1.0)
+    {
+        const uint32_t size = static_cast<uint32_t>(std::floor(m_backlog));
+        Inject(size);
+        m_backlog -= size;
+    }
+
+    m_sendEvent = Simulator::Schedule(m_updatePeriod, &CbrFluidSource::Update, this);
+}
+
+} // end of `namespace ns3`
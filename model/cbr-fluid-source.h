@@ -0,0 +1,94 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef CBR_FLUID_SOURCE_H
+#define CBR_FLUID_SOURCE_H
+
+#include "cbr-device-injector.h"
+
+#include "ns3/nstime.h"
+
+#include <stdint.h>
+
+namespace ns3
+{
+
+/**
+ * @ingroup traffic
+ * @brief Generate the load of an aggregate of CBR flows as a fluid, with a
+ *        constant number of events per update period.
+ *
+ * The aggregate of `NumOfFlows` CBR flows, each sending `PacketSize` bytes
+ * every `Interval`, has the constant rate of
+ * `NumOfFlows * PacketSize / Interval`. Instead of sending every packet of
+ * every flow, this application wakes up every `UpdatePeriod` and injects the
+ * bytes which the flows would have sent since the previous update, as large
+ * aggregate packets of at most `MaxAggregateSize` bytes of payload. By
+ * default, the aggregate packets are as large as the MTU of the device
+ * allows, i.e., the MTU minus the IPv4 and UDP headers. Bytes which do not
+ * make a whole byte yet are carried over to the next update, so the
+ * long-term rate is exact. The packets are injected into a device in the
+ * same way as CbrDeviceInjector does, which also provides the other
+ * attributes.
+ *
+ * The cost is therefore one event per update period, regardless of the
+ * number of flows and their rate. The price is the granularity: the load
+ * arrives at the queue in bursts of one update period, and the header
+ * overhead is that of the aggregate packets rather than of the individual
+ * packets. Hence the application suits background load whose only role is to
+ * occupy capacity, with an update period which is short compared to the time
+ * scales of interest. CbrHelper::InstallFluid() configures it from the
+ * parameters given to CbrHelper::SetConstantTraffic().
+ */
+class CbrFluidSource : public CbrDeviceInjector
+{
+  public:
+    /**
+     * @brief Returns the object TypeId.
+     * @return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /// Creates a new instance of fluid source.
+    CbrFluidSource();
+
+    /**
+     * @return the aggregate rate of the flows in bytes per second
+     */
+    double GetRate() const;
+
+  protected:
+    // Inherited from CbrDeviceInjector base class
+    virtual void StartSending();
+
+  private:
+    /// Inject the bytes accumulated since the previous update.
+    void Update();
+
+    uint32_t m_numOfFlows;       ///< `NumOfFlows` attribute.
+    Time m_updatePeriod;         ///< `UpdatePeriod` attribute.
+    uint32_t m_maxAggregateSize; ///< `MaxAggregateSize` attribute.
+    uint32_t m_aggregateSize;    ///< Payload size of a full aggregate packet.
+    double m_backlog;            ///< Bytes generated but not yet injected.
+
+}; // end of `class CbrFluidSource`
+
+} // end of `namespace ns3`
+
+#endif /* CBR_FLUID_SOURCE_H */
@@ -0,0 +1,170 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "nrtv-catalog.h"
+
+#include "nrtv-variables.h"
+
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/nstime.h"
+#include "ns3/pointer.h"
+#include "ns3/uinteger.h"
+
+#include <limits>
+
+NS_LOG_COMPONENT_DEFINE("NrtvCatalog");
+
+namespace ns3
+{
+
+NS_OBJECT_ENSURE_REGISTERED(NrtvCatalog);
+
+NrtvCatalog::NrtvCatalog()
+    : m_numOfTitles(100),
+      m_zipfExponent(0.8),
+      m_popularityRng(CreateObject<ZipfRandomVariable>())
+{
+    NS_LOG_FUNCTION(this);
+    m_nrtvVariables = CreateObject<NrtvVariables>();
+}
+
+TypeId
+NrtvCatalog::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::NrtvCatalog")
+            .SetParent<Object>()
+            .AddConstructor<NrtvCatalog>()
+            .AddAttribute("NumOfTitles",
+                          "The number of titles in the catalog.",
+                          UintegerValue(100),
+                          MakeUintegerAccessor(&NrtvCatalog::m_numOfTitles),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("ZipfExponent",
+                          "The exponent of the Zipf distribution of the popularity of "
+                          "the titles. Zero makes every title equally popular.",
+                          DoubleValue(0.8),
+                          MakeDoubleAccessor(&NrtvCatalog::m_zipfExponent),
+                          MakeDoubleChecker<double>(0.0))
+            .AddAttribute("Variables",
+                          "The variables from which the titles are drawn.",
+                          PointerValue(),
+                          MakePointerAccessor(&NrtvCatalog::m_nrtvVariables),
+                          MakePointerChecker<NrtvVariables>());
+    return tid;
+}
+
+void
+NrtvCatalog::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_titles.clear();
+    m_nrtvVariables = nullptr;
+    m_popularityRng = nullptr;
+    Object::DoDispose();
+}
+
+uint32_t
+NrtvCatalog::GetNumOfTitles() const
+{
+    return m_numOfTitles;
+}
+
+const NrtvCatalog::Title&
+NrtvCatalog::GetTitle(uint32_t index)
+{
+    Generate();
+    NS_ASSERT_MSG(index < m_titles.size(), "Title " << index << " does not exist");
+    return m_titles[index];
+}
+
+uint32_t
+NrtvCatalog::PickTitle()
+{
+    Generate();
+    const uint32_t index = m_popularityRng->GetInteger() - 1; // Zipf is 1-based
+    NS_LOG_INFO(this << " picked title " << index);
+    return index;
+}
+
+int64_t
+NrtvCatalog::AssignStreams(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    m_nrtvVariables->SetStream(stream);
+    m_popularityRng->SetStream(stream + 1);
+    return 2;
+}
+
+uint64_t
+NrtvCatalog::GetMemoryUsage() const
+{
+    uint64_t bytes = 0;
+    for (const Title& title : m_titles)
+    {
+        bytes += title.slices.capacity() * sizeof(Slice);
+    }
+    return bytes;
+}
+
+void
+NrtvCatalog::Generate()
+{
+    if (!m_titles.empty())
+    {
+        return;
+    }
+
+    NS_LOG_FUNCTION(this << m_numOfTitles);
+    NS_ASSERT(m_nrtvVariables != nullptr);
+
+    if (m_nrtvVariables->GetSliceSizeMax() > std::numeric_limits<uint16_t>::max() ||
+        m_nrtvVariables->GetSliceEncodingDelayMax() >
+            MilliSeconds(std::numeric_limits<uint16_t>::max()))
+    {
+        NS_FATAL_ERROR("Slice size or encoding delay does not fit in the catalog");
+    }
+
+    m_popularityRng->SetAttribute("N", UintegerValue(m_numOfTitles));
+    m_popularityRng->SetAttribute("Alpha", DoubleValue(m_zipfExponent));
+
+    m_titles.resize(m_numOfTitles);
+    for (Title& title : m_titles)
+    {
+        title.numOfFrames = m_nrtvVariables->GetNumOfFrames();
+        NS_ASSERT(title.numOfFrames > 0);
+        title.numOfSlices = m_nrtvVariables->GetNumOfSlices();
+        NS_ASSERT(title.numOfSlices > 0);
+        title.slices.resize(static_cast<std::size_t>(title.numOfFrames) * title.numOfSlices);
+
+        for (Slice& slice : title.slices)
+        {
+            slice.size = static_cast<uint16_t>(m_nrtvVariables->GetSliceSize());
+            slice.encodingDelay = static_cast<uint16_t>(
+                m_nrtvVariables->GetSliceEncodingDelay().GetMilliSeconds());
+        }
+    }
+
+    NS_LOG_INFO(this << " generated " << m_numOfTitles << " titles in " << GetMemoryUsage()
+                     << " bytes");
+
+} // end of `void Generate ()`
+
+} // end of `namespace ns3`
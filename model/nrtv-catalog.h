@@ -0,0 +1,144 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef NRTV_CATALOG_H
+#define NRTV_CATALOG_H
+
+#include "ns3/object.h"
+#include "ns3/ptr.h"
+#include "ns3/random-variable-stream.h"
+
+#include <stdint.h>
+#include <vector>
+
+namespace ns3
+{
+
+class NrtvVariables;
+
+/**
+ * @ingroup nrtv
+ * @brief A video-on-demand catalog of NRTV titles, shared by video workers.
+ *
+ * Without a catalog, every NrtvVideoWorker draws the length of its video and
+ * the size and encoding delay of every slice from its own NrtvVariables. With
+ * a catalog (see the `Catalog` attribute of NrtvTcpServer and NrtvUdpServer),
+ * the slice sequence of each of the `NumOfTitles` titles is drawn once, from
+ * the NrtvVariables given by the `Variables` attribute, and is then played
+ * read-only by every worker which picks the title. Each video picks a title
+ * at random according to a Zipf popularity distribution, where title 0 is the
+ * most popular one and `ZipfExponent` controls how skewed the popularity is.
+ *
+ * The titles are generated on the first call of GetTitle() or PickTitle(), so
+ * the attributes must be set before that. Each slice is stored in 4 bytes: the
+ * slice size in bytes and the encoding delay in milliseconds, both as 16-bit
+ * values. With the default NrtvVariables, a title is about 3000 frames of 8
+ * slices long, i.e., about 100 kB.
+ */
+class NrtvCatalog : public Object
+{
+  public:
+    /// Creates a new instance of catalog.
+    NrtvCatalog();
+
+    /**
+     * @brief Returns the object TypeId.
+     * @return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /// A slice of a title.
+    struct Slice
+    {
+        uint16_t size;          ///< Slice size in bytes, excluding the NrtvHeader.
+        uint16_t encodingDelay; ///< Encoding delay in milliseconds.
+    };
+
+    /// A title, i.e., the content of a video.
+    struct Title
+    {
+        uint32_t numOfFrames;      ///< Length of the video in frames.
+        uint16_t numOfSlices;      ///< Number of slices per frame.
+        std::vector<Slice> slices; ///< All slices, frame by frame.
+
+        /**
+         * @param frameNumber frame number, starting from 1.
+         * @param sliceNumber slice number within the frame, starting from 1.
+         * @return the slice.
+         */
+        const Slice& GetSlice(uint32_t frameNumber, uint16_t sliceNumber) const
+        {
+            return slices[(frameNumber - 1) * numOfSlices + (sliceNumber - 1)];
+        }
+    };
+
+    /**
+     * @return the number of titles
+     */
+    uint32_t GetNumOfTitles() const;
+
+    /**
+     * @param index title index, from 0 to GetNumOfTitles() - 1.
+     * @return the title, which stays valid as long as the catalog exists.
+     */
+    const Title& GetTitle(uint32_t index);
+
+    /**
+     * @return the index of a randomly picked title, according to the
+     *         popularity of the titles
+     */
+    uint32_t PickTitle();
+
+    /**
+     * @brief Assign fixed random variable stream numbers to the random
+     *        variables used by the catalog.
+     * @param stream first stream index to use
+     * @return the number of stream indices assigned
+     */
+    int64_t AssignStreams(int64_t stream);
+
+    /**
+     * @return the number of bytes used by the slice sequences of the titles
+     */
+    uint64_t GetMemoryUsage() const;
+
+  protected:
+    // Inherited from Object base class
+    virtual void DoDispose();
+
+  private:
+    /// Draw the slice sequences of all titles, if not done yet.
+    void Generate();
+
+    /// `NumOfTitles` attribute.
+    uint32_t m_numOfTitles;
+    /// `ZipfExponent` attribute.
+    double m_zipfExponent;
+    /// `Variables` attribute.
+    Ptr<NrtvVariables> m_nrtvVariables;
+    /// Random variable for picking titles.
+    Ptr<ZipfRandomVariable> m_popularityRng;
+    /// All titles, empty until generated.
+    std::vector<Title> m_titles;
+
+}; // end of `class NrtvCatalog`
+
+} // end of `namespace ns3`
+
+#endif /* NRTV_CATALOG_H */
@@ -39,7 +39,8 @@ NrtvHeader::NrtvHeader()
       m_sliceNumber(0),
       m_numOfSlices(0),
       m_sliceSize(0),
-      m_arrivalTime(Simulator::Now())
+      m_arrivalTime(Simulator::Now()),
+      m_isCompact(false)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -122,10 +123,51 @@ NrtvHeader::GetArrivalTime() const
     return m_arrivalTime;
 }
 
+void
+NrtvHeader::SetCompact(bool isCompact)
+{
+    NS_LOG_FUNCTION(this << isCompact);
+    m_isCompact = isCompact;
+}
+
+bool
+NrtvHeader::IsCompact() const
+{
+    return m_isCompact;
+}
+
+uint32_t // static
+NrtvHeader::GetStaticSerializedSize()
+{
+    return 24;
+}
+
+uint32_t // static
+NrtvHeader::PeekSerializedSize(uint8_t firstByte)
+{
+    if (firstByte & COMPACT_MARKER)
+    {
+        return static_cast<uint8_t>(firstByte & ~COMPACT_MARKER);
+    }
+    else
+    {
+        return GetStaticSerializedSize();
+    }
+}
+
 uint32_t
 NrtvHeader::GetSerializedSize() const
 {
-    return 24;
+    if (m_isCompact)
+    {
+        return 1 + GetVarIntSize(m_frameNumber) + GetVarIntSize(m_numOfFrames) +
+               GetVarIntSize(m_sliceNumber) + GetVarIntSize(m_numOfSlices) +
+               GetVarIntSize(m_sliceSize) + 4;
+    }
+    else
+    {
+        return GetStaticSerializedSize();
+    }
 }
 
 void
@@ -141,6 +183,19 @@ NrtvHeader::Serialize(Buffer::Iterator start) const
 {
     NS_LOG_FUNCTION(this << &start);
     Buffer::Iterator i = start;
+
+    if (m_isCompact)
+    {
+        i.WriteU8(static_cast<uint8_t>(COMPACT_MARKER | GetSerializedSize()));
+        WriteVarInt(i, m_frameNumber);
+        WriteVarInt(i, m_numOfFrames);
+        WriteVarInt(i, m_sliceNumber);
+        WriteVarInt(i, m_numOfSlices);
+        WriteVarInt(i, m_sliceSize);
+        i.WriteHtonU32(static_cast<uint32_t>(m_arrivalTime.GetMicroSeconds()));
+        return;
+    }
+
     i.WriteHtonU32(m_frameNumber);
     i.WriteHtonU32(m_numOfFrames);
     i.WriteHtonU16(m_sliceNumber);
@@ -154,6 +209,30 @@ NrtvHeader::Deserialize(Buffer::Iterator start)
 {
     NS_LOG_FUNCTION(this << &start);
     Buffer::Iterator i = start;
+    m_isCompact = (i.PeekU8() & COMPACT_MARKER) != 0;
+
+    if (m_isCompact)
+    {
+        const uint32_t size = PeekSerializedSize(i.ReadU8());
+        m_frameNumber = ReadVarInt(i);
+        m_numOfFrames = ReadVarInt(i);
+        m_sliceNumber = ReadVarInt(i);
+        m_numOfSlices = ReadVarInt(i);
+        m_sliceSize = ReadVarInt(i);
+
+        /*
+         * Only the lowest 32 bits of the arrival time were sent. The header is
+         * read shortly after it was sent, so the arrival time is the latest
+         * time before now which matches those bits.
+         */
+        const int64_t now = Simulator::Now().GetMicroSeconds();
+        const uint32_t elapsed = static_cast<uint32_t>(now) - i.ReadNtohU32();
+        m_arrivalTime = MicroSeconds(now - elapsed);
+
+        NS_ASSERT_MSG(size == GetSerializedSize(), "Malformed compact NRTV header");
+        return size;
+    }
+
     m_frameNumber = i.ReadNtohU32();
     m_numOfFrames = i.ReadNtohU32();
     m_sliceNumber = i.ReadNtohU16();
@@ -169,4 +248,42 @@ NrtvHeader::GetInstanceTypeId() const
     return GetTypeId();
 }
 
+uint32_t // static
+NrtvHeader::GetVarIntSize(uint32_t value)
+{
+    uint32_t size = 1;
+    while (value >= 0x80)
+    {
+        value >>= 7;
+        size++;
+    }
+    return size;
+}
+
+void // static
+NrtvHeader::WriteVarInt(Buffer::Iterator& i, uint32_t value)
+{
+    while (value >= 0x80)
+    {
+        i.WriteU8(static_cast<uint8_t>(value) | 0x80);
+        value >>= 7;
+    }
+    i.WriteU8(static_cast<uint8_t>(value));
+}
+
+uint32_t // static
+NrtvHeader::ReadVarInt(Buffer::Iterator& i)
+{
+    uint32_t value = 0;
+    uint8_t byte;
+    uint8_t shift = 0;
+    do
+    {
+        byte = i.ReadU8();
+        value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+        shift += 7;
+    } while ((byte & 0x80) && (shift < 35));
+    return value;
+}
+
 } // namespace ns3
@@ -91,6 +91,24 @@ namespace ns3
  * @warning You will get an error if you invoke Packet::RemoveHeader() or
  *          Packet::PeekHeader() on a packet smaller than 24 bytes,
  *
+ * Optionally, the header can be serialized in a compact format by calling
+ * SetCompact() before adding it to a packet. The compact format begins with a
+ * byte which has its most significant bit set and carries the total length of
+ * the header in the remaining 7 bits. It is followed by the frame number, the
+ * number of frames, the slice number, the number of slices and the slice size,
+ * each as a variable-length integer (7 bits per byte, least significant group
+ * first), and by the arrival time as the lowest 32 bits of its value in
+ * microseconds. A typical compact header is 11 to 13 bytes long, while the
+ * longest one, with five 5-byte integers, is 30 bytes long. The receiver
+ * restores the arrival time from the current simulation time, so the header
+ * must be deserialized within about 71 minutes after it was sent, and the
+ * delay is only accurate to a microsecond.
+ *
+ * Both formats are recognized by Deserialize() from the first byte, thus the
+ * receiver needs no configuration. The full format never begins with a byte
+ * which has its most significant bit set, because frame numbers do not reach
+ * 2^31. PeekSerializedSize() tells the length of a header from its first
+ * byte, which is useful when the header may have been split across packets.
  */
 class NrtvHeader : public Header
 {
@@ -167,6 +185,30 @@ class NrtvHeader : public Header
      */
     Time GetArrivalTime() const;
 
+    /**
+     * @param isCompact whether this header instance is serialized in the
+     *                  compact format
+     */
+    void SetCompact(bool isCompact);
+
+    /**
+     * @return true if this header instance is serialized in the compact format
+     */
+    bool IsCompact() const;
+
+    /**
+     * @return the length of a header in the full format; a header in the
+     *         compact format may be up to 30 bytes long, see
+     *         PeekSerializedSize()
+     */
+    static uint32_t GetStaticSerializedSize();
+
+    /**
+     * @param firstByte the first byte of a serialized header
+     * @return the length of the serialized header
+     */
+    static uint32_t PeekSerializedSize(uint8_t firstByte);
+
     // Inherited from Header base class
     virtual uint32_t GetSerializedSize() const;
     virtual void Serialize(Buffer::Iterator start) const;
@@ -177,12 +219,35 @@ class NrtvHeader : public Header
     virtual TypeId GetInstanceTypeId() const;
 
   private:
+    /// Bit set in the first byte of a header in the compact format.
+    static const uint8_t COMPACT_MARKER = 0x80;
+
+    /**
+     * @param value an unsigned integer
+     * @return the number of bytes needed to write the value as a
+     *         variable-length integer
+     */
+    static uint32_t GetVarIntSize(uint32_t value);
+
+    /**
+     * @param i the buffer position, advanced past the written bytes
+     * @param value the value to be written as a variable-length integer
+     */
+    static void WriteVarInt(Buffer::Iterator& i, uint32_t value);
+
+    /**
+     * @param i the buffer position, advanced past the read bytes
+     * @return the value of the variable-length integer
+     */
+    static uint32_t ReadVarInt(Buffer::Iterator& i);
+
     uint32_t m_frameNumber; ///< Frame number field (an index starting from 0).
     uint32_t m_numOfFrames; ///< Number of frames field.
     uint16_t m_sliceNumber; ///< Slice number field (an index starting from 0).
     uint16_t m_numOfSlices; ///< Number of slices field.
     uint16_t m_sliceSize;   ///< Slice size field.
     Time m_arrivalTime;     ///< Arrival time field in Time format.
+    bool m_isCompact;       ///< Whether the compact format is used.
 
 }; // end of `class NrtvHeader`
 
@@ -24,6 +24,7 @@
 #include "nrtv-header.h"
 #include "nrtv-variables.h"
 
+#include "ns3/boolean.h"
 #include "ns3/config.h"
 #include "ns3/inet-socket-address.h"
 #include "ns3/inet6-socket-address.h"
@@ -51,6 +52,7 @@ NrtvTcpClient::NrtvTcpClient()
       m_socket(0),
       m_rxBuffer(Create<NrtvTcpClientRxBuffer>()),
       m_nrtvVariables(CreateObject<NrtvVariables>()),
+      m_keepAlive(false),
       m_lastDelay(0)
 {
     NS_LOG_FUNCTION(this);
@@ -82,6 +84,12 @@ NrtvTcpClient::GetTypeId()
                           UintegerValue(1935), // the default port for Adobe Flash video
                           MakeUintegerAccessor(&NrtvTcpClient::m_remoteServerPort),
                           MakeUintegerChecker<uint16_t>())
+            .AddAttribute("KeepAlive",
+                          "Keep the connection open across videos and request the next "
+                          "video in-band, instead of reconnecting for every video",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&NrtvTcpClient::m_keepAlive),
+                          MakeBooleanChecker())
             .AddTraceSource("Rx",
                             "One packet of has been received (not necessarily a "
                             "single video slice)",
@@ -106,7 +114,13 @@ NrtvTcpClient::GetTypeId()
             .AddTraceSource("StateTransition",
                             "Trace fired upon every NRTV client state transition",
                             MakeTraceSourceAccessor(&NrtvTcpClient::m_stateTransitionTrace),
-                            "ns3::NrtvVariables::StateTransitionCallback");
+                            "ns3::NrtvVariables::StateTransitionCallback")
+            .AddTraceSource("StateTransitionEnum",
+                            "Trace fired upon every state transition, with the old and the new "
+                            "state as enum values. Cheaper than StateTransition, which "
+                            "converts both states to strings.",
+                            MakeTraceSourceAccessor(&NrtvTcpClient::m_stateTransitionEnumTrace),
+                            "ns3::NrtvTcpClient::StateTransitionEnumCallback");
     return tid;
 }
 
@@ -230,6 +244,12 @@ NrtvTcpClient::ConnectionSucceededCallback(Ptr<Socket> socket)
         NS_ASSERT_MSG(m_socket == socket, "Invalid socket");
         socket->SetRecvCallback(MakeCallback(&NrtvTcpClient::ReceivedDataCallback, this));
         SwitchToState(RECEIVING);
+
+        if (m_keepAlive)
+        {
+            // Tell the server to keep the connection for the next videos.
+            SendVideoRequest();
+        }
     }
     else
     {
@@ -261,6 +281,12 @@ NrtvTcpClient::NormalCloseCallback(Ptr<Socket> socket)
     NS_LOG_FUNCTION(this << socket);
 
     CancelAllPendingEvents();
+
+    if (m_keepAlive)
+    {
+        socket->Close(); // close the other direction as well
+    }
+
     SwitchToState(IDLE);
     const Time idleTime = m_nrtvVariables->GetIdleTime();
     NS_LOG_INFO(this << " a video has just completed, now waiting for " << idleTime.GetSeconds()
@@ -375,7 +401,11 @@ NrtvTcpClient::OpenConnection()
         // NS_UNUSED (ret); // mute compiler warning
         NS_ASSERT_MSG(m_socket != nullptr, "Failed creating socket");
 
-        m_socket->ShutdownSend();
+        if (!m_keepAlive)
+        {
+            m_socket->ShutdownSend();
+        }
+
         m_socket->SetConnectCallback(
             MakeCallback(&NrtvTcpClient::ConnectionSucceededCallback, this),
             MakeCallback(&NrtvTcpClient::ConnectionFailedCallback, this));
@@ -435,20 +465,63 @@ NrtvTcpClient::CloseConnection()
     }
 }
 
+void
+NrtvTcpClient::SendVideoRequest()
+{
+    NS_LOG_FUNCTION(this);
+
+    NrtvHeader nrtvHeader; // frame number 0 marks a video request
+    Ptr<Packet> packet = Create<Packet>();
+    packet->AddHeader(nrtvHeader);
+    const uint32_t packetSize = packet->GetSize();
+    const int actualBytes = m_socket->Send(packet);
+    NS_LOG_DEBUG(this << " Send() packet " << packet << " of " << packetSize << " bytes,"
+                      << " return value= " << actualBytes);
+
+    if (actualBytes != static_cast<int>(packetSize))
+    {
+        NS_LOG_WARN(this << " failed to send a video request,"
+                         << " GetErrNo= " << m_socket->GetErrno());
+    }
+}
+
+void
+NrtvTcpClient::RequestNextVideo()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (m_state == IDLE)
+    {
+        SwitchToState(RECEIVING);
+        SendVideoRequest();
+    }
+    else
+    {
+        NS_LOG_WARN(this << " invalid state " << GetStateString() << " for RequestNextVideo");
+    }
+}
+
 uint32_t
 NrtvTcpClient::ReceiveVideoSlice(const Address& from)
 {
     NS_LOG_FUNCTION(this << from);
 
-    Ptr<Packet> slice = m_rxBuffer->PopVideoSlice();
-
-    NrtvHeader nrtvHeader;
+    NrtvHeader nrtvHeader; // already decoded by the Rx buffer
+    Ptr<Packet> slice = m_rxBuffer->PopVideoSlice(nrtvHeader);
+    const uint32_t frameNumber = nrtvHeader.GetFrameNumber();
 
-    NS_ASSERT_MSG(slice->GetSize() >= nrtvHeader.GetSerializedSize(),
-                  "The video slice contains no NRTV header");
+    if (frameNumber == 0)
+    {
+        // The server has marked the end of the video, but kept the connection.
+        SwitchToState(IDLE);
+        const Time idleTime = m_nrtvVariables->GetIdleTime();
+        NS_LOG_INFO(this << " a video has just completed, now waiting for "
+                         << idleTime.GetSeconds() << " seconds before the next video");
+        m_eventRequestNextVideo =
+            Simulator::Schedule(idleTime, &NrtvTcpClient::RequestNextVideo, this);
+        return 0;
+    }
 
-    slice->PeekHeader(nrtvHeader);
-    const uint32_t frameNumber = nrtvHeader.GetFrameNumber();
     const uint32_t numOfFrames = nrtvHeader.GetNumOfFrames();
     const uint16_t sliceNumber = nrtvHeader.GetSliceNumber();
     const uint16_t numOfSlices = nrtvHeader.GetNumOfSlices();
@@ -490,18 +563,32 @@ NrtvTcpClient::CancelAllPendingEvents()
                          << " seconds");
         Simulator::Cancel(m_eventRetryConnection);
     }
+
+    if (!Simulator::IsExpired(m_eventRequestNextVideo))
+    {
+        NS_LOG_INFO(this << " canceling RequestNextVideo which is due in "
+                         << Simulator::GetDelayLeft(m_eventRequestNextVideo).GetSeconds()
+                         << " seconds");
+        Simulator::Cancel(m_eventRequestNextVideo);
+    }
 }
 
 void
 NrtvTcpClient::SwitchToState(NrtvTcpClient::State_t state)
 {
-    const std::string oldState = GetStateString();
-    const std::string newState = GetStateString(state);
-    NS_LOG_FUNCTION(this << oldState << newState);
+    const State_t oldState = m_state;
+    NS_LOG_FUNCTION(this << GetStateString(oldState) << GetStateString(state));
 
     m_state = state;
-    NS_LOG_INFO(this << " NrtvTcpClient " << oldState << " --> " << newState);
-    m_stateTransitionTrace(oldState, newState);
+    NS_LOG_INFO(this << " NrtvTcpClient " << GetStateString(oldState) << " --> "
+                     << GetStateString(state));
+    m_stateTransitionEnumTrace(oldState, state);
+
+    // The state names are only constructed if someone is listening to them.
+    if (!m_stateTransitionTrace.IsEmpty())
+    {
+        m_stateTransitionTrace(GetStateString(oldState), GetStateString(state));
+    }
 }
 
 // NRTV CLIENT TX BUFFER //////////////////////////////////////////////////////
@@ -510,6 +597,7 @@ NS_LOG_COMPONENT_DEFINE("NrtvTcpClientRxBuffer");
 
 NrtvTcpClientRxBuffer::NrtvTcpClientRxBuffer()
     : m_totalBytes(0),
+      m_isHeaderKnown(false),
       m_sizeOfVideoSlice(0)
 {
     NS_LOG_FUNCTION(this);
@@ -533,8 +621,7 @@ NrtvTcpClientRxBuffer::IsEmpty() const
 bool
 NrtvTcpClientRxBuffer::HasVideoSlice() const
 {
-    NrtvHeader header;
-    return m_totalBytes >= (m_sizeOfVideoSlice + header.GetSerializedSize());
+    return m_isHeaderKnown && (m_totalBytes >= m_sizeOfVideoSlice);
 }
 
 void
@@ -543,10 +630,9 @@ NrtvTcpClientRxBuffer::PushPacket(Ptr<const Packet> packet)
     const uint32_t packetSize = packet->GetSize();
     NS_LOG_FUNCTION(this << packet << packetSize);
 
-    if (m_sizeOfVideoSlice == 0)
+    if (!m_isHeaderKnown)
     {
         // we don't know the size of slice yet
-        NrtvHeader header;
 
         if (IsEmpty())
         {
@@ -561,7 +647,10 @@ NrtvTcpClientRxBuffer::PushPacket(Ptr<const Packet> packet)
              */
             NS_ASSERT(m_rxBuffer.size() == 1);
             const uint32_t priorRemain = m_rxBuffer.back()->GetSize();
-            NS_ASSERT(priorRemain < header.GetSerializedSize());
+            uint8_t firstByte = 0;
+            m_rxBuffer.back()->CopyData(&firstByte, 1);
+            // A compact header may be longer than one in the full format.
+            NS_ASSERT(priorRemain < NrtvHeader::PeekSerializedSize(firstByte));
             NS_LOG_LOGIC(this << " combining a " << priorRemain << "-byte"
                               << " left over from previous slice with " << packetSize
                               << " bytes of packet");
@@ -569,19 +658,7 @@ NrtvTcpClientRxBuffer::PushPacket(Ptr<const Packet> packet)
         }
 
         NS_ASSERT(m_rxBuffer.size() == 1);
-        if (m_rxBuffer.back()->GetSize() >= header.GetSerializedSize())
-        {
-            m_sizeOfVideoSlice = PeekSliceSize(m_rxBuffer.back());
-            NS_LOG_INFO(this << " now expecting a video slice of " << m_sizeOfVideoSlice
-                             << " bytes");
-        }
-        else
-        {
-            /*
-             * Still not enough packets to constitute a 24-byte header (sigh).
-             * m_sizeOfVideoSlice stays at zero.
-             */
-        }
+        ReadHeader();
     }
     else
     {
@@ -595,16 +672,14 @@ NrtvTcpClientRxBuffer::PushPacket(Ptr<const Packet> packet)
 }
 
 Ptr<Packet>
-NrtvTcpClientRxBuffer::PopVideoSlice()
+NrtvTcpClientRxBuffer::PopVideoSlice(NrtvHeader& header)
 {
     NS_LOG_FUNCTION(this);
     NS_ASSERT_MSG(!IsEmpty(), "Unable to pop from an empty Rx buffer");
     NS_ASSERT_MSG(HasVideoSlice(), "Not enough packets to constitute a complete video slice");
-    NS_ASSERT(PeekSliceSize(m_rxBuffer.front()) == m_sizeOfVideoSlice);
 
     Ptr<Packet> slice = Create<Packet>();
-    NrtvHeader header;
-    const uint32_t expectedPacketSize = m_sizeOfVideoSlice + header.GetSerializedSize();
+    const uint32_t expectedPacketSize = m_sizeOfVideoSlice;
     uint32_t bytesToFetch = expectedPacketSize;
 
     while (bytesToFetch > 0)
@@ -646,6 +721,10 @@ NrtvTcpClientRxBuffer::PopVideoSlice()
     NS_LOG_DEBUG(this << " Rx buffer now contains " << m_rxBuffer.size() << " packet(s)" << " ("
                       << m_totalBytes << " bytes)");
 
+    header = m_header;
+    m_isHeaderKnown = false;
+    m_sizeOfVideoSlice = 0;
+
     // determine the size of next slice to receive
     if (m_rxBuffer.empty())
     {
@@ -653,35 +732,44 @@ NrtvTcpClientRxBuffer::PopVideoSlice()
          * The buffer is empty, so we can only tell about the next slice later
          * after the next packet is received.
          */
-        m_sizeOfVideoSlice = 0;
-    }
-    else if (m_rxBuffer.front()->GetSize() >= header.GetSerializedSize())
-    {
-        // the buffer is not empty and we can read an NRTV header from it
-        m_sizeOfVideoSlice = PeekSliceSize(m_rxBuffer.front());
-        NS_LOG_INFO(this << " now expecting a video slice of " << m_sizeOfVideoSlice << " bytes");
     }
     else
     {
-        // the buffer is not empty, but we cannot read an NRTV header
-        m_sizeOfVideoSlice = 0;
-        NS_LOG_INFO(this << " cannot read the header yet," << " it must have been split,"
-                         << " so the rest will come in the next packet");
+        ReadHeader();
     }
 
     return slice;
 
-} // end of `Ptr<Packet> PopVideoSlice ()`
+} // end of `Ptr<Packet> PopVideoSlice (NrtvHeader &)`
 
-uint32_t // static
-NrtvTcpClientRxBuffer::PeekSliceSize(Ptr<const Packet> packet)
+void
+NrtvTcpClientRxBuffer::ReadHeader()
 {
-    NS_LOG_FUNCTION(packet << packet->GetSize());
-    NrtvHeader nrtvHeader;
-    NS_ASSERT_MSG(packet->GetSize() >= nrtvHeader.GetSerializedSize(),
-                  "The packet contains no NRTV header");
-    packet->PeekHeader(nrtvHeader);
-    return nrtvHeader.GetSliceSize();
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!m_isHeaderKnown);
+    NS_ASSERT(!m_rxBuffer.empty());
+
+    Ptr<Packet> packet = m_rxBuffer.front();
+    uint8_t firstByte;
+
+    if ((packet->CopyData(&firstByte, 1) == 1) &&
+        (packet->GetSize() >= NrtvHeader::PeekSerializedSize(firstByte)))
+    {
+        // the buffer is not empty and we can read an NRTV header from it
+        packet->PeekHeader(m_header);
+        m_isHeaderKnown = true;
+        m_sizeOfVideoSlice = m_header.GetSerializedSize() + m_header.GetSliceSize();
+        NS_LOG_INFO(this << " now expecting a video slice of " << m_header.GetSliceSize()
+                         << " bytes");
+    }
+    else
+    {
+        /*
+         * Still not enough packets to constitute a whole header, it must have
+         * been split, so the rest will come in the next packet.
+         */
+        NS_LOG_INFO(this << " cannot read the header yet");
+    }
 }
 
 } // namespace ns3
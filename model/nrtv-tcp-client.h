@@ -23,6 +23,8 @@
 #ifndef NRTV_TCP_CLIENT_H
 #define NRTV_TCP_CLIENT_H
 
+#include "nrtv-header.h"
+
 #include "ns3/address.h"
 #include "ns3/application.h"
 #include "ns3/nstime.h"
@@ -54,6 +56,16 @@ class NrtvTcpClientRxBuffer;
  * between videos (e.g., commenting or picking the next video). After the IDLE
  * timer expires, the application restarts again by sending another connection
  * request.
+ *
+ * If the `KeepAlive` attribute is enabled, the application instead keeps the
+ * connection open across videos. Right after connecting, it sends a video
+ * request (an NrtvHeader with frame number 0) to the server. A server which
+ * understands the request, i.e., NrtvTcpServer, then marks the end of each
+ * video in-band with another NrtvHeader with frame number 0, instead of
+ * closing the connection. After the IDLE timer expires, the application
+ * requests the next video over the same connection, saving a connection setup
+ * per video. If the server closes the connection anyway, the application
+ * falls back to reconnecting.
  */
 class NrtvTcpClient : public Application
 {
@@ -130,6 +142,16 @@ class NrtvTcpClient : public Application
      */
     static std::string GetStateString(State_t state);
 
+    /**
+     * @brief Common signature used by callbacks to the `StateTransitionEnum`
+     *        trace source.
+     * @param oldState the old state.
+     * @param newState the new state.
+     *
+     * Use GetStateString() in the callback if the state names are needed.
+     */
+    typedef void (*StateTransitionEnumCallback)(State_t oldState, State_t newState);
+
   protected:
     // Inherited from Object base class
     virtual void DoDispose();
@@ -186,6 +208,18 @@ class NrtvTcpClient : public Application
      */
     void CloseConnection();
 
+    /**
+     * Send a video request to the server over the open connection. Used only
+     * when the `KeepAlive` attribute is enabled.
+     */
+    void SendVideoRequest();
+
+    /**
+     * Request the next video over the open connection, after the IDLE timer
+     * has expired.
+     */
+    void RequestNextVideo();
+
     /**
      * Receive a video slice from the video buffer.
      * @param from Address of the sender.
@@ -194,7 +228,7 @@ class NrtvTcpClient : public Application
     uint32_t ReceiveVideoSlice(const Address& from);
 
     /**
-     * Cancel reconnection event.
+     * Cancel reconnection and next video request events.
      */
     void CancelAllPendingEvents();
 
@@ -224,6 +258,7 @@ class NrtvTcpClient : public Application
 
     Address m_remoteServerAddress; ///!< Remote server address
     uint16_t m_remoteServerPort;   ///!< Remote server port
+    bool m_keepAlive;              ///!< `KeepAlive` attribute
 
     Time m_lastDelay; /// Last delay measurement. Used to compute jitter.
 
@@ -288,9 +323,16 @@ class NrtvTcpClient : public Application
      */
     TracedCallback<std::string, std::string> m_stateTransitionTrace;
 
+    /**
+     * @brief Trace source for application state changing, carrying the states
+     *        as enum values. See StateTransitionEnumCallback.
+     */
+    TracedCallback<State_t, State_t> m_stateTransitionEnumTrace;
+
     // EVENTS
 
     EventId m_eventRetryConnection; ///<! Event for retrying connection
+    EventId m_eventRequestNextVideo; ///<! Event for requesting the next video
 
 }; // end of `class NrtvTcpClient`
 
@@ -328,28 +370,35 @@ class NrtvTcpClientRxBuffer : public SimpleRefCount<NrtvTcpClientRxBuffer>
 
     /**
      * @brief Get and remove the next video slice from the buffer as a packet.
+     * @param header output argument which receives the NrtvHeader of the
+     *               slice, decoded when the header was received
      * @return the next video slice, re-assembled from the packets which have been
      *         received (still including its NrtvHeader)
      *
      * @warning As pre-conditions, IsEmpty() must be false and HasVideoSlice()
      *          must be true before calling this method.
      */
-    Ptr<Packet> PopVideoSlice();
+    Ptr<Packet> PopVideoSlice(NrtvHeader& header);
 
   private:
     /**
-     * @param packet the packet to be read
-     * @return the slice size field of the NRTV header embedded in the packet
+     * @brief Decode the NRTV header in the beginning of the first packet of the
+     *        buffer, if the packet is long enough to contain it.
      *
-     * @warning An NRTV header must be found in the beginning of the packet.
+     * The header of each slice is decoded only once, here, and kept in
+     * #m_header until the slice is popped.
      */
-    static uint32_t PeekSliceSize(Ptr<const Packet> packet);
+    void ReadHeader();
 
     /// The buffer, containing copies of packets received.
     std::list<Ptr<Packet>> m_rxBuffer;
     /// Overall size of buffer in bytes (including header).
     uint32_t m_totalBytes;
-    /// The expected size of the next video slice (zero if size is not yet known).
+    /// Whether #m_header has been decoded for the next video slice.
+    bool m_isHeaderKnown;
+    /// The header of the next video slice (valid if #m_isHeaderKnown is true).
+    NrtvHeader m_header;
+    /// The expected size of the next video slice, including its header.
     uint32_t m_sizeOfVideoSlice;
 
 }; // end of `class NrtvTcpClientRxBuffer`
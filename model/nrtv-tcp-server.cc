@@ -21,6 +21,7 @@
 
 #include "nrtv-tcp-server.h"
 
+#include "nrtv-catalog.h"
 #include "nrtv-video-worker.h"
 
 #include "ns3/address-utils.h"
@@ -69,6 +70,12 @@ NrtvTcpServer::GetTypeId()
                           UintegerValue(1935), // the default port for Adobe Flash video
                           MakeUintegerAccessor(&NrtvTcpServer::m_localPort),
                           MakeUintegerChecker<uint16_t>())
+            .AddAttribute("Catalog",
+                          "Catalog of titles played by the video workers. If not set, "
+                          "every video is drawn by its worker.",
+                          PointerValue(),
+                          MakePointerAccessor(&NrtvTcpServer::m_catalog),
+                          MakePointerChecker<NrtvCatalog>())
             .AddTraceSource("Tx",
                             "A packet has been sent",
                             MakeTraceSourceAccessor(&NrtvTcpServer::m_txTrace),
@@ -76,7 +83,13 @@ NrtvTcpServer::GetTypeId()
             .AddTraceSource("StateTransition",
                             "Trace fired upon every NRTV server state transition",
                             MakeTraceSourceAccessor(&NrtvTcpServer::m_stateTransitionTrace),
-                            "ns3::NrtvVariables::StateTransitionCallback");
+                            "ns3::NrtvVariables::StateTransitionCallback")
+            .AddTraceSource("StateTransitionEnum",
+                            "Trace fired upon every state transition, with the old and the new "
+                            "state as enum values. Cheaper than StateTransition, which "
+                            "converts both states to strings.",
+                            MakeTraceSourceAccessor(&NrtvTcpServer::m_stateTransitionEnumTrace),
+                            "ns3::NrtvTcpServer::StateTransitionEnumCallback");
     return tid;
 }
 
@@ -240,6 +253,10 @@ NrtvTcpServer::NewConnectionCreatedCallback(Ptr<Socket> socket, const Address& a
     NS_LOG_FUNCTION(this << socket << address);
 
     Ptr<NrtvVideoWorker> worker = CreateObject<NrtvVideoWorker>(socket);
+    if (m_catalog != nullptr)
+    {
+        worker->SetCatalog(m_catalog);
+    }
     worker->SetTxCallback(MakeCallback(&NrtvTcpServer::NotifyTxSlice, this));
     worker->SetVideoCompletedCallback(MakeCallback(&NrtvTcpServer::NotifyVideoCompleted, this));
     m_workers[socket] = worker;
@@ -302,12 +319,18 @@ NrtvTcpServer::NotifyVideoCompleted(Ptr<Socket> socket)
 void
 NrtvTcpServer::SwitchToState(NrtvTcpServer::State_t state)
 {
-    const std::string oldState = GetStateString();
-    const std::string newState = GetStateString(state);
-    NS_LOG_FUNCTION(this << oldState << newState);
+    const State_t oldState = m_state;
+    NS_LOG_FUNCTION(this << GetStateString(oldState) << GetStateString(state));
     m_state = state;
-    NS_LOG_INFO(this << " NrtvTcpServer " << oldState << " --> " << newState);
-    m_stateTransitionTrace(oldState, newState);
+    NS_LOG_INFO(this << " NrtvTcpServer " << GetStateString(oldState) << " --> "
+                     << GetStateString(state));
+    m_stateTransitionEnumTrace(oldState, state);
+
+    // The state names are only constructed if someone is listening to them.
+    if (!m_stateTransitionTrace.IsEmpty())
+    {
+        m_stateTransitionTrace(GetStateString(oldState), GetStateString(state));
+    }
 }
 
 } // namespace ns3
@@ -34,6 +34,7 @@ namespace ns3
 {
 
 class Socket;
+class NrtvCatalog;
 class NrtvVariables;
 class NrtvVideoWorker;
 
@@ -51,6 +52,9 @@ class NrtvVideoWorker;
  *
  * The application maintains several workers (NrtvTcpServerVideoWorker). Each
  * worker is responsible for sending a single video for a single client.
+ *
+ * If the `Catalog` attribute is set, the workers play titles picked from the
+ * given NrtvCatalog instead of drawing their videos.
  */
 class NrtvTcpServer : public Application
 {
@@ -102,6 +106,16 @@ class NrtvTcpServer : public Application
      */
     static std::string GetStateString(State_t state);
 
+    /**
+     * @brief Common signature used by callbacks to the `StateTransitionEnum`
+     *        trace source.
+     * @param oldState the old state.
+     * @param newState the new state.
+     *
+     * Use GetStateString() in the callback if the state names are needed.
+     */
+    typedef void (*StateTransitionEnumCallback)(State_t oldState, State_t newState);
+
   protected:
     // Inherited from Object base class
     virtual void DoDispose();
@@ -136,12 +150,19 @@ class NrtvTcpServer : public Application
 
     Address m_localAddress;
     uint16_t m_localPort;
+    Ptr<NrtvCatalog> m_catalog;
 
     // TRACE SOURCES
 
     TracedCallback<Ptr<const Packet>> m_txTrace;
     TracedCallback<std::string, std::string> m_stateTransitionTrace;
 
+    /**
+     * @brief Trace source for application state changing, carrying the states
+     *        as enum values. See StateTransitionEnumCallback.
+     */
+    TracedCallback<State_t, State_t> m_stateTransitionEnumTrace;
+
 }; // end of `class NrtvTcpServer`
 
 } // namespace ns3
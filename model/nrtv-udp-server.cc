@@ -21,6 +21,7 @@
 
 #include "nrtv-udp-server.h"
 
+#include "nrtv-catalog.h"
 #include "nrtv-variables.h"
 #include "nrtv-video-worker.h"
 
@@ -40,6 +41,7 @@
 #include "ns3/udp-socket-factory.h"
 #include "ns3/uinteger.h"
 
+#include <algorithm>
 #include <map>
 #include <string>
 
@@ -75,6 +77,12 @@ NrtvUdpServer::GetTypeId()
                           UintegerValue(1935), // the default port for Adobe Flash video
                           MakeUintegerAccessor(&NrtvUdpServer::m_remotePort),
                           MakeUintegerChecker<uint16_t>())
+            .AddAttribute("Catalog",
+                          "Catalog of titles played by the video workers. If not set, "
+                          "every video is drawn by its worker.",
+                          PointerValue(),
+                          MakePointerAccessor(&NrtvUdpServer::m_catalog),
+                          MakePointerChecker<NrtvCatalog>())
             .AddTraceSource("Tx",
                             "A packet has been sent",
                             MakeTraceSourceAccessor(&NrtvUdpServer::m_txTrace),
@@ -82,7 +90,13 @@ NrtvUdpServer::GetTypeId()
             .AddTraceSource("StateTransition",
                             "Trace fired upon every NRTV UDP server state transition",
                             MakeTraceSourceAccessor(&NrtvUdpServer::m_stateTransitionTrace),
-                            "ns3::NrtvVariables::StateTransitionCallback");
+                            "ns3::NrtvVariables::StateTransitionCallback")
+            .AddTraceSource("StateTransitionEnum",
+                            "Trace fired upon every state transition, with the old and the new "
+                            "state as enum values. Cheaper than StateTransition, which "
+                            "converts both states to strings.",
+                            MakeTraceSourceAccessor(&NrtvUdpServer::m_stateTransitionEnumTrace),
+                            "ns3::NrtvUdpServer::StateTransitionEnumCallback");
     return tid;
 }
 
@@ -148,12 +162,17 @@ NrtvUdpServer::StartApplication()
         SwitchToState(STARTED);
         NS_LOG_INFO(this << " NRTV UDP server was started - " << " Starting workers...");
 
-        for (auto w = m_workers.begin(); w != m_workers.end(); w++)
+        for (uint32_t i = 0; i < m_clients.size(); i++)
+        {
+            ScheduleVideo(i, m_nrtvVariables->GetConnectionOpenDelay());
+        }
+
+        for (uint32_t i = 0; i < m_channels.size(); i++)
         {
             Simulator::Schedule(m_nrtvVariables->GetConnectionOpenDelay(),
-                                &NrtvVideoWorker::ChangeState,
-                                w->second,
-                                NrtvVideoWorker::READY);
+                                &NrtvUdpServer::StartChannel,
+                                this,
+                                i);
         }
     }
     else
@@ -175,17 +194,29 @@ NrtvUdpServer::StopApplication()
     }
 
     SwitchToState(STOPPED);
+    Simulator::Cancel(m_eventStartVideos);
+    m_idleClients.clear();
 
-    // close all accepted sockets
-    for (std::map<Ptr<Socket>, Ptr<NrtvVideoWorker>>::iterator it = m_workers.begin();
-         it != m_workers.end();
-         ++it)
+    // close all active sockets
+    for (auto it = m_videos.begin(); it != m_videos.end(); ++it)
     {
         it->first->Close();
         it->first->SetSendCallback(MakeNullCallback<void, Ptr<Socket>, uint32_t>());
     }
     // Clear video workers
-    m_workers.clear();
+    m_videos.clear();
+
+    for (LiveChannel& channel : m_channels)
+    {
+        if (channel.socket != nullptr)
+        {
+            channel.socket->Close();
+            channel.socket->SetSendCallback(MakeNullCallback<void, Ptr<Socket>, uint32_t>());
+            channel.socket = nullptr;
+        }
+        channel.worker = nullptr;
+    }
+    m_channelOf.clear();
 }
 
 void
@@ -201,31 +232,74 @@ NrtvUdpServer::NotifyVideoCompleted(Ptr<Socket> socket)
 {
     NS_LOG_FUNCTION(this << socket);
 
-    auto it = m_workers.find(socket);
-    NS_ASSERT(it != m_workers.end());
-    m_workers.erase(it); // this will destroy the worker
-    videosLeft[socket]--;
+    auto it = m_videos.find(socket);
+    NS_ASSERT(it != m_videos.end());
+    const uint32_t clientIndex = it->second.clientIndex;
+    m_videos.erase(it); // this will destroy the worker
 
-    if (videosLeft[socket] == 0)
+    // The socket is not needed while the client is idle.
+    socket->Close();
+
+    ClientRecord& client = m_clients[clientIndex];
+    NS_ASSERT(client.videosLeft > 0);
+    client.videosLeft--;
+
+    if (client.videosLeft == 0)
     {
-        socket->Close();
         NS_LOG_LOGIC(this << " a video has just completed. "
                              " The client is now disconnected.");
-
         return;
     }
 
-    // Socket was not closed, so we will re-use it for the next video.
-    // This has to be done since there is no connection between UDP
-    // client and server, and client (PacketSink) does not have
-    // capability to request a new video.
-
     // Wait until the next video.
     const Time idleTime = m_nrtvVariables->GetIdleTime();
     NS_LOG_LOGIC(this << " a video has just completed, now waiting for " << idleTime.GetSeconds()
                       << " seconds before the next video");
+    ScheduleVideo(clientIndex, idleTime);
+}
+
+void
+NrtvUdpServer::NotifyChannelTxSlice(Ptr<Socket> socket, Ptr<const Packet> packet)
+{
+    NS_LOG_FUNCTION(this << socket << packet << packet->GetSize());
+    m_txTrace(packet);
+
+    auto it = m_channelOf.find(socket);
+    NS_ASSERT(it != m_channelOf.end());
+    const LiveChannel& channel = m_channels[it->second];
+
+    // The worker has sent the slice to the first viewer; copy it to the others.
+    for (const Address& address : channel.fanOutAddresses)
+    {
+        Ptr<Packet> copy = packet->Copy();
+        socket->SendTo(copy, 0, address);
+        m_txTrace(copy);
+    }
+
+    NS_LOG_INFO("NrtvUdpServer sent " << packet->GetSize() << " bytes to "
+                                      << (channel.fanOutAddresses.size() + 1)
+                                      << " destinations of channel " << it->second);
+}
+
+void
+NrtvUdpServer::NotifyChannelVideoCompleted(Ptr<Socket> socket)
+{
+    NS_LOG_FUNCTION(this << socket);
+
+    auto it = m_channelOf.find(socket);
+    NS_ASSERT(it != m_channelOf.end());
 
-    Simulator::Schedule(idleTime, &NrtvUdpServer::AddVideoWorker, this, socket);
+    /*
+     * The old worker must be destroyed before the new one is created, because
+     * disposing a worker detaches the callbacks from the socket they share.
+     */
+    m_channels[it->second].worker = nullptr;
+
+    // Live TV goes on with the next video straight away.
+    if (m_state == STARTED)
+    {
+        StartChannelVideo(it->second);
+    }
 }
 
 void
@@ -233,6 +307,204 @@ NrtvUdpServer::AddClient(Address remoteAddress, uint32_t numberOfVideos)
 {
     NS_LOG_FUNCTION(this << remoteAddress);
 
+    if (numberOfVideos == 0)
+    {
+        return;
+    }
+
+    ClientRecord client;
+    client.remoteAddress = remoteAddress;
+    client.videosLeft = numberOfVideos;
+    m_clients.push_back(client);
+
+    if (m_state == STARTED)
+    {
+        StartVideo(m_clients.size() - 1);
+    }
+
+    NS_LOG_INFO("NrtvUdpServer will stream " << numberOfVideos << " videos to " << remoteAddress);
+} // end of `void AddClient ()`
+
+void
+NrtvUdpServer::ReserveClients(uint32_t numOfClients)
+{
+    NS_LOG_FUNCTION(this << numOfClients);
+    m_clients.reserve(m_clients.size() + numOfClients);
+}
+
+void
+NrtvUdpServer::AddLiveChannelViewer(uint32_t channel, Address remoteAddress)
+{
+    NS_LOG_FUNCTION(this << channel << remoteAddress);
+    NS_ASSERT_MSG(m_state == NOT_STARTED,
+                  "Live channel viewers must be added before the application starts");
+    GetLiveChannel(channel).viewers.push_back(remoteAddress);
+}
+
+void
+NrtvUdpServer::SetLiveChannelGroup(uint32_t channel, Address groupAddress)
+{
+    NS_LOG_FUNCTION(this << channel << groupAddress);
+    NS_ASSERT_MSG(m_state == NOT_STARTED,
+                  "Live channel groups must be set before the application starts");
+    GetLiveChannel(channel).groupAddress = groupAddress;
+}
+
+uint32_t
+NrtvUdpServer::GetNLiveChannels() const
+{
+    return m_channels.size();
+}
+
+uint32_t
+NrtvUdpServer::GetNActiveVideos() const
+{
+    return m_videos.size();
+}
+
+NrtvUdpServer::LiveChannel&
+NrtvUdpServer::GetLiveChannel(uint32_t channel)
+{
+    if (channel >= m_channels.size())
+    {
+        m_channels.resize(channel + 1);
+    }
+    return m_channels[channel];
+}
+
+void
+NrtvUdpServer::StartChannel(uint32_t channelIndex)
+{
+    NS_LOG_FUNCTION(this << channelIndex);
+
+    LiveChannel& channel = m_channels[channelIndex];
+
+    if (!channel.groupAddress.IsInvalid())
+    {
+        channel.socket = CreateClientSocket(channel.groupAddress);
+        channel.socket->SetAllowBroadcast(true);
+    }
+    else if (!channel.viewers.empty())
+    {
+        // The socket is connected to the first viewer; the rest get copies.
+        channel.socket = CreateClientSocket(channel.viewers.front());
+        channel.fanOutAddresses.clear();
+        channel.fanOutAddresses.reserve(channel.viewers.size() - 1);
+
+        for (std::size_t i = 1; i < channel.viewers.size(); i++)
+        {
+            const Address& viewer = channel.viewers[i];
+            if (Ipv4Address::IsMatchingType(viewer))
+            {
+                channel.fanOutAddresses.push_back(
+                    InetSocketAddress(Ipv4Address::ConvertFrom(viewer), m_remotePort));
+            }
+            else if (Ipv6Address::IsMatchingType(viewer))
+            {
+                channel.fanOutAddresses.push_back(
+                    Inet6SocketAddress(Ipv6Address::ConvertFrom(viewer), m_remotePort));
+            }
+        }
+    }
+    else
+    {
+        NS_LOG_LOGIC(this << " live channel " << channelIndex << " has no viewers");
+        return;
+    }
+
+    m_channelOf[channel.socket] = channelIndex;
+    StartChannelVideo(channelIndex);
+
+} // end of `void StartChannel (uint32_t)`
+
+void
+NrtvUdpServer::StartChannelVideo(uint32_t channelIndex)
+{
+    NS_LOG_FUNCTION(this << channelIndex);
+
+    LiveChannel& channel = m_channels[channelIndex];
+    NS_ASSERT(channel.socket != nullptr);
+    NS_ASSERT(channel.worker == nullptr);
+    channel.worker = CreateObject<NrtvVideoWorker>(channel.socket);
+    if (m_catalog != nullptr)
+    {
+        channel.worker->SetCatalog(m_catalog);
+    }
+    channel.worker->SetTxCallback(MakeCallback(&NrtvUdpServer::NotifyChannelTxSlice, this));
+    channel.worker->SetVideoCompletedCallback(
+        MakeCallback(&NrtvUdpServer::NotifyChannelVideoCompleted, this));
+    channel.worker->ChangeState(NrtvVideoWorker::READY);
+}
+
+void
+NrtvUdpServer::StartVideo(uint32_t clientIndex)
+{
+    NS_LOG_FUNCTION(this << clientIndex);
+
+    Ptr<Socket> socket = CreateClientSocket(m_clients[clientIndex].remoteAddress);
+    Ptr<NrtvVideoWorker> worker = CreateObject<NrtvVideoWorker>(socket);
+    if (m_catalog != nullptr)
+    {
+        worker->SetCatalog(m_catalog);
+    }
+    worker->SetTxCallback(MakeCallback(&NrtvUdpServer::NotifyTxSlice, this));
+    worker->SetVideoCompletedCallback(MakeCallback(&NrtvUdpServer::NotifyVideoCompleted, this));
+    m_videos[socket] = {worker, clientIndex};
+    worker->ChangeState(NrtvVideoWorker::READY);
+}
+
+void
+NrtvUdpServer::ScheduleVideo(uint32_t clientIndex, const Time& delay)
+{
+    NS_LOG_FUNCTION(this << clientIndex << delay.GetSeconds());
+
+    const Time startTime = Simulator::Now() + delay;
+    m_clients[clientIndex].nextStartTime = startTime;
+
+    auto isLater = [this](uint32_t a, uint32_t b) {
+        return m_clients[a].nextStartTime > m_clients[b].nextStartTime;
+    };
+    m_idleClients.push_back(clientIndex);
+    std::push_heap(m_idleClients.begin(), m_idleClients.end(), isLater);
+
+    if (m_idleClients.front() == clientIndex)
+    {
+        // The new video is the earliest one, so the timer has to be re-armed.
+        Simulator::Cancel(m_eventStartVideos);
+        m_eventStartVideos = Simulator::Schedule(delay, &NrtvUdpServer::StartDueVideos, this);
+    }
+}
+
+void
+NrtvUdpServer::StartDueVideos()
+{
+    NS_LOG_FUNCTION(this);
+
+    auto isLater = [this](uint32_t a, uint32_t b) {
+        return m_clients[a].nextStartTime > m_clients[b].nextStartTime;
+    };
+    const Time now = Simulator::Now();
+
+    while (!m_idleClients.empty() && m_clients[m_idleClients.front()].nextStartTime <= now)
+    {
+        std::pop_heap(m_idleClients.begin(), m_idleClients.end(), isLater);
+        const uint32_t clientIndex = m_idleClients.back();
+        m_idleClients.pop_back();
+        StartVideo(clientIndex);
+    }
+
+    if (!m_idleClients.empty())
+    {
+        const Time delay = m_clients[m_idleClients.front()].nextStartTime - now;
+        m_eventStartVideos = Simulator::Schedule(delay, &NrtvUdpServer::StartDueVideos, this);
+    }
+}
+
+Ptr<Socket>
+NrtvUdpServer::CreateClientSocket(const Address& remoteAddress)
+{
+    NS_LOG_FUNCTION(this << remoteAddress);
+
     Ptr<Socket> socket = Socket::CreateSocket(GetNode(), UdpSocketFactory::GetTypeId());
     int ret;
 
@@ -254,39 +526,25 @@ NrtvUdpServer::AddClient(Address remoteAddress, uint32_t numberOfVideos)
     }
 
     // NS_UNUSED (ret);
+    return socket;
 
-    // Create an entry of how many videos are to be streamed to this socket
-    // before disconnecting.
-    videosLeft[socket] = numberOfVideos;
-
-    // Assign video worker for the socket
-    AddVideoWorker(socket);
-
-    NS_LOG_INFO("NrtvUdpServer will stream " << numberOfVideos << " videos to " << remoteAddress);
-} // end of `void AddClient ()`
-
-void
-NrtvUdpServer::AddVideoWorker(Ptr<Socket> socket)
-{
-    Ptr<NrtvVideoWorker> worker = CreateObject<NrtvVideoWorker>(socket);
-    m_workers[socket] = worker;
-    worker->SetTxCallback(MakeCallback(&NrtvUdpServer::NotifyTxSlice, this));
-    worker->SetVideoCompletedCallback(MakeCallback(&NrtvUdpServer::NotifyVideoCompleted, this));
-    if (GetState() == STARTED)
-    {
-        worker->ChangeState(NrtvVideoWorker::READY);
-    }
-}
+} // end of `Ptr<Socket> CreateClientSocket (const Address &remoteAddress)`
 
 void
 NrtvUdpServer::SwitchToState(NrtvUdpServer::State_t state)
 {
-    const std::string oldState = GetStateString();
-    const std::string newState = GetStateString(state);
-    NS_LOG_FUNCTION(this << oldState << newState);
+    const State_t oldState = m_state;
+    NS_LOG_FUNCTION(this << GetStateString(oldState) << GetStateString(state));
     m_state = state;
-    NS_LOG_INFO(this << " NrtvUdpServer " << oldState << " --> " << newState);
-    m_stateTransitionTrace(oldState, newState);
+    NS_LOG_INFO(this << " NrtvUdpServer " << GetStateString(oldState) << " --> "
+                     << GetStateString(state));
+    m_stateTransitionEnumTrace(oldState, state);
+
+    // The state names are only constructed if someone is listening to them.
+    if (!m_stateTransitionTrace.IsEmpty())
+    {
+        m_stateTransitionTrace(GetStateString(oldState), GetStateString(state));
+    }
 }
 
 } // namespace ns3
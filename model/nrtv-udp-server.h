@@ -30,12 +30,14 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 namespace ns3
 {
 
 class Packet;
 class Socket;
+class NrtvCatalog;
 class NrtvVariables;
 class NrtvVideoWorker;
 
@@ -50,6 +52,27 @@ class NrtvVideoWorker;
  *
  * When the transmission of a whole video is completed, the application becomes
  * idle for a random length of time, and then resumes with another video.
+ *
+ * A socket and a video worker exist for a client only while a video is being
+ * streamed to it. Between videos, the client is represented only by a compact
+ * record in a flat array, and all idle clients share a single timer event.
+ * Hence the memory usage grows with the number of concurrent viewers rather
+ * than with the total number of clients.
+ *
+ * For live TV scenarios, clients can instead be added as viewers of a live
+ * channel with AddLiveChannelViewer(). All viewers of a channel watch the
+ * same content, so a single video worker per channel generates each slice
+ * once. The slice is then either sent once to a group (multicast or
+ * broadcast) address given by SetLiveChannelGroup(), relying on the network
+ * to deliver it to the viewers, or fanned out to every viewer from the same
+ * event through one socket. Hence the number of frame and slice events grows
+ * with the number of channels rather than with the number of viewers. A live
+ * channel plays one video after another, without idle time, from the start
+ * to the end of the application. NrtvHelper::SetLiveChannels() distributes
+ * the clients among the channels.
+ *
+ * If the `Catalog` attribute is set, the videos, including those of the live
+ * channels, are titles picked from the given NrtvCatalog.
  */
 class NrtvUdpServer : public Application
 {
@@ -69,15 +92,58 @@ class NrtvUdpServer : public Application
 
     /**
      * @brief Adds a client in remote address to the server memory.
-     *        a video worker instance will be created for the client.
      *        Once server is started (or if it has already been started),
-     *        the video worker starts generating and sending packets.
+     *        a video worker instance is created for the client and starts
+     *        generating and sending packets.
      *
      * @param remoteAddress Address of the remote application.
      * @param numberOfVideos Number of videos streamed to the client.
+     *
+     * The client is only recorded. Its socket and video worker are created
+     * when a video starts and released when the video ends. Hence adding many
+     * clients at installation time is cheap.
      */
     void AddClient(Address remoteAddress, uint32_t numberOfVideos = 1);
 
+    /**
+     * @brief Reserve memory for the clients which are about to be added.
+     * @param numOfClients the expected number of additional clients.
+     */
+    void ReserveClients(uint32_t numOfClients);
+
+    /**
+     * @brief Adds a client as a viewer of a live channel.
+     * @param channel Index of the channel, which is created if it does not
+     *                exist yet.
+     * @param remoteAddress Address of the viewer.
+     *
+     * Viewers must be added before the application starts. If the channel has
+     * a group address, the viewer is only recorded, because the slices are
+     * delivered to it by the network.
+     */
+    void AddLiveChannelViewer(uint32_t channel, Address remoteAddress);
+
+    /**
+     * @brief Sends a live channel to a multicast or broadcast address instead
+     *        of fanning it out to its viewers.
+     * @param channel Index of the channel, which is created if it does not
+     *                exist yet.
+     * @param groupAddress IPv4 or IPv6 group address of the channel.
+     */
+    void SetLiveChannelGroup(uint32_t channel, Address groupAddress);
+
+    /**
+     * @return the number of live channels
+     */
+    uint32_t GetNLiveChannels() const;
+
+    /**
+     * @return the number of videos being streamed to clients added with
+     *         AddClient(), i.e., the number of sockets and video workers held
+     *         for them
+     */
+    uint32_t GetNActiveVideos() const;
+
     /**
      * @return the address of the destination client
      */
@@ -112,6 +178,16 @@ class NrtvUdpServer : public Application
      */
     static std::string GetStateString(State_t state);
 
+    /**
+     * @brief Common signature used by callbacks to the `StateTransitionEnum`
+     *        trace source.
+     * @param oldState the old state.
+     * @param newState the new state.
+     *
+     * Use GetStateString() in the callback if the state names are needed.
+     */
+    typedef void (*StateTransitionEnumCallback)(State_t oldState, State_t newState);
+
   protected:
     // Inherited from Object base class
     virtual void DoDispose();
@@ -128,20 +204,93 @@ class NrtvUdpServer : public Application
     void NotifyVideoCompleted(Ptr<Socket> socket);
 
     /**
-     * Add a video worker for the socket. Socket is assumed to be
-     * bound to remote address.
+     * Create a socket and a video worker for a client and start its video.
+     * @param clientIndex Index of the client in #m_clients.
+     */
+    void StartVideo(uint32_t clientIndex);
+
+    /**
+     * Set the start time of the next video of a client and put the client in
+     * the queue of idle clients.
+     * @param clientIndex Index of the client in #m_clients.
+     * @param delay Time until the next video starts.
      */
-    void AddVideoWorker(Ptr<Socket> socket);
+    void ScheduleVideo(uint32_t clientIndex, const Time& delay);
+
+    /// Start the videos which are due and re-arm #m_eventStartVideos.
+    void StartDueVideos();
+
+    /// Invoked by the video worker of a live channel after it has sent a slice.
+    void NotifyChannelTxSlice(Ptr<Socket> socket, Ptr<const Packet> packet);
+
+    /// Invoked by the video worker of a live channel after it has completed a video.
+    void NotifyChannelVideoCompleted(Ptr<Socket> socket);
+
+    /**
+     * Create the socket of a live channel and start its first video.
+     * @param channelIndex Index of the channel in #m_channels.
+     */
+    void StartChannel(uint32_t channelIndex);
+
+    /**
+     * Create a new video worker for a live channel.
+     * @param channelIndex Index of the channel in #m_channels.
+     */
+    void StartChannelVideo(uint32_t channelIndex);
+
+    /**
+     * Create a socket connected to a client.
+     * @param remoteAddress Address of the client.
+     * @return the new socket.
+     */
+    Ptr<Socket> CreateClientSocket(const Address& remoteAddress);
+
+    /// Compact record of a client, kept for the whole lifetime of the server.
+    struct ClientRecord
+    {
+        Address remoteAddress; ///< Address of the client.
+        Time nextStartTime;    ///< Start time of the next video, while idle.
+        uint32_t videosLeft;   ///< Videos left to be streamed to the client.
+    };
+
+    /// A video being streamed to a client.
+    struct ActiveVideo
+    {
+        Ptr<NrtvVideoWorker> worker; ///< The worker streaming the video.
+        uint32_t clientIndex;        ///< Index of the client in #m_clients.
+    };
+
+    /// A live channel, whose video is shared by all of its viewers.
+    struct LiveChannel
+    {
+        Address groupAddress;                  ///< Group address, if any.
+        std::vector<Address> viewers;          ///< Addresses of the viewers.
+        std::vector<Address> fanOutAddresses;  ///< Socket addresses to copy slices to.
+        Ptr<Socket> socket;                    ///< Socket used by the worker.
+        Ptr<NrtvVideoWorker> worker;           ///< Worker of the current video.
+    };
+
+    /**
+     * @param channel Index of a channel.
+     * @return the channel, created if it does not exist yet.
+     */
+    LiveChannel& GetLiveChannel(uint32_t channel);
 
     /**
      * Switches the state of the application.
      */
     void SwitchToState(State_t state);
 
-    State_t m_state;                            ///< Internal state of the application
-    std::map<Ptr<Socket>, uint32_t> videosLeft; ///< Videos left to be streamed to the socket.
-    std::map<Ptr<Socket>, Ptr<NrtvVideoWorker>> m_workers; ///< Worker memory
+    State_t m_state;                             ///< Internal state of the application
+    std::vector<ClientRecord> m_clients;         ///< All clients, in the order of AddClient()
+    std::map<Ptr<Socket>, ActiveVideo> m_videos; ///< Videos being streamed, by socket
+    /// Indices of the idle clients, as a min-heap on their next start time.
+    std::vector<uint32_t> m_idleClients;
+    EventId m_eventStartVideos;         ///< Event of StartDueVideos()
     Ptr<NrtvVariables> m_nrtvVariables; ///< Nrtv variable collection of this instance
+    Ptr<NrtvCatalog> m_catalog;         ///< `Catalog` attribute
+    std::vector<LiveChannel> m_channels;         ///< Live channels, by index
+    std::map<Ptr<Socket>, uint32_t> m_channelOf; ///< Index of the live channel, by socket
 
     // ATTRIBUTES
 
@@ -152,6 +301,12 @@ class NrtvUdpServer : public Application
     TracedCallback<Ptr<const Packet>> m_txTrace;
     TracedCallback<std::string, std::string> m_stateTransitionTrace;
 
+    /**
+     * @brief Trace source for application state changing, carrying the states
+     *        as enum values. See StateTransitionEnumCallback.
+     */
+    TracedCallback<State_t, State_t> m_stateTransitionEnumTrace;
+
 }; // end of `class NrtvUdpServer`
 
 } // namespace ns3
@@ -21,6 +21,7 @@
 
 #include "nrtv-variables.h"
 
+#include "ns3/boolean.h"
 #include "ns3/double.h"
 #include "ns3/integer.h"
 #include "ns3/log.h"
@@ -52,7 +53,9 @@ NrtvVariables::NrtvVariables()
       m_numOfFramesMean(3000),
       m_numOfFramesStdDev(2400),
       m_numOfFramesMin(200),
-      m_numOfFramesMax(36000)
+      m_numOfFramesMax(36000),
+      m_isWorkloadTapeEnabled(true),
+      m_workloadKey(0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -174,7 +177,17 @@ NrtvVariables::GetTypeId()
                           "The distribution for the amount of videos streamed to UDP clients.",
                           StringValue("ns3::ConstantRandomVariable[Constant=1]"),
                           MakePointerAccessor(&NrtvVariables::m_numberOfVideosRng),
-                          MakePointerChecker<RandomVariableStream>());
+                          MakePointerChecker<RandomVariableStream>())
+
+            // WORKLOAD CAPTURE AND REPLAY
+            .AddAttribute("EnableWorkloadTape",
+                          "If true, the values drawn by this instance are recorded and played "
+                          "back by the active WorkloadTape. Only instances which are created in "
+                          "the same order in every run, i.e., before the simulation starts, "
+                          "should have it enabled.",
+                          BooleanValue(true),
+                          MakeBooleanAccessor(&NrtvVariables::m_isWorkloadTapeEnabled),
+                          MakeBooleanChecker());
     return tid;
 
 } // end of `TypeId NrtvVariables::GetTypeId ()`
@@ -182,7 +195,7 @@ NrtvVariables::GetTypeId()
 uint32_t
 NrtvVariables::GetNumOfFrames()
 {
-    return GetBoundedInteger(m_numOfFramesRng, m_numOfFramesMin, m_numOfFramesMax);
+    return GetWorkloadValue(WORKLOAD_NUM_OF_FRAMES);
 }
 
 Time
@@ -200,13 +213,13 @@ NrtvVariables::GetNumOfSlices()
 uint32_t
 NrtvVariables::GetSliceSize()
 {
-    return m_sliceSizeRng->GetInteger();
+    return GetWorkloadValue(WORKLOAD_SLICE_SIZE);
 }
 
 Time
 NrtvVariables::GetSliceEncodingDelay()
 {
-    return MilliSeconds(m_sliceEncodingDelayRng->GetInteger());
+    return NanoSeconds(GetWorkloadValue(WORKLOAD_SLICE_ENCODING_DELAY));
 }
 
 uint64_t
@@ -224,13 +237,13 @@ NrtvVariables::GetDejitterBufferWindowSize()
 Time
 NrtvVariables::GetIdleTime()
 {
-    return Seconds(m_idleTimeRng->GetValue());
+    return NanoSeconds(GetWorkloadValue(WORKLOAD_IDLE_TIME));
 }
 
 Time
 NrtvVariables::GetConnectionOpenDelay()
 {
-    return Seconds(m_connectionOpenDelayRng->GetValue());
+    return NanoSeconds(GetWorkloadValue(WORKLOAD_CONNECTION_OPEN_DELAY));
 }
 
 double
@@ -442,6 +455,80 @@ NrtvVariables::GetNumOfVideos() const
     return nmbr;
 }
 
+// WORKLOAD CAPTURE AND REPLAY ////////////////////////////////////////////////
+
+int64_t
+NrtvVariables::DrawWorkloadValue(WorkloadChannel_t channel)
+{
+    switch (channel)
+    {
+    case NrtvVariables::WORKLOAD_NUM_OF_FRAMES:
+        return GetBoundedInteger(m_numOfFramesRng, m_numOfFramesMin, m_numOfFramesMax);
+    case NrtvVariables::WORKLOAD_SLICE_SIZE:
+        return m_sliceSizeRng->GetInteger();
+    case NrtvVariables::WORKLOAD_SLICE_ENCODING_DELAY:
+        return MilliSeconds(m_sliceEncodingDelayRng->GetInteger()).GetNanoSeconds();
+    case NrtvVariables::WORKLOAD_IDLE_TIME:
+        return Seconds(m_idleTimeRng->GetValue()).GetNanoSeconds();
+    case NrtvVariables::WORKLOAD_CONNECTION_OPEN_DELAY:
+        return Seconds(m_connectionOpenDelayRng->GetValue()).GetNanoSeconds();
+    default:
+        NS_FATAL_ERROR("Invalid workload channel " << channel);
+        break;
+    }
+
+    return 0;
+}
+
+void
+NrtvVariables::AppendPregeneratedWorkload(WorkloadChannel_t channel,
+                                          const std::vector<int64_t>& values)
+{
+    NS_LOG_FUNCTION(this << channel << values.size());
+    m_pregenerated.Append(channel, values);
+}
+
+void
+NrtvVariables::NotifyConstructionCompleted()
+{
+    NS_LOG_FUNCTION(this);
+
+    // The attributes are set by now, so the instance registers only if enabled.
+    if (m_isWorkloadTapeEnabled)
+    {
+        m_workloadTape = WorkloadTape::GetActive();
+        if (m_workloadTape != nullptr)
+        {
+            m_workloadKey = m_workloadTape->Register();
+        }
+    }
+
+    Object::NotifyConstructionCompleted();
+}
+
+int64_t
+NrtvVariables::GetWorkloadValue(WorkloadChannel_t channel)
+{
+    int64_t value;
+
+    if ((m_workloadTape != nullptr) && m_workloadTape->Replay(m_workloadKey, channel, value))
+    {
+        return value;
+    }
+
+    if (!m_pregenerated.Pop(channel, value))
+    {
+        value = DrawWorkloadValue(channel);
+    }
+
+    if (m_workloadTape != nullptr)
+    {
+        m_workloadTape->Capture(m_workloadKey, channel, value);
+    }
+
+    return value;
+}
+
 // OTHER HELPER METHODS ///////////////////////////////////////////////////////
 
 uint64_t
@@ -25,8 +25,10 @@
 #include "ns3/nstime.h"
 #include "ns3/object.h"
 #include "ns3/random-variable-stream.h"
+#include "ns3/workload-tape.h"
 
 #include <string>
+#include <vector>
 
 namespace ns3
 {
@@ -56,6 +58,13 @@ namespace ns3
  * Most parameters of the random distributions are configurable via attributes
  * and methods of this class.
  *
+ * The random values (except the constant ones) can be recorded and played
+ * back by WorkloadTape, or generated in advance by WorkloadPregenerator, under
+ * the channels listed in WorkloadChannel_t. Instances created in response to
+ * network events, e.g., by NrtvVideoWorker, disable the `EnableWorkloadTape`
+ * attribute, so that the instances on the tape are always created in the same
+ * order.
+ *
  * References:
  * [1] NGMN Alliance, "NGMN Radio Access Performance Evaluation Methodology",
  *     v1.0, January 2008.
@@ -66,6 +75,18 @@ namespace ns3
 class NrtvVariables : public Object
 {
   public:
+    /**
+     * @brief Channels under which the drawn values are recorded by WorkloadTape.
+     */
+    typedef enum
+    {
+        WORKLOAD_NUM_OF_FRAMES = 0,
+        WORKLOAD_SLICE_SIZE,
+        WORKLOAD_SLICE_ENCODING_DELAY,
+        WORKLOAD_IDLE_TIME,
+        WORKLOAD_CONNECTION_OPEN_DELAY
+    } WorkloadChannel_t;
+
     /**
      * @brief Common signature used by callback to collector's trace source.
      * @param oldState Name of the old state.
@@ -239,9 +260,36 @@ class NrtvVariables : public Object
 
     uint32_t GetNumOfVideos() const;
 
+    // WORKLOAD CAPTURE, REPLAY AND PRE-GENERATION
+
+    /**
+     * @brief Draw a new value of a workload channel from the random number
+     *        generators, bypassing WorkloadTape and any pre-generated values.
+     * @param channel the channel.
+     * @return the value, with times in nanoseconds.
+     */
+    int64_t DrawWorkloadValue(WorkloadChannel_t channel);
+
+    /**
+     * @brief Store values to be returned by the getter of a channel before
+     *        any new value is drawn (see WorkloadPregenerator).
+     * @param channel the channel.
+     * @param values the values, with times in nanoseconds.
+     */
+    void AppendPregeneratedWorkload(WorkloadChannel_t channel,
+                                    const std::vector<int64_t>& values);
+
+  protected:
+    // Inherited from ObjectBase base class
+    virtual void NotifyConstructionCompleted();
+
   private:
     // HELPER METHODS
 
+    // Get the next value of a channel: from the WorkloadTape if it is replaying,
+    // otherwise from the pre-generated values or the random number generators
+    int64_t GetWorkloadValue(WorkloadChannel_t channel);
+
     // Get a bounded integer from a random variable stream
     uint64_t GetBoundedInteger(Ptr<RandomVariableStream> random, double min, double max);
 
@@ -272,6 +320,12 @@ class NrtvVariables : public Object
     double m_numOfFramesMin;
     double m_numOfFramesMax;
 
+    // WORKLOAD CAPTURE, REPLAY AND PRE-GENERATION
+    bool m_isWorkloadTapeEnabled;     // `EnableWorkloadTape` attribute
+    Ptr<WorkloadTape> m_workloadTape; // null if the tape is off or disabled
+    uint32_t m_workloadKey;           // key of this instance in the tape
+    WorkloadBuffer m_pregenerated;    // values from WorkloadPregenerator
+
 }; // end of `class NrtvVariables`
 
 } // namespace ns3
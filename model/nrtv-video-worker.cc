@@ -25,11 +25,14 @@
 #include "nrtv-variables.h"
 
 #include "ns3/boolean.h"
+#include "ns3/enum.h"
 #include "ns3/log.h"
+#include "ns3/object-factory.h"
 #include "ns3/packet.h"
 #include "ns3/pointer.h"
 #include "ns3/simulator.h"
 #include "ns3/socket.h"
+#include "ns3/trace-source-accessor.h"
 #include "ns3/uinteger.h"
 
 #include <algorithm>
@@ -46,7 +49,15 @@ NrtvVideoWorker::NrtvVideoWorker()
       m_numOfFrames(0),
       m_numOfFramesServed(0),
       m_numOfSlices(0),
-      m_numOfSlicesServed(0)
+      m_numOfSlicesServed(0),
+      m_maxQueueSize(64),
+      m_overflowPolicy(NrtvVideoWorker::DROP_OLDEST),
+      m_isCompactHeader(false),
+      m_droppedFrameNumber(0),
+      m_isEncoderBlocked(false),
+      m_isKeepAlive(false),
+      m_isWaitingForRequest(false),
+      m_isVideoEnding(false)
 {
     NS_LOG_FUNCTION(this);
     NS_FATAL_ERROR("Default constructor not supported.");
@@ -55,12 +66,24 @@ NrtvVideoWorker::NrtvVideoWorker()
 NrtvVideoWorker::NrtvVideoWorker(Ptr<Socket> socket)
     : m_socket(socket),
       m_state(NrtvVideoWorker::NOT_READY),
+      m_title(nullptr),
       m_numOfFramesServed(0),
-      m_numOfSlicesServed(0)
+      m_numOfSlicesServed(0),
+      m_maxQueueSize(64),
+      m_overflowPolicy(NrtvVideoWorker::DROP_OLDEST),
+      m_isCompactHeader(false),
+      m_droppedFrameNumber(0),
+      m_isEncoderBlocked(false),
+      m_isKeepAlive(false),
+      m_isWaitingForRequest(false),
+      m_isVideoEnding(false)
 {
     NS_LOG_FUNCTION(this << socket);
 
-    m_nrtvVariables = CreateObject<NrtvVariables>();
+    // Workers are created as connections arrive, in an order which depends on
+    // the network, so their values are kept off the WorkloadTape.
+    m_nrtvVariables =
+        CreateObjectWithAttributes<NrtvVariables>("EnableWorkloadTape", BooleanValue(false));
     m_frameInterval = m_nrtvVariables->GetFrameInterval(); // frame rate
     m_numOfFrames = m_nrtvVariables->GetNumOfFrames();     // length of video
     NS_ASSERT(m_numOfFrames > 0);
@@ -72,6 +95,8 @@ NrtvVideoWorker::NrtvVideoWorker(Ptr<Socket> socket)
 
     socket->SetCloseCallbacks(MakeCallback(&NrtvVideoWorker::NormalCloseCallback, this),
                               MakeCallback(&NrtvVideoWorker::ErrorCloseCallback, this));
+    socket->SetSendCallback(MakeCallback(&NrtvVideoWorker::SendCallback, this));
+    socket->SetRecvCallback(MakeCallback(&NrtvVideoWorker::ReceivedDataCallback, this));
 }
 
 void
@@ -83,9 +108,11 @@ NrtvVideoWorker::DoDispose()
     m_socket->SetCloseCallbacks(MakeNullCallback<void, Ptr<Socket>>(),
                                 MakeNullCallback<void, Ptr<Socket>>());
     m_socket->SetSendCallback(MakeNullCallback<void, Ptr<Socket>, uint32_t>());
+    m_socket->SetRecvCallback(MakeNullCallback<void, Ptr<Socket>>());
     // m_socket->Close (); // Do not close the socket, leave it for the application.
 
     CancelAllPendingEvents();
+    ClearQueue();
 }
 
 TypeId
@@ -103,7 +130,46 @@ NrtvVideoWorker::GetTypeId()
                                           "Maximum size of a slice",
                                           UintegerValue(536),
                                           MakeUintegerAccessor(&NrtvVideoWorker::m_maxSliceSize),
-                                          MakeUintegerChecker<uint32_t>(200, 1500));
+                                          MakeUintegerChecker<uint32_t>(200, 1500))
+                            .AddAttribute("MaxQueueSize",
+                                          "Maximum number of encoded slices waiting for space "
+                                          "in the transmit buffer of the socket",
+                                          UintegerValue(64),
+                                          MakeUintegerAccessor(&NrtvVideoWorker::m_maxQueueSize),
+                                          MakeUintegerChecker<uint32_t>(1))
+                            .AddAttribute("QueueOverflowPolicy",
+                                          "What to do with a new slice when the queue is full",
+                                          EnumValue(NrtvVideoWorker::DROP_OLDEST),
+                                          MakeEnumAccessor<NrtvVideoWorker::QueueOverflowPolicy_t>(
+                                              &NrtvVideoWorker::m_overflowPolicy),
+                                          MakeEnumChecker(NrtvVideoWorker::DROP_OLDEST,
+                                                          "DROP_OLDEST",
+                                                          NrtvVideoWorker::DROP_FRAME,
+                                                          "DROP_FRAME",
+                                                          NrtvVideoWorker::BLOCK_ENCODER,
+                                                          "BLOCK_ENCODER"))
+                            .AddAttribute("CompactHeader",
+                                          "Whether the NrtvHeader of each slice is "
+                                          "serialized in the compact format",
+                                          BooleanValue(false),
+                                          MakeBooleanAccessor(&NrtvVideoWorker::m_isCompactHeader),
+                                          MakeBooleanChecker())
+                            .AddTraceSource("QueueingDelay",
+                                            "Time spent by a slice in the send queue, fired "
+                                            "when the slice is accepted by the socket",
+                                            MakeTraceSourceAccessor(
+                                                &NrtvVideoWorker::m_queueingDelayTrace),
+                                            "ns3::NrtvVideoWorker::QueueingDelayCallback")
+                            .AddTraceSource("Drop",
+                                            "A slice discarded because the send queue is full",
+                                            MakeTraceSourceAccessor(&NrtvVideoWorker::m_dropTrace),
+                                            "ns3::Packet::TracedCallback")
+                            .AddTraceSource("SkippedFrame",
+                                            "A frame which has ended without any of its "
+                                            "slices being encoded",
+                                            MakeTraceSourceAccessor(
+                                                &NrtvVideoWorker::m_skippedFrameTrace),
+                                            "ns3::NrtvVideoWorker::SkippedFrameCallback");
     return tid;
 }
 
@@ -114,6 +180,7 @@ NrtvVideoWorker::ChangeState(SendState_t state)
     {
         return; // If state is not changed, do nothing
     }
+    m_state = state;
     if (state == NrtvVideoWorker::READY)
     {
         // It is OK to start scheduling frames
@@ -122,6 +189,7 @@ NrtvVideoWorker::ChangeState(SendState_t state)
     else
     {
         CancelAllPendingEvents(); // cancel any scheduled transmission
+        ClearQueue();
         m_videoCompletedCallback(m_socket);
     }
 }
@@ -138,6 +206,35 @@ NrtvVideoWorker::SetVideoCompletedCallback(Callback<void, Ptr<Socket>> callback)
     m_videoCompletedCallback = callback;
 }
 
+void
+NrtvVideoWorker::SetCatalog(Ptr<NrtvCatalog> catalog)
+{
+    NS_LOG_FUNCTION(this << catalog);
+    NS_ASSERT_MSG(m_state == NrtvVideoWorker::NOT_READY,
+                  "The catalog must be set before the worker is ready");
+    m_catalog = catalog;
+
+    if (m_catalog == nullptr)
+    {
+        m_title = nullptr;
+    }
+    else
+    {
+        PickTitle();
+    }
+}
+
+void
+NrtvVideoWorker::PickTitle()
+{
+    const uint32_t index = m_catalog->PickTitle();
+    m_title = &m_catalog->GetTitle(index);
+    m_numOfFrames = m_title->numOfFrames;
+    m_numOfSlices = m_title->numOfSlices;
+    NS_LOG_INFO(this << " playing title " << index << ", which is " << m_numOfFrames
+                     << " frames long");
+}
+
 void
 NrtvVideoWorker::NormalCloseCallback(Ptr<Socket> socket)
 {
@@ -147,6 +244,7 @@ NrtvVideoWorker::NormalCloseCallback(Ptr<Socket> socket)
                             << " is received");
     m_socket->SetSendCallback(MakeNullCallback<void, Ptr<Socket>, uint32_t>());
     CancelAllPendingEvents(); // cancel any scheduled transmission
+    ClearQueue();
     m_videoCompletedCallback(m_socket);
 }
 
@@ -159,6 +257,7 @@ NrtvVideoWorker::ErrorCloseCallback(Ptr<Socket> socket)
                             << " is received");
     m_socket->SetSendCallback(MakeNullCallback<void, Ptr<Socket>, uint32_t>());
     CancelAllPendingEvents(); // cancel any scheduled transmission
+    ClearQueue();
     m_videoCompletedCallback(m_socket);
 }
 
@@ -169,6 +268,198 @@ NrtvVideoWorker::SendCallback(Ptr<Socket> socket, uint32_t availableBufferSize)
     NS_ASSERT_MSG(m_socket == socket,
                   "Socket " << m_socket << " is expected, " << "but socket " << socket
                             << " is received");
+    TrySend();
+
+    if (m_isEncoderBlocked && m_queue.size() < m_maxQueueSize)
+    {
+        // The queue has room again, so the held slice goes in and encoding resumes.
+        NS_LOG_INFO(this << " resuming the encoder");
+        m_isEncoderBlocked = false;
+        m_queue.push_back(m_blockedSlice);
+        m_blockedSlice.packet = nullptr;
+        TrySend();
+
+        if (m_numOfSlicesServed < m_numOfSlices && !Simulator::IsExpired(m_eventNewFrame))
+        {
+            ScheduleNewSlice();
+        }
+    }
+
+    FinishVideo();
+}
+
+void
+NrtvVideoWorker::ReceivedDataCallback(Ptr<Socket> socket)
+{
+    NS_LOG_FUNCTION(this << socket);
+    NS_ASSERT_MSG(m_socket == socket,
+                  "Socket " << m_socket << " is expected, " << "but socket " << socket
+                            << " is received");
+
+    NrtvHeader nrtvHeader;
+    const uint32_t headerSize = nrtvHeader.GetSerializedSize();
+    Ptr<Packet> packet;
+
+    while ((packet = socket->Recv()))
+    {
+        if (packet->GetSize() == 0)
+        {
+            break; // EOF
+        }
+
+        if (m_rxBuffer != nullptr)
+        {
+            // Complete the request which was cut off at the end of the previous packet.
+            m_rxBuffer->AddAtEnd(packet);
+            packet = m_rxBuffer;
+            m_rxBuffer = nullptr;
+        }
+
+        while (packet->GetSize() >= headerSize)
+        {
+            packet->RemoveHeader(nrtvHeader);
+            NS_LOG_INFO(this << " received a video request");
+            m_isKeepAlive = true;
+
+            if (m_isWaitingForRequest)
+            {
+                m_isWaitingForRequest = false;
+                StartNextVideo();
+            }
+        }
+
+        if (packet->GetSize() > 0)
+        {
+            m_rxBuffer = packet;
+        }
+
+    } // end of `while ((packet = socket->Recv ()))`
+
+} // end of `void ReceivedDataCallback (Ptr<Socket> socket)`
+
+bool
+NrtvVideoWorker::EnqueueSlice(const QueuedSlice& slice)
+{
+    NS_LOG_FUNCTION(this << slice.packet << slice.frameNumber);
+
+    if (m_droppedFrameNumber == slice.frameNumber)
+    {
+        // The rest of a frame discarded by DROP_FRAME.
+        DropSlice(slice);
+        return true;
+    }
+
+    if (m_queue.size() < m_maxQueueSize)
+    {
+        m_queue.push_back(slice);
+        return true;
+    }
+
+    switch (m_overflowPolicy)
+    {
+    case NrtvVideoWorker::DROP_OLDEST:
+        NS_LOG_INFO(this << " queue is full, discarding the oldest slice");
+        DropSlice(m_queue.front());
+        m_queue.pop_front();
+        m_queue.push_back(slice);
+        break;
+
+    case NrtvVideoWorker::DROP_FRAME: {
+        NS_LOG_INFO(this << " queue is full, discarding frame " << slice.frameNumber);
+        m_droppedFrameNumber = slice.frameNumber;
+        std::deque<QueuedSlice>::iterator it = m_queue.begin();
+        while (it != m_queue.end())
+        {
+            if (it->frameNumber == slice.frameNumber)
+            {
+                DropSlice(*it);
+                it = m_queue.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+        DropSlice(slice);
+        break;
+    }
+
+    case NrtvVideoWorker::BLOCK_ENCODER:
+        NS_LOG_INFO(this << " queue is full, pausing the encoder");
+        NS_ASSERT(!m_isEncoderBlocked);
+        m_isEncoderBlocked = true;
+        m_blockedSlice = slice;
+        return false;
+
+    default:
+        NS_FATAL_ERROR("Unknown queue overflow policy " << m_overflowPolicy);
+        break;
+    }
+
+    return true;
+
+} // end of `bool EnqueueSlice (const QueuedSlice &)`
+
+void
+NrtvVideoWorker::TrySend()
+{
+    while (!m_queue.empty())
+    {
+        const QueuedSlice& slice = m_queue.front();
+        const uint32_t packetSize = slice.packet->GetSize();
+
+        if (m_socket->GetTxAvailable() < packetSize)
+        {
+            // Wait for SendCallback() to be invoked.
+            NS_LOG_LOGIC(this << " socket is full, " << m_queue.size() << " slices are queued");
+            return;
+        }
+
+        const int actualBytes = m_socket->Send(slice.packet);
+        NS_LOG_DEBUG(this << " Send() packet " << slice.packet << " of " << packetSize
+                          << " bytes," << " return value= " << actualBytes);
+
+        if (actualBytes < 0 || static_cast<uint32_t>(actualBytes) != packetSize)
+        {
+            // Retry once the socket reports space again.
+            NS_LOG_WARN(this << " failure in sending packet, will retry");
+            return;
+        }
+
+        m_queueingDelayTrace(Simulator::Now() - slice.enqueueTime);
+        m_txCallback(m_socket, slice.packet);
+        m_queue.pop_front();
+    }
+}
+
+void
+NrtvVideoWorker::DropSlice(const QueuedSlice& slice)
+{
+    NS_LOG_FUNCTION(this << slice.packet << slice.frameNumber);
+    m_dropTrace(slice.packet);
+}
+
+void
+NrtvVideoWorker::ClearQueue()
+{
+    NS_LOG_FUNCTION(this << m_queue.size());
+
+    for (std::deque<QueuedSlice>::const_iterator it = m_queue.begin(); it != m_queue.end(); ++it)
+    {
+        if (it->frameNumber > 0) // not an end-of-video marker
+        {
+            DropSlice(*it);
+        }
+    }
+    m_queue.clear();
+
+    if (m_isEncoderBlocked)
+    {
+        DropSlice(m_blockedSlice);
+    }
+    m_isEncoderBlocked = false;
+    m_blockedSlice.packet = nullptr;
+    m_isVideoEnding = false; // nothing left to wait for
 }
 
 void
@@ -186,6 +477,11 @@ NrtvVideoWorker::ScheduleNewFrame()
 void
 NrtvVideoWorker::NewFrame()
 {
+    if (m_numOfFramesServed > 0)
+    {
+        CheckSkippedFrame(); // the previous frame has ended
+    }
+
     m_numOfFramesServed++;
     NS_LOG_FUNCTION(this << m_numOfFramesServed << m_numOfFrames);
 
@@ -201,6 +497,14 @@ NrtvVideoWorker::NewFrame()
     }
 
     m_numOfSlicesServed = 0;
+
+    if (m_isEncoderBlocked)
+    {
+        // SendCallback() will resume the encoding of this frame.
+        NS_LOG_LOGIC(this << " encoder is blocked by a full send queue");
+        return;
+    }
+
     ScheduleNewSlice(); // the first slice of this frame
 }
 
@@ -211,7 +515,10 @@ NrtvVideoWorker::ScheduleNewSlice()
     NS_LOG_FUNCTION(this << sliceNumber << m_numOfSlices);
     NS_ASSERT(sliceNumber <= m_numOfSlices);
 
-    const Time encodingDelay = m_nrtvVariables->GetSliceEncodingDelay();
+    const Time encodingDelay =
+        m_title == nullptr
+            ? m_nrtvVariables->GetSliceEncodingDelay()
+            : MilliSeconds(m_title->GetSlice(m_numOfFramesServed, sliceNumber).encodingDelay);
     NS_LOG_DEBUG(this << " encoding the slice needs " << encodingDelay.GetMilliSeconds() << " ms,"
                       << " while new frame is coming in "
                       << Simulator::GetDelayLeft(m_eventNewFrame).GetMilliSeconds() << " ms");
@@ -236,72 +543,136 @@ NrtvVideoWorker::NewSlice()
     m_numOfSlicesServed++;
     NS_LOG_FUNCTION(this << m_numOfSlicesServed << m_numOfSlices);
 
-    const uint32_t socketSize = m_socket->GetTxAvailable();
-    NS_LOG_DEBUG(this << " socket has " << socketSize << " bytes available for Tx");
-
-    const uint32_t sliceSize = m_nrtvVariables->GetSliceSize();
+    const uint32_t sliceSize =
+        m_title == nullptr ? m_nrtvVariables->GetSliceSize()
+                           : m_title->GetSlice(m_numOfFramesServed, m_numOfSlicesServed).size;
     NS_LOG_INFO(this << " video slice " << m_numOfSlicesServed << " is " << sliceSize << " bytes");
 
     NrtvHeader nrtvHeader;
-
-    const uint32_t headerSize = nrtvHeader.GetSerializedSize();
-    const uint32_t contentSize = std::min(sliceSize, socketSize - headerSize);
-    /*
-     * We simply assume that our packets are rather small and the socket will
-     * always has space to fit these packets.
-     */
-    NS_ASSERT_MSG(contentSize == sliceSize, "Socket size is too small");
-
     nrtvHeader.SetFrameNumber(m_numOfFramesServed);
     nrtvHeader.SetNumOfFrames(m_numOfFrames);
     nrtvHeader.SetSliceNumber(m_numOfSlicesServed);
     nrtvHeader.SetNumOfSlices(m_numOfSlices);
     nrtvHeader.SetSliceSize(sliceSize);
+    nrtvHeader.SetCompact(m_isCompactHeader);
 
-    Ptr<Packet> packet = Create<Packet>(contentSize);
+    Ptr<Packet> packet = Create<Packet>(sliceSize);
     packet->AddHeader(nrtvHeader);
-
-    const uint32_t packetSize = packet->GetSize();
-    NS_ASSERT(packetSize == (contentSize + headerSize));
-    NS_ASSERT(packetSize <= socketSize);
+    NS_ASSERT(packet->GetSize() == (sliceSize + nrtvHeader.GetSerializedSize()));
     // NS_ASSERT_MSG (packetSize <= m_maxSliceSize, // hard-coded MTU size 536
     //                "Packet size shall not be larger than MTU size");
 
-    NS_LOG_INFO(this << " created packet " << packet << " of " << packetSize << " bytes");
+    NS_LOG_INFO(this << " created packet " << packet << " of " << packet->GetSize() << " bytes");
 
-#ifdef NS3_LOG_ENABLE
-    const int actualBytes = m_socket->Send(packet);
-    NS_LOG_DEBUG(this << " Send() packet " << packet << " of " << packetSize << " bytes,"
-                      << " return value= " << actualBytes);
+    QueuedSlice slice;
+    slice.packet = packet;
+    slice.enqueueTime = Simulator::Now();
+    slice.frameNumber = m_numOfFramesServed;
+    const bool isEncoderRunning = EnqueueSlice(slice);
+    TrySend();
 
-    if ((unsigned)actualBytes == packetSize)
+    // make way for the next slice
+    if (isEncoderRunning && m_numOfSlicesServed < m_numOfSlices)
     {
-        // nothing
+        ScheduleNewSlice();
     }
-    else
+
+} // end of `void NewSlice ()`
+
+void
+NrtvVideoWorker::EndVideo()
+{
+    NS_LOG_FUNCTION(this);
+    CheckSkippedFrame(); // the last frame has ended
+    m_isVideoEnding = true;
+    FinishVideo();
+}
+
+void
+NrtvVideoWorker::CheckSkippedFrame()
+{
+    NS_LOG_FUNCTION(this << m_numOfFramesServed << m_numOfSlicesServed);
+
+    if (m_numOfSlicesServed == 0)
     {
-        /// @todo We don't do retry at the moment, so we just do nothing in this case
-        NS_LOG_ERROR(this << " failure in sending packet");
+        // Typically because `BLOCK_ENCODER` has paused the encoder for the whole frame.
+        NS_LOG_INFO(this << " frame " << m_numOfFramesServed << " is skipped");
+        m_skippedFrameTrace(m_numOfFramesServed);
     }
-#else  /* NS3_LOG_ENABLE */
-    m_socket->Send(packet);
-#endif /* NS3_LOG_ENABLE */
+}
 
-    m_txCallback(m_socket, packet);
+void
+NrtvVideoWorker::FinishVideo()
+{
+    NS_LOG_FUNCTION(this << m_isVideoEnding << m_queue.size() << m_isEncoderBlocked);
 
-    // make way for the next slice
-    if (m_numOfSlicesServed < m_numOfSlices)
+    if (!m_isVideoEnding || m_isEncoderBlocked)
     {
-        ScheduleNewSlice();
+        // The held slice goes into the queue first, see SendCallback().
+        return;
     }
 
-} // end of `void NewSlice ()`
+    if (!m_isKeepAlive)
+    {
+        if (!m_queue.empty())
+        {
+            // Wait for SendCallback() to drain the queue.
+            NS_LOG_LOGIC(this << " " << m_queue.size() << " slices are still queued");
+            return;
+        }
+
+        m_isVideoEnding = false;
+        m_videoCompletedCallback(m_socket);
+        return;
+    }
+
+    if (m_queue.size() >= m_maxQueueSize)
+    {
+        // Wait for SendCallback() to make room for the marker.
+        NS_LOG_LOGIC(this << " no room for the end-of-video marker");
+        return;
+    }
+
+    // Mark the end of the video in-band, behind the slices still in the queue.
+    NS_LOG_INFO(this << " video completed, keeping the socket for the next request");
+    m_isVideoEnding = false;
+    NrtvHeader nrtvHeader; // frame number 0 marks the end of the video
+    nrtvHeader.SetCompact(m_isCompactHeader);
+    QueuedSlice marker;
+    marker.packet = Create<Packet>();
+    marker.packet->AddHeader(nrtvHeader);
+    marker.enqueueTime = Simulator::Now();
+    marker.frameNumber = 0;
+    m_queue.push_back(marker);
+    TrySend();
+    m_isWaitingForRequest = true;
+}
 
 void
-NrtvVideoWorker::EndVideo()
+NrtvVideoWorker::StartNextVideo()
 {
     NS_LOG_FUNCTION(this);
-    m_videoCompletedCallback(m_socket);
+
+    if (m_catalog == nullptr)
+    {
+        m_numOfFrames = m_nrtvVariables->GetNumOfFrames();
+        NS_ASSERT(m_numOfFrames > 0);
+        m_numOfSlices = m_nrtvVariables->GetNumOfSlices();
+        NS_ASSERT(m_numOfSlices > 0);
+    }
+    else
+    {
+        PickTitle();
+    }
+    m_numOfFramesServed = 0;
+    m_numOfSlicesServed = 0;
+    m_droppedFrameNumber = 0;
+    NS_LOG_INFO(this << " the next video is " << m_numOfFrames << " frames long");
+
+    if (m_state == NrtvVideoWorker::READY)
+    {
+        m_eventNewFrame = Simulator::ScheduleNow(&NrtvVideoWorker::NewFrame, this);
+    }
 }
 
 void
@@ -22,11 +22,16 @@
 #ifndef NRTV_VIDEO_WORKER_H
 #define NRTV_VIDEO_WORKER_H
 
+#include "nrtv-catalog.h"
+
 #include "ns3/callback.h"
 #include "ns3/event-id.h"
 #include "ns3/nstime.h"
 #include "ns3/object.h"
 #include "ns3/ptr.h"
+#include "ns3/traced-callback.h"
+
+#include <deque>
 
 namespace ns3
 {
@@ -58,18 +63,41 @@ class NrtvVideoWorker : public Object
      * Each frame has a fixed number of slices, and each slice is preceded by a
      * random length of encoding delay. Each slice constitutes a single packet,
      * which size is also determined randomly. Each packet begins with a 24-byte
-     * NrtvHeader.
+     * NrtvHeader, or a shorter one in the compact format if the `CompactHeader`
+     * attribute is enabled.
      *
      * Each frame always abides to the given frame rate, i.e., the start of each
-     * frame is always punctual according to the frame rate. If the transmission
+     * frame is always punctual according to the frame rate. If the encoding
      * of the slices takes longer than the length of a single frame, then the
-     * remaining unsent slices would be discarded, without postponing the start
-     * time of the next frame.
+     * remaining unencoded slices would be discarded, without postponing the
+     * start time of the next frame.
+     *
+     * Encoded slices are put into a bounded queue (see the `MaxQueueSize`
+     * attribute), which is drained into the socket whenever the socket has
+     * enough space in its transmit buffer. Hence a congested connection does
+     * not cause slices to be lost immediately. When the queue is full, the
+     * `QueueOverflowPolicy` attribute determines which slices are discarded.
+     * Under `BLOCK_ENCODER`, the frames which start and end while the encoder
+     * is paused are skipped as a whole. Instead of the `Drop` trace source,
+     * which reports encoded slices, each of them is reported by the
+     * `SkippedFrame` trace source.
      *
-     * Each slice sent will invoke the callback function specified using
-     * SetTxCallback(). After all the frames have been transmitted, another
+     * Each slice handed to the socket will invoke the callback function
+     * specified using SetTxCallback(). After all the frames have been encoded
+     * and every queued or held slice has been handed to the socket, another
      * callback function, specified using SetVideoCompletedCallback(), will be
      * invoked.
+     *
+     * If the client has sent a video request (an NrtvHeader with frame number
+     * 0, see the `KeepAlive` attribute of NrtvTcpClient), the worker instead
+     * marks the end of the video with an NrtvHeader with frame number 0 and
+     * keeps the socket. The marker is queued behind the last slice of the
+     * video, once the queue has room for it. The next video request then
+     * starts a new video, with its own length, over the same socket.
+     *
+     * If a catalog is given with SetCatalog(), each video is instead a title
+     * picked from the catalog, whose length, slice sizes and encoding delays
+     * are read from the catalog rather than drawn.
      */
     NrtvVideoWorker();
     NrtvVideoWorker(Ptr<Socket> socket);
@@ -80,6 +108,35 @@ class NrtvVideoWorker : public Object
         READY
     };
 
+    /// What to do with a new slice when the send queue is full.
+    enum QueueOverflowPolicy_t
+    {
+        /// Discard the oldest slice in the queue to make room for the new one.
+        DROP_OLDEST = 0,
+        /// Discard the new slice, the queued slices of its frame, and the rest of its frame.
+        DROP_FRAME,
+        /**
+         * Hold the new slice and pause encoding until the queue has room.
+         * Frames elapsing meanwhile are skipped, see the `SkippedFrame` trace source.
+         */
+        BLOCK_ENCODER
+    };
+
+    /**
+     * @brief Common signature used by callbacks to the `QueueingDelay` trace
+     *        source.
+     * @param delay the time the slice has spent in the send queue.
+     */
+    typedef void (*QueueingDelayCallback)(const Time& delay);
+
+    /**
+     * @brief Common signature used by callbacks to the `SkippedFrame` trace
+     *        source.
+     * @param frameNumber the frame which has ended without any of its slices
+     *                    being encoded.
+     */
+    typedef void (*SkippedFrameCallback)(uint32_t frameNumber);
+
     void ChangeState(SendState_t state);
 
     // inherited from ObjectBase base class
@@ -99,6 +156,15 @@ class NrtvVideoWorker : public Object
      */
     void SetVideoCompletedCallback(Callback<void, Ptr<Socket>> callback);
 
+    /**
+     * @brief Play titles picked from a catalog instead of drawing the videos.
+     * @param catalog the catalog, shared with other workers.
+     *
+     * Must be called before the worker is set to READY. The current video is
+     * replaced by a title picked from the catalog, and so is every next video.
+     */
+    void SetCatalog(Ptr<NrtvCatalog> catalog);
+
   protected:
     /// Instance destructor, will close the socket.
     void DoDispose();
@@ -112,12 +178,57 @@ class NrtvVideoWorker : public Object
     void ErrorCloseCallback(Ptr<Socket> socket);
     /// Invoked if the socket has space for transmission.
     void SendCallback(Ptr<Socket> socket, uint32_t availableBufferSize);
+    /// Invoked if the client has sent video requests.
+    void ReceivedDataCallback(Ptr<Socket> socket);
+
+    // SEND QUEUE
+
+    /// A slice waiting in the send queue.
+    struct QueuedSlice
+    {
+        Ptr<Packet> packet;   ///< The slice, including its NrtvHeader.
+        Time enqueueTime;     ///< The time the slice has entered the queue.
+        uint32_t frameNumber; ///< The frame which the slice belongs to.
+    };
+
+    /**
+     * @brief Put a new slice into the send queue, applying the overflow policy
+     *        if the queue is full.
+     * @param slice the new slice.
+     * @return false if the encoder has been blocked, i.e., the slice is held
+     *         until the queue has room.
+     */
+    bool EnqueueSlice(const QueuedSlice& slice);
+
+    /// Hand over as many queued slices to the socket as it accepts.
+    void TrySend();
+
+    /**
+     * @brief Discard a slice and fire the `Drop` trace source.
+     * @param slice the discarded slice.
+     */
+    void DropSlice(const QueuedSlice& slice);
+
+    /// Discard every queued and held slice, firing the `Drop` trace source for each of them.
+    void ClearQueue();
 
     void ScheduleNewFrame();
     void NewFrame();
     void ScheduleNewSlice();
     void NewSlice();
     void EndVideo();
+    /// Fire the `SkippedFrame` trace source if no slice of the ending frame has been encoded.
+    void CheckSkippedFrame();
+    /**
+     * @brief Complete the ended video once its slices have left the queue,
+     *        i.e., invoke the video completed callback or, in keep-alive mode,
+     *        queue the end-of-video marker.
+     */
+    void FinishVideo();
+    /// Determine the length of a new video and start it if sending is allowed.
+    void StartNextVideo();
+    /// Pick the title of the next video from #m_catalog.
+    void PickTitle();
     void CancelAllPendingEvents();
 
     // EVENTS
@@ -134,6 +245,10 @@ class NrtvVideoWorker : public Object
 
     /// Length of time between consecutive frames.
     Time m_frameInterval;
+    /// Catalog of titles, or null if the videos are drawn.
+    Ptr<NrtvCatalog> m_catalog;
+    /// The title being played, owned by #m_catalog, or null.
+    const NrtvCatalog::Title* m_title;
     /// Number of frames, i.e., indicating the length of the video.
     uint32_t m_numOfFrames;
     /// The number of frames that has been sent.
@@ -143,6 +258,37 @@ class NrtvVideoWorker : public Object
     /// The number of slices that has been sent, resets to 0 after completing a frame.
     uint16_t m_numOfSlicesServed;
 
+    /// Slices which have been encoded but not yet accepted by the socket.
+    std::deque<QueuedSlice> m_queue;
+    /// `MaxQueueSize` attribute.
+    uint32_t m_maxQueueSize;
+    /// `QueueOverflowPolicy` attribute.
+    QueueOverflowPolicy_t m_overflowPolicy;
+    /// `CompactHeader` attribute.
+    bool m_isCompactHeader;
+    /// The frame whose remaining slices are being discarded by `DROP_FRAME`, or 0.
+    uint32_t m_droppedFrameNumber;
+    /// True if the encoder is paused by `BLOCK_ENCODER`.
+    bool m_isEncoderBlocked;
+    /// The slice held while the encoder is paused.
+    QueuedSlice m_blockedSlice;
+
+    /// True if the client has asked to keep the socket for the next videos.
+    bool m_isKeepAlive;
+    /// True if a video has ended and the worker is waiting for the next request.
+    bool m_isWaitingForRequest;
+    /// True if the last frame has ended but the slices of the video are still queued.
+    bool m_isVideoEnding;
+    /// Received bytes of an incomplete video request.
+    Ptr<Packet> m_rxBuffer;
+
+    /// The `QueueingDelay` trace source.
+    TracedCallback<const Time&> m_queueingDelayTrace;
+    /// The `Drop` trace source.
+    TracedCallback<Ptr<const Packet>> m_dropTrace;
+    /// The `SkippedFrame` trace source.
+    TracedCallback<uint32_t> m_skippedFrameTrace;
+
 }; // end of `class NrtvVideoWorker`
 
 } // namespace ns3
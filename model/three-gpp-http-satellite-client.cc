@@ -21,10 +21,13 @@
 
 #include "three-gpp-http-satellite-client.h"
 
-#include "three-gpp-http-variables.h"
+#include "three-gpp-http-stream-header.h"
+#include "three-gpp-http-satellite-variables.h"
 
+#include "ns3/boolean.h"
 #include "ns3/callback.h"
 #include "ns3/double.h"
+#include "ns3/enum.h"
 #include "ns3/inet-socket-address.h"
 #include "ns3/inet6-socket-address.h"
 #include "ns3/log.h"
@@ -35,6 +38,7 @@
 #include "ns3/tcp-socket-factory.h"
 #include "ns3/uinteger.h"
 
+#include <algorithm>
 #include <string>
 
 NS_LOG_COMPONENT_DEFINE("ThreeGppHttpSatelliteClient");
@@ -46,16 +50,38 @@ NS_OBJECT_ENSURE_REGISTERED(ThreeGppHttpSatelliteClient);
 
 ThreeGppHttpSatelliteClient::ThreeGppHttpSatelliteClient()
     : m_state(NOT_STARTED),
-      m_socket(nullptr),
-      m_objectBytesToBeReceived(0),
-      m_objectClientTs(MilliSeconds(0)),
-      m_objectServerTs(MilliSeconds(0)),
       m_embeddedObjectsToBeRequested(0),
-      m_httpVariables(CreateObject<ThreeGppHttpVariables>())
+      m_embeddedObjectsToBeReceived(0),
+      m_firstStreamId(1),
+      m_nextStreamId(1),
+      m_httpVariables(CreateObject<ThreeGppHttpSatelliteVariables>()),
+      m_maxParallelConnections(1),
+      m_requestMode(SERIAL),
+      m_keepAlive(false),
+      m_idleTimeout(Seconds(0))
 {
     NS_LOG_FUNCTION(this);
 }
 
+ThreeGppHttpSatelliteClient::RxState::RxState()
+    : objectBytesToBeReceived(0),
+      constructedPacket(nullptr),
+      objectClientTs(MilliSeconds(0)),
+      objectServerTs(MilliSeconds(0)),
+      rxBuffer(nullptr)
+{
+}
+
+ThreeGppHttpSatelliteClient::Connection::Connection(Ptr<Socket> s)
+    : socket(s),
+      isConnected(false),
+      outstandingRequests(0),
+      frameStreamId(0),
+      frameBytesToBeReceived(0),
+      frameBuffer(nullptr)
+{
+}
+
 // static
 TypeId
 ThreeGppHttpSatelliteClient::GetTypeId()
@@ -69,7 +95,7 @@ ThreeGppHttpSatelliteClient::GetTypeId()
                 "Variable collection, which is used to control e.g. timing and HTTP request size.",
                 PointerValue(),
                 MakePointerAccessor(&ThreeGppHttpSatelliteClient::m_httpVariables),
-                MakePointerChecker<ThreeGppHttpVariables>())
+                MakePointerChecker<ThreeGppHttpSatelliteVariables>())
             .AddAttribute("RemoteServerAddress",
                           "The address of the destination server.",
                           AddressValue(),
@@ -80,6 +106,41 @@ ThreeGppHttpSatelliteClient::GetTypeId()
                           UintegerValue(80), // the default HTTP port
                           MakeUintegerAccessor(&ThreeGppHttpSatelliteClient::m_remoteServerPort),
                           MakeUintegerChecker<uint16_t>())
+            .AddAttribute(
+                "MaxParallelConnections",
+                "The maximum number of connections utilized simultaneously for fetching the "
+                "embedded objects of a web page. The default value of 1 fetches the embedded "
+                "objects one after another over the primary connection.",
+                UintegerValue(1),
+                MakeUintegerAccessor(&ThreeGppHttpSatelliteClient::m_maxParallelConnections),
+                MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("RequestMode",
+                          "How the requests for the embedded objects of a web page are sent. "
+                          "PIPELINED requires a server which queues the requests, e.g., "
+                          "ns3::ThreeGppHttpSatelliteServer. MULTIPLEXED requires "
+                          "ns3::ThreeGppHttpSatelliteServer with multiplexing enabled.",
+                          EnumValue(ThreeGppHttpSatelliteClient::SERIAL),
+                          MakeEnumAccessor<ThreeGppHttpSatelliteClient::RequestMode_t>(
+                              &ThreeGppHttpSatelliteClient::m_requestMode),
+                          MakeEnumChecker(ThreeGppHttpSatelliteClient::SERIAL,
+                                          "SERIAL",
+                                          ThreeGppHttpSatelliteClient::PIPELINED,
+                                          "PIPELINED",
+                                          ThreeGppHttpSatelliteClient::MULTIPLEXED,
+                                          "MULTIPLEXED"))
+            .AddAttribute("KeepAlive",
+                          "Keep the additional connections of the pool open during the reading "
+                          "time and reuse them for the next web page.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&ThreeGppHttpSatelliteClient::m_keepAlive),
+                          MakeBooleanChecker())
+            .AddAttribute("IdleTimeout",
+                          "Close every connection which stays idle during the reading time for "
+                          "longer than this. The primary connection is opened again before the "
+                          "next main object request. Zero keeps the connections open forever.",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&ThreeGppHttpSatelliteClient::m_idleTimeout),
+                          MakeTimeChecker(Seconds(0)))
             .AddTraceSource(
                 "ConnectionEstablished",
                 "Connection to the destination web server has been established.",
@@ -145,14 +206,21 @@ ThreeGppHttpSatelliteClient::GetTypeId()
                 "StateTransition",
                 "Trace fired upon every HTTP client state transition.",
                 MakeTraceSourceAccessor(&ThreeGppHttpSatelliteClient::m_stateTransitionTrace),
-                "ns3::Application::StateTransitionCallback");
+                "ns3::Application::StateTransitionCallback")
+            .AddTraceSource(
+                "StateTransitionEnum",
+                "Trace fired upon every state transition, with the old and the new "
+                "state as enum values. Cheaper than StateTransition, which "
+                "converts both states to strings.",
+                MakeTraceSourceAccessor(&ThreeGppHttpSatelliteClient::m_stateTransitionEnumTrace),
+                "ns3::ThreeGppHttpSatelliteClient::StateTransitionEnumCallback");
     return tid;
 }
 
 Ptr<Socket>
 ThreeGppHttpSatelliteClient::GetSocket() const
 {
-    return m_socket;
+    return m_connections.empty() ? nullptr : m_connections.front().socket;
 }
 
 ThreeGppHttpSatelliteClient::State_t
@@ -236,10 +304,16 @@ ThreeGppHttpSatelliteClient::StopApplication()
 
     SwitchToState(STOPPED);
     CancelAllPendingEvents();
-    m_socket->Close();
-    m_socket->SetConnectCallback(MakeNullCallback<void, Ptr<Socket>>(),
-                                 MakeNullCallback<void, Ptr<Socket>>());
-    m_socket->SetRecvCallback(MakeNullCallback<void, Ptr<Socket>>());
+    CloseParallelConnections();
+
+    if (!m_connections.empty())
+    {
+        Ptr<Socket> socket = m_connections.front().socket;
+        socket->Close();
+        socket->SetConnectCallback(MakeNullCallback<void, Ptr<Socket>>(),
+                                   MakeNullCallback<void, Ptr<Socket>>());
+        socket->SetRecvCallback(MakeNullCallback<void, Ptr<Socket>>());
+    }
 }
 
 void
@@ -249,7 +323,8 @@ ThreeGppHttpSatelliteClient::ConnectionSucceededCallback(Ptr<Socket> socket)
 
     if (m_state == CONNECTING)
     {
-        NS_ASSERT_MSG(m_socket == socket, "Invalid socket.");
+        NS_ASSERT_MSG(GetSocket() == socket, "Invalid socket.");
+        m_connections.front().isConnected = true;
         m_connectionEstablishedTrace(this);
         socket->SetRecvCallback(
             MakeCallback(&ThreeGppHttpSatelliteClient::ReceivedDataCallback, this));
@@ -292,8 +367,8 @@ ThreeGppHttpSatelliteClient::NormalCloseCallback(Ptr<Socket> socket)
                           << " error code: " << socket->GetErrno() << ".");
     }
 
-    m_socket->SetCloseCallbacks(MakeNullCallback<void, Ptr<Socket>>(),
-                                MakeNullCallback<void, Ptr<Socket>>());
+    socket->SetCloseCallbacks(MakeNullCallback<void, Ptr<Socket>>(),
+                              MakeNullCallback<void, Ptr<Socket>>());
 
     m_connectionClosedTrace(this);
 }
@@ -313,11 +388,78 @@ ThreeGppHttpSatelliteClient::ErrorCloseCallback(Ptr<Socket> socket)
     m_connectionClosedTrace(this);
 }
 
+void
+ThreeGppHttpSatelliteClient::ParallelConnectionSucceededCallback(Ptr<Socket> socket)
+{
+    NS_LOG_FUNCTION(this << socket);
+
+    Connection* connection = FindConnection(socket);
+    NS_ASSERT_MSG(connection != nullptr, "Invalid socket.");
+    connection->isConnected = true;
+    m_connectionEstablishedTrace(this);
+
+    if ((m_state == PARSING_MAIN_OBJECT || m_state == EXPECTING_EMBEDDED_OBJECT) &&
+        m_embeddedObjectsToBeRequested > 0 && Simulator::IsExpired(m_eventRequestEmbeddedObject))
+    {
+        // Put the new connection to work straight away.
+        m_eventRequestEmbeddedObject =
+            Simulator::ScheduleNow(&ThreeGppHttpSatelliteClient::RequestEmbeddedObject, this);
+    }
+}
+
+void
+ThreeGppHttpSatelliteClient::ParallelConnectionFailedCallback(Ptr<Socket> socket)
+{
+    NS_LOG_FUNCTION(this << socket);
+    NS_LOG_ERROR(this << " Failed to open an additional connection"
+                      << " to remote address " << m_remoteServerAddress << " port "
+                      << m_remoteServerPort << ".");
+    ParallelConnectionClosedCallback(socket);
+}
+
+void
+ThreeGppHttpSatelliteClient::ParallelConnectionClosedCallback(Ptr<Socket> socket)
+{
+    NS_LOG_FUNCTION(this << socket);
+
+    for (auto it = m_connections.begin() + 1; it != m_connections.end(); ++it)
+    {
+        if (it->socket == socket)
+        {
+            if (it->outstandingRequests > 0)
+            {
+                NS_LOG_INFO(this << " " << it->outstandingRequests
+                                 << " embedded object(s) will be requested again.");
+                m_embeddedObjectsToBeRequested += it->outstandingRequests;
+                m_embeddedObjectsToBeReceived -= it->outstandingRequests;
+            }
+
+            socket->SetCloseCallbacks(MakeNullCallback<void, Ptr<Socket>>(),
+                                      MakeNullCallback<void, Ptr<Socket>>());
+            socket->SetRecvCallback(MakeNullCallback<void, Ptr<Socket>>());
+            m_connections.erase(it);
+            m_connectionClosedTrace(this);
+
+            if (m_state == EXPECTING_EMBEDDED_OBJECT && m_embeddedObjectsToBeRequested > 0 &&
+                Simulator::IsExpired(m_eventRequestEmbeddedObject))
+            {
+                m_eventRequestEmbeddedObject =
+                    Simulator::ScheduleNow(&ThreeGppHttpSatelliteClient::RequestEmbeddedObject,
+                                           this);
+            }
+            return;
+        }
+    }
+
+} // end of `void ParallelConnectionClosedCallback (Ptr<Socket> socket)`
+
 void
 ThreeGppHttpSatelliteClient::ReceivedDataCallback(Ptr<Socket> socket)
 {
     NS_LOG_FUNCTION(this << socket);
 
+    Connection* connection = FindConnection(socket);
+    NS_ASSERT_MSG(connection != nullptr, "Invalid socket.");
     Ptr<Packet> packet;
     Address from;
 
@@ -348,17 +490,23 @@ ThreeGppHttpSatelliteClient::ReceivedDataCallback(Ptr<Socket> socket)
 
         m_rxTrace(packet, from);
 
-        switch (m_state)
+        if (m_requestMode == MULTIPLEXED)
+        {
+            ReceiveFrames(packet, from, *connection);
+            continue;
+        }
+
+        // A packet may carry the end of one object and the beginning of the next one.
+        while (packet != nullptr)
         {
-        case EXPECTING_MAIN_OBJECT:
-            ReceiveMainObject(packet, from);
-            break;
-        case EXPECTING_EMBEDDED_OBJECT:
-            ReceiveEmbeddedObject(packet, from);
-            break;
-        default:
-            NS_FATAL_ERROR("Invalid state " << GetStateString() << " for ReceivedData().");
-            break;
+            packet = ReceiveObjectPart(packet, from, *connection, connection->rx);
+
+            // An additional connection is closed once it has completed the web page.
+            connection = FindConnection(socket);
+            if (connection == nullptr)
+            {
+                return;
+            }
         }
 
     } // end of `while ((packet = socket->RecvFrom (from)))`
@@ -373,53 +521,26 @@ ThreeGppHttpSatelliteClient::OpenConnection()
     if (m_state == NOT_STARTED || m_state == EXPECTING_EMBEDDED_OBJECT ||
         m_state == PARSING_MAIN_OBJECT || m_state == READING)
     {
-        m_socket = Socket::CreateSocket(GetNode(), TcpSocketFactory::GetTypeId());
-
-        int ret;
-
-        if (Ipv4Address::IsMatchingType(m_remoteServerAddress))
+        Ptr<Socket> socket = CreateSocket();
+        if (m_connections.empty())
         {
-            ret = m_socket->Bind();
-            NS_LOG_DEBUG(this << " Bind() return value= " << ret
-                              << " GetErrNo= " << m_socket->GetErrno() << ".");
-
-            Ipv4Address ipv4 = Ipv4Address::ConvertFrom(m_remoteServerAddress);
-            InetSocketAddress inetSocket = InetSocketAddress(ipv4, m_remoteServerPort);
-            NS_LOG_INFO(this << " Connecting to " << ipv4 << " port " << m_remoteServerPort << " / "
-                             << inetSocket << ".");
-            ret = m_socket->Connect(inetSocket);
-            NS_LOG_DEBUG(this << " Connect() return value= " << ret
-                              << " GetErrNo= " << m_socket->GetErrno() << ".");
+            m_connections.emplace_back(socket);
         }
-        else if (Ipv6Address::IsMatchingType(m_remoteServerAddress))
+        else
         {
-            ret = m_socket->Bind6();
-            NS_LOG_DEBUG(this << " Bind6() return value= " << ret
-                              << " GetErrNo= " << m_socket->GetErrno() << ".");
-
-            Ipv6Address ipv6 = Ipv6Address::ConvertFrom(m_remoteServerAddress);
-            Inet6SocketAddress inet6Socket = Inet6SocketAddress(ipv6, m_remoteServerPort);
-            NS_LOG_INFO(this << " connecting to " << ipv6 << " port " << m_remoteServerPort << " / "
-                             << inet6Socket << ".");
-            ret = m_socket->Connect(inet6Socket);
-            NS_LOG_DEBUG(this << " Connect() return value= " << ret
-                              << " GetErrNo= " << m_socket->GetErrno() << ".");
+            m_connections.front() = Connection(socket);
         }
 
-        // NS_UNUSED (ret); // Mute compiler warning.
-        NS_ASSERT_MSG(m_socket != nullptr, "Failed creating socket.");
-
         SwitchToState(CONNECTING);
 
-        m_socket->SetConnectCallback(
+        socket->SetConnectCallback(
             MakeCallback(&ThreeGppHttpSatelliteClient::ConnectionSucceededCallback, this),
             MakeCallback(&ThreeGppHttpSatelliteClient::ConnectionFailedCallback, this));
-        m_socket->SetCloseCallbacks(
+        socket->SetCloseCallbacks(
             MakeCallback(&ThreeGppHttpSatelliteClient::NormalCloseCallback, this),
             MakeCallback(&ThreeGppHttpSatelliteClient::ErrorCloseCallback, this));
-        m_socket->SetRecvCallback(
+        socket->SetRecvCallback(
             MakeCallback(&ThreeGppHttpSatelliteClient::ReceivedDataCallback, this));
-        m_socket->SetAttribute("MaxSegLifetime", DoubleValue(0.02)); // 20 ms.
 
     } // end of `if (m_state == {NOT_STARTED, EXPECTING_EMBEDDED_OBJECT, PARSING_MAIN_OBJECT,
       // READING})`
@@ -430,38 +551,237 @@ ThreeGppHttpSatelliteClient::OpenConnection()
 
 } // end of `void OpenConnection ()`
 
+Ptr<Socket>
+ThreeGppHttpSatelliteClient::CreateSocket()
+{
+    NS_LOG_FUNCTION(this);
+
+    Ptr<Socket> socket = Socket::CreateSocket(GetNode(), TcpSocketFactory::GetTypeId());
+
+    int ret;
+
+    if (Ipv4Address::IsMatchingType(m_remoteServerAddress))
+    {
+        ret = socket->Bind();
+        NS_LOG_DEBUG(this << " Bind() return value= " << ret
+                          << " GetErrNo= " << socket->GetErrno() << ".");
+
+        Ipv4Address ipv4 = Ipv4Address::ConvertFrom(m_remoteServerAddress);
+        InetSocketAddress inetSocket = InetSocketAddress(ipv4, m_remoteServerPort);
+        NS_LOG_INFO(this << " Connecting to " << ipv4 << " port " << m_remoteServerPort << " / "
+                         << inetSocket << ".");
+        ret = socket->Connect(inetSocket);
+        NS_LOG_DEBUG(this << " Connect() return value= " << ret
+                          << " GetErrNo= " << socket->GetErrno() << ".");
+    }
+    else if (Ipv6Address::IsMatchingType(m_remoteServerAddress))
+    {
+        ret = socket->Bind6();
+        NS_LOG_DEBUG(this << " Bind6() return value= " << ret
+                          << " GetErrNo= " << socket->GetErrno() << ".");
+
+        Ipv6Address ipv6 = Ipv6Address::ConvertFrom(m_remoteServerAddress);
+        Inet6SocketAddress inet6Socket = Inet6SocketAddress(ipv6, m_remoteServerPort);
+        NS_LOG_INFO(this << " connecting to " << ipv6 << " port " << m_remoteServerPort << " / "
+                         << inet6Socket << ".");
+        ret = socket->Connect(inet6Socket);
+        NS_LOG_DEBUG(this << " Connect() return value= " << ret
+                          << " GetErrNo= " << socket->GetErrno() << ".");
+    }
+
+    // NS_UNUSED (ret); // Mute compiler warning.
+    NS_ASSERT_MSG(socket != nullptr, "Failed creating socket.");
+    socket->SetAttribute("MaxSegLifetime", DoubleValue(0.02)); // 20 ms.
+    return socket;
+
+} // end of `Ptr<Socket> CreateSocket ()`
+
+void
+ThreeGppHttpSatelliteClient::OpenParallelConnections()
+{
+    NS_LOG_FUNCTION(this);
+
+    const uint32_t wanted = std::min(m_maxParallelConnections, m_embeddedObjectsToBeRequested);
+
+    while (m_connections.size() < wanted)
+    {
+        Ptr<Socket> socket = CreateSocket();
+        socket->SetConnectCallback(
+            MakeCallback(&ThreeGppHttpSatelliteClient::ParallelConnectionSucceededCallback, this),
+            MakeCallback(&ThreeGppHttpSatelliteClient::ParallelConnectionFailedCallback, this));
+        socket->SetCloseCallbacks(
+            MakeCallback(&ThreeGppHttpSatelliteClient::ParallelConnectionClosedCallback, this),
+            MakeCallback(&ThreeGppHttpSatelliteClient::ParallelConnectionClosedCallback, this));
+        socket->SetRecvCallback(
+            MakeCallback(&ThreeGppHttpSatelliteClient::ReceivedDataCallback, this));
+        m_connections.emplace_back(socket);
+    }
+
+    NS_LOG_INFO(this << " The pool has " << m_connections.size() << " connection(s).");
+}
+
+void
+ThreeGppHttpSatelliteClient::CloseParallelConnections()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (m_connections.size() <= 1)
+    {
+        return;
+    }
+
+    for (auto it = m_connections.begin() + 1; it != m_connections.end(); ++it)
+    {
+        it->socket->SetConnectCallback(MakeNullCallback<void, Ptr<Socket>>(),
+                                       MakeNullCallback<void, Ptr<Socket>>());
+        it->socket->SetCloseCallbacks(MakeNullCallback<void, Ptr<Socket>>(),
+                                      MakeNullCallback<void, Ptr<Socket>>());
+        it->socket->SetRecvCallback(MakeNullCallback<void, Ptr<Socket>>());
+        it->socket->Close();
+    }
+
+    m_connections.erase(m_connections.begin() + 1, m_connections.end());
+}
+
+void
+ThreeGppHttpSatelliteClient::CloseIdleConnections()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (m_state != READING)
+    {
+        NS_FATAL_ERROR("Invalid state " << GetStateString() << " for CloseIdleConnections().");
+    }
+
+    const std::size_t numOfConnections = m_connections.size();
+    NS_LOG_INFO(this << " Closing " << numOfConnections << " idle connection(s).");
+    CloseParallelConnections();
+
+    // Silence the callbacks first, so that closing does not cancel the next request.
+    Connection& primary = m_connections.front();
+    primary.socket->SetConnectCallback(MakeNullCallback<void, Ptr<Socket>>(),
+                                       MakeNullCallback<void, Ptr<Socket>>());
+    primary.socket->SetCloseCallbacks(MakeNullCallback<void, Ptr<Socket>>(),
+                                      MakeNullCallback<void, Ptr<Socket>>());
+    primary.socket->SetRecvCallback(MakeNullCallback<void, Ptr<Socket>>());
+    primary.socket->Close();
+    primary.isConnected = false;
+
+    for (std::size_t i = 0; i < numOfConnections; i++)
+    {
+        m_connectionClosedTrace(this); // once for each closed connection
+    }
+}
+
+ThreeGppHttpSatelliteClient::Connection*
+ThreeGppHttpSatelliteClient::FindConnection(Ptr<Socket> socket)
+{
+    // The pool is small, so a linear search is good enough.
+    for (auto& connection : m_connections)
+    {
+        if (connection.socket == socket)
+        {
+            return &connection;
+        }
+    }
+
+    return nullptr;
+}
+
+ThreeGppHttpSatelliteClient::RxState*
+ThreeGppHttpSatelliteClient::FindStream(uint32_t streamId)
+{
+    // Stream IDs of a web page are consecutive, so they map directly to an index.
+    const uint32_t index = streamId - m_firstStreamId;
+    if (streamId < m_firstStreamId || index >= m_streams.size())
+    {
+        return nullptr;
+    }
+
+    return &m_streams[index];
+}
+
+bool
+ThreeGppHttpSatelliteClient::SendRequest(Ptr<Packet> packet, Connection& connection)
+{
+    NS_LOG_FUNCTION(this << packet << connection.socket);
+
+    if (m_requestMode == MULTIPLEXED)
+    {
+        ThreeGppHttpStreamHeader streamHeader;
+        streamHeader.SetStreamId(m_nextStreamId);
+        streamHeader.SetFrameLength(packet->GetSize());
+        packet->AddHeader(streamHeader);
+    }
+
+    const uint32_t packetSize = packet->GetSize();
+    NS_ASSERT_MSG(packetSize <= 536, // Hard-coded MTU size.
+                  "Packet size shall not be larger than MTU size.");
+
+    m_txTrace(packet);
+    const int actualBytes = connection.socket->Send(packet);
+    NS_LOG_DEBUG(this << " Send() packet " << packet << " of " << packetSize << " bytes,"
+                      << " return value= " << actualBytes << ".");
+
+    if (actualBytes != static_cast<int>(packetSize))
+    {
+        NS_LOG_ERROR(this << " Failed to send request,"
+                          << " GetErrNo= " << connection.socket->GetErrno() << ","
+                          << " waiting for another Tx opportunity.");
+        return false;
+    }
+
+    if (m_requestMode == MULTIPLEXED)
+    {
+        NS_LOG_INFO(this << " Opened stream " << m_nextStreamId << ".");
+        m_streams.emplace_back();
+        m_nextStreamId++;
+    }
+
+    return true;
+
+} // end of `bool SendRequest (Ptr<Packet> packet, Connection &connection)`
+
 void
 ThreeGppHttpSatelliteClient::RequestMainObject()
 {
     NS_LOG_FUNCTION(this);
 
+    if (m_state == READING && !m_connections.front().isConnected)
+    {
+        // The idle timeout has closed the connection, so open it again.
+        OpenConnection();
+        return;
+    }
+
     if (m_state == CONNECTING || m_state == READING)
     {
+        Connection& connection = m_connections.front();
+        if (connection.rx.objectBytesToBeReceived > 0)
+        {
+            NS_FATAL_ERROR("Cannot start a new receiving session"
+                           << " if the previous object" << " ("
+                           << connection.rx.objectBytesToBeReceived << " bytes)"
+                           << " is not completely received yet.");
+        }
+
+        // The streams of the previous web page are no longer needed.
+        m_streams.clear();
+        m_firstStreamId = m_nextStreamId;
+
         ThreeGppHttpHeader header;
-        header.SetContentLength(0); // Request does not need any content length.
+        const uint32_t requestSize = m_httpVariables->GetRequestSize();
+        // The content length lets the server find where a request ends.
+        header.SetContentLength(requestSize);
         header.SetContentType(ThreeGppHttpHeader::MAIN_OBJECT);
         header.SetClientTs(Simulator::Now());
 
-        const uint32_t requestSize = m_httpVariables->GetRequestSize();
         Ptr<Packet> packet = Create<Packet>(requestSize);
         packet->AddHeader(header);
-        const uint32_t packetSize = packet->GetSize();
-        NS_ASSERT_MSG(packetSize <= 536, // Hard-coded MTU size.
-                      "Packet size shall not be larger than MTU size.");
 
         m_txMainObjectRequestTrace(packet);
-        m_txTrace(packet);
         m_requestTime = Simulator::Now();
-        const int actualBytes = m_socket->Send(packet);
-        NS_LOG_DEBUG(this << " Send() packet " << packet << " of " << packet->GetSize() << " bytes,"
-                          << " return value= " << actualBytes << ".");
-        if (actualBytes != static_cast<int>(packetSize))
-        {
-            NS_LOG_ERROR(this << " Failed to send request for embedded object,"
-                              << " GetErrNo= " << m_socket->GetErrno() << ","
-                              << " waiting for another Tx opportunity.");
-        }
-        else
+        if (SendRequest(packet, connection))
         {
             SwitchToState(EXPECTING_MAIN_OBJECT);
         }
@@ -483,33 +803,36 @@ ThreeGppHttpSatelliteClient::RequestEmbeddedObject()
     {
         if (m_embeddedObjectsToBeRequested > 0)
         {
-            ThreeGppHttpHeader header;
-            header.SetContentLength(0); // Request does not need any content length.
-            header.SetContentType(ThreeGppHttpHeader::EMBEDDED_OBJECT);
-            header.SetClientTs(Simulator::Now());
-
-            const uint32_t requestSize = m_httpVariables->GetRequestSize();
-            Ptr<Packet> packet = Create<Packet>(requestSize);
-            packet->AddHeader(header);
-            const uint32_t packetSize = packet->GetSize();
-            NS_ASSERT_MSG(packetSize <= 536, // Hard-coded MTU size.
-                          "Packet size shall not be larger than MTU size.");
-
-            m_txEmbeddedObjectRequestTrace(packet);
-            m_txTrace(packet);
-            const int actualBytes = m_socket->Send(packet);
-            NS_LOG_DEBUG(this << " Send() packet " << packet << " of " << packet->GetSize()
-                              << " bytes," << " return value= " << actualBytes << ".");
-
-            if (actualBytes != static_cast<int>(packetSize))
+            bool isSent = false;
+
+            if (m_requestMode != SERIAL)
             {
-                NS_LOG_ERROR(this << " Failed to send request for embedded object,"
-                                  << " GetErrNo= " << m_socket->GetErrno() << ","
-                                  << " waiting for another Tx opportunity.");
+                // Send all the remaining requests on the primary connection.
+                Connection& connection = m_connections.front();
+                while (m_embeddedObjectsToBeRequested > 0 &&
+                       SendEmbeddedObjectRequest(connection))
+                {
+                    isSent = true;
+                }
             }
             else
             {
-                m_embeddedObjectsToBeRequested--;
+                for (auto& connection : m_connections)
+                {
+                    if (m_embeddedObjectsToBeRequested == 0)
+                    {
+                        break;
+                    }
+
+                    if (connection.isConnected && connection.outstandingRequests == 0)
+                    {
+                        isSent |= SendEmbeddedObjectRequest(connection);
+                    }
+                }
+            }
+
+            if (isSent)
+            {
                 SwitchToState(EXPECTING_EMBEDDED_OBJECT);
             }
         }
@@ -525,31 +848,163 @@ ThreeGppHttpSatelliteClient::RequestEmbeddedObject()
 
 } // end of `void RequestEmbeddedObject ()`
 
+bool
+ThreeGppHttpSatelliteClient::SendEmbeddedObjectRequest(Connection& connection)
+{
+    NS_LOG_FUNCTION(this << connection.socket);
+
+    if (connection.rx.objectBytesToBeReceived > 0 && m_requestMode == SERIAL)
+    {
+        NS_FATAL_ERROR("Cannot start a new receiving session"
+                       << " if the previous object" << " ("
+                       << connection.rx.objectBytesToBeReceived << " bytes)"
+                       << " is not completely received yet.");
+    }
+
+    ThreeGppHttpHeader header;
+    const uint32_t requestSize = m_httpVariables->GetRequestSize();
+    // The content length lets the server find where a request ends.
+    header.SetContentLength(requestSize);
+    header.SetContentType(ThreeGppHttpHeader::EMBEDDED_OBJECT);
+    header.SetClientTs(Simulator::Now());
+
+    Ptr<Packet> packet = Create<Packet>(requestSize);
+    packet->AddHeader(header);
+
+    m_txEmbeddedObjectRequestTrace(packet);
+    if (!SendRequest(packet, connection))
+    {
+        return false;
+    }
+
+    m_embeddedObjectsToBeRequested--;
+    m_embeddedObjectsToBeReceived++;
+    connection.outstandingRequests++;
+    return true;
+
+} // end of `bool SendEmbeddedObjectRequest (Connection &connection)`
+
 void
-ThreeGppHttpSatelliteClient::ReceiveMainObject(Ptr<Packet> packet, const Address& from)
+ThreeGppHttpSatelliteClient::ReceiveFrames(Ptr<Packet> packet,
+                                           const Address& from,
+                                           Connection& connection)
 {
     NS_LOG_FUNCTION(this << packet << from);
 
+    static const uint32_t streamHeaderSize = ThreeGppHttpStreamHeader::GetStaticSerializedSize();
+
+    if (connection.frameBuffer != nullptr)
+    {
+        // Complete the frame header which was cut off at the end of the previous packet.
+        connection.frameBuffer->AddAtEnd(packet);
+        packet = connection.frameBuffer;
+        connection.frameBuffer = nullptr;
+    }
+
+    while (packet->GetSize() > 0)
+    {
+        if (connection.frameBytesToBeReceived == 0)
+        {
+            if (packet->GetSize() < streamHeaderSize)
+            {
+                connection.frameBuffer = packet;
+                return;
+            }
+
+            ThreeGppHttpStreamHeader streamHeader;
+            packet->RemoveHeader(streamHeader);
+            connection.frameStreamId = streamHeader.GetStreamId();
+            connection.frameBytesToBeReceived = streamHeader.GetFrameLength();
+            continue;
+        }
+
+        const uint32_t partSize = std::min(connection.frameBytesToBeReceived, packet->GetSize());
+        Ptr<Packet> part = packet->CreateFragment(0, partSize);
+        packet->RemoveAtStart(partSize);
+        connection.frameBytesToBeReceived -= partSize;
+
+        RxState* stream = FindStream(connection.frameStreamId);
+        if (stream == nullptr)
+        {
+            NS_LOG_WARN(this << " Discarding " << partSize << " bytes of unknown stream "
+                             << connection.frameStreamId << ".");
+            continue;
+        }
+
+        ReceiveObjectPart(part, from, connection, *stream);
+
+    } // end of `while (packet->GetSize () > 0)`
+
+} // end of `void ReceiveFrames (Ptr<Packet> packet)`
+
+Ptr<Packet>
+ThreeGppHttpSatelliteClient::ReceiveObjectPart(Ptr<Packet> packet,
+                                               const Address& from,
+                                               Connection& connection,
+                                               RxState& rx)
+{
+    NS_LOG_FUNCTION(this << packet << from);
+
+    static const uint32_t headerSize = ThreeGppHttpHeader().GetSerializedSize();
+
+    if (rx.rxBuffer != nullptr)
+    {
+        // Complete the header which was cut off at the end of the previous packet.
+        rx.rxBuffer->AddAtEnd(packet);
+        packet = rx.rxBuffer;
+        rx.rxBuffer = nullptr;
+    }
+
+    if (rx.objectBytesToBeReceived == 0 && packet->GetSize() < headerSize)
+    {
+        rx.rxBuffer = packet;
+        return nullptr;
+    }
+
+    switch (m_state)
+    {
+    case EXPECTING_MAIN_OBJECT:
+        return ReceiveMainObject(packet, from, rx);
+    case EXPECTING_EMBEDDED_OBJECT:
+        return ReceiveEmbeddedObject(packet, from, connection, rx);
+    default:
+        NS_FATAL_ERROR("Invalid state " << GetStateString() << " for ReceivedData().");
+        break;
+    }
+
+    return nullptr;
+
+} // end of `Ptr<Packet> ReceiveObjectPart (Ptr<Packet> packet)`
+
+Ptr<Packet>
+ThreeGppHttpSatelliteClient::ReceiveMainObject(Ptr<Packet> packet,
+                                               const Address& from,
+                                               RxState& rx)
+{
+    NS_LOG_FUNCTION(this << packet << from);
+
+    Ptr<Packet> excess;
+
     if (m_state == EXPECTING_MAIN_OBJECT)
     {
         /*
-         * In the following call to Receive(), #m_objectBytesToBeReceived *will*
-         * be updated. #m_objectClientTs and #m_objectServerTs *may* be updated.
-         * ThreeGppHttpHeader will be removed from the packet, if it is the first
-         * packet of the object to be received; the header will be available in
-         * #m_constructedPacketHeader.
-         * #m_constructedPacket will also be updated.
+         * In the following call to Receive(), the bytes to be received by the
+         * connection or stream *will* be updated. Its client and server time stamps *may*
+         * be updated. ThreeGppHttpHeader will be removed from the packet, if it
+         * is the first packet of the object to be received; the header will be
+         * available in the constructed packet of the receive state, which will
+         * also be updated.
          */
-        Receive(packet);
+        excess = Receive(packet, rx, false);
         m_rxMainObjectPacketTrace(packet);
 
-        if (m_objectBytesToBeReceived > 0)
+        if (rx.objectBytesToBeReceived > 0)
         {
             /*
              * There are more packets of this main object, so just stay still
              * and wait until they arrive.
              */
-            NS_LOG_INFO(this << " " << m_objectBytesToBeReceived << " byte(s)"
+            NS_LOG_INFO(this << " " << rx.objectBytesToBeReceived << " byte(s)"
                              << " remains from this chunk of main object.");
         }
         else
@@ -559,23 +1014,23 @@ ThreeGppHttpSatelliteClient::ReceiveMainObject(Ptr<Packet> packet, const Address
              * reception of a whole main object
              */
             NS_LOG_INFO(this << " Finished receiving a main object.");
-            m_rxMainObjectTrace(this, m_constructedPacket);
+            m_rxMainObjectTrace(this, rx.constructedPacket);
 
-            if (!m_objectServerTs.IsZero())
+            if (!rx.objectServerTs.IsZero())
             {
-                m_rxDelayTrace(Simulator::Now() - m_objectServerTs, from);
-                m_objectServerTs = MilliSeconds(0); // Reset back to zero.
+                m_rxDelayTrace(Simulator::Now() - rx.objectServerTs, from);
+                rx.objectServerTs = MilliSeconds(0); // Reset back to zero.
             }
 
-            if (!m_objectClientTs.IsZero())
+            if (!rx.objectClientTs.IsZero())
             {
-                m_rxRttTrace(Simulator::Now() - m_objectClientTs, from);
-                m_objectClientTs = MilliSeconds(0); // Reset back to zero.
+                m_rxRttTrace(Simulator::Now() - rx.objectClientTs, from);
+                rx.objectClientTs = MilliSeconds(0); // Reset back to zero.
             }
 
             EnterParsingTime();
 
-        } // end of else of `if (m_objectBytesToBeReceived > 0)`
+        } // end of else of `if (rx.objectBytesToBeReceived > 0)`
 
     } // end of `if (m_state == EXPECTING_MAIN_OBJECT)`
     else
@@ -583,32 +1038,42 @@ ThreeGppHttpSatelliteClient::ReceiveMainObject(Ptr<Packet> packet, const Address
         NS_FATAL_ERROR("Invalid state " << GetStateString() << " for ReceiveMainObject().");
     }
 
-} // end of `void ReceiveMainObject (Ptr<Packet> packet)`
+    return excess;
 
-void
-ThreeGppHttpSatelliteClient::ReceiveEmbeddedObject(Ptr<Packet> packet, const Address& from)
+} // end of `Ptr<Packet> ReceiveMainObject (Ptr<Packet> packet)`
+
+Ptr<Packet>
+ThreeGppHttpSatelliteClient::ReceiveEmbeddedObject(Ptr<Packet> packet,
+                                                   const Address& from,
+                                                   Connection& connection,
+                                                   RxState& rx)
 {
     NS_LOG_FUNCTION(this << packet << from);
 
+    Ptr<Packet> excess;
+
     if (m_state == EXPECTING_EMBEDDED_OBJECT)
     {
         /*
-         * In the following call to Receive(), #m_objectBytesToBeReceived *will*
-         * be updated. #m_objectClientTs and #m_objectServerTs *may* be updated.
-         * ThreeGppHttpHeader will be removed from the packet, if it is the first
-         * packet of the object to be received; the header will be available in
-         * #m_constructedPacket, which will also be updated.
+         * In the following call to Receive(), the bytes to be received by the
+         * connection or stream *will* be updated. Its client and server time stamps *may*
+         * be updated. ThreeGppHttpHeader will be removed from the packet, if it
+         * is the first packet of the object to be received; the header will be
+         * available in the constructed packet of the receive state, which will
+         * also be updated.
          */
-        Receive(packet);
+        excess = Receive(packet,
+                         rx,
+                         m_requestMode == PIPELINED && connection.outstandingRequests > 1);
         m_rxEmbeddedObjectPacketTrace(packet);
 
-        if (m_objectBytesToBeReceived > 0)
+        if (rx.objectBytesToBeReceived > 0)
         {
             /*
              * There are more packets of this embedded object, so just stay
              * still and wait until they arrive.
              */
-            NS_LOG_INFO(this << " " << m_objectBytesToBeReceived << " byte(s)"
+            NS_LOG_INFO(this << " " << rx.objectBytesToBeReceived << " byte(s)"
                              << " remains from this chunk of embedded object");
         }
         else
@@ -618,28 +1083,41 @@ ThreeGppHttpSatelliteClient::ReceiveEmbeddedObject(Ptr<Packet> packet, const Add
              * the reception of a whole embedded object
              */
             NS_LOG_INFO(this << " Finished receiving an embedded object.");
-            m_rxEmbeddedObjectTrace(this, m_constructedPacket);
+            m_rxEmbeddedObjectTrace(this, rx.constructedPacket);
 
-            if (!m_objectServerTs.IsZero())
+            if (!rx.objectServerTs.IsZero())
             {
-                m_rxDelayTrace(Simulator::Now() - m_objectServerTs, from);
-                m_objectServerTs = MilliSeconds(0); // Reset back to zero.
+                m_rxDelayTrace(Simulator::Now() - rx.objectServerTs, from);
+                rx.objectServerTs = MilliSeconds(0); // Reset back to zero.
             }
 
-            if (!m_objectClientTs.IsZero())
+            if (!rx.objectClientTs.IsZero())
             {
-                m_rxRttTrace(Simulator::Now() - m_objectClientTs, from);
-                m_objectClientTs = MilliSeconds(0); // Reset back to zero.
+                m_rxRttTrace(Simulator::Now() - rx.objectClientTs, from);
+                rx.objectClientTs = MilliSeconds(0); // Reset back to zero.
             }
 
+            NS_ASSERT(connection.outstandingRequests > 0);
+            NS_ASSERT(m_embeddedObjectsToBeReceived > 0);
+            connection.outstandingRequests--;
+            m_embeddedObjectsToBeReceived--;
+
             if (m_embeddedObjectsToBeRequested > 0)
             {
                 NS_LOG_INFO(this << " " << m_embeddedObjectsToBeRequested
                                  << " more embedded object(s) to be requested.");
-                // Immediately request another using the existing connection.
-                m_eventRequestEmbeddedObject =
-                    Simulator::ScheduleNow(&ThreeGppHttpSatelliteClient::RequestEmbeddedObject,
-                                           this);
+                // Immediately request another using the existing connection(s).
+                if (Simulator::IsExpired(m_eventRequestEmbeddedObject))
+                {
+                    m_eventRequestEmbeddedObject =
+                        Simulator::ScheduleNow(&ThreeGppHttpSatelliteClient::RequestEmbeddedObject,
+                                               this);
+                }
+            }
+            else if (m_embeddedObjectsToBeReceived > 0)
+            {
+                NS_LOG_INFO(this << " Waiting for " << m_embeddedObjectsToBeReceived
+                                 << " more embedded object(s) from the other connection(s).");
             }
             else
             {
@@ -651,7 +1129,7 @@ ThreeGppHttpSatelliteClient::ReceiveEmbeddedObject(Ptr<Packet> packet, const Add
                 EnterReadingTime();
             }
 
-        } // end of else of `if (m_objectBytesToBeReceived > 0)`
+        } // end of else of `if (rx.objectBytesToBeReceived > 0)`
 
     } // end of `if (m_state == EXPECTING_EMBEDDED_OBJECT)`
     else
@@ -659,60 +1137,80 @@ ThreeGppHttpSatelliteClient::ReceiveEmbeddedObject(Ptr<Packet> packet, const Add
         NS_FATAL_ERROR("Invalid state " << GetStateString() << " for ReceiveEmbeddedObject().");
     }
 
-} // end of `void ReceiveEmbeddedObject (Ptr<Packet> packet)`
+    return excess;
 
-void
-ThreeGppHttpSatelliteClient::Receive(Ptr<Packet> packet)
+} // end of `Ptr<Packet> ReceiveEmbeddedObject (Ptr<Packet> packet)`
+
+Ptr<Packet>
+ThreeGppHttpSatelliteClient::Receive(Ptr<Packet> packet, RxState& rx, bool isMoreExpected)
 {
-    NS_LOG_FUNCTION(this << packet);
+    NS_LOG_FUNCTION(this << packet << isMoreExpected);
 
     /* In a "real" HTTP message the message size is coded differently. The use of a header
      * is to avoid the burden of doing a real message parser.
      */
     bool firstPacket = false;
+    ThreeGppHttpHeader httpHeader;
 
-    if (m_objectBytesToBeReceived == 0)
+    if (rx.objectBytesToBeReceived == 0)
     {
         // This is the first packet of the object.
         firstPacket = true;
 
         // Remove the header in order to calculate remaining data to be received.
-        ThreeGppHttpHeader httpHeader;
         packet->RemoveHeader(httpHeader);
 
-        m_objectBytesToBeReceived = httpHeader.GetContentLength();
-        m_objectClientTs = httpHeader.GetClientTs();
-        m_objectServerTs = httpHeader.GetServerTs();
+        rx.objectBytesToBeReceived = httpHeader.GetContentLength();
+        rx.objectClientTs = httpHeader.GetClientTs();
+        rx.objectServerTs = httpHeader.GetServerTs();
+    }
+    uint32_t contentSize = packet->GetSize();
+    Ptr<Packet> excess;
 
+    if (rx.objectBytesToBeReceived < contentSize && isMoreExpected)
+    {
+        /*
+         * Pipelined responses follow each other in the byte stream, so the
+         * rest of the packet belongs to the next object.
+         */
+        const uint32_t excessSize = contentSize - rx.objectBytesToBeReceived;
+        excess = packet->CreateFragment(rx.objectBytesToBeReceived, excessSize);
+        packet->RemoveAtEnd(excessSize);
+        contentSize = rx.objectBytesToBeReceived;
+    }
+
+    if (firstPacket)
+    {
         // Take a copy for constructed packet trace. Note that header is included.
-        m_constructedPacket = packet->Copy();
-        m_constructedPacket->AddHeader(httpHeader);
+        rx.constructedPacket = packet->Copy();
+        rx.constructedPacket->AddHeader(httpHeader);
     }
-    uint32_t contentSize = packet->GetSize();
 
     /* Note that the packet does not contain header at this point.
      * The content is purely raw data, which was the only intended data to be received.
      */
-    if (m_objectBytesToBeReceived < contentSize)
+    if (rx.objectBytesToBeReceived < contentSize)
     {
         NS_LOG_WARN(this << " The received packet" << " (" << contentSize << " bytes of content)"
                          << " is larger than" << " the content that we expected to receive" << " ("
-                         << m_objectBytesToBeReceived << " bytes).");
+                         << rx.objectBytesToBeReceived << " bytes).");
         // Stop expecting any more packet of this object.
-        m_objectBytesToBeReceived = 0;
-        m_constructedPacket = NULL;
+        rx.objectBytesToBeReceived = 0;
+        rx.constructedPacket = NULL;
     }
     else
     {
-        m_objectBytesToBeReceived -= contentSize;
+        rx.objectBytesToBeReceived -= contentSize;
         if (!firstPacket)
         {
             Ptr<Packet> packetCopy = packet->Copy();
-            m_constructedPacket->AddAtEnd(packetCopy);
+            rx.constructedPacket->AddAtEnd(packetCopy);
         }
     }
 
-} // end of `void Receive (packet)`
+    return excess;
+
+} // end of `Ptr<Packet> Receive (packet)`
 
 void
 ThreeGppHttpSatelliteClient::EnterParsingTime()
@@ -749,8 +1247,13 @@ ThreeGppHttpSatelliteClient::ParseMainObject()
         {
             /*
              * Immediately request the first embedded object using the
-             * existing connection.
+             * existing connection. Additional connections, if allowed, will
+             * take part as soon as they are established.
              */
+            if (m_requestMode == SERIAL)
+            {
+                OpenParallelConnections();
+            }
             m_eventRequestEmbeddedObject =
                 Simulator::ScheduleNow(&ThreeGppHttpSatelliteClient::RequestEmbeddedObject, this);
         }
@@ -784,6 +1287,19 @@ ThreeGppHttpSatelliteClient::EnterReadingTime()
 
         m_rxPltTrace(Simulator::Now() - m_requestTime, m_remoteServerAddress);
 
+        if (!m_keepAlive)
+        {
+            CloseParallelConnections();
+        }
+
+        if (m_idleTimeout.IsStrictlyPositive() && readingTime > m_idleTimeout)
+        {
+            m_eventIdleTimeout =
+                Simulator::Schedule(m_idleTimeout,
+                                    &ThreeGppHttpSatelliteClient::CloseIdleConnections,
+                                    this);
+        }
+
         // Schedule a request of another main object once the reading time expires.
         m_eventRequestMainObject =
             Simulator::Schedule(readingTime, &ThreeGppHttpSatelliteClient::RequestMainObject, this);
@@ -823,28 +1339,29 @@ ThreeGppHttpSatelliteClient::CancelAllPendingEvents()
                          << " seconds.");
         Simulator::Cancel(m_eventParseMainObject);
     }
+
+    if (!Simulator::IsExpired(m_eventIdleTimeout))
+    {
+        Simulator::Cancel(m_eventIdleTimeout);
+    }
 }
 
 void
 ThreeGppHttpSatelliteClient::SwitchToState(ThreeGppHttpSatelliteClient::State_t state)
 {
-    const std::string oldState = GetStateString();
-    const std::string newState = GetStateString(state);
-    NS_LOG_FUNCTION(this << oldState << newState);
+    const State_t oldState = m_state;
+    NS_LOG_FUNCTION(this << GetStateString(oldState) << GetStateString(state));
 
-    if ((state == EXPECTING_MAIN_OBJECT) || (state == EXPECTING_EMBEDDED_OBJECT))
+    m_state = state;
+    NS_LOG_INFO(this << " HttpClient " << GetStateString(oldState) << " --> "
+                     << GetStateString(state) << ".");
+    m_stateTransitionEnumTrace(oldState, state);
+
+    // The state names are only constructed if someone is listening to them.
+    if (!m_stateTransitionTrace.IsEmpty())
     {
-        if (m_objectBytesToBeReceived > 0)
-        {
-            NS_FATAL_ERROR("Cannot start a new receiving session"
-                           << " if the previous object" << " (" << m_objectBytesToBeReceived
-                           << " bytes)" << " is not completely received yet.");
-        }
+        m_stateTransitionTrace(GetStateString(oldState), GetStateString(state));
     }
-
-    m_state = state;
-    NS_LOG_INFO(this << " HttpClient " << oldState << " --> " << newState << ".");
-    m_stateTransitionTrace(oldState, newState);
 }
 
 } // namespace ns3
@@ -28,13 +28,14 @@
 #include "ns3/traced-callback.h"
 
 #include <string>
+#include <vector>
 
 namespace ns3
 {
 
 class Socket;
 class Packet;
-class ThreeGppHttpVariables;
+class ThreeGppHttpSatelliteVariables;
 
 /**
  * @ingroup applications
@@ -58,7 +59,7 @@ class ThreeGppHttpVariables;
  * number of clients and/or sufficiently long simulation duration in order to
  * generate any significant traffic in the system.
  *
- * Many aspects of the traffic are randomly determined by ThreeGppHttpVariables.
+ * Many aspects of the traffic are randomly determined by ThreeGppHttpSatelliteVariables.
  * These characteristics are based on a legacy 3GPP specification. The description
  * can be found in the following references:
  *   - 3GPP TR 25.892, "Feasibility Study for Orthogonal Frequency Division
@@ -99,6 +100,39 @@ class ThreeGppHttpVariables;
  * connection to the server is maintained and used for transmitting and receiving
  * all objects.
  *
+ * If the `MaxParallelConnections` attribute is greater than one, the client
+ * behaves like a browser with a connection pool. After parsing a main object,
+ * it opens additional connections to the server (up to the attribute value,
+ * but not more than the number of embedded objects) and requests one embedded
+ * object on each idle connection at a time. Each connection keeps its own
+ * receive state. The additional connections are closed when the web page has
+ * been completely received, unless the `KeepAlive` attribute is enabled, in
+ * which case they are kept open during the reading time and reused for the
+ * next web page.
+ *
+ * If the `IdleTimeout` attribute is non-zero, every connection which stays
+ * idle during the reading time for longer than the timeout is closed, like a
+ * browser does with unused persistent connections. The primary connection is
+ * then opened again before requesting the next main object.
+ *
+ * If the `RequestMode` attribute is set to `PIPELINED`, the client instead
+ * sends the requests for all embedded objects back-to-back on the primary
+ * connection right after parsing, like HTTP/1.1 pipelining, and
+ * `MaxParallelConnections` is not used. The responses are matched to the
+ * requests in order, using the content length of each ThreeGppHttpHeader to
+ * find where one object ends and the next one begins. This mode requires a
+ * server which queues the requests of a connection, e.g.,
+ * ThreeGppHttpSatelliteServer.
+ *
+ * If the `RequestMode` attribute is set to `MULTIPLEXED`, the client works
+ * like an HTTP/2 browser. Every request opens a new stream on the primary
+ * connection, and all data is exchanged in frames carrying a
+ * ThreeGppHttpStreamHeader. The server interleaves the frames of the objects
+ * it is sending, so the objects arrive in parallel without additional
+ * connections. Each stream keeps its own receive state, which is found
+ * directly from the stream ID of a frame. This mode requires a
+ * ThreeGppHttpSatelliteServer with its `Multiplexing` attribute enabled.
+ *
  * Each request by default has a constant size of 350 bytes. A ThreeGppHttpHeader
  * is attached to each request packet. The header contains information
  * such as the content type requested (either main object or embedded object)
@@ -124,7 +158,7 @@ class ThreeGppHttpSatelliteClient : public Application
     static TypeId GetTypeId();
 
     /**
-     * Returns a pointer to the associated socket.
+     * Returns a pointer to the socket of the primary connection.
      * @return Pointer to the associated socket.
      */
     Ptr<Socket> GetSocket() const;
@@ -148,6 +182,17 @@ class ThreeGppHttpSatelliteClient : public Application
         STOPPED
     };
 
+    /// How the requests for the embedded objects of a web page are sent.
+    enum RequestMode_t
+    {
+        /// One request at a time on each connection, see `MaxParallelConnections`.
+        SERIAL = 0,
+        /// All requests back-to-back on the primary connection.
+        PIPELINED,
+        /// All requests on the primary connection, each response in its own stream.
+        MULTIPLEXED
+    };
+
     /**
      * Returns the current state of the application.
      * @return The current state of the application.
@@ -167,6 +212,16 @@ class ThreeGppHttpSatelliteClient : public Application
      */
     static std::string GetStateString(State_t state);
 
+    /**
+     * @brief Common signature used by callbacks to the `StateTransitionEnum`
+     *        trace source.
+     * @param oldState the old state.
+     * @param newState the new state.
+     *
+     * Use GetStateString() in the callback if the state names are needed.
+     */
+    typedef void (*StateTransitionEnumCallback)(State_t oldState, State_t newState);
+
     /**
      * Common callback signature for `ConnectionEstablished`, `RxMainObject`, and
      * `RxEmbeddedObject` trace sources.
@@ -187,47 +242,156 @@ class ThreeGppHttpSatelliteClient : public Application
     // SOCKET CALLBACK METHODS
 
     /**
-     * Invoked when a connection is established successfully on #m_socket. This
+     * Invoked when the primary connection is established successfully. This
      * triggers a request for a main object.
      * @param socket Pointer to the socket where the event originates from.
      */
     void ConnectionSucceededCallback(Ptr<Socket> socket);
     /**
-     * Invoked when #m_socket cannot establish a connection with the web server.
+     * Invoked when the primary connection with the web server cannot be established.
      * Simulation will stop and error will be raised.
      * @param socket Pointer to the socket where the event originates from.
      */
     void ConnectionFailedCallback(Ptr<Socket> socket);
     /**
-     * Invoked when connection between #m_socket and the web sever is terminated.
+     * Invoked when the primary connection with the web sever is terminated.
      * Error will be logged, but simulation continues.
      * @param socket Pointer to the socket where the event originates from.
      */
     void NormalCloseCallback(Ptr<Socket> socket);
     /**
-     * Invoked when connection between #m_socket and the web sever is terminated.
+     * Invoked when the primary connection with the web sever is terminated.
      * Error will be logged, but simulation continues.
      * @param socket Pointer to the socket where the event originates from.
      */
     void ErrorCloseCallback(Ptr<Socket> socket);
     /**
-     * Invoked when #m_socket receives some packet data. Fires the `Rx` trace
-     * source and triggers ReceiveMainObject() or ReceiveEmbeddedObject().
+     * Invoked when any connection in #m_connections receives some packet data.
+     * Fires the `Rx` trace source and triggers ReceiveMainObject() or
+     * ReceiveEmbeddedObject().
      * @param socket Pointer to the socket where the event originates from.
      */
     void ReceivedDataCallback(Ptr<Socket> socket);
+    /**
+     * Invoked when an additional connection of the pool is established. The
+     * connection is then utilized for requesting the remaining embedded objects.
+     * @param socket Pointer to the socket where the event originates from.
+     */
+    void ParallelConnectionSucceededCallback(Ptr<Socket> socket);
+    /**
+     * Invoked when an additional connection of the pool cannot be established.
+     * Error will be logged and the connection is removed from the pool, but
+     * simulation continues.
+     * @param socket Pointer to the socket where the event originates from.
+     */
+    void ParallelConnectionFailedCallback(Ptr<Socket> socket);
+    /**
+     * Invoked when an additional connection of the pool is terminated. Embedded
+     * objects which were still expected from the connection are requested
+     * again on the remaining connections.
+     * @param socket Pointer to the socket where the event originates from.
+     */
+    void ParallelConnectionClosedCallback(Ptr<Socket> socket);
 
-    // CONNECTION-RELATED METHOD
+    // CONNECTION-RELATED METHODS
+
+    /// Receive state of the objects coming from a connection or a stream.
+    struct RxState
+    {
+        /// Creates a new receive state, which is not expecting any object.
+        RxState();
+
+        /// According to the content length specified by the ThreeGppHttpHeader.
+        uint32_t objectBytesToBeReceived;
+        /// The packet constructed of one or more parts with ThreeGppHttpHeader.
+        Ptr<Packet> constructedPacket;
+        /// The client time stamp of the ThreeGppHttpHeader from the last received packet.
+        Time objectClientTs;
+        /// The server time stamp of the ThreeGppHttpHeader from the last received packet.
+        Time objectServerTs;
+        /// Received bytes of an incomplete ThreeGppHttpHeader, kept until the rest arrives.
+        Ptr<Packet> rxBuffer;
+    };
+
+    /// State of a single connection to the web server.
+    struct Connection
+    {
+        /**
+         * @brief Creates a new connection record in unconnected state.
+         * @param s The socket of the connection.
+         */
+        explicit Connection(Ptr<Socket> s);
+
+        /// The socket for sending and receiving packets to/from the web server.
+        Ptr<Socket> socket;
+        /// True after the connection has been established.
+        bool isConnected;
+        /// Number of requests sent on the connection and not answered yet.
+        uint32_t outstandingRequests;
+        /// Receive state of the objects, except in `MULTIPLEXED` mode.
+        RxState rx;
+        /// In `MULTIPLEXED` mode, the stream ID of the frame being received.
+        uint32_t frameStreamId;
+        /// In `MULTIPLEXED` mode, the remaining bytes of the frame being received.
+        uint32_t frameBytesToBeReceived;
+        /// In `MULTIPLEXED` mode, received bytes of an incomplete frame header.
+        Ptr<Packet> frameBuffer;
+    };
 
     /**
-     * Initialize #m_socket to connect to the destination web server at
-     * #m_remoteServerAddress and #m_remoteServerPort and set up callbacks to
-     * listen to its event. Invoked upon the start of the application.
+     * Initialize the primary connection to connect to the destination web
+     * server at #m_remoteServerAddress and #m_remoteServerPort and set up
+     * callbacks to listen to its event. Invoked upon the start of the
+     * application.
      */
     void OpenConnection();
+    /**
+     * Create a new TCP socket, bind it, and start connecting it to
+     * #m_remoteServerAddress and #m_remoteServerPort.
+     * @return The new socket.
+     */
+    Ptr<Socket> CreateSocket();
+    /**
+     * Open additional connections until the pool has as many connections as
+     * allowed by the `MaxParallelConnections` attribute, but not more than
+     * there are embedded objects to be requested.
+     */
+    void OpenParallelConnections();
+    /**
+     * Close every connection of the pool, except the primary connection.
+     */
+    void CloseParallelConnections();
+    /**
+     * Close every connection, including the primary connection, because they
+     * have been idle for longer than the `IdleTimeout` attribute. Invoked
+     * during the reading time. Fires the `ConnectionClosed` trace source once
+     * for each closed connection.
+     */
+    void CloseIdleConnections();
+    /**
+     * @param socket A socket.
+     * @return Pointer to the connection of the given socket in #m_connections,
+     *         or a null pointer if the socket does not belong to the pool.
+     */
+    Connection* FindConnection(Ptr<Socket> socket);
+    /**
+     * @param streamId A stream ID.
+     * @return Pointer to the receive state of the stream of the current web
+     *         page, or a null pointer if the stream is unknown.
+     */
+    RxState* FindStream(uint32_t streamId);
 
     // TX-RELATED METHODS
 
+    /**
+     * Send a request packet on a connection. In `MULTIPLEXED` mode, a new
+     * stream is opened for the request and a ThreeGppHttpStreamHeader is added
+     * to the packet. Fires the `Tx` trace source.
+     * @param packet The request packet, with ThreeGppHttpHeader.
+     * @param connection The connection to send the request on.
+     * @return True if the request has been sent.
+     */
+    bool SendRequest(Ptr<Packet> packet, Connection& connection);
     /**
      * Send a request object for a main object to the destination web server.
      * The size of the request packet is randomly determined by HttpVariables and
@@ -238,24 +402,58 @@ class ThreeGppHttpSatelliteClient : public Application
      * reading time has elapsed.
      */
     void RequestMainObject();
+    /**
+     * Send requests for the remaining embedded objects to the destination web
+     * server. In `SERIAL` mode, one request is sent on each connection of the
+     * pool which is established and is not expecting any object. In
+     * `PIPELINED` mode, all the remaining requests are sent at once.
+     */
+    void RequestEmbeddedObject();
     /**
      * Send a request object for an embedded object to the destination web
      * server. The size of the request packet is randomly determined by
      * ThreeGppHttpVariables and is assumed to be smaller than 536 bytes. Fires the
      * `TxEmbeddedObjectRequest` trace source.
+     * @param connection The connection to send the request on.
+     * @return True if the request has been sent.
      */
-    void RequestEmbeddedObject();
+    bool SendEmbeddedObjectRequest(Connection& connection);
 
     // RX-RELATED METHODS
 
+    /**
+     * Split the frames in a packet received in `MULTIPLEXED` mode and pass the
+     * content of each frame to ReceiveObjectPart() with the receive state of
+     * the stream of the frame.
+     * @param packet The received packet.
+     * @param from Address of the sender.
+     * @param connection The connection where the packet is received.
+     */
+    void ReceiveFrames(Ptr<Packet> packet, const Address& from, Connection& connection);
+    /**
+     * Pass a part of an object to ReceiveMainObject() or
+     * ReceiveEmbeddedObject(), depending on the current state. If the part
+     * begins a new object but does not contain its whole ThreeGppHttpHeader
+     * yet, the part is kept in the receive state until more bytes arrive.
+     * @param packet The received part.
+     * @param from Address of the sender.
+     * @param connection The connection where the part is received.
+     * @param rx The receive state of the connection or stream.
+     * @return The part of the packet which belongs to the next object, or a null
+     *         pointer if the whole packet has been consumed.
+     */
+    Ptr<Packet> ReceiveObjectPart(Ptr<Packet> packet,
+                                  const Address& from,
+                                  Connection& connection,
+                                  RxState& rx);
     /**
      * Receive a packet of main object from the destination web server. Fires the
      * `RxMainObjectPacket` trace source.
      *
      * A main object may come from more than one packets. This is determined by
      * comparing the content length specified in the ThreeGppHttpHeader of the packet and
-     * the actual packet size. #m_objectBytesToBeReceived keeps track of the
-     * number of bytes that has been received.
+     * the actual packet size. The receive state of the connection keeps track
+     * of the number of bytes that has been received.
      *
      * If the received packet is not the last packet of the object, then the
      * method simply quits, expecting it to be invoked again when the next packet
@@ -267,16 +465,19 @@ class ThreeGppHttpSatelliteClient : public Application
      *
      * @param packet The received packet.
      * @param from Address of the sender.
+     * @param rx The receive state of the connection or stream.
+     * @return The part of the packet which belongs to the next object, or a null
+     *         pointer if the whole packet has been consumed.
      */
-    void ReceiveMainObject(Ptr<Packet> packet, const Address& from);
+    Ptr<Packet> ReceiveMainObject(Ptr<Packet> packet, const Address& from, RxState& rx);
     /**
      * Receive a packet of embedded object from the destination web server. Fires
      * the `RxEmbeddedObjectPacket` trace source.
      *
      * An embedded object may come from more than one packets. This is determined
      * by comparing the content length specified in the TheeGppHttpHeader of the packet and
-     * the actual packet size. #m_objectBytesToBeReceived keeps track of the
-     * number of bytes that has been received.
+     * the actual packet size. The receive state of the connection keeps track
+     * of the number of bytes that has been received.
      *
      * If the received packet is not the last packet of the object, then the
      * method simply quits, expecting it to be invoked again when the next packet
@@ -285,26 +486,41 @@ class ThreeGppHttpSatelliteClient : public Application
      * If the received packet is the last packet of the object, then the method
      * fires the `RxEmbeddedObject`, `RxDelay`, and `RxRtt` trace sources.
      * Depending on the number of embedded objects remaining
-     * (#m_embeddedObjectsToBeRequested) the client can either trigger
-     * RequestEmbeddedObject() or EnterReadingTime().
+     * (#m_embeddedObjectsToBeRequested and #m_embeddedObjectsToBeReceived) the
+     * client can either trigger RequestEmbeddedObject(), wait for the other
+     * connections, or trigger EnterReadingTime().
      *
      * @param packet The received packet.
      * @param from Address of the sender.
+     * @param connection The connection where the packet is received.
+     * @param rx The receive state of the connection or stream.
+     * @return The part of the packet which belongs to the next object, or a null
+     *         pointer if the whole packet has been consumed.
      */
-    void ReceiveEmbeddedObject(Ptr<Packet> packet, const Address& from);
+    Ptr<Packet> ReceiveEmbeddedObject(Ptr<Packet> packet,
+                                      const Address& from,
+                                      Connection& connection,
+                                      RxState& rx);
     /**
      * Simulate a consumption of the received packet by subtracting the packet
-     * size from the internal counter at #m_objectBytesToBeReceived. Also updates
-     * #m_objectClientTs and #m_objectServerTs according to the ThreeGppHttpHeader
-     * found in the packet.
+     * size from the internal counter of the receive state. Also updates the
+     * client and server time stamps of the receive state according to the
+     * ThreeGppHttpHeader found in the packet.
      *
      * This method is invoked as a sub-procedure of ReceiveMainObject() and
      * ReceiveEmbeddedObject().
      *
+     * If the packet is longer than the rest of the object and more objects
+     * are expected (i.e., pipelined responses), the excess part is cut off from
+     * the packet and returned.
+     *
      * @param packet The received packet. If it is the first packet of the object,
      *               then it must have a ThreeGppHttpHeader attached to it.
+     * @param rx The receive state of the connection or stream.
+     * @param isMoreExpected True if more objects follow in the same byte stream.
+     * @return The excess part of the packet, or a null pointer.
      */
-    void Receive(Ptr<Packet> packet);
+    Ptr<Packet> Receive(Ptr<Packet> packet, RxState& rx, bool isMoreExpected);
 
     // OFF-TIME-RELATED METHODS
 
@@ -334,9 +550,9 @@ class ThreeGppHttpSatelliteClient : public Application
      */
     void EnterReadingTime();
     /**
-     * Cancels #m_eventRequestMainObject, #m_eventRequestEmbeddedObject, and
-     * #m_eventParseMainObject. Invoked by StopApplication() and when connection
-     * has been terminated.
+     * Cancels #m_eventRequestMainObject, #m_eventRequestEmbeddedObject,
+     * #m_eventParseMainObject, and #m_eventIdleTimeout. Invoked by
+     * StopApplication() and when connection has been terminated.
      */
     void CancelAllPendingEvents();
 
@@ -348,27 +564,42 @@ class ThreeGppHttpSatelliteClient : public Application
 
     /// The current state of the client application. Begins with NOT_STARTED.
     State_t m_state;
-    /// The socket for sending and receiving packets to/from the web server.
-    Ptr<Socket> m_socket;
-    /// According to the content length specified by the ThreeGppHttpHeader.
-    uint32_t m_objectBytesToBeReceived;
-    /// The packet constructed of one or more parts with ThreeGppHttpHeader.
-    Ptr<Packet> m_constructedPacket;
-    /// The client time stamp of the ThreeGppHttpHeader from the last received packet.
-    Time m_objectClientTs;
-    /// The server time stamp of the ThreeGppHttpHeader from the last received packet.
-    Time m_objectServerTs;
+    /**
+     * The connections to the web server. The first one is the primary
+     * connection, which is opened upon start and is used for main objects. The
+     * rest are opened only for fetching embedded objects in parallel.
+     */
+    std::vector<Connection> m_connections;
     /// Determined after parsing the main object.
     uint32_t m_embeddedObjectsToBeRequested;
+    /// Number of embedded objects requested but not completely received yet.
+    uint32_t m_embeddedObjectsToBeReceived;
+    /**
+     * In `MULTIPLEXED` mode, the receive state of the streams of the current
+     * web page, indexed by the stream ID minus #m_firstStreamId.
+     */
+    std::vector<RxState> m_streams;
+    /// The stream ID of the main object of the current web page.
+    uint32_t m_firstStreamId;
+    /// The stream ID to be given to the next request.
+    uint32_t m_nextStreamId;
 
     // ATTRIBUTES
 
     /// The `Variables` attribute.
-    Ptr<ThreeGppHttpVariables> m_httpVariables;
+    Ptr<ThreeGppHttpSatelliteVariables> m_httpVariables;
     /// The `RemoteServerAddress` attribute. The address of the web server.
     Address m_remoteServerAddress;
     /// The `RemoteServerPort` attribute.
     uint16_t m_remoteServerPort;
+    /// The `MaxParallelConnections` attribute.
+    uint32_t m_maxParallelConnections;
+    /// The `RequestMode` attribute.
+    RequestMode_t m_requestMode;
+    /// The `KeepAlive` attribute.
+    bool m_keepAlive;
+    /// The `IdleTimeout` attribute.
+    Time m_idleTimeout;
     /// Time of request for main object
     Time m_requestTime;
 
@@ -404,6 +635,8 @@ class ThreeGppHttpSatelliteClient : public Application
     ns3::TracedCallback<const Time&, const Address&> m_rxRttTrace;
     /// The `StateTransition` trace source.
     ns3::TracedCallback<const std::string&, const std::string&> m_stateTransitionTrace;
+    /// The `StateTransitionEnum` trace source.
+    ns3::TracedCallback<State_t, State_t> m_stateTransitionEnumTrace;
 
     // EVENTS
 
@@ -422,6 +655,10 @@ class ThreeGppHttpSatelliteClient : public Application
      * elapsed.
      */
     EventId m_eventParseMainObject;
+    /**
+     * An event of CloseIdleConnections(), scheduled during the reading time.
+     */
+    EventId m_eventIdleTimeout;
 
 }; // end of `class ThreeGppHttpSatelliteClient`
 
@@ -0,0 +1,710 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "three-gpp-http-satellite-server.h"
+
+#include "three-gpp-http-stream-header.h"
+#include "three-gpp-http-satellite-variables.h"
+
+#include "ns3/boolean.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/inet6-socket-address.h"
+#include "ns3/log.h"
+#include "ns3/packet.h"
+#include "ns3/pointer.h"
+#include "ns3/simulator.h"
+#include "ns3/socket.h"
+#include "ns3/tcp-socket-factory.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <string>
+
+NS_LOG_COMPONENT_DEFINE("ThreeGppHttpSatelliteServer");
+
+namespace ns3
+{
+
+NS_OBJECT_ENSURE_REGISTERED(ThreeGppHttpSatelliteServer);
+
+ThreeGppHttpSatelliteServer::ThreeGppHttpSatelliteServer()
+    : m_state(NOT_STARTED),
+      m_initialSocket(nullptr),
+      m_httpVariables(CreateObject<ThreeGppHttpSatelliteVariables>()),
+      m_isMultiplexing(false),
+      m_frameSize(16384)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TypeId
+ThreeGppHttpSatelliteServer::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::ThreeGppHttpSatelliteServer")
+            .SetParent<Application>()
+            .AddConstructor<ThreeGppHttpSatelliteServer>()
+            .AddAttribute("Variables",
+                          "Variable collection, which is used to control e.g. processing and "
+                          "object generation delays.",
+                          PointerValue(),
+                          MakePointerAccessor(&ThreeGppHttpSatelliteServer::m_httpVariables),
+                          MakePointerChecker<ThreeGppHttpSatelliteVariables>())
+            .AddAttribute("LocalAddress",
+                          "The local address of the server, "
+                          "i.e., the address on which to bind the Rx socket",
+                          AddressValue(),
+                          MakeAddressAccessor(&ThreeGppHttpSatelliteServer::m_localAddress),
+                          MakeAddressChecker())
+            .AddAttribute("LocalPort",
+                          "Port on which the application listen for incoming packets",
+                          UintegerValue(80), // the default HTTP port
+                          MakeUintegerAccessor(&ThreeGppHttpSatelliteServer::m_localPort),
+                          MakeUintegerChecker<uint16_t>())
+            .AddAttribute("Multiplexing",
+                          "Expect every request in a stream frame and interleave the frames "
+                          "of the responses, for ThreeGppHttpSatelliteClient in MULTIPLEXED "
+                          "request mode",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&ThreeGppHttpSatelliteServer::m_isMultiplexing),
+                          MakeBooleanChecker())
+            .AddAttribute("FrameSize",
+                          "The maximum number of bytes of an object carried by a single frame, "
+                          "when multiplexing is enabled",
+                          UintegerValue(16384),
+                          MakeUintegerAccessor(&ThreeGppHttpSatelliteServer::m_frameSize),
+                          MakeUintegerChecker<uint32_t>(64))
+            .AddTraceSource("ConnectionEstablished",
+                            "Connection to a remote web client has been established",
+                            MakeTraceSourceAccessor(
+                                &ThreeGppHttpSatelliteServer::m_connectionEstablishedTrace),
+                            "ns3::ThreeGppHttpSatelliteServer::ConnectionEstablishedCallback")
+            .AddTraceSource(
+                "MainObject",
+                "A main object has been generated",
+                MakeTraceSourceAccessor(&ThreeGppHttpSatelliteServer::m_mainObjectTrace),
+                "ns3::ThreeGppHttpSatelliteServer::HttpObjectCallback")
+            .AddTraceSource(
+                "EmbeddedObject",
+                "An embedded object has been generated",
+                MakeTraceSourceAccessor(&ThreeGppHttpSatelliteServer::m_embeddedObjectTrace),
+                "ns3::ThreeGppHttpSatelliteServer::HttpObjectCallback")
+            .AddTraceSource("Tx",
+                            "A packet has been sent",
+                            MakeTraceSourceAccessor(&ThreeGppHttpSatelliteServer::m_txTrace),
+                            "ns3::Packet::TracedCallback")
+            .AddTraceSource("Rx",
+                            "A packet has been received",
+                            MakeTraceSourceAccessor(&ThreeGppHttpSatelliteServer::m_rxTrace),
+                            "ns3::Packet::PacketAddressTracedCallback")
+            .AddTraceSource("RxDelay",
+                            "A request has been received, with the delay since it was sent",
+                            MakeTraceSourceAccessor(&ThreeGppHttpSatelliteServer::m_rxDelayTrace),
+                            "ns3::Application::PacketDelayAddressCallback");
+    return tid;
+}
+
+Address
+ThreeGppHttpSatelliteServer::GetLocalAddress() const
+{
+    return m_localAddress;
+}
+
+uint16_t
+ThreeGppHttpSatelliteServer::GetLocalPort() const
+{
+    return m_localPort;
+}
+
+ThreeGppHttpSatelliteServer::State_t
+ThreeGppHttpSatelliteServer::GetState() const
+{
+    return m_state;
+}
+
+std::string
+ThreeGppHttpSatelliteServer::GetStateString() const
+{
+    return GetStateString(m_state);
+}
+
+std::string
+ThreeGppHttpSatelliteServer::GetStateString(ThreeGppHttpSatelliteServer::State_t state)
+{
+    switch (state)
+    {
+    case NOT_STARTED:
+        return "NOT_STARTED";
+        break;
+    case STARTED:
+        return "STARTED";
+        break;
+    case STOPPED:
+        return "STOPPED";
+        break;
+    default:
+        NS_FATAL_ERROR("Unknown state");
+        return "";
+        break;
+    }
+}
+
+void
+ThreeGppHttpSatelliteServer::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (!Simulator::IsFinished()) // guard against canceling out-of-bound events
+    {
+        StopApplication();
+    }
+
+    Application::DoDispose(); // chain up
+}
+
+void
+ThreeGppHttpSatelliteServer::StartApplication()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (m_state == NOT_STARTED)
+    {
+        if (m_initialSocket == nullptr)
+        {
+            m_initialSocket = Socket::CreateSocket(GetNode(), TcpSocketFactory::GetTypeId());
+            NS_LOG_INFO(this << " created socket " << m_initialSocket);
+            int ret;
+
+            if (Ipv4Address::IsMatchingType(m_localAddress))
+            {
+                const Ipv4Address ipv4 = Ipv4Address::ConvertFrom(m_localAddress);
+                const InetSocketAddress inetSocket = InetSocketAddress(ipv4, m_localPort);
+                NS_LOG_INFO(this << " binding on " << ipv4 << " port " << m_localPort << " / "
+                                 << inetSocket);
+                ret = m_initialSocket->Bind(inetSocket);
+                NS_LOG_DEBUG(this << " Bind() return value= " << ret
+                                  << " GetErrNo= " << m_initialSocket->GetErrno());
+            }
+            else if (Ipv6Address::IsMatchingType(m_localAddress))
+            {
+                const Ipv6Address ipv6 = Ipv6Address::ConvertFrom(m_localAddress);
+                const Inet6SocketAddress inet6Socket = Inet6SocketAddress(ipv6, m_localPort);
+                NS_LOG_INFO(this << " binding on " << ipv6 << " port " << m_localPort << " / "
+                                 << inet6Socket);
+                ret = m_initialSocket->Bind(inet6Socket);
+                NS_LOG_DEBUG(this << " Bind() return value= " << ret
+                                  << " GetErrNo= " << m_initialSocket->GetErrno());
+            }
+
+            ret = m_initialSocket->Listen();
+            NS_LOG_DEBUG(this << " Listen () return value= " << ret
+                              << " GetErrNo= " << m_initialSocket->GetErrno());
+
+        } // end of `if (m_initialSocket == nullptr)`
+
+        NS_ASSERT_MSG(m_initialSocket != nullptr, "Failed creating socket");
+        m_initialSocket->ShutdownRecv();
+        m_initialSocket->SetAcceptCallback(
+            MakeCallback(&ThreeGppHttpSatelliteServer::ConnectionRequestCallback, this),
+            MakeCallback(&ThreeGppHttpSatelliteServer::NewConnectionCreatedCallback, this));
+        m_initialSocket->SetCloseCallbacks(
+            MakeCallback(&ThreeGppHttpSatelliteServer::NormalCloseCallback, this),
+            MakeCallback(&ThreeGppHttpSatelliteServer::ErrorCloseCallback, this));
+
+        SwitchToState(STARTED);
+
+    } // end of `if (m_state == NOT_STARTED)`
+    else
+    {
+        NS_LOG_WARN(this << " invalid state " << GetStateString() << " for StartApplication");
+    }
+
+} // end of `void StartApplication ()`
+
+void
+ThreeGppHttpSatelliteServer::StopApplication()
+{
+    NS_LOG_FUNCTION(this);
+
+    SwitchToState(STOPPED);
+
+    // close all accepted sockets
+    for (auto it = m_connections.begin(); it != m_connections.end(); ++it)
+    {
+        Simulator::Cancel(it->second.eventServe);
+        it->first->Close();
+        it->first->SetCloseCallbacks(MakeNullCallback<void, Ptr<Socket>>(),
+                                     MakeNullCallback<void, Ptr<Socket>>());
+        it->first->SetRecvCallback(MakeNullCallback<void, Ptr<Socket>>());
+        it->first->SetSendCallback(MakeNullCallback<void, Ptr<Socket>, uint32_t>());
+    }
+
+    m_connections.clear();
+
+    // stop listening
+    if (m_initialSocket != nullptr)
+    {
+        m_initialSocket->Close();
+        m_initialSocket->SetAcceptCallback(
+            MakeNullCallback<bool, Ptr<Socket>, const Address&>(),
+            MakeNullCallback<void, Ptr<Socket>, const Address&>());
+    }
+}
+
+bool
+ThreeGppHttpSatelliteServer::ConnectionRequestCallback(Ptr<Socket> socket, const Address& address)
+{
+    NS_LOG_FUNCTION(this << socket << address);
+    return true; // unconditionally accept the connection request
+}
+
+void
+ThreeGppHttpSatelliteServer::NewConnectionCreatedCallback(Ptr<Socket> socket,
+                                                          const Address& address)
+{
+    NS_LOG_FUNCTION(this << socket << address);
+
+    ClientConnection& connection = m_connections[socket];
+    connection.rxBuffer = nullptr;
+    connection.requestBytesToBeSkipped = 0;
+
+    socket->SetCloseCallbacks(
+        MakeCallback(&ThreeGppHttpSatelliteServer::NormalCloseCallback, this),
+        MakeCallback(&ThreeGppHttpSatelliteServer::ErrorCloseCallback, this));
+    socket->SetRecvCallback(MakeCallback(&ThreeGppHttpSatelliteServer::ReceivedDataCallback, this));
+    socket->SetSendCallback(MakeCallback(&ThreeGppHttpSatelliteServer::SendCallback, this));
+
+    m_connectionEstablishedTrace(this, socket);
+}
+
+void
+ThreeGppHttpSatelliteServer::NormalCloseCallback(Ptr<Socket> socket)
+{
+    NS_LOG_FUNCTION(this << socket);
+
+    if (socket == m_initialSocket)
+    {
+        if (m_state == STARTED)
+        {
+            NS_FATAL_ERROR(
+                "Initial listener socket shall not be closed when server is still running");
+        }
+    }
+    else
+    {
+        RemoveConnection(socket);
+        socket->Close(); // close the other direction as well
+    }
+}
+
+void
+ThreeGppHttpSatelliteServer::ErrorCloseCallback(Ptr<Socket> socket)
+{
+    NS_LOG_FUNCTION(this << socket);
+
+    if (socket == m_initialSocket)
+    {
+        if (m_state == STARTED)
+        {
+            NS_FATAL_ERROR(
+                "Initial listener socket shall not be closed when server is still running");
+        }
+    }
+    else
+    {
+        RemoveConnection(socket);
+    }
+}
+
+void
+ThreeGppHttpSatelliteServer::ReceivedDataCallback(Ptr<Socket> socket)
+{
+    NS_LOG_FUNCTION(this << socket);
+
+    auto it = m_connections.find(socket);
+    NS_ASSERT_MSG(it != m_connections.end(), "Invalid socket.");
+
+    Ptr<Packet> packet;
+    Address from;
+
+    while ((packet = socket->RecvFrom(from)))
+    {
+        if (packet->GetSize() == 0)
+        {
+            break; // EOF
+        }
+
+        NS_LOG_INFO(this << " A packet of " << packet->GetSize() << " bytes"
+                         << " received from " << from);
+        m_rxTrace(packet, from);
+        ParseRequests(socket, it->second, packet, from);
+    }
+
+    ServeFromQueue(socket);
+}
+
+void
+ThreeGppHttpSatelliteServer::SendCallback(Ptr<Socket> socket, uint32_t availableBufferSize)
+{
+    NS_LOG_FUNCTION(this << socket << availableBufferSize);
+    ServeFromQueue(socket);
+}
+
+void
+ThreeGppHttpSatelliteServer::ParseRequests(Ptr<Socket> socket,
+                                           ClientConnection& connection,
+                                           Ptr<Packet> packet,
+                                           const Address& from)
+{
+    NS_LOG_FUNCTION(this << socket << packet << from);
+
+    static const uint32_t headerSize = ThreeGppHttpHeader().GetSerializedSize();
+    static const uint32_t streamHeaderSize = ThreeGppHttpStreamHeader::GetStaticSerializedSize();
+    const uint32_t overhead = m_isMultiplexing ? streamHeaderSize + headerSize : headerSize;
+
+    if (connection.rxBuffer != nullptr)
+    {
+        // Complete the header which was cut off at the end of the previous packet.
+        connection.rxBuffer->AddAtEnd(packet);
+        packet = connection.rxBuffer;
+        connection.rxBuffer = nullptr;
+    }
+
+    while (packet->GetSize() > 0)
+    {
+        if (connection.requestBytesToBeSkipped > 0)
+        {
+            // The content of a request carries no information.
+            const uint32_t skipped =
+                std::min(connection.requestBytesToBeSkipped, packet->GetSize());
+            packet->RemoveAtStart(skipped);
+            connection.requestBytesToBeSkipped -= skipped;
+            continue;
+        }
+
+        if (packet->GetSize() < overhead)
+        {
+            connection.rxBuffer = packet;
+            break;
+        }
+
+        // Each multiplexed request is sent as a single frame on its own stream.
+        ThreeGppHttpStreamHeader streamHeader;
+        if (m_isMultiplexing)
+        {
+            packet->RemoveHeader(streamHeader);
+            NS_ASSERT_MSG(streamHeader.GetFrameLength() >= headerSize,
+                          "Frame of stream " << streamHeader.GetStreamId()
+                                             << " is too short for a request.");
+        }
+
+        ThreeGppHttpHeader httpHeader;
+        packet->RemoveHeader(httpHeader);
+        m_rxDelayTrace(Simulator::Now() - httpHeader.GetClientTs(), from);
+
+        PendingResponse response;
+        response.contentType = httpHeader.GetContentType();
+        response.clientTs = httpHeader.GetClientTs();
+        response.streamId = streamHeader.GetStreamId();
+        response.isSending = false;
+        response.objectSize = 0;
+        response.objectBytesToBeSent = 0;
+
+        switch (response.contentType)
+        {
+        case ThreeGppHttpHeader::MAIN_OBJECT:
+            response.readyTime =
+                Simulator::Now() + m_httpVariables->GetMainObjectGenerationDelay();
+            break;
+        case ThreeGppHttpHeader::EMBEDDED_OBJECT:
+            response.readyTime =
+                Simulator::Now() + m_httpVariables->GetEmbeddedObjectGenerationDelay();
+            break;
+        default:
+            NS_FATAL_ERROR("Invalid content type " << response.contentType << " in a request.");
+            break;
+        }
+
+        connection.responses.push_back(response);
+        NS_LOG_INFO(this << " " << connection.responses.size()
+                         << " request(s) in the queue of socket " << socket << ".");
+
+        // A request without content length spans the rest of the packet.
+        if (m_isMultiplexing)
+        {
+            connection.requestBytesToBeSkipped = streamHeader.GetFrameLength() - headerSize;
+        }
+        else
+        {
+            connection.requestBytesToBeSkipped = (httpHeader.GetContentLength() > 0)
+                                                     ? httpHeader.GetContentLength()
+                                                     : packet->GetSize();
+        }
+
+    } // end of `while (packet->GetSize () > 0)`
+
+} // end of `void ParseRequests (...)`
+
+void
+ThreeGppHttpSatelliteServer::ServeFromQueue(Ptr<Socket> socket)
+{
+    NS_LOG_FUNCTION(this << socket);
+
+    auto it = m_connections.find(socket);
+    if (it == m_connections.end())
+    {
+        return; // the connection has been closed in the meantime
+    }
+
+    static const uint32_t headerSize = ThreeGppHttpHeader().GetSerializedSize();
+    ClientConnection& connection = it->second;
+
+    if (m_isMultiplexing)
+    {
+        ServeFrames(socket, connection);
+        return;
+    }
+
+    while (!connection.responses.empty())
+    {
+        PendingResponse& response = connection.responses.front();
+
+        if (!response.isSending)
+        {
+            const Time now = Simulator::Now();
+            if (response.readyTime > now)
+            {
+                if (Simulator::IsExpired(connection.eventServe))
+                {
+                    connection.eventServe =
+                        Simulator::Schedule(response.readyTime - now,
+                                            &ThreeGppHttpSatelliteServer::ServeFromQueue,
+                                            this,
+                                            socket);
+                }
+                return; // the object is still being generated
+            }
+
+            StartResponse(response);
+        }
+
+        const bool isFirstPacket = (response.objectBytesToBeSent == response.objectSize);
+        const uint32_t overhead = isFirstPacket ? headerSize : 0;
+        const uint32_t txAvailable = socket->GetTxAvailable();
+        if (txAvailable <= overhead)
+        {
+            return; // wait for SendCallback()
+        }
+
+        const uint32_t contentSize =
+            std::min(response.objectBytesToBeSent, txAvailable - overhead);
+        Ptr<Packet> packet = Create<Packet>(contentSize);
+
+        if (isFirstPacket)
+        {
+            ThreeGppHttpHeader httpHeader;
+            httpHeader.SetContentType(response.contentType);
+            httpHeader.SetContentLength(response.objectSize);
+            httpHeader.SetClientTs(response.clientTs);
+            httpHeader.SetServerTs(Simulator::Now());
+            packet->AddHeader(httpHeader);
+        }
+
+        const uint32_t packetSize = packet->GetSize();
+        const int actualBytes = socket->Send(packet);
+        NS_LOG_DEBUG(this << " Send() packet " << packet << " of " << packetSize << " bytes,"
+                          << " return value= " << actualBytes << ".");
+
+        if (actualBytes != static_cast<int>(packetSize))
+        {
+            NS_LOG_WARN(this << " Failed to send a packet, GetErrNo= " << socket->GetErrno()
+                             << ", waiting for another Tx opportunity.");
+            return;
+        }
+
+        m_txTrace(packet);
+        response.objectBytesToBeSent -= contentSize;
+
+        if (response.objectBytesToBeSent == 0)
+        {
+            NS_LOG_INFO(this << " Finished sending an object of " << response.objectSize
+                             << " bytes.");
+            connection.responses.pop_front();
+        }
+
+    } // end of `while (!connection.responses.empty ())`
+
+} // end of `void ServeFromQueue (Ptr<Socket> socket)`
+
+void
+ThreeGppHttpSatelliteServer::ServeFrames(Ptr<Socket> socket, ClientConnection& connection)
+{
+    NS_LOG_FUNCTION(this << socket);
+
+    static const uint32_t headerSize = ThreeGppHttpHeader().GetSerializedSize();
+    static const uint32_t streamHeaderSize = ThreeGppHttpStreamHeader::GetStaticSerializedSize();
+
+    /*
+     * The response at the head of the queue gets the next frame. Afterwards it
+     * is moved to the back of the queue, unless the object is complete.
+     */
+    uint32_t notReadyCount = 0;
+    Time nextReadyTime = Time::Max();
+
+    while (!connection.responses.empty())
+    {
+        const Time now = Simulator::Now();
+        PendingResponse& response = connection.responses.front();
+
+        if (!response.isSending)
+        {
+            if (response.readyTime > now)
+            {
+                nextReadyTime = std::min(nextReadyTime, response.readyTime);
+                notReadyCount++;
+                if (notReadyCount >= connection.responses.size())
+                {
+                    // None of the remaining objects is ready yet.
+                    if (Simulator::IsExpired(connection.eventServe))
+                    {
+                        connection.eventServe =
+                            Simulator::Schedule(nextReadyTime - now,
+                                                &ThreeGppHttpSatelliteServer::ServeFromQueue,
+                                                this,
+                                                socket);
+                    }
+                    return;
+                }
+
+                connection.responses.push_back(response);
+                connection.responses.pop_front();
+                continue;
+            }
+
+            StartResponse(response);
+        }
+
+        const bool isFirstFrame = (response.objectBytesToBeSent == response.objectSize);
+        const uint32_t overhead = streamHeaderSize + (isFirstFrame ? headerSize : 0);
+        const uint32_t txAvailable = socket->GetTxAvailable();
+        if (txAvailable <= overhead)
+        {
+            return; // wait for SendCallback()
+        }
+
+        const uint32_t frameContentLimit = m_frameSize - (isFirstFrame ? headerSize : 0);
+        const uint32_t contentSize = std::min(
+            {response.objectBytesToBeSent, frameContentLimit, txAvailable - overhead});
+        Ptr<Packet> packet = Create<Packet>(contentSize);
+
+        if (isFirstFrame)
+        {
+            ThreeGppHttpHeader httpHeader;
+            httpHeader.SetContentType(response.contentType);
+            httpHeader.SetContentLength(response.objectSize);
+            httpHeader.SetClientTs(response.clientTs);
+            httpHeader.SetServerTs(now);
+            packet->AddHeader(httpHeader);
+        }
+
+        ThreeGppHttpStreamHeader streamHeader;
+        streamHeader.SetStreamId(response.streamId);
+        streamHeader.SetFrameLength(packet->GetSize());
+        packet->AddHeader(streamHeader);
+
+        const uint32_t packetSize = packet->GetSize();
+        const int actualBytes = socket->Send(packet);
+        NS_LOG_DEBUG(this << " Send() frame " << packet << " of " << packetSize << " bytes"
+                          << " on stream " << response.streamId << ","
+                          << " return value= " << actualBytes << ".");
+
+        if (actualBytes != static_cast<int>(packetSize))
+        {
+            NS_LOG_WARN(this << " Failed to send a frame, GetErrNo= " << socket->GetErrno()
+                             << ", waiting for another Tx opportunity.");
+            return;
+        }
+
+        m_txTrace(packet);
+        response.objectBytesToBeSent -= contentSize;
+        notReadyCount = 0;
+        nextReadyTime = Time::Max();
+
+        if (response.objectBytesToBeSent == 0)
+        {
+            NS_LOG_INFO(this << " Finished sending an object of " << response.objectSize
+                             << " bytes on stream " << response.streamId << ".");
+        }
+        else
+        {
+            connection.responses.push_back(response);
+        }
+
+        connection.responses.pop_front();
+
+    } // end of `while (!connection.responses.empty ())`
+
+} // end of `void ServeFrames (Ptr<Socket> socket, ClientConnection &connection)`
+
+void
+ThreeGppHttpSatelliteServer::StartResponse(PendingResponse& response)
+{
+    NS_LOG_FUNCTION(this << response.contentType);
+
+    if (response.contentType == ThreeGppHttpHeader::MAIN_OBJECT)
+    {
+        response.objectSize = m_httpVariables->GetMainObjectSize();
+        m_mainObjectTrace(response.objectSize);
+    }
+    else
+    {
+        response.objectSize = m_httpVariables->GetEmbeddedObjectSize();
+        m_embeddedObjectTrace(response.objectSize);
+    }
+
+    response.objectBytesToBeSent = response.objectSize;
+    response.isSending = true;
+}
+
+void
+ThreeGppHttpSatelliteServer::RemoveConnection(Ptr<Socket> socket)
+{
+    NS_LOG_FUNCTION(this << socket);
+
+    auto it = m_connections.find(socket);
+    if (it != m_connections.end())
+    {
+        Simulator::Cancel(it->second.eventServe);
+        m_connections.erase(it);
+    }
+
+    socket->SetRecvCallback(MakeNullCallback<void, Ptr<Socket>>());
+    socket->SetSendCallback(MakeNullCallback<void, Ptr<Socket>, uint32_t>());
+}
+
+void
+ThreeGppHttpSatelliteServer::SwitchToState(ThreeGppHttpSatelliteServer::State_t state)
+{
+    NS_LOG_FUNCTION(this << GetStateString(m_state) << GetStateString(state));
+    NS_LOG_INFO(this << " ThreeGppHttpSatelliteServer " << GetStateString(m_state) << " --> "
+                     << GetStateString(state));
+    m_state = state;
+}
+
+} // namespace ns3
@@ -0,0 +1,260 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef THREE_GPP_HTTP_SATELLITE_SERVER_H
+#define THREE_GPP_HTTP_SATELLITE_SERVER_H
+
+#include "ns3/address.h"
+#include "ns3/application.h"
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+#include "ns3/three-gpp-http-header.h"
+#include "ns3/traced-callback.h"
+
+#include <deque>
+#include <map>
+#include <string>
+
+namespace ns3
+{
+
+class Socket;
+class Packet;
+class ThreeGppHttpSatelliteVariables;
+
+/**
+ * @ingroup http
+ * @brief Model application which simulates the traffic of a web server, for
+ *        use with ThreeGppHttpSatelliteClient.
+ *
+ * The server listens on a TCP port and accepts every connection request. Each
+ * request received from a client is answered with a main object or an
+ * embedded object, depending on the content type in its ThreeGppHttpHeader.
+ * The object size and the generation delay of each object are determined by
+ * ThreeGppHttpSatelliteVariables, like in ThreeGppHttpServer.
+ *
+ * Unlike ThreeGppHttpServer, the server keeps a queue of requests for each
+ * connection, so a client may send several requests without waiting for the
+ * responses (HTTP/1.1 pipelining, see the `RequestMode` attribute of
+ * ThreeGppHttpSatelliteClient). The requests are located in the byte stream
+ * with the content length of their ThreeGppHttpHeader, and the responses are
+ * sent in the order of the requests. A request with zero content length is
+ * assumed to span the whole received packet, as sent by ThreeGppHttpClient.
+ *
+ * The first packet of every object carries a ThreeGppHttpHeader with the
+ * object size as the content length, the time stamp of the request, and the
+ * time stamp of the beginning of the transmission.
+ *
+ * When the `Multiplexing` attribute is enabled, every request is expected to
+ * arrive in a frame preceded by a ThreeGppHttpStreamHeader, as sent by
+ * ThreeGppHttpSatelliteClient in MULTIPLEXED request mode. The responses are
+ * then cut into frames of at most `FrameSize` bytes, and the frames of all
+ * ready objects are interleaved round-robin on the connection, so that a
+ * large object does not hold back the smaller ones behind it.
+ */
+class ThreeGppHttpSatelliteServer : public Application
+{
+  public:
+    /**
+     * @brief Creates a new instance of HTTP server application.
+     *
+     * After creation, the application must be further configured through
+     * attributes. To avoid having to do this process manually, please use
+     * ThreeGppHttpSatelliteServerHelper.
+     */
+    ThreeGppHttpSatelliteServer();
+
+    // inherited from ObjectBase base class
+    static TypeId GetTypeId();
+
+    /**
+     * @return the address bound to the server
+     */
+    Address GetLocalAddress() const;
+
+    /**
+     * @return the port the server listens to
+     */
+    uint16_t GetLocalPort() const;
+
+    /// The possible states of the application.
+    enum State_t
+    {
+        NOT_STARTED = 0, ///< Before StartApplication() is invoked.
+        STARTED,         ///< Passively waiting for connections and/or actively serving objects.
+        STOPPED          ///< After StopApplication() is invoked.
+    };
+
+    /**
+     * @return the current state of the application
+     */
+    State_t GetState() const;
+
+    /**
+     * @return the current state of the application in string format
+     */
+    std::string GetStateString() const;
+
+    /**
+     * @param state an arbitrary state of an application
+     * @return the state equivalently expressed in string format
+     */
+    static std::string GetStateString(State_t state);
+
+    /**
+     * @brief Common callback signature for `ConnectionEstablished` trace source.
+     * @param httpServer Pointer to this instance of ThreeGppHttpSatelliteServer,
+     *                   which is where the trace originated.
+     * @param socket Pointer to the socket where the connection is established.
+     */
+    typedef void (*ConnectionEstablishedCallback)(Ptr<const ThreeGppHttpSatelliteServer> httpServer,
+                                                  Ptr<Socket> socket);
+
+    /**
+     * @brief Common callback signature for `MainObject` and `EmbeddedObject`
+     *        trace sources.
+     * @param size Size of the generated object in bytes.
+     */
+    typedef void (*HttpObjectCallback)(uint32_t size);
+
+  protected:
+    // Inherited from Object base class
+    virtual void DoDispose();
+
+    // Inherited from Application base class
+    virtual void StartApplication();
+    virtual void StopApplication();
+
+  private:
+    /// A request waiting to be answered.
+    struct PendingResponse
+    {
+        /// The type of the object requested.
+        ThreeGppHttpHeader::ContentType_t contentType;
+        /// The client time stamp of the request.
+        Time clientTs;
+        /// The time when the generation of the object is finished.
+        Time readyTime;
+        /// The stream of the request (only used with multiplexing).
+        uint32_t streamId;
+        /// True if the object is being sent.
+        bool isSending;
+        /// Size of the object.
+        uint32_t objectSize;
+        /// Remaining bytes of the object.
+        uint32_t objectBytesToBeSent;
+    };
+
+    /// State of a single accepted connection.
+    struct ClientConnection
+    {
+        /// Received bytes of an incomplete request header.
+        Ptr<Packet> rxBuffer;
+        /// Remaining content bytes of the current request, to be skipped.
+        uint32_t requestBytesToBeSkipped;
+        /// Requests waiting to be answered, in the order of arrival.
+        std::deque<PendingResponse> responses;
+        /// Pending ServeFromQueue() while the next object is being generated.
+        EventId eventServe;
+    };
+
+    // LISTENER SOCKET CALLBACK METHODS
+    bool ConnectionRequestCallback(Ptr<Socket> socket, const Address& address);
+    void NewConnectionCreatedCallback(Ptr<Socket> socket, const Address& address);
+
+    // ACCEPTED SOCKET CALLBACK METHODS
+    void NormalCloseCallback(Ptr<Socket> socket);
+    void ErrorCloseCallback(Ptr<Socket> socket);
+    void ReceivedDataCallback(Ptr<Socket> socket);
+    void SendCallback(Ptr<Socket> socket, uint32_t availableBufferSize);
+
+    /**
+     * @brief Parse as many requests as possible from the received bytes of a
+     *        connection and queue a response for each of them.
+     * @param socket the socket of the connection.
+     * @param connection the state of the connection.
+     * @param packet the received bytes.
+     * @param from the address of the client.
+     */
+    void ParseRequests(Ptr<Socket> socket,
+                       ClientConnection& connection,
+                       Ptr<Packet> packet,
+                       const Address& from);
+
+    /**
+     * @brief Send the queued responses of a connection in order, as far as the
+     *        transmit buffer of the socket allows.
+     * @param socket the socket of the connection.
+     *
+     * If the object at the head of the queue is still being generated, the
+     * method schedules itself to be invoked again when the object is ready.
+     */
+    void ServeFromQueue(Ptr<Socket> socket);
+
+    /**
+     * @brief Send frames of the ready responses of a connection in round-robin
+     *        order, as far as the transmit buffer of the socket allows.
+     * @param socket the socket of the connection.
+     * @param connection the state of the connection.
+     */
+    void ServeFrames(Ptr<Socket> socket, ClientConnection& connection);
+
+    /**
+     * @brief Generate the object of a response which is ready to be sent.
+     * @param response the response.
+     */
+    void StartResponse(PendingResponse& response);
+
+    /**
+     * @brief Remove an accepted connection and cancel its pending events.
+     * @param socket the socket of the connection.
+     */
+    void RemoveConnection(Ptr<Socket> socket);
+
+    void SwitchToState(State_t state);
+
+    State_t m_state;
+    Ptr<Socket> m_initialSocket;
+
+    /// The accepted connections, indexed by their sockets.
+    std::map<Ptr<Socket>, ClientConnection> m_connections;
+
+    // ATTRIBUTES
+
+    Ptr<ThreeGppHttpSatelliteVariables> m_httpVariables;
+    Address m_localAddress;
+    uint16_t m_localPort;
+    bool m_isMultiplexing;
+    uint32_t m_frameSize;
+
+    // TRACE SOURCES
+
+    TracedCallback<Ptr<const ThreeGppHttpSatelliteServer>, Ptr<Socket>>
+        m_connectionEstablishedTrace;
+    TracedCallback<uint32_t> m_mainObjectTrace;
+    TracedCallback<uint32_t> m_embeddedObjectTrace;
+    TracedCallback<Ptr<const Packet>> m_txTrace;
+    TracedCallback<Ptr<const Packet>, const Address&> m_rxTrace;
+    TracedCallback<const Time&, const Address&> m_rxDelayTrace;
+
+}; // end of `class ThreeGppHttpSatelliteServer`
+
+} // namespace ns3
+
+#endif /* THREE_GPP_HTTP_SATELLITE_SERVER_H */
@@ -0,0 +1,139 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "three-gpp-http-satellite-variables.h"
+
+#include "ns3/log.h"
+
+NS_LOG_COMPONENT_DEFINE("ThreeGppHttpSatelliteVariables");
+
+namespace ns3
+{
+
+NS_OBJECT_ENSURE_REGISTERED(ThreeGppHttpSatelliteVariables);
+
+ThreeGppHttpSatelliteVariables::ThreeGppHttpSatelliteVariables()
+    : m_workloadTape(WorkloadTape::GetActive()),
+      m_workloadKey(m_workloadTape == nullptr ? 0 : m_workloadTape->Register())
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TypeId
+ThreeGppHttpSatelliteVariables::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::ThreeGppHttpSatelliteVariables")
+                            .SetParent<ThreeGppHttpVariables>()
+                            .AddConstructor<ThreeGppHttpSatelliteVariables>();
+    return tid;
+}
+
+uint32_t
+ThreeGppHttpSatelliteVariables::GetMtuSize()
+{
+    return GetWorkloadValue(WORKLOAD_MTU_SIZE);
+}
+
+uint32_t
+ThreeGppHttpSatelliteVariables::GetMainObjectSize()
+{
+    return GetWorkloadValue(WORKLOAD_MAIN_OBJECT_SIZE);
+}
+
+uint32_t
+ThreeGppHttpSatelliteVariables::GetEmbeddedObjectSize()
+{
+    return GetWorkloadValue(WORKLOAD_EMBEDDED_OBJECT_SIZE);
+}
+
+uint32_t
+ThreeGppHttpSatelliteVariables::GetNumOfEmbeddedObjects()
+{
+    return GetWorkloadValue(WORKLOAD_NUM_OF_EMBEDDED_OBJECTS);
+}
+
+Time
+ThreeGppHttpSatelliteVariables::GetReadingTime()
+{
+    return NanoSeconds(GetWorkloadValue(WORKLOAD_READING_TIME));
+}
+
+Time
+ThreeGppHttpSatelliteVariables::GetParsingTime()
+{
+    return NanoSeconds(GetWorkloadValue(WORKLOAD_PARSING_TIME));
+}
+
+int64_t
+ThreeGppHttpSatelliteVariables::DrawWorkloadValue(WorkloadChannel_t channel)
+{
+    switch (channel)
+    {
+    case ThreeGppHttpSatelliteVariables::WORKLOAD_MTU_SIZE:
+        return ThreeGppHttpVariables::GetMtuSize();
+    case ThreeGppHttpSatelliteVariables::WORKLOAD_MAIN_OBJECT_SIZE:
+        return ThreeGppHttpVariables::GetMainObjectSize();
+    case ThreeGppHttpSatelliteVariables::WORKLOAD_EMBEDDED_OBJECT_SIZE:
+        return ThreeGppHttpVariables::GetEmbeddedObjectSize();
+    case ThreeGppHttpSatelliteVariables::WORKLOAD_NUM_OF_EMBEDDED_OBJECTS:
+        return ThreeGppHttpVariables::GetNumOfEmbeddedObjects();
+    case ThreeGppHttpSatelliteVariables::WORKLOAD_READING_TIME:
+        return ThreeGppHttpVariables::GetReadingTime().GetNanoSeconds();
+    case ThreeGppHttpSatelliteVariables::WORKLOAD_PARSING_TIME:
+        return ThreeGppHttpVariables::GetParsingTime().GetNanoSeconds();
+    default:
+        NS_FATAL_ERROR("Invalid workload channel " << channel);
+        break;
+    }
+
+    return 0;
+}
+
+void
+ThreeGppHttpSatelliteVariables::AppendPregeneratedWorkload(WorkloadChannel_t channel,
+                                                           const std::vector<int64_t>& values)
+{
+    NS_LOG_FUNCTION(this << channel << values.size());
+    m_pregenerated.Append(channel, values);
+}
+
+int64_t
+ThreeGppHttpSatelliteVariables::GetWorkloadValue(WorkloadChannel_t channel)
+{
+    int64_t value;
+
+    if ((m_workloadTape != nullptr) && m_workloadTape->Replay(m_workloadKey, channel, value))
+    {
+        return value;
+    }
+
+    if (!m_pregenerated.Pop(channel, value))
+    {
+        value = DrawWorkloadValue(channel);
+    }
+
+    if (m_workloadTape != nullptr)
+    {
+        m_workloadTape->Capture(m_workloadKey, channel, value);
+    }
+
+    return value;
+}
+
+} // end of `namespace ns3`
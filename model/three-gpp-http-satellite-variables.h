@@ -0,0 +1,129 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef THREE_GPP_HTTP_SATELLITE_VARIABLES_H
+#define THREE_GPP_HTTP_SATELLITE_VARIABLES_H
+
+#include "workload-tape.h"
+
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/three-gpp-http-variables.h"
+
+#include <stdint.h>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup traffic
+ * @brief ThreeGppHttpVariables whose random values can be recorded and played
+ *        back by WorkloadTape, or generated in advance by WorkloadPregenerator.
+ *
+ * This is the variables class used by ThreeGppHttpSatelliteClient and
+ * ThreeGppHttpSatelliteServer. The distributions and their attributes are
+ * inherited unchanged from ThreeGppHttpVariables; only the getters of the
+ * non-constant values listed in WorkloadChannel_t are replaced, so that they
+ * consult the tape and the pre-generated values before drawing a new value
+ * from the parent class.
+ *
+ * The getters of ThreeGppHttpVariables are not virtual. The replaced getters
+ * therefore take effect only when they are called through a pointer to this
+ * class, as the satellite client and server do.
+ */
+class ThreeGppHttpSatelliteVariables : public ThreeGppHttpVariables
+{
+  public:
+    /**
+     * @brief Channels under which the drawn values are recorded by WorkloadTape.
+     */
+    typedef enum
+    {
+        WORKLOAD_MTU_SIZE = 0,
+        WORKLOAD_MAIN_OBJECT_SIZE,
+        WORKLOAD_EMBEDDED_OBJECT_SIZE,
+        WORKLOAD_NUM_OF_EMBEDDED_OBJECTS,
+        WORKLOAD_READING_TIME,
+        WORKLOAD_PARSING_TIME
+    } WorkloadChannel_t;
+
+    /// Creates a new instance and registers it with the active WorkloadTape.
+    ThreeGppHttpSatelliteVariables();
+
+    /**
+     * @brief Returns the object TypeId.
+     * @return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /// @return the MTU size, in bytes.
+    uint32_t GetMtuSize();
+
+    /// @return the size of a main object, in bytes.
+    uint32_t GetMainObjectSize();
+
+    /// @return the size of an embedded object, in bytes.
+    uint32_t GetEmbeddedObjectSize();
+
+    /// @return the number of embedded objects in a web page.
+    uint32_t GetNumOfEmbeddedObjects();
+
+    /// @return the length of the reading time.
+    Time GetReadingTime();
+
+    /// @return the length of the parsing time.
+    Time GetParsingTime();
+
+    /**
+     * @brief Draw a new value of a workload channel from the random number
+     *        generators, bypassing WorkloadTape and any pre-generated values.
+     * @param channel the channel.
+     * @return the value, with times in nanoseconds.
+     */
+    int64_t DrawWorkloadValue(WorkloadChannel_t channel);
+
+    /**
+     * @brief Store values to be returned by the getter of a channel before
+     *        any new value is drawn (see WorkloadPregenerator).
+     * @param channel the channel.
+     * @param values the values, with times in nanoseconds.
+     */
+    void AppendPregeneratedWorkload(WorkloadChannel_t channel,
+                                    const std::vector<int64_t>& values);
+
+  private:
+    /**
+     * @brief Get the next value of a channel: from the WorkloadTape if it is
+     *        replaying, otherwise from the pre-generated values or the random
+     *        number generators.
+     * @param channel the channel.
+     * @return the value, with times in nanoseconds.
+     */
+    int64_t GetWorkloadValue(WorkloadChannel_t channel);
+
+    Ptr<WorkloadTape> m_workloadTape; ///< Null if the tape is off.
+    uint32_t m_workloadKey;           ///< Key of this instance in #m_workloadTape.
+    WorkloadBuffer m_pregenerated;    ///< Values from WorkloadPregenerator.
+
+}; // end of `class ThreeGppHttpSatelliteVariables`
+
+} // end of `namespace ns3`
+
+#endif /* THREE_GPP_HTTP_SATELLITE_VARIABLES_H */
@@ -0,0 +1,118 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "three-gpp-http-stream-header.h"
+
+#include "ns3/log.h"
+
+#include <ostream>
+
+NS_LOG_COMPONENT_DEFINE("ThreeGppHttpStreamHeader");
+
+namespace ns3
+{
+
+NS_OBJECT_ENSURE_REGISTERED(ThreeGppHttpStreamHeader);
+
+ThreeGppHttpStreamHeader::ThreeGppHttpStreamHeader()
+    : m_streamId(0),
+      m_frameLength(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TypeId
+ThreeGppHttpStreamHeader::GetTypeId(void)
+{
+    static TypeId tid = TypeId("ns3::ThreeGppHttpStreamHeader")
+                            .SetParent<Header>()
+                            .AddConstructor<ThreeGppHttpStreamHeader>();
+    return tid;
+}
+
+void
+ThreeGppHttpStreamHeader::SetStreamId(uint32_t streamId)
+{
+    NS_LOG_FUNCTION(this << streamId);
+    m_streamId = streamId;
+}
+
+uint32_t
+ThreeGppHttpStreamHeader::GetStreamId() const
+{
+    return m_streamId;
+}
+
+void
+ThreeGppHttpStreamHeader::SetFrameLength(uint32_t frameLength)
+{
+    NS_LOG_FUNCTION(this << frameLength);
+    m_frameLength = frameLength;
+}
+
+uint32_t
+ThreeGppHttpStreamHeader::GetFrameLength() const
+{
+    return m_frameLength;
+}
+
+uint32_t
+ThreeGppHttpStreamHeader::GetStaticSerializedSize()
+{
+    return 8;
+}
+
+uint32_t
+ThreeGppHttpStreamHeader::GetSerializedSize() const
+{
+    return GetStaticSerializedSize();
+}
+
+void
+ThreeGppHttpStreamHeader::Print(std::ostream& os) const
+{
+    os << "(streamId: " << m_streamId << " frameLength: " << m_frameLength << ")";
+}
+
+void
+ThreeGppHttpStreamHeader::Serialize(Buffer::Iterator start) const
+{
+    NS_LOG_FUNCTION(this << &start);
+    Buffer::Iterator i = start;
+    i.WriteHtonU32(m_streamId);
+    i.WriteHtonU32(m_frameLength);
+}
+
+uint32_t
+ThreeGppHttpStreamHeader::Deserialize(Buffer::Iterator start)
+{
+    NS_LOG_FUNCTION(this << &start);
+    Buffer::Iterator i = start;
+    m_streamId = i.ReadNtohU32();
+    m_frameLength = i.ReadNtohU32();
+    return GetSerializedSize();
+}
+
+TypeId
+ThreeGppHttpStreamHeader::GetInstanceTypeId() const
+{
+    return GetTypeId();
+}
+
+} // namespace ns3
@@ -0,0 +1,105 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef THREE_GPP_HTTP_STREAM_HEADER_H
+#define THREE_GPP_HTTP_STREAM_HEADER_H
+
+#include "ns3/header.h"
+
+#include <ostream>
+
+namespace ns3
+{
+
+/**
+ * @ingroup http
+ * @brief Frame header of the multiplexed (HTTP/2-like) mode of
+ *        ThreeGppHttpSatelliteClient and ThreeGppHttpSatelliteServer.
+ *
+ * The header is 8 bytes in length. There are 2 fields in the header:
+ * - stream ID (4 bytes), which identifies the request and response pair the
+ *   frame belongs to; and
+ * - frame length (4 bytes), i.e., the number of bytes following the header
+ *   which belong to the frame.
+ *
+ * In multiplexed mode, every request and every part of a response is sent as a
+ * frame over the single connection. The first frame of each response carries
+ * the ThreeGppHttpHeader of the object, the following frames carry only object
+ * content. Frames of different streams are interleaved, so a small object is
+ * not blocked behind a large one.
+ *
+ * Make sure a packet is at least GetStaticSerializedSize() bytes long before
+ * invoking Packet::RemoveHeader() or Packet::PeekHeader() with this header.
+ */
+class ThreeGppHttpStreamHeader : public Header
+{
+  public:
+    /// Create a plain new instance of stream header.
+    ThreeGppHttpStreamHeader();
+
+    // Inherited from ObjectBase base class
+    static TypeId GetTypeId(void);
+
+    /**
+     * @param streamId the value for the "stream ID" field of this header
+     *                 instance
+     */
+    void SetStreamId(uint32_t streamId);
+
+    /**
+     * @return the current value of the "stream ID" field of this header
+     *         instance
+     */
+    uint32_t GetStreamId() const;
+
+    /**
+     * @param frameLength the value for the "frame length" field of this header
+     *                    instance
+     */
+    void SetFrameLength(uint32_t frameLength);
+
+    /**
+     * @return the current value of the "frame length" field of this header
+     *         instance
+     */
+    uint32_t GetFrameLength() const;
+
+    /**
+     * @return the size of the header in bytes, without an instance
+     */
+    static uint32_t GetStaticSerializedSize();
+
+    // Inherited from Header base class
+    virtual uint32_t GetSerializedSize() const;
+    virtual void Serialize(Buffer::Iterator start) const;
+    virtual uint32_t Deserialize(Buffer::Iterator start);
+    virtual void Print(std::ostream& os) const;
+
+    // Inherited from ObjectBase base class
+    virtual TypeId GetInstanceTypeId() const;
+
+  private:
+    uint32_t m_streamId;    ///< Stream ID field.
+    uint32_t m_frameLength; ///< Frame length field.
+
+}; // end of `class ThreeGppHttpStreamHeader`
+
+} // namespace ns3
+
+#endif /* THREE_GPP_HTTP_STREAM_HEADER_H */
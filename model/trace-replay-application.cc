@@ -0,0 +1,264 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "trace-replay-application.h"
+
+#include "trace-replay-file.h"
+#include "traffic-time-tag.h"
+
+#include "ns3/boolean.h"
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/socket.h"
+#include "ns3/string.h"
+#include "ns3/trace-source-accessor.h"
+#include "ns3/udp-socket-factory.h"
+#include "ns3/uinteger.h"
+
+NS_LOG_COMPONENT_DEFINE("TraceReplayApplication");
+
+namespace ns3
+{
+
+NS_OBJECT_ENSURE_REGISTERED(TraceReplayApplication);
+
+TraceReplayApplication::TraceReplayApplication()
+    : m_firstRecord(0),
+      m_readAhead(4096),
+      m_isStatisticsTagsEnabled(false),
+      m_readPosition(0),
+      m_prefetchPosition(0),
+      m_totTxBytes(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TraceReplayApplication::~TraceReplayApplication()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TypeId
+TraceReplayApplication::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::TraceReplayApplication")
+            .SetParent<Application>()
+            .AddConstructor<TraceReplayApplication>()
+            .AddAttribute("TraceFile",
+                          "Path to the binary trace file to be replayed. Ignored if the trace "
+                          "has been given by SetTraceFile().",
+                          StringValue(""),
+                          MakeStringAccessor(&TraceReplayApplication::m_traceFilePath),
+                          MakeStringChecker())
+            .AddAttribute("Remote",
+                          "The address of the destination.",
+                          AddressValue(),
+                          MakeAddressAccessor(&TraceReplayApplication::m_remote),
+                          MakeAddressChecker())
+            .AddAttribute("Protocol",
+                          "The type of protocol to use.",
+                          TypeIdValue(UdpSocketFactory::GetTypeId()),
+                          MakeTypeIdAccessor(&TraceReplayApplication::m_protocol),
+                          MakeTypeIdChecker())
+            .AddAttribute("FirstRecord",
+                          "Index of the first record to be replayed.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&TraceReplayApplication::m_firstRecord),
+                          MakeUintegerChecker<uint64_t>())
+            .AddAttribute("TimeShift",
+                          "Delay between the start of the application and the transmission "
+                          "of the first replayed record.",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&TraceReplayApplication::m_timeShift),
+                          MakeTimeChecker())
+            .AddAttribute("ReadAhead",
+                          "Number of records paged in ahead of the read position.",
+                          UintegerValue(4096),
+                          MakeUintegerAccessor(&TraceReplayApplication::m_readAhead),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("EnableStatisticsTags",
+                          "If true, some tags will be added to each transmitted packet to assist "
+                          "with statistics computation",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&TraceReplayApplication::m_isStatisticsTagsEnabled),
+                          MakeBooleanChecker())
+            .AddTraceSource("Tx",
+                            "A new packet is created and is sent",
+                            MakeTraceSourceAccessor(&TraceReplayApplication::m_txTrace),
+                            "ns3::Packet::TracedCallback");
+    return tid;
+}
+
+void
+TraceReplayApplication::SetTraceFile(Ptr<TraceReplayFile> file)
+{
+    NS_LOG_FUNCTION(this << file->GetPath());
+    m_file = file;
+}
+
+Ptr<TraceReplayFile>
+TraceReplayApplication::GetTraceFile() const
+{
+    return m_file;
+}
+
+Ptr<Socket>
+TraceReplayApplication::GetSocket() const
+{
+    return m_socket;
+}
+
+uint64_t
+TraceReplayApplication::GetSent() const
+{
+    return m_totTxBytes;
+}
+
+void
+TraceReplayApplication::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+
+    m_eventSendRecord.Cancel();
+    m_socket = nullptr;
+    m_file = nullptr; // releases the mapping if this was the last user
+    Application::DoDispose();
+}
+
+void
+TraceReplayApplication::StartApplication()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (m_file == nullptr)
+    {
+        if (m_traceFilePath.empty())
+        {
+            NS_FATAL_ERROR("No trace file has been given to " << this);
+        }
+
+        m_file = TraceReplayFile::Open(m_traceFilePath);
+    }
+
+    if (m_firstRecord >= m_file->GetNRecords())
+    {
+        NS_LOG_WARN(this << " first record " << m_firstRecord << " is beyond the end of "
+                         << m_file->GetPath() << ", nothing to replay");
+        return;
+    }
+
+    if (m_socket == nullptr)
+    {
+        m_socket = Socket::CreateSocket(GetNode(), m_protocol);
+        m_socket->Bind();
+        m_socket->SetConnectCallback(
+            MakeCallback(&TraceReplayApplication::ConnectionSucceededCallback, this),
+            MakeCallback(&TraceReplayApplication::ConnectionFailedCallback, this));
+        m_socket->Connect(m_remote);
+        m_socket->SetAllowBroadcast(true);
+        m_socket->ShutdownRecv();
+    }
+
+} // end of `void StartApplication ()`
+
+void
+TraceReplayApplication::StopApplication()
+{
+    NS_LOG_FUNCTION(this);
+
+    m_eventSendRecord.Cancel();
+
+    if (m_socket != nullptr)
+    {
+        m_socket->Close();
+    }
+}
+
+void
+TraceReplayApplication::ConnectionSucceededCallback(Ptr<Socket> socket)
+{
+    NS_LOG_FUNCTION(this << socket);
+
+    m_readPosition = m_firstRecord;
+    m_prefetchPosition = m_firstRecord;
+    m_replayStartTime = Simulator::Now() + m_timeShift - m_file->GetTime(m_firstRecord);
+    m_eventSendRecord.Cancel();
+    ScheduleNextRecord();
+}
+
+void
+TraceReplayApplication::ConnectionFailedCallback(Ptr<Socket> socket)
+{
+    NS_LOG_FUNCTION(this << socket);
+    NS_LOG_WARN(this << " unable to connect, the trace will not be replayed");
+}
+
+void
+TraceReplayApplication::ScheduleNextRecord()
+{
+    if (m_readPosition >= m_file->GetNRecords())
+    {
+        NS_LOG_INFO(this << " reached the end of " << m_file->GetPath() << " after sending "
+                         << m_totTxBytes << " bytes");
+        return;
+    }
+
+    // Keep one window of records paged in ahead of the read position.
+    if (m_readPosition + m_readAhead > m_prefetchPosition)
+    {
+        m_file->Prefetch(m_prefetchPosition, m_readAhead);
+        m_prefetchPosition += m_readAhead;
+    }
+
+    Time delay = m_replayStartTime + m_file->GetTime(m_readPosition) - Simulator::Now();
+    if (delay.IsNegative())
+    {
+        delay = Seconds(0);
+    }
+
+    m_eventSendRecord = Simulator::Schedule(delay, &TraceReplayApplication::SendRecord, this);
+}
+
+void
+TraceReplayApplication::SendRecord()
+{
+    const uint32_t size = m_file->GetSize(m_readPosition);
+    m_readPosition++;
+
+    if (size > 0)
+    {
+        Ptr<Packet> packet = Create<Packet>(size);
+
+        if (m_isStatisticsTagsEnabled)
+        {
+            packet->AddPacketTag(TrafficTimeTag(Simulator::Now()));
+        }
+
+        m_txTrace(packet);
+        m_socket->Send(packet);
+        m_totTxBytes += size;
+    }
+
+    ScheduleNextRecord();
+}
+
+} // end of `namespace ns3`
@@ -0,0 +1,170 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef TRACE_REPLAY_APPLICATION_H
+#define TRACE_REPLAY_APPLICATION_H
+
+#include "ns3/address.h"
+#include "ns3/application.h"
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/traced-callback.h"
+
+#include <stdint.h>
+#include <string>
+
+namespace ns3
+{
+
+class Socket;
+class Packet;
+class TraceReplayFile;
+
+/**
+ * @ingroup traffic
+ * @brief Send packets to a single destination according to a recorded trace.
+ *
+ * The packet sizes and send times are taken from a binary trace file (see
+ * TraceReplayFile), which is given either by its path in the `TraceFile`
+ * attribute or directly by SetTraceFile(). Applications replaying the same
+ * file share one read-only memory mapping of it.
+ *
+ * Replay begins at the record given by the `FirstRecord` attribute, which is
+ * sent `TimeShift` after the application has started (and the socket has
+ * connected). The following records keep their relative timing from the
+ * trace. Only one record is read at a time, just before it is sent, and the
+ * next `ReadAhead` records are paged in ahead of the read position, so the
+ * trace is streamed rather than loaded. The application stops sending at the
+ * end of the trace.
+ */
+class TraceReplayApplication : public Application
+{
+  public:
+    /// Creates a new instance of trace replay application.
+    TraceReplayApplication();
+
+    /// Destructor.
+    virtual ~TraceReplayApplication();
+
+    /**
+     * @brief Returns the object TypeId.
+     * @return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * @brief Use an already opened trace instead of the `TraceFile` attribute.
+     * @param file the trace to be replayed.
+     */
+    void SetTraceFile(Ptr<TraceReplayFile> file);
+
+    /**
+     * @return the trace being replayed, or a null pointer if the trace has
+     *         not been opened yet.
+     */
+    Ptr<TraceReplayFile> GetTraceFile() const;
+
+    /**
+     * @return the associated socket.
+     */
+    Ptr<Socket> GetSocket() const;
+
+    /**
+     * @return the number of bytes sent so far.
+     */
+    uint64_t GetSent() const;
+
+  protected:
+    // Inherited from Object base class
+    virtual void DoDispose();
+
+    // Inherited from Application base class
+    virtual void StartApplication();
+    virtual void StopApplication();
+
+  private:
+    /**
+     * @brief Invoked when the socket has connected. Starts the replay.
+     * @param socket pointer to the socket.
+     */
+    void ConnectionSucceededCallback(Ptr<Socket> socket);
+
+    /**
+     * @brief Invoked when the socket has failed to connect.
+     * @param socket pointer to the socket.
+     */
+    void ConnectionFailedCallback(Ptr<Socket> socket);
+
+    /// Schedule the transmission of the record at the read position.
+    void ScheduleNextRecord();
+
+    /// Send the record at the read position and advance the position.
+    void SendRecord();
+
+    /// `TraceFile` attribute.
+    std::string m_traceFilePath;
+
+    /// The trace being replayed.
+    Ptr<TraceReplayFile> m_file;
+
+    /// `Remote` attribute.
+    Address m_remote;
+
+    /// `Protocol` attribute.
+    TypeId m_protocol;
+
+    /// `FirstRecord` attribute.
+    uint64_t m_firstRecord;
+
+    /// `TimeShift` attribute.
+    Time m_timeShift;
+
+    /// `ReadAhead` attribute.
+    uint32_t m_readAhead;
+
+    /// `EnableStatisticsTags` attribute.
+    bool m_isStatisticsTagsEnabled;
+
+    /// The associated socket.
+    Ptr<Socket> m_socket;
+
+    /// Index of the next record to be sent.
+    uint64_t m_readPosition;
+
+    /// Index of the first record which has not been prefetched yet.
+    uint64_t m_prefetchPosition;
+
+    /// Simulation time corresponding to the time of the first record.
+    Time m_replayStartTime;
+
+    /// Number of bytes sent so far.
+    uint64_t m_totTxBytes;
+
+    /// Pending invocation of SendRecord().
+    EventId m_eventSendRecord;
+
+    /// `Tx` trace source.
+    TracedCallback<Ptr<const Packet>> m_txTrace;
+
+}; // end of `class TraceReplayApplication`
+
+} // end of `namespace ns3`
+
+#endif /* TRACE_REPLAY_APPLICATION_H */
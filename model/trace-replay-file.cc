@@ -0,0 +1,290 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "trace-replay-file.h"
+
+#include "ns3/log.h"
+
+#include <cmath>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+NS_LOG_COMPONENT_DEFINE("TraceReplayFile");
+
+namespace ns3
+{
+
+/// Magic string at the beginning of every binary trace file.
+static const char TRACE_REPLAY_MAGIC[8] = {'N', 'S', '3', 'T', 'R', 'P', 'L', '1'};
+
+/**
+ * @return the registry of the currently alive mappings, indexed by path.
+ */
+static std::map<std::string, TraceReplayFile*>&
+GetTraceReplayFileRegistry()
+{
+    static std::map<std::string, TraceReplayFile*> registry;
+    return registry;
+}
+
+Ptr<TraceReplayFile> // static
+TraceReplayFile::Open(const std::string& path)
+{
+    NS_LOG_FUNCTION(path);
+
+    std::map<std::string, TraceReplayFile*>& registry = GetTraceReplayFileRegistry();
+    std::map<std::string, TraceReplayFile*>::iterator it = registry.find(path);
+
+    if (it != registry.end())
+    {
+        NS_LOG_INFO("Sharing the existing mapping of " << path);
+        return Ptr<TraceReplayFile>(it->second);
+    }
+
+    Ptr<TraceReplayFile> file = Create<TraceReplayFile>(path);
+    registry[path] = PeekPointer(file);
+    return file;
+}
+
+uint64_t // static
+TraceReplayFile::ConvertFromText(std::istream& input, const std::string& outputPath)
+{
+    NS_LOG_FUNCTION(outputPath);
+
+    std::ofstream output(outputPath.c_str(), std::ios::binary | std::ios::trunc);
+    if (!output.is_open())
+    {
+        NS_FATAL_ERROR("Unable to open " << outputPath << " for writing");
+    }
+
+    // The number of records is written again once it is known.
+    uint64_t nRecords = 0;
+    output.write(TRACE_REPLAY_MAGIC, sizeof(TRACE_REPLAY_MAGIC));
+    output.write(reinterpret_cast<const char*>(&nRecords), sizeof(nRecords));
+
+    std::string line;
+    uint64_t lineNumber = 0;
+    double firstTime = 0.0;
+    uint64_t lastTimeNs = 0;
+
+    while (std::getline(input, line))
+    {
+        lineNumber++;
+
+        if (line.empty() || line[0] == '#')
+        {
+            continue;
+        }
+
+        for (std::string::iterator it = line.begin(); it != line.end(); ++it)
+        {
+            if (*it == ',' || *it == ';')
+            {
+                *it = ' ';
+            }
+        }
+
+        std::istringstream iss(line);
+        double time;
+        double size;
+        if (!(iss >> time >> size))
+        {
+            NS_LOG_INFO("Skipping line " << lineNumber << " of the text trace");
+            continue;
+        }
+
+        if (!(size >= 0.0 && size <= 4294967295.0))
+        {
+            NS_LOG_WARN("Skipping line " << lineNumber << " of the text trace,"
+                                         << " invalid packet size " << size);
+            continue;
+        }
+
+        if (nRecords == 0)
+        {
+            firstTime = time;
+        }
+
+        const bool isAfterFirst = (time >= firstTime);
+        const uint64_t timeNs =
+            isAfterFirst ? static_cast<uint64_t>(std::llround((time - firstTime) * 1000000000.0))
+                         : 0;
+        if (!isAfterFirst || timeNs < lastTimeNs)
+        {
+            NS_LOG_WARN("Skipping line " << lineNumber << " of the text trace,"
+                                         << " timestamp " << time << " is earlier than"
+                                         << " the previous one");
+            continue;
+        }
+
+        const uint32_t sizeBytes = static_cast<uint32_t>(size);
+
+        output.write(reinterpret_cast<const char*>(&timeNs), sizeof(timeNs));
+        output.write(reinterpret_cast<const char*>(&sizeBytes), sizeof(sizeBytes));
+        lastTimeNs = timeNs;
+        nRecords++;
+    }
+
+    output.seekp(sizeof(TRACE_REPLAY_MAGIC));
+    output.write(reinterpret_cast<const char*>(&nRecords), sizeof(nRecords));
+
+    if (!output.good())
+    {
+        NS_FATAL_ERROR("Error while writing " << outputPath);
+    }
+
+    NS_LOG_INFO("Converted " << nRecords << " records into " << outputPath);
+    return nRecords;
+
+} // end of `uint64_t ConvertFromText (std::istream &, const std::string &)`
+
+TraceReplayFile::TraceReplayFile(const std::string& path)
+    : m_path(path),
+      m_data(nullptr),
+      m_length(0),
+      m_nRecords(0)
+{
+    NS_LOG_FUNCTION(this << path);
+
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        NS_FATAL_ERROR("Unable to open trace file " << path);
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(HEADER_SIZE))
+    {
+        close(fd);
+        NS_FATAL_ERROR("Trace file " << path << " is too short");
+    }
+
+    m_length = static_cast<uint64_t>(st.st_size);
+    void* addr = mmap(nullptr, m_length, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd); // the mapping stays valid after the descriptor is closed
+
+    if (addr == MAP_FAILED)
+    {
+        NS_FATAL_ERROR("Unable to map trace file " << path);
+    }
+
+    m_data = static_cast<uint8_t*>(addr);
+
+    if (std::memcmp(m_data, TRACE_REPLAY_MAGIC, sizeof(TRACE_REPLAY_MAGIC)) != 0)
+    {
+        NS_FATAL_ERROR(path << " is not a binary trace file,"
+                            << " see TraceReplayFile::ConvertFromText()");
+    }
+
+    std::memcpy(&m_nRecords, m_data + sizeof(TRACE_REPLAY_MAGIC), sizeof(m_nRecords));
+    // Compared by division, as a corrupt record count may overflow the product.
+    if (m_nRecords > (m_length - HEADER_SIZE) / RECORD_SIZE)
+    {
+        NS_FATAL_ERROR("Trace file " << path << " is truncated");
+    }
+
+    // Records are mostly read front to back.
+    madvise(m_data, m_length, MADV_SEQUENTIAL);
+
+    NS_LOG_INFO(this << " mapped " << m_nRecords << " records from " << path);
+
+} // end of `TraceReplayFile (const std::string &)`
+
+TraceReplayFile::~TraceReplayFile()
+{
+    NS_LOG_FUNCTION(this);
+
+    std::map<std::string, TraceReplayFile*>& registry = GetTraceReplayFileRegistry();
+    std::map<std::string, TraceReplayFile*>::iterator it = registry.find(m_path);
+    if (it != registry.end() && it->second == this)
+    {
+        registry.erase(it);
+    }
+
+    if (m_data != nullptr)
+    {
+        munmap(m_data, m_length);
+    }
+}
+
+std::string
+TraceReplayFile::GetPath() const
+{
+    return m_path;
+}
+
+uint64_t
+TraceReplayFile::GetNRecords() const
+{
+    return m_nRecords;
+}
+
+Time
+TraceReplayFile::GetTime(uint64_t index) const
+{
+    uint64_t timeNs;
+    std::memcpy(&timeNs, GetRecord(index), sizeof(timeNs));
+    return NanoSeconds(static_cast<int64_t>(timeNs));
+}
+
+uint32_t
+TraceReplayFile::GetSize(uint64_t index) const
+{
+    uint32_t size;
+    std::memcpy(&size, GetRecord(index) + sizeof(uint64_t), sizeof(size));
+    return size;
+}
+
+void
+TraceReplayFile::Prefetch(uint64_t first, uint64_t count) const
+{
+    NS_LOG_FUNCTION(this << first << count);
+
+    if (first >= m_nRecords || count == 0)
+    {
+        return;
+    }
+
+    if (count > m_nRecords - first)
+    {
+        count = m_nRecords - first;
+    }
+
+    // madvise() requires a page-aligned start address.
+    static const uint64_t pageSize = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+    const uint64_t begin = HEADER_SIZE + first * RECORD_SIZE;
+    const uint64_t end = begin + count * RECORD_SIZE;
+    const uint64_t alignedBegin = begin - (begin % pageSize);
+    madvise(m_data + alignedBegin, end - alignedBegin, MADV_WILLNEED);
+}
+
+const uint8_t*
+TraceReplayFile::GetRecord(uint64_t index) const
+{
+    NS_ASSERT_MSG(index < m_nRecords, "Record " << index << " is out of range");
+    return m_data + HEADER_SIZE + index * RECORD_SIZE;
+}
+
+} // end of `namespace ns3`
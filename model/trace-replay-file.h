@@ -0,0 +1,151 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef TRACE_REPLAY_FILE_H
+#define TRACE_REPLAY_FILE_H
+
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+
+#include <istream>
+#include <stdint.h>
+#include <string>
+
+namespace ns3
+{
+
+/**
+ * @ingroup traffic
+ * @brief Read-only, memory-mapped packet trace used by TraceReplayApplication.
+ *
+ * The trace file is a compact binary file, consisting of a 16-byte file header
+ * followed by fixed-size 12-byte records:
+ * - file header: the magic string `NS3TRPL1` (8 bytes) and the number of
+ *   records (8 bytes);
+ * - record: the time of the packet in nanoseconds, relative to the first
+ *   record (8 bytes), and the size of the packet in bytes (4 bytes).
+ *
+ * The integers are stored in the byte order of the machine which wrote the
+ * file, and the records are sorted by time. Such a file is produced from a
+ * text trace by ConvertFromText().
+ *
+ * The file is mapped into memory rather than parsed, so opening even a
+ * multi-gigabyte trace is immediate and the records are only paged in when
+ * they are read. Use Open() to obtain an instance: every caller asking for
+ * the same path while a previous instance is still alive gets that instance,
+ * so any number of applications share one mapping. The mapping is released
+ * when the last reference disappears.
+ */
+class TraceReplayFile : public SimpleRefCount<TraceReplayFile>
+{
+  public:
+    /**
+     * @brief Map the given trace file, or return the existing mapping of it.
+     * @param path path to a binary trace file.
+     * @return the shared mapping of the file.
+     */
+    static Ptr<TraceReplayFile> Open(const std::string& path);
+
+    /**
+     * @brief Convert a text trace into a binary trace file.
+     * @param input the text trace.
+     * @param outputPath path of the binary trace file to be written.
+     * @return the number of records written.
+     *
+     * Each line of the text trace holds a timestamp in seconds and a packet
+     * size in bytes, separated by a comma or white space, e.g., as produced by
+     * `tshark -T fields -e frame.time_relative -e frame.len`. Empty lines,
+     * lines starting with `#`, and lines which do not start with two numbers
+     * (e.g., a CSV heading) are skipped. So are the lines with a negative or
+     * too large packet size, and the lines whose timestamp is earlier than the
+     * one of the previous record, each of them with a warning in the log. The
+     * timestamps are stored relative to the first record.
+     */
+    static uint64_t ConvertFromText(std::istream& input, const std::string& outputPath);
+
+    /**
+     * @brief Map the given trace file. Prefer Open(), which shares mappings.
+     * @param path path to a binary trace file.
+     */
+    TraceReplayFile(const std::string& path);
+
+    /// Unmap the file.
+    ~TraceReplayFile();
+
+    /**
+     * @return the path of the mapped file.
+     */
+    std::string GetPath() const;
+
+    /**
+     * @return the number of records in the trace.
+     */
+    uint64_t GetNRecords() const;
+
+    /**
+     * @param index the index of a record.
+     * @return the time of the record, relative to the first record.
+     */
+    Time GetTime(uint64_t index) const;
+
+    /**
+     * @param index the index of a record.
+     * @return the packet size of the record, in bytes.
+     */
+    uint32_t GetSize(uint64_t index) const;
+
+    /**
+     * @brief Advise the operating system that the given records will be read
+     *        soon, so that they are paged in ahead of time.
+     * @param first the index of the first record.
+     * @param count the number of records.
+     */
+    void Prefetch(uint64_t first, uint64_t count) const;
+
+    /// Size of the file header in bytes.
+    static const uint32_t HEADER_SIZE = 16;
+
+    /// Size of each record in bytes.
+    static const uint32_t RECORD_SIZE = 12;
+
+  private:
+    /**
+     * @param index the index of a record.
+     * @return pointer to the start of the record inside the mapping.
+     */
+    const uint8_t* GetRecord(uint64_t index) const;
+
+    /// Path of the mapped file.
+    std::string m_path;
+
+    /// Start of the mapping.
+    uint8_t* m_data;
+
+    /// Length of the mapping in bytes.
+    uint64_t m_length;
+
+    /// Number of records in the trace.
+    uint64_t m_nRecords;
+
+}; // end of `class TraceReplayFile`
+
+} // end of `namespace ns3`
+
+#endif /* TRACE_REPLAY_FILE_H */
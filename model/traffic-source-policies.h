@@ -0,0 +1,635 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef TRAFFIC_SOURCE_POLICIES_H
+#define TRAFFIC_SOURCE_POLICIES_H
+
+#include "trace-replay-file.h"
+#include "traffic-time-tag.h"
+
+#include "ns3/double.h"
+#include "ns3/nstime.h"
+#include "ns3/packet.h"
+#include "ns3/ptr.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/type-id.h"
+#include "ns3/uinteger.h"
+
+#include <stdint.h>
+#include <string>
+
+namespace ns3
+{
+
+/*
+ * The classes in this file are the policies of the TrafficSource template.
+ * Each policy class is a public base class of the TrafficSource instantiation
+ * which uses it, so that the attributes registered by its AddAttributes()
+ * method can point directly to its member variables. The methods called by
+ * TrafficSource on every packet are non-virtual and defined inline, and the
+ * random policies call the non-virtual, parameterized GetValue() of their
+ * random variable, so the whole send path can be inlined by the compiler.
+ *
+ * An arrival policy provides:
+ *   static std::string GetName ();
+ *   static TypeId AddAttributes (TypeId tid);
+ *   void InitArrival ();
+ *   bool NextInterval (Time &interval);  // false ends the traffic
+ *   int64_t AssignArrivalStreams (int64_t stream);
+ *
+ * A size policy provides:
+ *   static std::string GetName ();
+ *   static TypeId AddAttributes (TypeId tid);
+ *   void InitSize ();
+ *   uint32_t NextSize ();
+ *   int64_t AssignSizeStreams (int64_t stream);
+ *
+ * A tag policy provides:
+ *   static std::string GetName ();
+ *   static TypeId AddAttributes (TypeId tid);
+ *   void ApplyTag (Ptr<Packet> packet) const;
+ */
+
+// ARRIVAL POLICIES ///////////////////////////////////////////////////////////
+
+/**
+ * @ingroup traffic
+ * @brief Arrival policy with a constant interval between packets.
+ */
+class ConstantArrival
+{
+  public:
+    ConstantArrival()
+        : m_interval(Seconds(1))
+    {
+    }
+
+    static std::string GetName()
+    {
+        return "ConstantArrival";
+    }
+
+    static TypeId AddAttributes(TypeId tid)
+    {
+        return tid.AddAttribute("Interval",
+                                "Interval between packets.",
+                                TimeValue(Seconds(1)),
+                                MakeTimeAccessor(&ConstantArrival::m_interval),
+                                MakeTimeChecker(NanoSeconds(1)));
+    }
+
+    void InitArrival()
+    {
+    }
+
+    bool NextInterval(Time& interval)
+    {
+        interval = m_interval;
+        return true;
+    }
+
+    int64_t AssignArrivalStreams(int64_t /* stream */)
+    {
+        return 0;
+    }
+
+  private:
+    Time m_interval; ///< `Interval` attribute.
+};
+
+/**
+ * @ingroup traffic
+ * @brief Arrival policy with exponentially distributed intervals between
+ *        packets, i.e., Poisson arrivals.
+ */
+class ExponentialArrival
+{
+  public:
+    ExponentialArrival()
+        : m_meanInterval(Seconds(1)),
+          m_rng(CreateObject<ExponentialRandomVariable>())
+    {
+    }
+
+    static std::string GetName()
+    {
+        return "ExponentialArrival";
+    }
+
+    static TypeId AddAttributes(TypeId tid)
+    {
+        return tid.AddAttribute("MeanInterval",
+                                "Mean interval between packets.",
+                                TimeValue(Seconds(1)),
+                                MakeTimeAccessor(&ExponentialArrival::m_meanInterval),
+                                MakeTimeChecker(NanoSeconds(1)));
+    }
+
+    void InitArrival()
+    {
+    }
+
+    bool NextInterval(Time& interval)
+    {
+        interval = Seconds(m_rng->GetValue(m_meanInterval.GetSeconds(), 0.0));
+        return true;
+    }
+
+    int64_t AssignArrivalStreams(int64_t stream)
+    {
+        m_rng->SetStream(stream);
+        return 1;
+    }
+
+  private:
+    Time m_meanInterval;                   ///< `MeanInterval` attribute.
+    Ptr<ExponentialRandomVariable> m_rng; ///< Source of the intervals.
+};
+
+/**
+ * @ingroup traffic
+ * @brief Arrival policy with Pareto distributed intervals between packets.
+ */
+class ParetoArrival
+{
+  public:
+    ParetoArrival()
+        : m_scale(Seconds(1)),
+          m_shape(2.0),
+          m_bound(Seconds(0)),
+          m_rng(CreateObject<ParetoRandomVariable>())
+    {
+    }
+
+    static std::string GetName()
+    {
+        return "ParetoArrival";
+    }
+
+    static TypeId AddAttributes(TypeId tid)
+    {
+        return tid
+            .AddAttribute("IntervalScale",
+                          "Scale (minimum) of the Pareto distributed interval between packets.",
+                          TimeValue(Seconds(1)),
+                          MakeTimeAccessor(&ParetoArrival::m_scale),
+                          MakeTimeChecker(NanoSeconds(1)))
+            .AddAttribute("IntervalShape",
+                          "Shape of the Pareto distributed interval between packets.",
+                          DoubleValue(2.0),
+                          MakeDoubleAccessor(&ParetoArrival::m_shape),
+                          MakeDoubleChecker<double>(0.0))
+            .AddAttribute("IntervalBound",
+                          "Upper bound of the interval between packets. Zero means no bound.",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&ParetoArrival::m_bound),
+                          MakeTimeChecker(Seconds(0)));
+    }
+
+    void InitArrival()
+    {
+    }
+
+    bool NextInterval(Time& interval)
+    {
+        interval =
+            Seconds(m_rng->GetValue(m_scale.GetSeconds(), m_shape, m_bound.GetSeconds()));
+        return true;
+    }
+
+    int64_t AssignArrivalStreams(int64_t stream)
+    {
+        m_rng->SetStream(stream);
+        return 1;
+    }
+
+  private:
+    Time m_scale;                    ///< `IntervalScale` attribute.
+    double m_shape;                  ///< `IntervalShape` attribute.
+    Time m_bound;                    ///< `IntervalBound` attribute.
+    Ptr<ParetoRandomVariable> m_rng; ///< Source of the intervals.
+};
+
+/**
+ * @ingroup traffic
+ * @brief Arrival policy which follows the packet times of a TraceReplayFile.
+ *
+ * The first packet is sent immediately, and every following packet after
+ * the difference between the times of its record and the previous record.
+ * The traffic ends with the last record.
+ */
+class TraceArrival
+{
+  public:
+    TraceArrival()
+        : m_index(0)
+    {
+    }
+
+    static std::string GetName()
+    {
+        return "TraceArrival";
+    }
+
+    static TypeId AddAttributes(TypeId tid)
+    {
+        return tid.AddAttribute("ArrivalTrace",
+                                "Path of the trace file (see TraceReplayFile) which "
+                                "determines the packet times.",
+                                StringValue(""),
+                                MakeStringAccessor(&TraceArrival::m_path),
+                                MakeStringChecker());
+    }
+
+    void InitArrival()
+    {
+        m_trace = TraceReplayFile::Open(m_path);
+        m_index = 0;
+    }
+
+    bool NextInterval(Time& interval)
+    {
+        if (m_index >= m_trace->GetNRecords())
+        {
+            return false;
+        }
+
+        interval = (m_index == 0) ? Seconds(0)
+                                  : m_trace->GetTime(m_index) - m_trace->GetTime(m_index - 1);
+        m_index++;
+        return true;
+    }
+
+    int64_t AssignArrivalStreams(int64_t /* stream */)
+    {
+        return 0;
+    }
+
+  private:
+    std::string m_path;          ///< `ArrivalTrace` attribute.
+    Ptr<TraceReplayFile> m_trace; ///< The opened trace.
+    uint64_t m_index;             ///< Index of the next record.
+};
+
+// SIZE POLICIES //////////////////////////////////////////////////////////////
+
+/**
+ * @ingroup traffic
+ * @brief Size policy with a constant packet size.
+ */
+class ConstantSize
+{
+  public:
+    ConstantSize()
+        : m_size(512)
+    {
+    }
+
+    static std::string GetName()
+    {
+        return "ConstantSize";
+    }
+
+    static TypeId AddAttributes(TypeId tid)
+    {
+        return tid.AddAttribute("PacketSize",
+                                "The size of packets sent.",
+                                UintegerValue(512),
+                                MakeUintegerAccessor(&ConstantSize::m_size),
+                                MakeUintegerChecker<uint32_t>(1));
+    }
+
+    void InitSize()
+    {
+    }
+
+    uint32_t NextSize()
+    {
+        return m_size;
+    }
+
+    int64_t AssignSizeStreams(int64_t /* stream */)
+    {
+        return 0;
+    }
+
+  private:
+    uint32_t m_size; ///< `PacketSize` attribute.
+};
+
+/**
+ * @ingroup traffic
+ * @brief Size policy with exponentially distributed packet sizes.
+ */
+class ExponentialSize
+{
+  public:
+    ExponentialSize()
+        : m_mean(512),
+          m_max(1500),
+          m_rng(CreateObject<ExponentialRandomVariable>())
+    {
+    }
+
+    static std::string GetName()
+    {
+        return "ExponentialSize";
+    }
+
+    static TypeId AddAttributes(TypeId tid)
+    {
+        return tid
+            .AddAttribute("MeanPacketSize",
+                          "Mean size of packets sent.",
+                          DoubleValue(512),
+                          MakeDoubleAccessor(&ExponentialSize::m_mean),
+                          MakeDoubleChecker<double>(1.0))
+            .AddAttribute("MaxPacketSize",
+                          "Upper bound of the size of packets sent.",
+                          UintegerValue(1500),
+                          MakeUintegerAccessor(&ExponentialSize::m_max),
+                          MakeUintegerChecker<uint32_t>(1));
+    }
+
+    void InitSize()
+    {
+    }
+
+    uint32_t NextSize()
+    {
+        return BoundSize(m_rng->GetValue(m_mean, m_max), m_max);
+    }
+
+    int64_t AssignSizeStreams(int64_t stream)
+    {
+        m_rng->SetStream(stream);
+        return 1;
+    }
+
+    /**
+     * @param value a drawn size
+     * @param max the upper bound
+     * @return the size rounded to the nearest integer in [1, max]
+     */
+    static uint32_t BoundSize(double value, uint32_t max)
+    {
+        const uint32_t size = static_cast<uint32_t>(value + 0.5);
+        return size < 1 ? 1 : (size > max ? max : size);
+    }
+
+  private:
+    double m_mean;                        ///< `MeanPacketSize` attribute.
+    uint32_t m_max;                       ///< `MaxPacketSize` attribute.
+    Ptr<ExponentialRandomVariable> m_rng; ///< Source of the sizes.
+};
+
+/**
+ * @ingroup traffic
+ * @brief Size policy with Pareto distributed packet sizes.
+ */
+class ParetoSize
+{
+  public:
+    ParetoSize()
+        : m_scale(100),
+          m_shape(1.2),
+          m_max(1500),
+          m_rng(CreateObject<ParetoRandomVariable>())
+    {
+    }
+
+    static std::string GetName()
+    {
+        return "ParetoSize";
+    }
+
+    static TypeId AddAttributes(TypeId tid)
+    {
+        return tid
+            .AddAttribute("PacketSizeScale",
+                          "Scale (minimum) of the Pareto distributed size of packets sent.",
+                          DoubleValue(100),
+                          MakeDoubleAccessor(&ParetoSize::m_scale),
+                          MakeDoubleChecker<double>(1.0))
+            .AddAttribute("PacketSizeShape",
+                          "Shape of the Pareto distributed size of packets sent.",
+                          DoubleValue(1.2),
+                          MakeDoubleAccessor(&ParetoSize::m_shape),
+                          MakeDoubleChecker<double>(0.0))
+            .AddAttribute("MaxPacketSize",
+                          "Upper bound of the size of packets sent.",
+                          UintegerValue(1500),
+                          MakeUintegerAccessor(&ParetoSize::m_max),
+                          MakeUintegerChecker<uint32_t>(1));
+    }
+
+    void InitSize()
+    {
+    }
+
+    uint32_t NextSize()
+    {
+        return ExponentialSize::BoundSize(m_rng->GetValue(m_scale, m_shape, m_max), m_max);
+    }
+
+    int64_t AssignSizeStreams(int64_t stream)
+    {
+        m_rng->SetStream(stream);
+        return 1;
+    }
+
+  private:
+    double m_scale;                  ///< `PacketSizeScale` attribute.
+    double m_shape;                  ///< `PacketSizeShape` attribute.
+    uint32_t m_max;                  ///< `MaxPacketSize` attribute.
+    Ptr<ParetoRandomVariable> m_rng; ///< Source of the sizes.
+};
+
+/**
+ * @ingroup traffic
+ * @brief Size policy with log-normally distributed packet sizes.
+ */
+class LogNormalSize
+{
+  public:
+    LogNormalSize()
+        : m_mu(6.0),
+          m_sigma(0.5),
+          m_max(1500),
+          m_rng(CreateObject<LogNormalRandomVariable>())
+    {
+    }
+
+    static std::string GetName()
+    {
+        return "LogNormalSize";
+    }
+
+    static TypeId AddAttributes(TypeId tid)
+    {
+        return tid
+            .AddAttribute("PacketSizeMu",
+                          "Mu parameter of the log-normally distributed size of packets sent.",
+                          DoubleValue(6.0),
+                          MakeDoubleAccessor(&LogNormalSize::m_mu),
+                          MakeDoubleChecker<double>())
+            .AddAttribute("PacketSizeSigma",
+                          "Sigma parameter of the log-normally distributed size of packets sent.",
+                          DoubleValue(0.5),
+                          MakeDoubleAccessor(&LogNormalSize::m_sigma),
+                          MakeDoubleChecker<double>(0.0))
+            .AddAttribute("MaxPacketSize",
+                          "Upper bound of the size of packets sent.",
+                          UintegerValue(1500),
+                          MakeUintegerAccessor(&LogNormalSize::m_max),
+                          MakeUintegerChecker<uint32_t>(1));
+    }
+
+    void InitSize()
+    {
+    }
+
+    uint32_t NextSize()
+    {
+        return ExponentialSize::BoundSize(m_rng->GetValue(m_mu, m_sigma), m_max);
+    }
+
+    int64_t AssignSizeStreams(int64_t stream)
+    {
+        m_rng->SetStream(stream);
+        return 1;
+    }
+
+  private:
+    double m_mu;                        ///< `PacketSizeMu` attribute.
+    double m_sigma;                     ///< `PacketSizeSigma` attribute.
+    uint32_t m_max;                     ///< `MaxPacketSize` attribute.
+    Ptr<LogNormalRandomVariable> m_rng; ///< Source of the sizes.
+};
+
+/**
+ * @ingroup traffic
+ * @brief Size policy which follows the packet sizes of a TraceReplayFile.
+ *
+ * Used together with TraceArrival on the same file, each packet gets the
+ * size of the record which determined its time.
+ */
+class TraceSize
+{
+  public:
+    TraceSize()
+        : m_index(0)
+    {
+    }
+
+    static std::string GetName()
+    {
+        return "TraceSize";
+    }
+
+    static TypeId AddAttributes(TypeId tid)
+    {
+        return tid.AddAttribute("SizeTrace",
+                                "Path of the trace file (see TraceReplayFile) which "
+                                "determines the packet sizes.",
+                                StringValue(""),
+                                MakeStringAccessor(&TraceSize::m_path),
+                                MakeStringChecker());
+    }
+
+    void InitSize()
+    {
+        m_trace = TraceReplayFile::Open(m_path);
+        m_index = 0;
+    }
+
+    uint32_t NextSize()
+    {
+        // Wrap around if the trace has fewer records than packets to be sent.
+        if (m_index >= m_trace->GetNRecords())
+        {
+            m_index = 0;
+        }
+        return m_trace->GetSize(m_index++);
+    }
+
+    int64_t AssignSizeStreams(int64_t /* stream */)
+    {
+        return 0;
+    }
+
+  private:
+    std::string m_path;           ///< `SizeTrace` attribute.
+    Ptr<TraceReplayFile> m_trace; ///< The opened trace.
+    uint64_t m_index;             ///< Index of the next record.
+};
+
+// TAG POLICIES ///////////////////////////////////////////////////////////////
+
+/**
+ * @ingroup traffic
+ * @brief Tag policy which leaves the packets untouched.
+ */
+class NoTagging
+{
+  public:
+    static std::string GetName()
+    {
+        return "NoTagging";
+    }
+
+    static TypeId AddAttributes(TypeId tid)
+    {
+        return tid;
+    }
+
+    void ApplyTag(Ptr<Packet> /* packet */) const
+    {
+    }
+};
+
+/**
+ * @ingroup traffic
+ * @brief Tag policy which adds a TrafficTimeTag to every packet, as needed by
+ *        the delay statistics (see ApplicationStatsDelayHelper).
+ */
+class TimeTagging
+{
+  public:
+    static std::string GetName()
+    {
+        return "TimeTagging";
+    }
+
+    static TypeId AddAttributes(TypeId tid)
+    {
+        return tid;
+    }
+
+    void ApplyTag(Ptr<Packet> packet) const
+    {
+        packet->AddPacketTag(TrafficTimeTag(Simulator::Now()));
+    }
+};
+
+} // end of `namespace ns3`
+
+#endif /* TRAFFIC_SOURCE_POLICIES_H */
@@ -0,0 +1,37 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "traffic-source.h"
+
+NS_LOG_COMPONENT_DEFINE("TrafficSource");
+
+namespace ns3
+{
+
+template class TrafficSource<ConstantArrival, ConstantSize, TimeTagging>;
+template class TrafficSource<ExponentialArrival, ConstantSize, TimeTagging>;
+template class TrafficSource<ParetoArrival, LogNormalSize, TimeTagging>;
+template class TrafficSource<TraceArrival, TraceSize, TimeTagging>;
+
+NS_OBJECT_ENSURE_REGISTERED(ConstantTrafficSource);
+NS_OBJECT_ENSURE_REGISTERED(PoissonTrafficSource);
+NS_OBJECT_ENSURE_REGISTERED(ParetoTrafficSource);
+NS_OBJECT_ENSURE_REGISTERED(TraceTrafficSource);
+
+} // end of `namespace ns3`
@@ -0,0 +1,324 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef TRAFFIC_SOURCE_H
+#define TRAFFIC_SOURCE_H
+
+#include "traffic-source-policies.h"
+
+#include "ns3/address.h"
+#include "ns3/application.h"
+#include "ns3/event-id.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/log.h"
+#include "ns3/nstime.h"
+#include "ns3/packet.h"
+#include "ns3/ptr.h"
+#include "ns3/simulator.h"
+#include "ns3/socket.h"
+#include "ns3/trace-source-accessor.h"
+#include "ns3/traced-callback.h"
+#include "ns3/udp-socket-factory.h"
+#include "ns3/uinteger.h"
+
+#include <stdint.h>
+
+namespace ns3
+{
+
+/**
+ * @ingroup traffic
+ * @brief Send packets to a single destination, with the packet times, sizes
+ *        and tags determined by compile-time policies.
+ *
+ * The send loop of this application is written once, while the three policy
+ * classes given as template arguments decide
+ * - the interval before each packet (ConstantArrival, ExponentialArrival,
+ *   ParetoArrival, TraceArrival);
+ * - the size of each packet (ConstantSize, ExponentialSize, ParetoSize,
+ *   LogNormalSize, TraceSize); and
+ * - what is attached to each packet (NoTagging, TimeTagging).
+ *
+ * The policies are resolved at compile time and their per-packet methods are
+ * inline and non-virtual, so a new traffic type gets an efficient send path
+ * by combining existing policies or writing a new one (see the comment at
+ * the top of traffic-source-policies.h for what a policy must provide). The
+ * attributes of the policies become attributes of the instantiation.
+ *
+ * The TypeId name of an instantiation is made of the names of its policies,
+ * e.g., `ns3::TrafficSource<ExponentialArrival,ConstantSize,TimeTagging>`. The
+ * most common combinations have typedefs below (ConstantTrafficSource,
+ * PoissonTrafficSource, ParetoTrafficSource and TraceTrafficSource) and are
+ * registered by this module, so they can also be created by name through
+ * ObjectFactory and configured through Config::SetDefault(). Other
+ * combinations can be created with CreateObject() directly, or registered
+ * with NS_OBJECT_ENSURE_REGISTERED() on a typedef.
+ *
+ * Like CbrApplication, the first packet is scheduled after the socket has
+ * connected, one interval later. Sending stops when the application is
+ * stopped or when the arrival policy runs out of packets.
+ */
+template <class ArrivalPolicy, class SizePolicy, class TagPolicy>
+class TrafficSource : public Application,
+                      public ArrivalPolicy,
+                      public SizePolicy,
+                      public TagPolicy
+{
+  public:
+    /**
+     * @brief Returns the object TypeId.
+     * @return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /// Creates a new instance of traffic source.
+    TrafficSource();
+
+    /**
+     * @return the number of bytes sent so far
+     */
+    uint64_t GetSent() const;
+
+    /**
+     * @brief Assign fixed random variable stream numbers to the random
+     *        variables used by the policies.
+     * @param stream first stream index to use
+     * @return the number of stream indices assigned
+     */
+    int64_t AssignStreams(int64_t stream);
+
+  protected:
+    // Inherited from Object base class
+    virtual void DoDispose();
+
+  private:
+    // Inherited from Application base class
+    virtual void StartApplication();
+    virtual void StopApplication();
+
+    /// Schedule the next packet, unless the arrival policy has run out.
+    void ScheduleNextTx();
+
+    /// Create and send a packet, then schedule the next one.
+    void SendPacket();
+
+    /**
+     * @param socket the connected socket
+     */
+    void ConnectionSucceeded(Ptr<Socket> socket);
+
+    /**
+     * @param socket the socket which failed to connect
+     */
+    void ConnectionFailed(Ptr<Socket> socket);
+
+    Ptr<Socket> m_socket; ///< Associated socket.
+    Address m_peer;       ///< `Remote` attribute.
+    uint8_t m_tos;        ///< `Tos` attribute.
+    TypeId m_tid;         ///< `Protocol` attribute.
+    uint64_t m_totTxBytes; ///< Total bytes sent so far.
+    EventId m_sendEvent;   ///< Pending invocation of SendPacket().
+
+    /// `Tx` trace source.
+    TracedCallback<Ptr<const Packet>> m_txTrace;
+
+    NS_LOG_TEMPLATE_DECLARE; ///< The log component.
+
+}; // end of `class TrafficSource`
+
+/// Packets of constant size at constant intervals.
+typedef TrafficSource<ConstantArrival, ConstantSize, TimeTagging> ConstantTrafficSource;
+
+/// Packets of constant size with Poisson arrivals.
+typedef TrafficSource<ExponentialArrival, ConstantSize, TimeTagging> PoissonTrafficSource;
+
+/// Packets of log-normally distributed size at Pareto distributed intervals.
+typedef TrafficSource<ParetoArrival, LogNormalSize, TimeTagging> ParetoTrafficSource;
+
+/// Packet times and sizes from a TraceReplayFile.
+typedef TrafficSource<TraceArrival, TraceSize, TimeTagging> TraceTrafficSource;
+
+// Instantiated once, in traffic-source.cc.
+extern template class TrafficSource<ConstantArrival, ConstantSize, TimeTagging>;
+extern template class TrafficSource<ExponentialArrival, ConstantSize, TimeTagging>;
+extern template class TrafficSource<ParetoArrival, LogNormalSize, TimeTagging>;
+extern template class TrafficSource<TraceArrival, TraceSize, TimeTagging>;
+
+// IMPLEMENTATION /////////////////////////////////////////////////////////////
+
+template <class ArrivalPolicy, class SizePolicy, class TagPolicy>
+TypeId
+TrafficSource<ArrivalPolicy, SizePolicy, TagPolicy>::GetTypeId()
+{
+    typedef TrafficSource<ArrivalPolicy, SizePolicy, TagPolicy> Self;
+    static TypeId tid = TagPolicy::AddAttributes(SizePolicy::AddAttributes(
+        ArrivalPolicy::AddAttributes(
+            TypeId("ns3::TrafficSource<" + ArrivalPolicy::GetName() + "," +
+                   SizePolicy::GetName() + "," + TagPolicy::GetName() + ">")
+                .SetParent<Application>()
+                .AddConstructor<Self>()
+                .AddAttribute("Remote",
+                              "The address of the destination.",
+                              AddressValue(),
+                              MakeAddressAccessor(&Self::m_peer),
+                              MakeAddressChecker())
+                .AddAttribute("Tos",
+                              "The Type of Service used to send IPv4 packets. "
+                              "All 8 bits of the TOS byte are set (including ECN bits).",
+                              UintegerValue(0),
+                              MakeUintegerAccessor(&Self::m_tos),
+                              MakeUintegerChecker<uint8_t>())
+                .AddAttribute("Protocol",
+                              "The type of protocol to use.",
+                              TypeIdValue(UdpSocketFactory::GetTypeId()),
+                              MakeTypeIdAccessor(&Self::m_tid),
+                              MakeTypeIdChecker())
+                .AddTraceSource("Tx",
+                                "A new packet is created and is sent",
+                                MakeTraceSourceAccessor(&Self::m_txTrace),
+                                "ns3::Packet::TracedCallback"))));
+    return tid;
+}
+
+template <class ArrivalPolicy, class SizePolicy, class TagPolicy>
+TrafficSource<ArrivalPolicy, SizePolicy, TagPolicy>::TrafficSource()
+    : m_tos(0),
+      m_totTxBytes(0),
+      NS_LOG_TEMPLATE_DEFINE("TrafficSource")
+{
+    NS_LOG_FUNCTION(this);
+}
+
+template <class ArrivalPolicy, class SizePolicy, class TagPolicy>
+uint64_t
+TrafficSource<ArrivalPolicy, SizePolicy, TagPolicy>::GetSent() const
+{
+    return m_totTxBytes;
+}
+
+template <class ArrivalPolicy, class SizePolicy, class TagPolicy>
+int64_t
+TrafficSource<ArrivalPolicy, SizePolicy, TagPolicy>::AssignStreams(int64_t stream)
+{
+    const int64_t n = ArrivalPolicy::AssignArrivalStreams(stream);
+    return n + SizePolicy::AssignSizeStreams(stream + n);
+}
+
+template <class ArrivalPolicy, class SizePolicy, class TagPolicy>
+void
+TrafficSource<ArrivalPolicy, SizePolicy, TagPolicy>::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_socket = nullptr;
+    Application::DoDispose();
+}
+
+template <class ArrivalPolicy, class SizePolicy, class TagPolicy>
+void
+TrafficSource<ArrivalPolicy, SizePolicy, TagPolicy>::StartApplication()
+{
+    typedef TrafficSource<ArrivalPolicy, SizePolicy, TagPolicy> Self;
+    NS_LOG_FUNCTION(this);
+
+    ArrivalPolicy::InitArrival();
+    SizePolicy::InitSize();
+
+    if (!m_socket)
+    {
+        m_socket = Socket::CreateSocket(GetNode(), m_tid);
+        m_socket->Bind();
+        m_socket->SetConnectCallback(MakeCallback(&Self::ConnectionSucceeded, this),
+                                     MakeCallback(&Self::ConnectionFailed, this));
+
+        if (InetSocketAddress::IsMatchingType(m_peer))
+        {
+            m_socket->SetIpTos(m_tos); // Affects only IPv4 sockets.
+        }
+
+        m_socket->Connect(m_peer);
+        m_socket->SetAllowBroadcast(true);
+        m_socket->ShutdownRecv();
+    }
+}
+
+template <class ArrivalPolicy, class SizePolicy, class TagPolicy>
+void
+TrafficSource<ArrivalPolicy, SizePolicy, TagPolicy>::StopApplication()
+{
+    NS_LOG_FUNCTION(this);
+    m_sendEvent.Cancel();
+
+    if (m_socket != nullptr)
+    {
+        m_socket->Close();
+    }
+}
+
+template <class ArrivalPolicy, class SizePolicy, class TagPolicy>
+void
+TrafficSource<ArrivalPolicy, SizePolicy, TagPolicy>::ScheduleNextTx()
+{
+    typedef TrafficSource<ArrivalPolicy, SizePolicy, TagPolicy> Self;
+
+    Time interval;
+    if (ArrivalPolicy::NextInterval(interval))
+    {
+        m_sendEvent = Simulator::Schedule(interval, &Self::SendPacket, this);
+    }
+    else
+    {
+        NS_LOG_INFO(this << " no more packets to send");
+    }
+}
+
+template <class ArrivalPolicy, class SizePolicy, class TagPolicy>
+void
+TrafficSource<ArrivalPolicy, SizePolicy, TagPolicy>::SendPacket()
+{
+    const uint32_t size = SizePolicy::NextSize();
+    Ptr<Packet> packet = Create<Packet>(size);
+    TagPolicy::ApplyTag(packet);
+
+    m_txTrace(packet);
+    m_socket->Send(packet);
+    m_totTxBytes += size;
+    NS_LOG_INFO(this << " sent " << size << " bytes, total Tx " << m_totTxBytes << " bytes");
+
+    ScheduleNextTx();
+}
+
+template <class ArrivalPolicy, class SizePolicy, class TagPolicy>
+void
+TrafficSource<ArrivalPolicy, SizePolicy, TagPolicy>::ConnectionSucceeded(Ptr<Socket> socket)
+{
+    NS_LOG_FUNCTION(this << socket);
+    m_sendEvent.Cancel();
+    ScheduleNextTx();
+}
+
+template <class ArrivalPolicy, class SizePolicy, class TagPolicy>
+void
+TrafficSource<ArrivalPolicy, SizePolicy, TagPolicy>::ConnectionFailed(Ptr<Socket> socket)
+{
+    NS_LOG_FUNCTION(this << socket);
+}
+
+} // end of `namespace ns3`
+
+#endif /* TRAFFIC_SOURCE_H */
@@ -0,0 +1,393 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "workload-tape.h"
+
+#include "ns3/enum.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+
+#include <cstring>
+#include <fstream>
+
+NS_LOG_COMPONENT_DEFINE("WorkloadTape");
+
+namespace ns3
+{
+
+NS_OBJECT_ENSURE_REGISTERED(WorkloadTape);
+
+/// Magic string at the beginning of every workload file.
+static const char WORKLOAD_TAPE_MAGIC[8] = {'N', 'S', '3', 'W', 'K', 'L', 'D', '1'};
+
+/**
+ * @brief Write an unsigned integer in variable-length encoding (7 bits per
+ *        byte, least significant group first).
+ * @param os the output stream.
+ * @param value the integer.
+ */
+static void
+WriteVarint(std::ostream& os, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        os.put(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    os.put(static_cast<char>(value));
+}
+
+/**
+ * @brief Read an unsigned integer written by WriteVarint().
+ * @param is the input stream.
+ * @param value output argument which receives the integer.
+ * @return false if the stream ended before the integer was complete.
+ */
+static bool
+ReadVarint(std::istream& is, uint64_t& value)
+{
+    value = 0;
+    for (uint32_t shift = 0; shift < 64; shift += 7)
+    {
+        const int c = is.get();
+        if (c == std::char_traits<char>::eof())
+        {
+            return false;
+        }
+
+        value |= static_cast<uint64_t>(c & 0x7F) << shift;
+        if ((c & 0x80) == 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @return the storage of the process-wide tape.
+ */
+static Ptr<WorkloadTape>&
+GetWorkloadTapeInstance()
+{
+    static Ptr<WorkloadTape> instance;
+    return instance;
+}
+
+// WORKLOAD BUFFER ////////////////////////////////////////////////////////////
+
+WorkloadBuffer::WorkloadBuffer()
+{
+}
+
+void
+WorkloadBuffer::Append(uint8_t channel, const std::vector<int64_t>& values)
+{
+    std::vector<int64_t>& v = GetChannel(channel);
+    v.insert(v.end(), values.begin(), values.end());
+}
+
+void
+WorkloadBuffer::Push(uint8_t channel, int64_t value)
+{
+    GetChannel(channel).push_back(value);
+}
+
+bool
+WorkloadBuffer::Pop(uint8_t channel, int64_t& value)
+{
+    if ((channel >= m_values.size()) || (m_positions[channel] >= m_values[channel].size()))
+    {
+        return false;
+    }
+
+    value = m_values[channel][m_positions[channel]++];
+    return true;
+}
+
+uint32_t
+WorkloadBuffer::GetNChannels() const
+{
+    return m_values.size();
+}
+
+const std::vector<int64_t>&
+WorkloadBuffer::GetValues(uint8_t channel) const
+{
+    NS_ASSERT(channel < m_values.size());
+    return m_values[channel];
+}
+
+bool
+WorkloadBuffer::IsExhausted() const
+{
+    for (uint32_t channel = 0; channel < m_values.size(); channel++)
+    {
+        if (m_positions[channel] < m_values[channel].size())
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+std::vector<int64_t>&
+WorkloadBuffer::GetChannel(uint8_t channel)
+{
+    if (channel >= m_values.size())
+    {
+        m_values.resize(channel + 1);
+        m_positions.resize(channel + 1, 0);
+    }
+
+    return m_values[channel];
+}
+
+// WORKLOAD TAPE //////////////////////////////////////////////////////////////
+
+WorkloadTape::WorkloadTape()
+    : m_mode(WorkloadTape::MODE_OFF),
+      m_nSources(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TypeId
+WorkloadTape::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::WorkloadTape")
+            .SetParent<Object>()
+            .AddConstructor<WorkloadTape>()
+            .AddAttribute("Mode",
+                          "Whether the workload is drawn normally, recorded to the file, "
+                          "or read from the file.",
+                          EnumValue(WorkloadTape::MODE_OFF),
+                          MakeEnumAccessor<WorkloadTape::Mode_t>(&WorkloadTape::m_mode),
+                          MakeEnumChecker(WorkloadTape::MODE_OFF,
+                                          "OFF",
+                                          WorkloadTape::MODE_CAPTURE,
+                                          "CAPTURE",
+                                          WorkloadTape::MODE_REPLAY,
+                                          "REPLAY"))
+            .AddAttribute("FileName",
+                          "Path of the file where the workload is recorded or read from.",
+                          StringValue("workload.bin"),
+                          MakeStringAccessor(&WorkloadTape::m_fileName),
+                          MakeStringChecker());
+    return tid;
+}
+
+Ptr<WorkloadTape> // static
+WorkloadTape::GetActive()
+{
+    Ptr<WorkloadTape>& instance = GetWorkloadTapeInstance();
+
+    if (instance == nullptr)
+    {
+        instance = CreateObject<WorkloadTape>();
+
+        if (instance->m_mode == WorkloadTape::MODE_REPLAY)
+        {
+            instance->Load();
+        }
+
+        Simulator::ScheduleDestroy(&WorkloadTape::Finish);
+    }
+
+    if (instance->m_mode == WorkloadTape::MODE_OFF)
+    {
+        return nullptr;
+    }
+
+    return instance;
+}
+
+WorkloadTape::Mode_t
+WorkloadTape::GetMode() const
+{
+    return m_mode;
+}
+
+uint32_t
+WorkloadTape::Register()
+{
+    return m_nSources++;
+}
+
+void
+WorkloadTape::Capture(uint32_t key, uint8_t channel, int64_t value)
+{
+    if (m_mode == WorkloadTape::MODE_CAPTURE)
+    {
+        GetBuffer(key).Push(channel, value);
+    }
+}
+
+bool
+WorkloadTape::Replay(uint32_t key, uint8_t channel, int64_t& value)
+{
+    return (m_mode == WorkloadTape::MODE_REPLAY) && (key < m_buffers.size()) &&
+           m_buffers[key].Pop(channel, value);
+}
+
+void
+WorkloadTape::Append(uint32_t key, uint8_t channel, const std::vector<int64_t>& values)
+{
+    GetBuffer(key).Append(channel, values);
+}
+
+void
+WorkloadTape::Save() const
+{
+    NS_LOG_FUNCTION(this << m_fileName);
+
+    std::ofstream ofs(m_fileName.c_str(), std::ios::binary | std::ios::trunc);
+    if (!ofs.is_open())
+    {
+        NS_FATAL_ERROR("Unable to open " << m_fileName << " for writing");
+    }
+
+    ofs.write(WORKLOAD_TAPE_MAGIC, sizeof(WORKLOAD_TAPE_MAGIC));
+    uint64_t nValues = 0;
+
+    for (uint32_t key = 0; key < m_buffers.size(); key++)
+    {
+        for (uint32_t channel = 0; channel < m_buffers[key].GetNChannels(); channel++)
+        {
+            const std::vector<int64_t>& values = m_buffers[key].GetValues(channel);
+            if (values.empty())
+            {
+                continue;
+            }
+
+            WriteVarint(ofs, key);
+            WriteVarint(ofs, channel);
+            WriteVarint(ofs, values.size());
+            for (std::vector<int64_t>::const_iterator it = values.begin(); it != values.end();
+                 ++it)
+            {
+                // Zig-zag encoding keeps small negative numbers short.
+                const uint64_t u = static_cast<uint64_t>(*it);
+                WriteVarint(ofs, (u << 1) ^ static_cast<uint64_t>(*it >> 63));
+            }
+
+            nValues += values.size();
+        }
+    }
+
+    if (!ofs.good())
+    {
+        NS_FATAL_ERROR("Error while writing " << m_fileName);
+    }
+
+    NS_LOG_INFO(this << " saved " << nValues << " values of " << m_buffers.size()
+                     << " sources to " << m_fileName);
+
+} // end of `void Save () const`
+
+void
+WorkloadTape::Load()
+{
+    NS_LOG_FUNCTION(this << m_fileName);
+
+    std::ifstream ifs(m_fileName.c_str(), std::ios::binary);
+    if (!ifs.is_open())
+    {
+        NS_FATAL_ERROR("Unable to open workload file " << m_fileName);
+    }
+
+    char magic[sizeof(WORKLOAD_TAPE_MAGIC)];
+    ifs.read(magic, sizeof(magic));
+    if (!ifs.good() || std::memcmp(magic, WORKLOAD_TAPE_MAGIC, sizeof(magic)) != 0)
+    {
+        NS_FATAL_ERROR(m_fileName << " is not a workload file");
+    }
+
+    uint64_t key;
+    uint64_t channel;
+    uint64_t n;
+    while (ReadVarint(ifs, key))
+    {
+        if (!ReadVarint(ifs, channel) || !ReadVarint(ifs, n) || channel > 0xFF ||
+            key > 0xFFFFFFFF)
+        {
+            NS_FATAL_ERROR("Workload file " << m_fileName << " is corrupted");
+        }
+
+        std::vector<int64_t> values;
+        values.reserve(n);
+
+        for (uint64_t i = 0; i < n; i++)
+        {
+            uint64_t u;
+            if (!ReadVarint(ifs, u))
+            {
+                NS_FATAL_ERROR("Workload file " << m_fileName << " is truncated");
+            }
+            values.push_back(static_cast<int64_t>(u >> 1) ^ -static_cast<int64_t>(u & 1));
+        }
+
+        Append(static_cast<uint32_t>(key), static_cast<uint8_t>(channel), values);
+    }
+
+    NS_LOG_INFO(this << " loaded " << m_buffers.size() << " sources from " << m_fileName);
+
+} // end of `void Load ()`
+
+void
+WorkloadTape::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_buffers.clear();
+    Object::DoDispose();
+}
+
+void // static
+WorkloadTape::Finish()
+{
+    Ptr<WorkloadTape>& instance = GetWorkloadTapeInstance();
+
+    if (instance != nullptr)
+    {
+        if (instance->m_mode == WorkloadTape::MODE_CAPTURE)
+        {
+            instance->Save();
+        }
+
+        instance->Dispose();
+        instance = nullptr;
+    }
+}
+
+WorkloadBuffer&
+WorkloadTape::GetBuffer(uint32_t key)
+{
+    if (key >= m_buffers.size())
+    {
+        m_buffers.resize(key + 1);
+    }
+
+    return m_buffers[key];
+}
+
+} // end of `namespace ns3`
@@ -0,0 +1,255 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef WORKLOAD_TAPE_H
+#define WORKLOAD_TAPE_H
+
+#include "ns3/object.h"
+#include "ns3/ptr.h"
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup traffic
+ * @brief Compact per-channel arrays of workload values, consumed front to
+ *        back.
+ *
+ * Used by WorkloadTape to hold the values of each source, and by
+ * NrtvVariables and ThreeGppHttpSatelliteVariables to hold the values
+ * pre-generated for them by WorkloadPregenerator.
+ */
+class WorkloadBuffer
+{
+  public:
+    /// Creates an empty buffer.
+    WorkloadBuffer();
+
+    /**
+     * @param channel the kind of value.
+     * @param values the values to be appended to the channel.
+     */
+    void Append(uint8_t channel, const std::vector<int64_t>& values);
+
+    /**
+     * @param channel the kind of value.
+     * @param value the value to be appended to the channel.
+     */
+    void Push(uint8_t channel, int64_t value);
+
+    /**
+     * @brief Consume the next value of a channel.
+     * @param channel the kind of value.
+     * @param value output argument which receives the value.
+     * @return false if the channel has no values left.
+     */
+    bool Pop(uint8_t channel, int64_t& value);
+
+    /**
+     * @return the number of channels which have held values.
+     */
+    uint32_t GetNChannels() const;
+
+    /**
+     * @param channel the kind of value.
+     * @return every value of the channel, including those already consumed.
+     */
+    const std::vector<int64_t>& GetValues(uint8_t channel) const;
+
+    /**
+     * @return true if no channel has any value left.
+     */
+    bool IsExhausted() const;
+
+  private:
+    /**
+     * @param channel the kind of value.
+     * @return the values of the channel, created if it does not exist yet.
+     */
+    std::vector<int64_t>& GetChannel(uint8_t channel);
+
+    /// Values, indexed by channel.
+    std::vector<std::vector<int64_t>> m_values;
+
+    /// Index of the next value to be consumed, indexed by channel.
+    std::vector<uint32_t> m_positions;
+
+}; // end of `class WorkloadBuffer`
+
+/**
+ * @ingroup traffic
+ * @brief Records the workload drawn by NrtvVariables and
+ *        ThreeGppHttpSatelliteVariables and plays it back in later runs.
+ *
+ * In `CAPTURE` mode, every random value drawn by an NrtvVariables or a
+ * ThreeGppHttpSatelliteVariables instance (e.g., video lengths, slice sizes and
+ * encoding delays, object sizes, reading and parsing times) is recorded and
+ * written to the file given by the `FileName` attribute when the simulator is
+ * destroyed.
+ * In `REPLAY` mode, the file is read when the first variables instance is
+ * created, and the instances return the recorded values instead of drawing
+ * new ones. Different network variants can then be compared on the exact same
+ * workload, without paying the cost of the random number generation again.
+ *
+ * The tape is a process-wide singleton, configured through the default values
+ * of its attributes *before* any application is created, e.g.:
+ * @code
+ *     Config::SetDefault ("ns3::WorkloadTape::Mode", StringValue ("REPLAY"));
+ *     Config::SetDefault ("ns3::WorkloadTape::FileName", StringValue ("workload.bin"));
+ * @endcode
+ *
+ * Each variables instance registers itself when it is created and is
+ * identified by its order of creation. Each kind of value it draws is kept in
+ * a separate channel, so the values of one channel are played back in the
+ * order they were drawn, regardless of how the draws of different channels
+ * interleave. When a channel runs out during replay (e.g., because the replay
+ * runs longer than the capture), the instance falls back to its random number
+ * generator.
+ *
+ * The keys are therefore only stable for instances created before the
+ * simulation starts, in an order given by the scenario alone, such as those
+ * of the clients and servers themselves and of NrtvCatalog. Instances created
+ * in response to network events, i.e., those of the NRTV video workers, would
+ * be created in a different order in a different network variant and pick up
+ * the workload of another session. They do not register with the tape (see
+ * the `EnableWorkloadTape` attribute of NrtvVariables) and always draw from
+ * their random number generators; a NrtvCatalog keeps the video content on
+ * the tape instead.
+ *
+ * The file starts with the magic string `NS3WKLD1`, followed by one block per
+ * channel: the instance key, the channel number, the number of values and the
+ * values themselves. Every number is written as a variable-length integer
+ * (values are zig-zag encoded), and times are stored in nanoseconds.
+ */
+class WorkloadTape : public Object
+{
+  public:
+    /// The operation mode of the tape.
+    typedef enum
+    {
+        MODE_OFF = 0,  ///< Variables draw from their random number generators.
+        MODE_CAPTURE,  ///< Drawn values are recorded to the file.
+        MODE_REPLAY    ///< Recorded values are read from the file.
+    } Mode_t;
+
+    /// Creates a new tape. Use GetActive() instead.
+    WorkloadTape();
+
+    /**
+     * @brief Returns the object TypeId.
+     * @return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * @return the process-wide tape, or a null pointer if the `Mode` attribute
+     *         is `OFF`. The tape is created and, in `REPLAY` mode, loaded on the
+     *         first call.
+     */
+    static Ptr<WorkloadTape> GetActive();
+
+    /**
+     * @return the operation mode of the tape.
+     */
+    Mode_t GetMode() const;
+
+    /**
+     * @brief Register a new source of values, i.e., a variables instance.
+     * @return the key identifying the source, in order of registration.
+     *
+     * Must only be called by instances created before the simulation starts,
+     * so that the same instance gets the same key in every run.
+     */
+    uint32_t Register();
+
+    /**
+     * @brief Record a value drawn by a source. Has no effect unless in
+     *        `CAPTURE` mode.
+     * @param key the key of the source, as returned by Register().
+     * @param channel the kind of value, numbered by the source.
+     * @param value the drawn value.
+     */
+    void Capture(uint32_t key, uint8_t channel, int64_t value);
+
+    /**
+     * @brief Retrieve the next recorded value of a source.
+     * @param key the key of the source, as returned by Register().
+     * @param channel the kind of value, numbered by the source.
+     * @param value output argument which receives the value.
+     * @return true if a value was retrieved, false if not in `REPLAY` mode or
+     *         if the channel has run out of values.
+     */
+    bool Replay(uint32_t key, uint8_t channel, int64_t& value);
+
+    /**
+     * @brief Store values for a source, to be retrieved by Replay().
+     * @param key the key of the source.
+     * @param channel the kind of value, numbered by the source.
+     * @param values the values, in the order in which they are retrieved.
+     *
+     * The values are appended to those already stored for the channel.
+     */
+    void Append(uint32_t key, uint8_t channel, const std::vector<int64_t>& values);
+
+    /**
+     * @brief Write the recorded values to the file given by the `FileName`
+     *        attribute.
+     */
+    void Save() const;
+
+    /**
+     * @brief Read the values from the file given by the `FileName` attribute.
+     */
+    void Load();
+
+  protected:
+    // Inherited from Object base class
+    virtual void DoDispose();
+
+  private:
+    /// Invoked when the simulator is destroyed. Saves and releases the tape.
+    static void Finish();
+
+    /**
+     * @param key the key of a source.
+     * @return the buffer of the source, created if it does not exist yet.
+     */
+    WorkloadBuffer& GetBuffer(uint32_t key);
+
+    /// `Mode` attribute.
+    Mode_t m_mode;
+
+    /// `FileName` attribute.
+    std::string m_fileName;
+
+    /// Number of sources registered so far.
+    uint32_t m_nSources;
+
+    /// Recorded values, indexed by source key.
+    std::vector<WorkloadBuffer> m_buffers;
+
+}; // end of `class WorkloadTape`
+
+} // end of `namespace ns3`
+
+#endif /* WORKLOAD_TAPE_H */
@@ -29,16 +29,18 @@
 #include "ns3/enum.h"
 #include "ns3/gnuplot-aggregator.h"
 #include "ns3/inet-socket-address.h"
+#include "ns3/ipv4-address.h"
 #include "ns3/ipv4.h"
 #include "ns3/log.h"
-#include "ns3/multi-file-aggregator.h"
 #include "ns3/node.h"
 #include "ns3/nstime.h"
 #include "ns3/probe.h"
 #include "ns3/scalar-collector.h"
+#include "ns3/simulator.h"
 #include "ns3/string.h"
 #include "ns3/unit-conversion-collector.h"
 
+#include <cctype>
 #include <map>
 #include <sstream>
 #include <string>
@@ -51,6 +53,7 @@ namespace ns3
 NS_OBJECT_ENSURE_REGISTERED(ApplicationStatsDelayHelper);
 
 ApplicationStatsDelayHelper::ApplicationStatsDelayHelper()
+    : m_averagingMode(false)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -64,10 +67,50 @@ TypeId // static
 ApplicationStatsDelayHelper::GetTypeId()
 {
     static TypeId tid =
-        TypeId("ns3::ApplicationStatsDelayHelper").SetParent<ApplicationStatsHelper>();
+        TypeId("ns3::ApplicationStatsDelayHelper")
+            .SetParent<ApplicationStatsHelper>()
+            .AddAttribute("AveragingMode",
+                          "If true, the samples of each identifier will be averaged before "
+                          "passed to aggregator. Only supports histogram, PDF, and CDF output "
+                          "types.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&ApplicationStatsDelayHelper::SetAveragingMode,
+                                              &ApplicationStatsDelayHelper::GetAveragingMode),
+                          MakeBooleanChecker());
     return tid;
 }
 
+void
+ApplicationStatsDelayHelper::SetAveragingMode(bool averagingMode)
+{
+    NS_LOG_FUNCTION(this << averagingMode);
+    m_averagingMode = averagingMode;
+}
+
+bool
+ApplicationStatsDelayHelper::GetAveragingMode() const
+{
+    return m_averagingMode;
+}
+
+Ptr<DataCollectionObject>
+ApplicationStatsDelayHelper::GetAggregator() const
+{
+    return m_aggregator;
+}
+
+std::string
+ApplicationStatsDelayHelper::GetHeadingLabel() const
+{
+    return "delay_sec";
+}
+
+std::string
+ApplicationStatsDelayHelper::GetLegendLabel() const
+{
+    return "Packet delay";
+}
+
 void
 ApplicationStatsDelayHelper::DoInstall()
 {
@@ -83,8 +126,14 @@ ApplicationStatsDelayHelper::DoInstall()
         break;
 
     case ApplicationStatsHelper::OUTPUT_SCALAR_FILE: {
+        if (m_averagingMode)
+        {
+            NS_FATAL_ERROR("AveragingMode is not supported by "
+                           << GetOutputTypeName(GetOutputType()));
+        }
+
         // Setup aggregator.
-        m_aggregator = CreateAggregator("ns3::MultiFileAggregator",
+        m_aggregator = CreateAggregator(GetFileAggregatorTypeName(),
                                         "OutputFileName",
                                         StringValue(GetName()),
                                         "MultiFileMode",
@@ -92,7 +141,7 @@ ApplicationStatsDelayHelper::DoInstall()
                                         "EnableContextPrinting",
                                         BooleanValue(true),
                                         "GeneralHeading",
-                                        StringValue("% identifier delay_sec"));
+                                        StringValue("% identifier " + GetHeadingLabel()));
 
         // Setup collectors.
         m_terminalCollectors.SetType("ns3::ScalarCollector");
@@ -102,40 +151,54 @@ ApplicationStatsDelayHelper::DoInstall()
             "OutputType",
             EnumValue(ScalarCollector::OUTPUT_TYPE_AVERAGE_PER_SAMPLE));
         CreateCollectorPerIdentifier(m_terminalCollectors);
-        m_terminalCollectors.ConnectToAggregator("Output",
-                                                 m_aggregator,
-                                                 &MultiFileAggregator::Write1d);
+        ConnectCollectorsToFileAggregator(m_terminalCollectors,
+                                          "Output",
+                                          FILE_SINK_WRITE_1D,
+                                          m_aggregator);
         break;
     }
 
     case ApplicationStatsHelper::OUTPUT_SCATTER_FILE: {
+        if (m_averagingMode)
+        {
+            NS_FATAL_ERROR("AveragingMode is not supported by "
+                           << GetOutputTypeName(GetOutputType()));
+        }
+
         // Setup aggregator.
-        m_aggregator = CreateAggregator("ns3::MultiFileAggregator",
+        m_aggregator = CreateAggregator(GetFileAggregatorTypeName(),
                                         "OutputFileName",
                                         StringValue(GetName()),
                                         "GeneralHeading",
-                                        StringValue("% time_sec delay_sec"));
+                                        StringValue("% time_sec " + GetHeadingLabel()));
 
         // Setup collectors.
         m_terminalCollectors.SetType("ns3::UnitConversionCollector");
         m_terminalCollectors.SetAttribute("ConversionType",
                                           EnumValue(UnitConversionCollector::TRANSPARENT));
         CreateCollectorPerIdentifier(m_terminalCollectors);
-        m_terminalCollectors.ConnectToAggregator("OutputTimeValue",
-                                                 m_aggregator,
-                                                 &MultiFileAggregator::Write2d);
+        ConnectCollectorsToFileAggregator(m_terminalCollectors,
+                                          "OutputTimeValue",
+                                          FILE_SINK_WRITE_2D,
+                                          m_aggregator);
         break;
     }
 
     case ApplicationStatsHelper::OUTPUT_HISTOGRAM_FILE:
     case ApplicationStatsHelper::OUTPUT_PDF_FILE:
     case ApplicationStatsHelper::OUTPUT_CDF_FILE: {
+        if (m_averagingMode)
+        {
+            InstallAveraging();
+            break;
+        }
+
         // Setup aggregator.
-        m_aggregator = CreateAggregator("ns3::MultiFileAggregator",
+        m_aggregator = CreateAggregator(GetFileAggregatorTypeName(),
                                         "OutputFileName",
                                         StringValue(GetName()),
                                         "GeneralHeading",
-                                        StringValue("% delay_sec freq"));
+                                        StringValue("% " + GetHeadingLabel() + " freq"));
 
         // Setup collectors.
         m_terminalCollectors.SetType("ns3::DistributionCollector");
@@ -151,15 +214,18 @@ ApplicationStatsDelayHelper::DoInstall()
         }
         m_terminalCollectors.SetAttribute("OutputType", EnumValue(outputType));
         CreateCollectorPerIdentifier(m_terminalCollectors);
-        m_terminalCollectors.ConnectToAggregator("Output",
-                                                 m_aggregator,
-                                                 &MultiFileAggregator::Write2d);
-        m_terminalCollectors.ConnectToAggregator("OutputString",
-                                                 m_aggregator,
-                                                 &MultiFileAggregator::AddContextHeading);
-        m_terminalCollectors.ConnectToAggregator("Warning",
-                                                 m_aggregator,
-                                                 &MultiFileAggregator::EnableContextWarning);
+        ConnectCollectorsToFileAggregator(m_terminalCollectors,
+                                          "Output",
+                                          FILE_SINK_WRITE_2D,
+                                          m_aggregator);
+        ConnectCollectorsToFileAggregator(m_terminalCollectors,
+                                          "OutputString",
+                                          FILE_SINK_CONTEXT_HEADING,
+                                          m_aggregator);
+        ConnectCollectorsToFileAggregator(m_terminalCollectors,
+                                          "Warning",
+                                          FILE_SINK_CONTEXT_WARNING,
+                                          m_aggregator);
         break;
     }
 
@@ -170,10 +236,16 @@ ApplicationStatsDelayHelper::DoInstall()
         break;
 
     case ApplicationStatsHelper::OUTPUT_SCATTER_PLOT: {
+        if (m_averagingMode)
+        {
+            NS_FATAL_ERROR("AveragingMode is not supported by "
+                           << GetOutputTypeName(GetOutputType()));
+        }
+
         // Setup aggregator.
         Ptr<GnuplotAggregator> plotAggregator = CreateObject<GnuplotAggregator>(GetName());
         // plot->SetTitle ("");
-        plotAggregator->SetLegend("Time (in seconds)", "Packet delay (in seconds)");
+        plotAggregator->SetLegend("Time (in seconds)", GetLegendLabel() + " (in seconds)");
         plotAggregator->Set2dDatasetDefaultStyle(Gnuplot2dDataset::LINES);
         m_aggregator = plotAggregator;
 
@@ -198,10 +270,16 @@ ApplicationStatsDelayHelper::DoInstall()
     case ApplicationStatsHelper::OUTPUT_HISTOGRAM_PLOT:
     case ApplicationStatsHelper::OUTPUT_PDF_PLOT:
     case ApplicationStatsHelper::OUTPUT_CDF_PLOT: {
+        if (m_averagingMode)
+        {
+            InstallAveraging();
+            break;
+        }
+
         // Setup aggregator.
         Ptr<GnuplotAggregator> plotAggregator = CreateObject<GnuplotAggregator>(GetName());
         // plot->SetTitle ("");
-        plotAggregator->SetLegend("Packet delay (in seconds)", "Frequency");
+        plotAggregator->SetLegend(GetLegendLabel() + " (in seconds)", "Frequency");
         plotAggregator->Set2dDatasetDefaultStyle(Gnuplot2dDataset::LINES);
         m_aggregator = plotAggregator;
 
@@ -249,6 +327,44 @@ ApplicationStatsDelayHelper::DoInstall()
          * first-level collectors.
          */
         uint32_t n = 0;
+
+        if (m_averagingMode || GetSamplingRatio() > 1)
+        {
+            /*
+             * Listen directly to each receiver, because there is no collector
+             * to probe, or because the samples must be selected before they
+             * reach the collector.
+             */
+            uint32_t identifier = 0;
+            std::map<std::string, ApplicationContainer>::const_iterator it1;
+            for (it1 = m_receiverInfo.begin(); it1 != m_receiverInfo.end(); ++it1)
+            {
+                for (ApplicationContainer::Iterator it2 = it1->second.Begin();
+                     it2 != it1->second.End();
+                     ++it2)
+                {
+                    Callback<void, Time, const Address&> cb =
+                        MakeBoundCallback(&ApplicationStatsDelayHelper::ReceiverDelayCallback,
+                                          this,
+                                          identifier);
+                    if ((*it2)->GetInstanceTypeId().LookupTraceSourceByName(
+                            GetTraceSourceName()) != nullptr &&
+                        (*it2)->TraceConnectWithoutContext(GetTraceSourceName(), cb))
+                    {
+                        n++;
+                    }
+                }
+
+                if (GetIdentifierType() == ApplicationStatsHelper::IDENTIFIER_RECEIVER)
+                {
+                    identifier++; // Move to the next accumulator.
+                }
+            }
+
+            NS_LOG_INFO(this << " connected to " << n << " trace sources");
+            break;
+        }
+
         switch (GetOutputType())
         {
         case ApplicationStatsHelper::OUTPUT_SCALAR_FILE:
@@ -321,15 +437,152 @@ ApplicationStatsDelayHelper::DoInstall()
 
 } // end of `void DoInstall ();`
 
+void
+ApplicationStatsDelayHelper::InstallAveraging()
+{
+    NS_LOG_FUNCTION(this);
+
+    // Setup the final-level collector.
+    m_averagingCollector = CreateObject<DistributionCollector>();
+    DistributionCollector::OutputType_t outputType = DistributionCollector::OUTPUT_TYPE_HISTOGRAM;
+    if (GetOutputType() == ApplicationStatsHelper::OUTPUT_PDF_FILE ||
+        GetOutputType() == ApplicationStatsHelper::OUTPUT_PDF_PLOT)
+    {
+        outputType = DistributionCollector::OUTPUT_TYPE_PROBABILITY;
+    }
+    else if (GetOutputType() == ApplicationStatsHelper::OUTPUT_CDF_FILE ||
+             GetOutputType() == ApplicationStatsHelper::OUTPUT_CDF_PLOT)
+    {
+        outputType = DistributionCollector::OUTPUT_TYPE_CUMULATIVE;
+    }
+    m_averagingCollector->SetOutputType(outputType);
+    m_averagingCollector->SetName("0");
+
+    switch (GetOutputType())
+    {
+    case ApplicationStatsHelper::OUTPUT_HISTOGRAM_FILE:
+    case ApplicationStatsHelper::OUTPUT_PDF_FILE:
+    case ApplicationStatsHelper::OUTPUT_CDF_FILE: {
+        // Setup aggregator.
+        m_aggregator = CreateAggregator(GetFileAggregatorTypeName(),
+                                        "OutputFileName",
+                                        StringValue(GetName()),
+                                        "MultiFileMode",
+                                        BooleanValue(false),
+                                        "EnableContextPrinting",
+                                        BooleanValue(false),
+                                        "GeneralHeading",
+                                        StringValue("% " + GetHeadingLabel() + " freq"));
+        ConnectToFileAggregator(m_averagingCollector,
+                                "Output",
+                                "0",
+                                FILE_SINK_WRITE_2D,
+                                m_aggregator);
+        ConnectToFileAggregator(m_averagingCollector,
+                                "OutputString",
+                                "0",
+                                FILE_SINK_CONTEXT_HEADING,
+                                m_aggregator);
+        ConnectToFileAggregator(m_averagingCollector,
+                                "Warning",
+                                "0",
+                                FILE_SINK_CONTEXT_WARNING,
+                                m_aggregator);
+        break;
+    }
+
+    case ApplicationStatsHelper::OUTPUT_HISTOGRAM_PLOT:
+    case ApplicationStatsHelper::OUTPUT_PDF_PLOT:
+    case ApplicationStatsHelper::OUTPUT_CDF_PLOT: {
+        // Setup aggregator.
+        Ptr<GnuplotAggregator> plotAggregator = CreateObject<GnuplotAggregator>(GetName());
+        std::string label = GetLegendLabel();
+        label[0] = std::tolower(label[0]);
+        plotAggregator->SetLegend("Average " + label + " (in seconds)", "Frequency");
+        plotAggregator->Set2dDatasetDefaultStyle(Gnuplot2dDataset::LINES);
+        plotAggregator->Add2dDataset(GetName(), GetName());
+        m_aggregator = plotAggregator;
+        m_averagingCollector->TraceConnect(
+            "Output",
+            GetName(),
+            MakeCallback(&GnuplotAggregator::Write2d, plotAggregator));
+        break;
+    }
+
+    default:
+        NS_FATAL_ERROR("AveragingMode is not supported by " << GetOutputTypeName(GetOutputType()));
+        break;
+    }
+
+    // Setup one accumulator for each identifier.
+    uint32_t n = 1;
+    if (GetIdentifierType() == ApplicationStatsHelper::IDENTIFIER_RECEIVER)
+    {
+        n = m_receiverInfo.size();
+    }
+    else if (GetIdentifierType() == ApplicationStatsHelper::IDENTIFIER_SENDER)
+    {
+        n = m_senderInfo.size();
+    }
+    const Accumulator empty = {0, 0.0};
+    m_accumulators.assign(n, empty);
+    NS_LOG_INFO(this << " created " << n << " accumulator(s)" << " for "
+                     << GetIdentifierTypeName(GetIdentifierType()));
+
+    // The means are final only when the simulation ends.
+    Simulator::ScheduleDestroy(&ApplicationStatsDelayHelper::FlushAccumulators,
+                               Ptr<ApplicationStatsDelayHelper>(this));
+
+} // end of `void InstallAveraging ();`
+
+void // static
+ApplicationStatsDelayHelper::ReceiverDelayCallback(ApplicationStatsDelayHelper* helper,
+                                                   uint32_t identifier,
+                                                   Time delay,
+                                                   const Address& from)
+{
+    if (helper->IsSampled(from))
+    {
+        helper->PassSampleToCollector(delay, identifier);
+    }
+}
+
+void
+ApplicationStatsDelayHelper::FlushAccumulators()
+{
+    NS_LOG_FUNCTION(this);
+
+    for (std::vector<Accumulator>::const_iterator it = m_accumulators.begin();
+         it != m_accumulators.end();
+         ++it)
+    {
+        // Identifiers which have not received anything do not have a mean delay.
+        if (it->n > 0)
+        {
+            m_averagingCollector->TraceSinkDouble1(it->mean);
+        }
+    }
+
+    m_accumulators.clear();
+}
+
 void
 ApplicationStatsDelayHelper::RxDelayCallback(Time delay, const Address& from)
 {
     // NS_LOG_FUNCTION (this << delay.GetSeconds () << from);
 
-    if (InetSocketAddress::IsMatchingType(from))
+    if (!IsSampled(from))
+    {
+        return; // Skip the look-up as well.
+    }
+
+    // Some trace sources (e.g., `RxPlt`) report a bare IPv4 address of the sender.
+    if (InetSocketAddress::IsMatchingType(from) || Ipv4Address::IsMatchingType(from))
     {
         // Determine the identifier associated with the sender address.
-        const Address ipv4Addr = InetSocketAddress::ConvertFrom(from).GetIpv4();
+        const Address ipv4Addr = InetSocketAddress::IsMatchingType(from)
+                                     ? Address(InetSocketAddress::ConvertFrom(from).GetIpv4())
+                                     : from;
         std::map<const Address, uint32_t>::const_iterator it1 = m_identifierMap.find(ipv4Addr);
 
         if (it1 == m_identifierMap.end())
@@ -347,7 +600,7 @@ ApplicationStatsDelayHelper::RxDelayCallback(Time delay, const Address& from)
     {
         NS_LOG_WARN(this << " discarding a packet delay of " << delay.GetSeconds()
                          << " from statistics collection" << " because it comes from sender "
-                         << from << " without valid InetSocketAddress");
+                         << from << " without valid IPv4 address");
     }
 
 } // end of `void RxDelayCallback (Time, const Address &)`
@@ -394,6 +647,18 @@ ApplicationStatsDelayHelper::PassSampleToCollector(Time delay, uint32_t identifi
 {
     // NS_LOG_FUNCTION (this << delay.GetSeconds () << identifier);
 
+    if (m_averagingMode)
+    {
+        NS_ASSERT_MSG(identifier < m_accumulators.size(),
+                      "Unable to find accumulator with identifier " << identifier);
+
+        // Welford's running mean, which stays accurate without keeping the sum.
+        Accumulator& acc = m_accumulators[identifier];
+        acc.n++;
+        acc.mean += (delay.GetSeconds() - acc.mean) / acc.n;
+        return;
+    }
+
     Ptr<DataCollectionObject> collector = m_terminalCollectors.Get(identifier);
     NS_ASSERT_MSG(collector != nullptr, "Unable to find collector with identifier " << identifier);
 
@@ -30,6 +30,8 @@
 
 #include <list>
 #include <map>
+#include <string>
+#include <vector>
 
 namespace ns3
 {
@@ -39,10 +41,28 @@ namespace ns3
 class Application;
 class Time;
 class DataCollectionObject;
+class DistributionCollector;
 
 /**
  * @ingroup applicationstats
- * @brief
+ * @brief Produce delay statistics from a trace source of the receiver
+ *        applications which reports a delay and the sender address.
+ *
+ * When the `SamplingRatio` attribute is N > 1, only the selected samples (see
+ * ApplicationStatsHelper) are recorded, and without any scaling: every output
+ * of this helper is a mean or a distribution, which is estimated from the
+ * recorded samples. In `PACKETS` mode the estimate of a run is off if the
+ * delay is correlated with the arrival order of the packets at period N,
+ * e.g., a sender which bursts exactly N packets at a time. In `FLOWS` mode
+ * every packet of a selected flow is recorded, so the estimate of a run is
+ * off if the selected flows differ from the others, e.g., in path length.
+ * Since the selection is salted with the seed and run number, these errors
+ * change from one replication to the next instead of repeating in every run,
+ * and they shrink when the results of several replications are combined.
+ * The variance grows as the number of recorded samples shrinks, so
+ * per-sender and per-receiver outputs need a lower ratio than global outputs.
+ * Samples are selected before they reach any probe or collector, so the
+ * skipped samples cost only a counter update or a hash.
  */
 class ApplicationStatsDelayHelper : public ApplicationStatsHelper
 {
@@ -56,6 +76,23 @@ class ApplicationStatsDelayHelper : public ApplicationStatsHelper
     // inherited from ObjectBase base class
     static TypeId GetTypeId();
 
+    /**
+     * @param averagingMode average all samples of each identifier before
+     *                      passing them to aggregator.
+     */
+    void SetAveragingMode(bool averagingMode);
+
+    /**
+     * @return the currently active averaging mode.
+     */
+    bool GetAveragingMode() const;
+
+    /**
+     * @return the aggregator created by Install(), or a null pointer before
+     *         the installation.
+     */
+    Ptr<DataCollectionObject> GetAggregator() const;
+
     /**
      * @brief Receive inputs from trace sources and determine the right collector
      *        to forward the inputs to.
@@ -74,7 +111,46 @@ class ApplicationStatsDelayHelper : public ApplicationStatsHelper
     // inherited from ApplicationStatsHelper base class
     virtual void DoInstall();
 
+    /**
+     * @return the column name of the samples in the heading of output files,
+     *         e.g., `delay_sec`.
+     */
+    virtual std::string GetHeadingLabel() const;
+
+    /**
+     * @return the name of the samples in the legend of output plots, e.g.,
+     *         `Packet delay`. The unit is appended automatically.
+     */
+    virtual std::string GetLegendLabel() const;
+
   private:
+    /**
+     * @brief Install the accumulators, the final collector, and the aggregator
+     *        of averaging mode.
+     *
+     * Each identifier keeps a running mean of its delay samples in
+     * #m_accumulators. The means are passed to #m_averagingCollector only once,
+     * by FlushAccumulators() at the end of simulation, so the memory usage does
+     * not grow with the number of samples.
+     */
+    void InstallAveraging();
+
+    /**
+     * @brief Receive delay samples from a receiver application in averaging
+     *        mode or with sampling, with `GLOBAL` or `RECEIVER` identifier.
+     * @param helper the helper instance.
+     * @param identifier the identifier associated with the receiver.
+     * @param delay packet delay.
+     * @param from the address of the sender of the packet.
+     */
+    static void ReceiverDelayCallback(ApplicationStatsDelayHelper* helper,
+                                      uint32_t identifier,
+                                      Time delay,
+                                      const Address& from);
+
+    /// Pass the mean of each identifier to the final collector.
+    void FlushAccumulators();
+
     /**
      * @brief Associate the given application's IPv4 address with the given
      *        identifier.
@@ -107,6 +183,21 @@ class ApplicationStatsDelayHelper : public ApplicationStatsHelper
     /// Map of address and the `SENDER` identifier associated with it.
     std::map<const Address, uint32_t> m_identifierMap;
 
+    /// Running mean of the delay samples of a single identifier.
+    struct Accumulator
+    {
+        uint64_t n;  ///< Number of samples so far.
+        double mean; ///< Mean of the samples so far, in seconds.
+    };
+
+    /// Accumulators utilized in averaged output, indexed by the identifier.
+    std::vector<Accumulator> m_accumulators;
+
+    /// The final collector utilized in averaged output (histogram, PDF, and CDF).
+    Ptr<DistributionCollector> m_averagingCollector;
+
+    bool m_averagingMode; ///< `AveragingMode` attribute.
+
 }; // end of class ApplicationStatsDelayHelper
 
 } // end of namespace ns3
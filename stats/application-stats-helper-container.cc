@@ -23,11 +23,15 @@
 
 #include "application-stats-delay-helper.h"
 #include "application-stats-helper.h"
+#include "application-stats-plt-helper.h"
+#include "application-stats-rtt-helper.h"
 #include "application-stats-throughput-helper.h"
 
 #include "ns3/enum.h"
 #include "ns3/log.h"
+#include "ns3/nstime.h"
 #include "ns3/string.h"
+#include "ns3/uinteger.h"
 
 #include <map>
 #include <sstream>
@@ -41,6 +45,9 @@ namespace ns3
 NS_OBJECT_ENSURE_REGISTERED(ApplicationStatsHelperContainer);
 
 ApplicationStatsHelperContainer::ApplicationStatsHelperContainer()
+    : m_warmUpTime(Seconds(0)),
+      m_samplingRatio(1),
+      m_samplingMode(ApplicationStatsHelper::SAMPLING_PACKETS)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -60,6 +67,10 @@ ApplicationStatsHelperContainer::DoDispose()
  * - [Global,PerReceiver,PerSender] Delay
  * - Average [PerReceiver,PerSender] Throughput
  * - Average [PerReceiver,PerSender] Delay
+ * - [Global,PerReceiver,PerSender] Plt
+ * - Average [PerReceiver,PerSender] Plt
+ * - [Global,PerReceiver,PerSender] Rtt
+ * - Average [PerReceiver,PerSender] Rtt
  *
  * Also check the Doxygen documentation of this class for more information.
  */
@@ -142,6 +153,31 @@ ApplicationStatsHelperContainer::GetTypeId()
                 MakeStringAccessor(&ApplicationStatsHelperContainer::SetTraceSourceName,
                                    &ApplicationStatsHelperContainer::GetTraceSourceName),
                 MakeStringChecker())
+            .AddAttribute("WarmUpTime",
+                          "Samples generated before this simulation time are ignored by the "
+                          "statistics added afterwards to this container",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&ApplicationStatsHelperContainer::SetWarmUpTime,
+                                           &ApplicationStatsHelperContainer::GetWarmUpTime),
+                          MakeTimeChecker())
+            .AddAttribute("SamplingRatio",
+                          "Only one in this many samples is recorded by the statistics added "
+                          "afterwards to this container",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&ApplicationStatsHelperContainer::SetSamplingRatio,
+                                               &ApplicationStatsHelperContainer::GetSamplingRatio),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("SamplingMode",
+                          "How the recorded samples are selected by the statistics added "
+                          "afterwards to this container",
+                          EnumValue(ApplicationStatsHelper::SAMPLING_PACKETS),
+                          MakeEnumAccessor<ApplicationStatsHelper::SamplingMode_t>(
+                              &ApplicationStatsHelperContainer::SetSamplingMode,
+                              &ApplicationStatsHelperContainer::GetSamplingMode),
+                          MakeEnumChecker(ApplicationStatsHelper::SAMPLING_PACKETS,
+                                          "PACKETS",
+                                          ApplicationStatsHelper::SAMPLING_FLOWS,
+                                          "FLOWS"))
 
         // Throughput statistics.
         ADD_APPLICATION_STATS_ATTRIBUTES_BASIC_SET(Throughput, "throughput statistics")
@@ -149,8 +185,15 @@ ApplicationStatsHelperContainer::GetTypeId()
 
         // Delay statistics.
         ADD_APPLICATION_STATS_ATTRIBUTES_DISTRIBUTION_SET(Delay, "packet delay statistics")
-        //    ADD_SAT_STATS_ATTRIBUTES_AVERAGED_DISTRIBUTION_SET (Delay,
-        //                                                        "packet delay statistics")
+            ADD_SAT_STATS_ATTRIBUTES_AVERAGED_DISTRIBUTION_SET(Delay, "packet delay statistics")
+
+        // Page load time statistics.
+        ADD_APPLICATION_STATS_ATTRIBUTES_DISTRIBUTION_SET(Plt, "page load time statistics")
+            ADD_SAT_STATS_ATTRIBUTES_AVERAGED_DISTRIBUTION_SET(Plt, "page load time statistics")
+
+        // Round trip time statistics.
+        ADD_APPLICATION_STATS_ATTRIBUTES_DISTRIBUTION_SET(Rtt, "round trip time statistics")
+            ADD_SAT_STATS_ATTRIBUTES_AVERAGED_DISTRIBUTION_SET(Rtt, "round trip time statistics")
 
         ;
     return tid;
@@ -190,6 +233,56 @@ ApplicationStatsHelperContainer::GetTraceSourceName() const
     return m_traceSourceName;
 }
 
+void
+ApplicationStatsHelperContainer::SetWarmUpTime(Time warmUpTime)
+{
+    NS_LOG_FUNCTION(this << warmUpTime.GetSeconds());
+    m_warmUpTime = warmUpTime;
+}
+
+Time
+ApplicationStatsHelperContainer::GetWarmUpTime() const
+{
+    return m_warmUpTime;
+}
+
+void
+ApplicationStatsHelperContainer::SetSampling(uint32_t samplingRatio,
+                                             ApplicationStatsHelper::SamplingMode_t samplingMode)
+{
+    NS_LOG_FUNCTION(this << samplingRatio << samplingMode);
+    SetSamplingRatio(samplingRatio);
+    SetSamplingMode(samplingMode);
+}
+
+void
+ApplicationStatsHelperContainer::SetSamplingRatio(uint32_t samplingRatio)
+{
+    NS_LOG_FUNCTION(this << samplingRatio);
+    NS_ASSERT_MSG(samplingRatio > 0, "Sampling ratio must be at least 1");
+    m_samplingRatio = samplingRatio;
+}
+
+uint32_t
+ApplicationStatsHelperContainer::GetSamplingRatio() const
+{
+    return m_samplingRatio;
+}
+
+void
+ApplicationStatsHelperContainer::SetSamplingMode(
+    ApplicationStatsHelper::SamplingMode_t samplingMode)
+{
+    NS_LOG_FUNCTION(this << samplingMode);
+    m_samplingMode = samplingMode;
+}
+
+ApplicationStatsHelper::SamplingMode_t
+ApplicationStatsHelperContainer::GetSamplingMode() const
+{
+    return m_samplingMode;
+}
+
 /*
  * The macro definitions following this comment block are used to declare the
  * majority of methods in this class. Below is the list of the class methods
@@ -199,11 +292,15 @@ ApplicationStatsHelperContainer::GetTraceSourceName() const
  * - AddAverage [Receiver,Sender] Throughput
  * - Add [Global,PerReceiver,PerSender] Delay
  * - AddAverage [Receiver,Sender] Delay
+ * - Add [Global,PerReceiver,PerSender] Plt
+ * - AddAverage [Receiver,Sender] Plt
+ * - Add [Global,PerReceiver,PerSender] Rtt
+ * - AddAverage [Receiver,Sender] Rtt
  *
  * Also check the Doxygen documentation of this class for more information.
  */
 
-#define APPLICATION_STATS_METHOD_DEFINITION(id, name)                                              \
+#define APPLICATION_STATS_METHOD_DEFINITION_WITH_TRACE(id, name, trace)                            \
     void ApplicationStatsHelperContainer::AddGlobal##id(ApplicationStatsHelper::OutputType_t type) \
     {                                                                                              \
         NS_LOG_FUNCTION(this << ApplicationStatsHelper::GetOutputTypeName(type));                  \
@@ -211,9 +308,12 @@ ApplicationStatsHelperContainer::GetTraceSourceName() const
         {                                                                                          \
             Ptr<ApplicationStats##id##Helper> stat = CreateObject<ApplicationStats##id##Helper>(); \
             stat->SetName(m_name + "-global-" + name + GetOutputTypeSuffix(type));                 \
-            stat->SetTraceSourceName(m_traceSourceName);                                           \
+            stat->SetTraceSourceName(trace);                                                       \
             stat->SetIdentifierType(ApplicationStatsHelper::IDENTIFIER_GLOBAL);                    \
             stat->SetOutputType(type);                                                             \
+            stat->SetWarmUpTime(m_warmUpTime);                                                     \
+            stat->SetSamplingRatio(m_samplingRatio);                                               \
+            stat->SetSamplingMode(m_samplingMode);                                                 \
             stat->SetSenderInformation(m_senderInfo);                                              \
             stat->SetReceiverInformation(m_receiverInfo);                                          \
             stat->Install();                                                                       \
@@ -228,9 +328,12 @@ ApplicationStatsHelperContainer::GetTraceSourceName() const
         {                                                                                          \
             Ptr<ApplicationStats##id##Helper> stat = CreateObject<ApplicationStats##id##Helper>(); \
             stat->SetName(m_name + "-per-receiver-" + name + GetOutputTypeSuffix(type));           \
-            stat->SetTraceSourceName(m_traceSourceName);                                           \
+            stat->SetTraceSourceName(trace);                                                       \
             stat->SetIdentifierType(ApplicationStatsHelper::IDENTIFIER_RECEIVER);                  \
             stat->SetOutputType(type);                                                             \
+            stat->SetWarmUpTime(m_warmUpTime);                                                     \
+            stat->SetSamplingRatio(m_samplingRatio);                                               \
+            stat->SetSamplingMode(m_samplingMode);                                                 \
             stat->SetSenderInformation(m_senderInfo);                                              \
             stat->SetReceiverInformation(m_receiverInfo);                                          \
             stat->Install();                                                                       \
@@ -245,9 +348,12 @@ ApplicationStatsHelperContainer::GetTraceSourceName() const
         {                                                                                          \
             Ptr<ApplicationStats##id##Helper> stat = CreateObject<ApplicationStats##id##Helper>(); \
             stat->SetName(m_name + "-per-sender-" + name + GetOutputTypeSuffix(type));             \
-            stat->SetTraceSourceName(m_traceSourceName);                                           \
+            stat->SetTraceSourceName(trace);                                                       \
             stat->SetIdentifierType(ApplicationStatsHelper::IDENTIFIER_SENDER);                    \
             stat->SetOutputType(type);                                                             \
+            stat->SetWarmUpTime(m_warmUpTime);                                                     \
+            stat->SetSamplingRatio(m_samplingRatio);                                               \
+            stat->SetSamplingMode(m_samplingMode);                                                 \
             stat->SetSenderInformation(m_senderInfo);                                              \
             stat->SetReceiverInformation(m_receiverInfo);                                          \
             stat->Install();                                                                       \
@@ -255,7 +361,7 @@ ApplicationStatsHelperContainer::GetTraceSourceName() const
         }                                                                                          \
     }
 
-#define APPLICATION_STATS_AVERAGE_METHOD_DEFINITION(id, name)                                      \
+#define APPLICATION_STATS_AVERAGE_METHOD_DEFINITION_WITH_TRACE(id, name, trace)                    \
     void ApplicationStatsHelperContainer::AddAverageReceiver##id(                                  \
         ApplicationStatsHelper::OutputType_t type)                                                 \
     {                                                                                              \
@@ -264,9 +370,12 @@ ApplicationStatsHelperContainer::GetTraceSourceName() const
         {                                                                                          \
             Ptr<ApplicationStats##id##Helper> stat = CreateObject<ApplicationStats##id##Helper>(); \
             stat->SetName(m_name + "-average-receiver-" + name + GetOutputTypeSuffix(type));       \
-            stat->SetTraceSourceName(m_traceSourceName);                                           \
+            stat->SetTraceSourceName(trace);                                                       \
             stat->SetIdentifierType(ApplicationStatsHelper::IDENTIFIER_RECEIVER);                  \
             stat->SetOutputType(type);                                                             \
+            stat->SetWarmUpTime(m_warmUpTime);                                                     \
+            stat->SetSamplingRatio(m_samplingRatio);                                               \
+            stat->SetSamplingMode(m_samplingMode);                                                 \
             stat->SetAveragingMode(true);                                                          \
             stat->SetSenderInformation(m_senderInfo);                                              \
             stat->SetReceiverInformation(m_receiverInfo);                                          \
@@ -282,9 +391,12 @@ ApplicationStatsHelperContainer::GetTraceSourceName() const
         {                                                                                          \
             Ptr<ApplicationStats##id##Helper> stat = CreateObject<ApplicationStats##id##Helper>(); \
             stat->SetName(m_name + "-average-sender-" + name + GetOutputTypeSuffix(type));         \
-            stat->SetTraceSourceName(m_traceSourceName);                                           \
+            stat->SetTraceSourceName(trace);                                                       \
             stat->SetIdentifierType(ApplicationStatsHelper::IDENTIFIER_SENDER);                    \
             stat->SetOutputType(type);                                                             \
+            stat->SetWarmUpTime(m_warmUpTime);                                                     \
+            stat->SetSamplingRatio(m_samplingRatio);                                               \
+            stat->SetSamplingMode(m_samplingMode);                                                 \
             stat->SetAveragingMode(true);                                                          \
             stat->SetSenderInformation(m_senderInfo);                                              \
             stat->SetReceiverInformation(m_receiverInfo);                                          \
@@ -293,14 +405,27 @@ ApplicationStatsHelperContainer::GetTraceSourceName() const
         }                                                                                          \
     }
 
+#define APPLICATION_STATS_METHOD_DEFINITION(id, name)                                              \
+    APPLICATION_STATS_METHOD_DEFINITION_WITH_TRACE(id, name, m_traceSourceName)
+
+#define APPLICATION_STATS_AVERAGE_METHOD_DEFINITION(id, name)                                      \
+    APPLICATION_STATS_AVERAGE_METHOD_DEFINITION_WITH_TRACE(id, name, m_traceSourceName)
+
 // Throughput statistics.
 APPLICATION_STATS_METHOD_DEFINITION(Throughput, "throughput")
 APPLICATION_STATS_AVERAGE_METHOD_DEFINITION(Throughput, "throughput")
 
 // Delay statistics.
 APPLICATION_STATS_METHOD_DEFINITION(Delay, "delay")
+APPLICATION_STATS_AVERAGE_METHOD_DEFINITION(Delay, "delay")
+
+// Page load time statistics, always taken from the `RxPlt` trace source.
+APPLICATION_STATS_METHOD_DEFINITION_WITH_TRACE(Plt, "plt", "RxPlt")
+APPLICATION_STATS_AVERAGE_METHOD_DEFINITION_WITH_TRACE(Plt, "plt", "RxPlt")
 
-// APPLICATION_STATS_AVERAGE_METHOD_DEFINITION (Delay, "delay")
+// Round trip time statistics, always taken from the `RxRtt` trace source.
+APPLICATION_STATS_METHOD_DEFINITION_WITH_TRACE(Rtt, "rtt", "RxRtt")
+APPLICATION_STATS_AVERAGE_METHOD_DEFINITION_WITH_TRACE(Rtt, "rtt", "RxRtt")
 
 std::string // static
 ApplicationStatsHelperContainer::GetOutputTypeSuffix(
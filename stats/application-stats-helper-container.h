@@ -26,6 +26,7 @@
 
 #include "ns3/application-container.h"
 #include "ns3/node-container.h"
+#include "ns3/nstime.h"
 #include "ns3/object.h"
 #include "ns3/ptr.h"
 
@@ -43,6 +44,8 @@ namespace ns3
  *
  * - Add [Global,PerReceiver,PerSender] Throughput
  * - Add [Global,PerReceiver,PerSender] Delay
+ * - Add [Global,PerReceiver,PerSender] Plt
+ * - Add [Global,PerReceiver,PerSender] Rtt
  *
  * Also check the Doxygen documentation of this class for more information.
  */
@@ -81,6 +84,27 @@ namespace ns3
  * which will produce output files with the names such as
  * `stat-per-receiver-throughput-scalar.txt`,
  * `stat-per-receiver-delay-cdf-receiver-1.txt`, etc.
+ *
+ * Page load time and round trip time statistics (e.g., AddPerSenderPlt() and
+ * AddGlobalRtt()) ignore the `TraceSourceName` attribute and always listen to
+ * the `RxPlt` and `RxRtt` trace sources, which are exported by
+ * ThreeGppHttpSatelliteClient. Hence they can be added to the same container
+ * as, e.g., delay statistics taken from `RxDelay`.
+ *
+ * When the simulation starts with a transient period which should be left out
+ * of the results, e.g., while an AdmissionRampController is still admitting
+ * clients, set the `WarmUpTime` attribute or call SetWarmUpTime() *before*
+ * adding the statistics. The statistics added afterwards ignore every sample
+ * generated before the warm-up time (see ApplicationStatsHelper::Install()).
+ *
+ * Similarly, the `SamplingRatio` and `SamplingMode` attributes, or
+ * SetSampling(), restrict the statistics added afterwards to a sample of the
+ * packets, e.g., a ratio of 100 records about 1% of them. Delay statistics
+ * are estimated from the recorded samples, while throughput statistics are
+ * scaled up by the ratio (see ApplicationStatsDelayHelper and
+ * ApplicationStatsThroughputHelper). Page load time and round trip time
+ * statistics are sampled in the same way, which is seldom useful, so they are
+ * better added before setting the ratio.
  */
 class ApplicationStatsHelperContainer : public Object
 {
@@ -128,6 +152,47 @@ class ApplicationStatsHelperContainer : public Object
      */
     std::string GetTraceSourceName() const;
 
+    /**
+     * @param warmUpTime the simulation time before which samples are ignored
+     *                   by the statistics added afterwards to this container.
+     */
+    void SetWarmUpTime(Time warmUpTime);
+
+    /**
+     * @return the simulation time before which samples are ignored.
+     */
+    Time GetWarmUpTime() const;
+
+    /**
+     * @param samplingRatio record only one in this many samples in the
+     *                      statistics added afterwards to this container.
+     * @param samplingMode how the recorded samples are selected.
+     */
+    void SetSampling(uint32_t samplingRatio,
+                     ApplicationStatsHelper::SamplingMode_t samplingMode =
+                         ApplicationStatsHelper::SAMPLING_PACKETS);
+
+    /**
+     * @param samplingRatio record only one in this many samples in the
+     *                      statistics added afterwards to this container.
+     */
+    void SetSamplingRatio(uint32_t samplingRatio);
+
+    /**
+     * @return one in how many samples is recorded.
+     */
+    uint32_t GetSamplingRatio() const;
+
+    /**
+     * @param samplingMode how the recorded samples are selected.
+     */
+    void SetSamplingMode(ApplicationStatsHelper::SamplingMode_t samplingMode);
+
+    /**
+     * @return how the recorded samples are selected.
+     */
+    ApplicationStatsHelper::SamplingMode_t GetSamplingMode() const;
+
     // Throughput statistics.
     APPLICATION_STATS_METHOD_DECLARATION(Throughput)
     void AddAverageSenderThroughput(ApplicationStatsHelper::OutputType_t outputType);
@@ -135,8 +200,18 @@ class ApplicationStatsHelperContainer : public Object
 
     // Delay statistics.
     APPLICATION_STATS_METHOD_DECLARATION(Delay)
-    //  void AddAverageSenderDelay (ApplicationStatsHelper::OutputType_t outputType);
-    //  void AddAverageReceiverDelay (ApplicationStatsHelper::OutputType_t outputType);
+    void AddAverageSenderDelay(ApplicationStatsHelper::OutputType_t outputType);
+    void AddAverageReceiverDelay(ApplicationStatsHelper::OutputType_t outputType);
+
+    // Page load time statistics (from the `RxPlt` trace source).
+    APPLICATION_STATS_METHOD_DECLARATION(Plt)
+    void AddAverageSenderPlt(ApplicationStatsHelper::OutputType_t outputType);
+    void AddAverageReceiverPlt(ApplicationStatsHelper::OutputType_t outputType);
+
+    // Round trip time statistics (from the `RxRtt` trace source).
+    APPLICATION_STATS_METHOD_DECLARATION(Rtt)
+    void AddAverageSenderRtt(ApplicationStatsHelper::OutputType_t outputType);
+    void AddAverageReceiverRtt(ApplicationStatsHelper::OutputType_t outputType);
 
     /**
      * @param outputType an arbitrary output type.
@@ -238,6 +313,15 @@ class ApplicationStatsHelperContainer : public Object
     /// The name of the application's trace source which produce the required information.
     std::string m_traceSourceName;
 
+    /// The simulation time before which samples are ignored.
+    Time m_warmUpTime;
+
+    /// One in how many samples is recorded.
+    uint32_t m_samplingRatio;
+
+    /// How the recorded samples are selected.
+    ApplicationStatsHelper::SamplingMode_t m_samplingMode;
+
     /// Maintains the active ApplicationStatsHelper instances which have created.
     std::list<Ptr<const ApplicationStatsHelper>> m_stats;
 
@@ -21,16 +21,26 @@
 
 #include "application-stats-helper.h"
 
+#include "async-file-aggregator.h"
+
 #include "ns3/address.h"
+#include "ns3/boolean.h"
 #include "ns3/data-collection-object.h"
 #include "ns3/enum.h"
+#include "ns3/hash.h"
 #include "ns3/log.h"
+#include "ns3/multi-file-aggregator.h"
 #include "ns3/object-factory.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
 #include "ns3/string.h"
+#include "ns3/uinteger.h"
 
+#include <cstring>
 #include <map>
 #include <sstream>
 #include <string>
+#include <vector>
 
 NS_LOG_COMPONENT_DEFINE("ApplicationStatsHelper");
 
@@ -39,6 +49,93 @@ namespace ns3
 
 NS_OBJECT_ENSURE_REGISTERED(ApplicationStatsHelper);
 
+/*
+ * MultiFileAggregator and AsyncFileAggregator have the same sink methods but
+ * no common base class with them, hence the file sinks are resolved on the
+ * aggregator type by the two function templates below.
+ */
+
+template <class A>
+static bool
+ConnectCollectorsToSink(CollectorMap& collectorMap,
+                        std::string traceSourceName,
+                        ApplicationStatsHelper::FileSink_t sink,
+                        Ptr<DataCollectionObject> aggregator)
+{
+    switch (sink)
+    {
+    case ApplicationStatsHelper::FILE_SINK_WRITE_1D:
+        return collectorMap.ConnectToAggregator(traceSourceName, aggregator, &A::Write1d);
+    case ApplicationStatsHelper::FILE_SINK_WRITE_2D:
+        return collectorMap.ConnectToAggregator(traceSourceName, aggregator, &A::Write2d);
+    case ApplicationStatsHelper::FILE_SINK_CONTEXT_HEADING:
+        return collectorMap.ConnectToAggregator(traceSourceName,
+                                                aggregator,
+                                                &A::AddContextHeading);
+    case ApplicationStatsHelper::FILE_SINK_CONTEXT_WARNING:
+        return collectorMap.ConnectToAggregator(traceSourceName,
+                                                aggregator,
+                                                &A::EnableContextWarning);
+    default:
+        NS_FATAL_ERROR("ApplicationStatsHelper - Invalid file sink");
+        break;
+    }
+
+    return false;
+}
+
+template <class C>
+static bool
+ConnectObjectToCallback(Ptr<Object> source,
+                        std::string traceSourceName,
+                        std::string context,
+                        C cb)
+{
+    return context.empty() ? source->TraceConnectWithoutContext(traceSourceName, cb)
+                           : source->TraceConnect(traceSourceName, context, cb);
+}
+
+template <class A>
+static bool
+ConnectObjectToSink(Ptr<Object> source,
+                    std::string traceSourceName,
+                    std::string context,
+                    ApplicationStatsHelper::FileSink_t sink,
+                    Ptr<DataCollectionObject> aggregator)
+{
+    Ptr<A> a = aggregator->GetObject<A>();
+    NS_ASSERT(a != nullptr);
+
+    switch (sink)
+    {
+    case ApplicationStatsHelper::FILE_SINK_WRITE_1D:
+        return ConnectObjectToCallback(source,
+                                       traceSourceName,
+                                       context,
+                                       MakeCallback(&A::Write1d, a));
+    case ApplicationStatsHelper::FILE_SINK_WRITE_2D:
+        return ConnectObjectToCallback(source,
+                                       traceSourceName,
+                                       context,
+                                       MakeCallback(&A::Write2d, a));
+    case ApplicationStatsHelper::FILE_SINK_CONTEXT_HEADING:
+        return ConnectObjectToCallback(source,
+                                       traceSourceName,
+                                       context,
+                                       MakeCallback(&A::AddContextHeading, a));
+    case ApplicationStatsHelper::FILE_SINK_CONTEXT_WARNING:
+        return ConnectObjectToCallback(source,
+                                       traceSourceName,
+                                       context,
+                                       MakeCallback(&A::EnableContextWarning, a));
+    default:
+        NS_FATAL_ERROR("ApplicationStatsHelper - Invalid file sink");
+        break;
+    }
+
+    return false;
+}
+
 std::string // static
 ApplicationStatsHelper::GetIdentifierTypeName(
     ApplicationStatsHelper::IdentifierType_t identifierType)
@@ -101,6 +198,13 @@ ApplicationStatsHelper::ApplicationStatsHelper()
       m_identifierType(ApplicationStatsHelper::IDENTIFIER_GLOBAL),
       m_outputType(ApplicationStatsHelper::OUTPUT_SCATTER_FILE),
       m_traceSourceName(""),
+      m_isAsyncFileOutput(false),
+      m_isCompressedFileOutput(false),
+      m_warmUpTime(Seconds(0)),
+      m_samplingRatio(1),
+      m_samplingMode(ApplicationStatsHelper::SAMPLING_PACKETS),
+      m_sampleCounter(0),
+      m_samplingSalt(0),
       m_isInstalled(false)
 {
     NS_LOG_FUNCTION(this);
@@ -109,6 +213,7 @@ ApplicationStatsHelper::ApplicationStatsHelper()
 ApplicationStatsHelper::~ApplicationStatsHelper()
 {
     NS_LOG_FUNCTION(this);
+    m_installEvent.Cancel();
 }
 
 TypeId // static
@@ -167,7 +272,49 @@ ApplicationStatsHelper::GetTypeId()
                                           ApplicationStatsHelper::OUTPUT_PDF_PLOT,
                                           "PDF_PLOT",
                                           ApplicationStatsHelper::OUTPUT_CDF_PLOT,
-                                          "CDF_PLOT"));
+                                          "CDF_PLOT"))
+            .AddAttribute("AsyncFileOutput",
+                          "If true, file output types are formatted and written to disk by a "
+                          "background thread, so that the simulation does not wait for the "
+                          "file system. Plot output types are not affected.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&ApplicationStatsHelper::SetAsyncFileOutput,
+                                              &ApplicationStatsHelper::IsAsyncFileOutput),
+                          MakeBooleanChecker())
+            .AddAttribute("CompressedFileOutput",
+                          "If true, file output types are passed through a streaming "
+                          "compressor (zstd or zlib, whichever is available at build time) "
+                          "before being written to disk. Plot output types are not affected.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&ApplicationStatsHelper::SetCompressedFileOutput,
+                                              &ApplicationStatsHelper::IsCompressedFileOutput),
+                          MakeBooleanChecker())
+            .AddAttribute("WarmUpTime",
+                          "Samples generated before this simulation time are ignored. The "
+                          "probes and collectors are only installed once the time is reached, "
+                          "so the warm-up period does not incur any statistics overhead.",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&ApplicationStatsHelper::SetWarmUpTime,
+                                           &ApplicationStatsHelper::GetWarmUpTime),
+                          MakeTimeChecker())
+            .AddAttribute("SamplingRatio",
+                          "Record only one in this many samples, to reduce the statistics "
+                          "overhead of per-packet trace sources. 1 records every sample.",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&ApplicationStatsHelper::SetSamplingRatio,
+                                               &ApplicationStatsHelper::GetSamplingRatio),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("SamplingMode",
+                          "Determines how the recorded samples are selected when "
+                          "SamplingRatio is greater than one.",
+                          EnumValue(ApplicationStatsHelper::SAMPLING_PACKETS),
+                          MakeEnumAccessor<ApplicationStatsHelper::SamplingMode_t>(
+                              &ApplicationStatsHelper::SetSamplingMode,
+                              &ApplicationStatsHelper::GetSamplingMode),
+                          MakeEnumChecker(ApplicationStatsHelper::SAMPLING_PACKETS,
+                                          "PACKETS",
+                                          ApplicationStatsHelper::SAMPLING_FLOWS,
+                                          "FLOWS"));
     return tid;
 }
 
@@ -194,11 +341,30 @@ ApplicationStatsHelper::Install()
     {
         NS_FATAL_ERROR("Trace source name must not be blank.");
     }
-    else if (m_outputType == ApplicationStatsHelper::OUTPUT_NONE)
+
+    /*
+     * Salt the sample selection with the seed and run number, so that it
+     * differs between replications but not between the helpers of a run. The
+     * salt is also the starting point of the counter in `PACKETS` mode.
+     */
+    std::ostringstream oss;
+    oss << RngSeedManager::GetSeed() << " " << RngSeedManager::GetRun();
+    m_samplingSalt = Hash32(oss.str());
+    m_sampleCounter = m_samplingSalt;
+
+    if (m_outputType == ApplicationStatsHelper::OUTPUT_NONE)
     {
         NS_LOG_WARN(this << " Skipping statistics installation"
                          << " because OUTPUT_NONE output type is selected.");
     }
+    else if (m_warmUpTime > Simulator::Now())
+    {
+        NS_LOG_INFO(this << " postponing statistics installation"
+                         << " until the warm-up time " << m_warmUpTime.GetSeconds() << "s");
+        m_installEvent = Simulator::Schedule(m_warmUpTime - Simulator::Now(),
+                                             &ApplicationStatsHelper::InstallAfterWarmUp,
+                                             this);
+    }
     else
     {
         DoInstall(); // this method is supposed to be implemented by the child class
@@ -206,6 +372,14 @@ ApplicationStatsHelper::Install()
     }
 }
 
+void
+ApplicationStatsHelper::InstallAfterWarmUp()
+{
+    NS_LOG_FUNCTION(this);
+    DoInstall();
+    m_isInstalled = true;
+}
+
 void
 ApplicationStatsHelper::SetName(std::string name)
 {
@@ -245,7 +419,7 @@ ApplicationStatsHelper::SetIdentifierType(ApplicationStatsHelper::IdentifierType
 {
     NS_LOG_FUNCTION(this << GetIdentifierTypeName(identifierType));
 
-    if (m_isInstalled && (m_identifierType != identifierType))
+    if ((m_isInstalled || IsInstallPending()) && (m_identifierType != identifierType))
     {
         NS_LOG_WARN(this << " cannot modify the current identifier type" << " ("
                          << GetIdentifierTypeName(m_identifierType) << ")"
@@ -268,7 +442,7 @@ ApplicationStatsHelper::SetOutputType(ApplicationStatsHelper::OutputType_t outpu
 {
     NS_LOG_FUNCTION(this << GetOutputTypeName(outputType));
 
-    if (m_isInstalled && (m_outputType != outputType))
+    if ((m_isInstalled || IsInstallPending()) && (m_outputType != outputType))
     {
         NS_LOG_WARN(this << " cannot modify the current output type" << " ("
                          << GetIdentifierTypeName(m_identifierType) << ")"
@@ -286,12 +460,144 @@ ApplicationStatsHelper::GetOutputType() const
     return m_outputType;
 }
 
+void
+ApplicationStatsHelper::SetAsyncFileOutput(bool asyncFileOutput)
+{
+    NS_LOG_FUNCTION(this << asyncFileOutput);
+
+    if ((m_isInstalled || IsInstallPending()) && (m_isAsyncFileOutput != asyncFileOutput))
+    {
+        NS_LOG_WARN(this << " cannot modify the current file output mode"
+                         << " because this instance have already been installed");
+    }
+    else
+    {
+        m_isAsyncFileOutput = asyncFileOutput;
+    }
+}
+
+bool
+ApplicationStatsHelper::IsAsyncFileOutput() const
+{
+    return m_isAsyncFileOutput;
+}
+
+void
+ApplicationStatsHelper::SetCompressedFileOutput(bool compressedFileOutput)
+{
+    NS_LOG_FUNCTION(this << compressedFileOutput);
+
+    if ((m_isInstalled || IsInstallPending()) && (m_isCompressedFileOutput != compressedFileOutput))
+    {
+        NS_LOG_WARN(this << " cannot modify the current file compression"
+                         << " because this instance have already been installed");
+    }
+    else
+    {
+        m_isCompressedFileOutput = compressedFileOutput;
+    }
+}
+
+bool
+ApplicationStatsHelper::IsCompressedFileOutput() const
+{
+    return m_isCompressedFileOutput;
+}
+
+void
+ApplicationStatsHelper::SetWarmUpTime(Time warmUpTime)
+{
+    NS_LOG_FUNCTION(this << warmUpTime.GetSeconds());
+
+    if ((m_isInstalled || IsInstallPending()) && (m_warmUpTime != warmUpTime))
+    {
+        NS_LOG_WARN(this << " cannot modify the current warm-up time"
+                         << " because this instance have already been installed");
+    }
+    else
+    {
+        m_warmUpTime = warmUpTime;
+    }
+}
+
+Time
+ApplicationStatsHelper::GetWarmUpTime() const
+{
+    return m_warmUpTime;
+}
+
+void
+ApplicationStatsHelper::SetSamplingRatio(uint32_t samplingRatio)
+{
+    NS_LOG_FUNCTION(this << samplingRatio);
+
+    if ((m_isInstalled || IsInstallPending()) && (m_samplingRatio != samplingRatio))
+    {
+        NS_LOG_WARN(this << " cannot modify the current sampling ratio"
+                         << " because this instance have already been installed");
+    }
+    else
+    {
+        NS_ASSERT_MSG(samplingRatio > 0, "Sampling ratio must be at least 1");
+        m_samplingRatio = samplingRatio;
+    }
+}
+
+uint32_t
+ApplicationStatsHelper::GetSamplingRatio() const
+{
+    return m_samplingRatio;
+}
+
+void
+ApplicationStatsHelper::SetSamplingMode(SamplingMode_t samplingMode)
+{
+    NS_LOG_FUNCTION(this << samplingMode);
+
+    if ((m_isInstalled || IsInstallPending()) && (m_samplingMode != samplingMode))
+    {
+        NS_LOG_WARN(this << " cannot modify the current sampling mode"
+                         << " because this instance have already been installed");
+    }
+    else
+    {
+        m_samplingMode = samplingMode;
+    }
+}
+
+ApplicationStatsHelper::SamplingMode_t
+ApplicationStatsHelper::GetSamplingMode() const
+{
+    return m_samplingMode;
+}
+
 bool
 ApplicationStatsHelper::IsInstalled() const
 {
     return m_isInstalled;
 }
 
+bool
+ApplicationStatsHelper::IsInstallPending() const
+{
+    return !Simulator::IsExpired(m_installEvent);
+}
+
+bool
+ApplicationStatsHelper::IsSampledFlow(const Address& from) const
+{
+    /*
+     * The serialized address includes the port number of an
+     * InetSocketAddress, so each socket of a sender is a separate flow. Trace
+     * sources which report a bare Ipv4Address (e.g., `RxPlt`) are sampled per
+     * sender node instead.
+     */
+    uint8_t buffer[sizeof(m_samplingSalt) + Address::MAX_SIZE];
+    std::memcpy(buffer, &m_samplingSalt, sizeof(m_samplingSalt));
+    const uint32_t size = sizeof(m_samplingSalt) + from.CopyTo(buffer + sizeof(m_samplingSalt));
+    return Hash32(reinterpret_cast<const char*>(buffer), size) % m_samplingRatio == 0;
+}
+
 Ptr<DataCollectionObject>
 ApplicationStatsHelper::CreateAggregator(std::string aggregatorTypeId,
                                          std::string n1,
@@ -315,6 +621,13 @@ ApplicationStatsHelper::CreateAggregator(std::string aggregatorTypeId,
     factory.Set(n3, v3);
     factory.Set(n4, v4);
     factory.Set(n5, v5);
+
+    if (tid == AsyncFileAggregator::GetTypeId())
+    {
+        factory.Set("Asynchronous", BooleanValue(m_isAsyncFileOutput));
+        factory.Set("Compressed", BooleanValue(m_isCompressedFileOutput));
+    }
+
     return factory.Create()->GetObject<DataCollectionObject>();
 }
 
@@ -368,4 +681,107 @@ ApplicationStatsHelper::CreateCollectorPerIdentifier(CollectorMap& collectorMap)
 
 } // end of `uint32_t CreateCollectorPerIdentifier (CollectorMap &);`
 
+std::vector<std::string>
+ApplicationStatsHelper::GetIdentifierNames() const
+{
+    std::vector<std::string> names;
+
+    switch (GetIdentifierType())
+    {
+    case ApplicationStatsHelper::IDENTIFIER_GLOBAL:
+        names.push_back("global");
+        break;
+
+    case ApplicationStatsHelper::IDENTIFIER_RECEIVER: {
+        std::map<std::string, ApplicationContainer>::const_iterator it;
+        for (it = m_receiverInfo.begin(); it != m_receiverInfo.end(); ++it)
+        {
+            names.push_back(it->first);
+        }
+        break;
+    }
+
+    case ApplicationStatsHelper::IDENTIFIER_SENDER: {
+        std::map<std::string, ApplicationContainer>::const_iterator it;
+        for (it = m_senderInfo.begin(); it != m_senderInfo.end(); ++it)
+        {
+            names.push_back(it->first);
+        }
+        break;
+    }
+
+    default:
+        NS_FATAL_ERROR("ApplicationStatsHelper - Invalid identifier type");
+        break;
+    }
+
+    return names;
+
+} // end of `std::vector<std::string> GetIdentifierNames () const`
+
+std::string
+ApplicationStatsHelper::GetFileAggregatorTypeName() const
+{
+    return IsUsingAsyncFileAggregator() ? "ns3::AsyncFileAggregator" : "ns3::MultiFileAggregator";
+}
+
+bool
+ApplicationStatsHelper::IsUsingAsyncFileAggregator() const
+{
+    // MultiFileAggregator is unable to compress, so compression always uses AsyncFileAggregator.
+    return m_isAsyncFileOutput || m_isCompressedFileOutput;
+}
+
+bool
+ApplicationStatsHelper::ConnectCollectorsToFileAggregator(
+    CollectorMap& collectorMap,
+    std::string traceSourceName,
+    FileSink_t sink,
+    Ptr<DataCollectionObject> aggregator) const
+{
+    NS_LOG_FUNCTION(this << traceSourceName << sink << aggregator);
+
+    if (IsUsingAsyncFileAggregator())
+    {
+        return ConnectCollectorsToSink<AsyncFileAggregator>(collectorMap,
+                                                            traceSourceName,
+                                                            sink,
+                                                            aggregator);
+    }
+    else
+    {
+        return ConnectCollectorsToSink<MultiFileAggregator>(collectorMap,
+                                                            traceSourceName,
+                                                            sink,
+                                                            aggregator);
+    }
+}
+
+bool
+ApplicationStatsHelper::ConnectToFileAggregator(Ptr<Object> source,
+                                                std::string traceSourceName,
+                                                std::string context,
+                                                FileSink_t sink,
+                                                Ptr<DataCollectionObject> aggregator) const
+{
+    NS_LOG_FUNCTION(this << source << traceSourceName << context << sink << aggregator);
+
+    if (IsUsingAsyncFileAggregator())
+    {
+        return ConnectObjectToSink<AsyncFileAggregator>(source,
+                                                        traceSourceName,
+                                                        context,
+                                                        sink,
+                                                        aggregator);
+    }
+    else
+    {
+        return ConnectObjectToSink<MultiFileAggregator>(source,
+                                                        traceSourceName,
+                                                        context,
+                                                        sink,
+                                                        aggregator);
+    }
+}
+
 } // end of namespace ns3
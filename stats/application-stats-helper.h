@@ -25,6 +25,8 @@
 #include "ns3/application-container.h"
 #include "ns3/callback.h"
 #include "ns3/collector-map.h"
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
 #include "ns3/object.h"
 #include "ns3/probe.h"
 #include "ns3/ptr.h"
@@ -33,6 +35,7 @@
 #include <list>
 #include <map>
 #include <string>
+#include <vector>
 
 namespace ns3
 {
@@ -87,6 +90,18 @@ class Address;
  * However, it's recommended to use the ApplicationStatsHelperContainer class
  * to automatically handle the above.
  *
+ * Per-packet statistics may be restricted to a sample of the packets by setting
+ * the `SamplingRatio` attribute to N > 1. Depending on the `SamplingMode`
+ * attribute, either every N-th packet (`PACKETS`) or every packet of about one
+ * in N flows (`FLOWS`) is recorded. The flows are selected by hashing the
+ * sender address reported by the trace source, and both the hash and the
+ * first recorded packet are salted with the seed and the run number of the
+ * random number generators (see RngSeedManager). Hence the selection is the
+ * same in every helper which samples the same trace source in a run, but
+ * changes from one replication to the next, so that every packet or flow is
+ * recorded in about one in N replications. See the documentation of the
+ * child classes for how the samples are scaled.
+ *
  * This parent abstract class hosts several protected methods which are
  * intended to simplify the development of child classes by sharing common
  * functions.
@@ -140,6 +155,30 @@ class ApplicationStatsHelper : public Object
      */
     static std::string GetOutputTypeName(OutputType_t outputType);
 
+    /**
+     * @enum SamplingMode_t
+     * @brief Possible ways of selecting the recorded samples when the
+     *        sampling ratio is greater than one.
+     */
+    typedef enum
+    {
+        SAMPLING_PACKETS = 0, // every N-th sample
+        SAMPLING_FLOWS,       // every sample of a hash-selected subset of senders
+    } SamplingMode_t;
+
+    /**
+     * @enum FileSink_t
+     * @brief Methods of the file aggregators which a trace source can be
+     *        connected to, regardless of which file aggregator is in use.
+     */
+    typedef enum
+    {
+        FILE_SINK_WRITE_1D = 0,     // Write1d (context, value)
+        FILE_SINK_WRITE_2D,         // Write2d (context, x, y)
+        FILE_SINK_CONTEXT_HEADING,  // AddContextHeading (context, heading)
+        FILE_SINK_CONTEXT_WARNING   // EnableContextWarning (context, isEnabled)
+    } FileSink_t;
+
     // CONSTRUCTOR AND DESTRUCTOR ///////////////////////////////////////////////
 
     /// Creates a new helper instance.
@@ -183,6 +222,12 @@ class ApplicationStatsHelper : public Object
      * @brief Install probes, collectors, and aggregators.
      *
      * Behaviour should be implemented by child class in DoInstall().
+     *
+     * If a warm-up time in the future has been set (see SetWarmUpTime()), the
+     * call to DoInstall() is postponed until the warm-up time. Until then no
+     * probe is connected to the applications, so samples generated during the
+     * warm-up period cost nothing and do not appear in the output. Meanwhile
+     * IsInstallPending() returns true and IsInstalled() returns false.
      */
     void Install();
 
@@ -233,10 +278,75 @@ class ApplicationStatsHelper : public Object
     OutputType_t GetOutputType() const;
 
     /**
-     * @return true if Install() has been invoked, otherwise false.
+     * @param asyncFileOutput if true, file output types are written by a
+     *                        background thread using AsyncFileAggregator.
+     * @warning Does not have any effect if invoked after Install().
+     */
+    void SetAsyncFileOutput(bool asyncFileOutput);
+
+    /**
+     * @return true if file output types are written by a background thread.
+     */
+    bool IsAsyncFileOutput() const;
+
+    /**
+     * @param compressedFileOutput if true, file output types are compressed
+     *                             using AsyncFileAggregator.
+     * @warning Does not have any effect if invoked after Install().
+     */
+    void SetCompressedFileOutput(bool compressedFileOutput);
+
+    /**
+     * @return true if file output types are compressed.
+     */
+    bool IsCompressedFileOutput() const;
+
+    /**
+     * @param warmUpTime the simulation time before which samples are ignored.
+     * @warning Does not have any effect if invoked after Install().
+     */
+    void SetWarmUpTime(Time warmUpTime);
+
+    /**
+     * @return the simulation time before which samples are ignored.
+     */
+    Time GetWarmUpTime() const;
+
+    /**
+     * @param samplingRatio record only one in this many samples; 1 records
+     *                      every sample.
+     * @warning Does not have any effect if invoked after Install().
+     */
+    void SetSamplingRatio(uint32_t samplingRatio);
+
+    /**
+     * @return the sampling ratio, i.e., one in how many samples is recorded.
+     */
+    uint32_t GetSamplingRatio() const;
+
+    /**
+     * @param samplingMode how the recorded samples are selected.
+     * @warning Does not have any effect if invoked after Install().
+     */
+    void SetSamplingMode(SamplingMode_t samplingMode);
+
+    /**
+     * @return how the recorded samples are selected.
+     */
+    SamplingMode_t GetSamplingMode() const;
+
+    /**
+     * @return true if Install() has been invoked and the probes, collectors,
+     *         and aggregators are in place, otherwise false.
      */
     bool IsInstalled() const;
 
+    /**
+     * @return true if Install() has been invoked, but the installation is
+     *         postponed until the warm-up time, otherwise false.
+     */
+    bool IsInstallPending() const;
+
   protected:
     /**
      * @brief Install the probes, collectors, and aggregators necessary to
@@ -264,6 +374,10 @@ class ApplicationStatsHelper : public Object
      *
      * The created aggregator is stored in #m_aggregator. It can be retrieved
      * from outside using GetAggregator().
+     *
+     * If the created aggregator is an AsyncFileAggregator, its `Asynchronous`
+     * and `Compressed` attributes are set according to the `AsyncFileOutput`
+     * and `CompressedFileOutput` attributes of this helper.
      */
     Ptr<DataCollectionObject> CreateAggregator(std::string aggregatorTypeId,
                                                std::string n1 = "",
@@ -295,6 +409,61 @@ class ApplicationStatsHelper : public Object
      */
     uint32_t CreateCollectorPerIdentifier(CollectorMap& collectorMap) const;
 
+    /**
+     * @brief Compute the name of each identifier, in the same order as
+     *        CreateCollectorPerIdentifier() creates the collectors.
+     * @return the names, indexed by the identifier.
+     */
+    std::vector<std::string> GetIdentifierNames() const;
+
+    /**
+     * @return the TypeId name of the aggregator to be used for file output
+     *         types, i.e., either `ns3::MultiFileAggregator` or
+     *         `ns3::AsyncFileAggregator`, depending on the `AsyncFileOutput`
+     *         and `CompressedFileOutput` attributes.
+     */
+    std::string GetFileAggregatorTypeName() const;
+
+    /**
+     * @return true if GetFileAggregatorTypeName() returns
+     *         `ns3::AsyncFileAggregator`.
+     */
+    bool IsUsingAsyncFileAggregator() const;
+
+    /**
+     * @brief Connect a trace source of every collector in a map to the file
+     *        aggregator created with GetFileAggregatorTypeName().
+     * @param collectorMap the collectors, each of them passes its name as the
+     *                     context.
+     * @param traceSourceName the name of the trace source of the collectors.
+     * @param sink the method of the aggregator to connect to.
+     * @param aggregator either a MultiFileAggregator or an AsyncFileAggregator,
+     *                   as indicated by IsUsingAsyncFileAggregator().
+     * @return true if every collector has been connected.
+     */
+    bool ConnectCollectorsToFileAggregator(CollectorMap& collectorMap,
+                                           std::string traceSourceName,
+                                           FileSink_t sink,
+                                           Ptr<DataCollectionObject> aggregator) const;
+
+    /**
+     * @brief Connect a trace source of a single object to the file aggregator
+     *        created with GetFileAggregatorTypeName().
+     * @param source the object owning the trace source.
+     * @param traceSourceName the name of the trace source.
+     * @param context the context passed to the aggregator, or an empty string
+     *                if the trace source passes the context by itself.
+     * @param sink the method of the aggregator to connect to.
+     * @param aggregator either a MultiFileAggregator or an AsyncFileAggregator,
+     *                   as indicated by IsUsingAsyncFileAggregator().
+     * @return true if the trace source has been connected.
+     */
+    bool ConnectToFileAggregator(Ptr<Object> source,
+                                 std::string traceSourceName,
+                                 std::string context,
+                                 FileSink_t sink,
+                                 Ptr<DataCollectionObject> aggregator) const;
+
     /**
      * @brief Create a probe attached to every receiver application and connected
      *        to a collector.
@@ -352,6 +521,33 @@ class ApplicationStatsHelper : public Object
     template <typename Q>
     uint32_t SetupListenersAtReceiver(Callback<void, Q, const Address&> cb);
 
+    /**
+     * @brief Decide whether a sample received from a trace source is recorded.
+     * @param from the address of the sender, as reported by the trace source.
+     * @return true if the sample should be passed to the collectors.
+     *
+     * Always true when the sampling ratio is 1. Otherwise, in `PACKETS` mode
+     * every N-th call returns true, counting the calls across all receivers
+     * of this helper from a salted starting point, and in `FLOWS` mode the
+     * result depends only on the sender address and the salt (see
+     * IsSampledFlow()).
+     */
+    inline bool IsSampled(const Address& from)
+    {
+        if (m_samplingRatio <= 1)
+        {
+            return true;
+        }
+        else if (m_samplingMode == SAMPLING_PACKETS)
+        {
+            return (m_sampleCounter++ % m_samplingRatio) == 0;
+        }
+        else
+        {
+            return IsSampledFlow(from);
+        }
+    }
+
     /// Internal map of sender applications, indexed by their names.
     std::map<std::string, ApplicationContainer> m_senderInfo;
 
@@ -359,10 +555,28 @@ class ApplicationStatsHelper : public Object
     std::map<std::string, ApplicationContainer> m_receiverInfo;
 
   private:
+    /**
+     * @param from the address of the sender.
+     * @return true if the hash of the salt and the serialized address is
+     *         divisible by the sampling ratio.
+     */
+    bool IsSampledFlow(const Address& from) const;
+
+    /// Invoke DoInstall() once the warm-up time is reached.
+    void InstallAfterWarmUp();
+
     std::string m_name;                ///<
     IdentifierType_t m_identifierType; ///<
     OutputType_t m_outputType;         ///<
     std::string m_traceSourceName;     ///<
+    bool m_isAsyncFileOutput;          ///< `AsyncFileOutput` attribute.
+    bool m_isCompressedFileOutput;     ///< `CompressedFileOutput` attribute.
+    Time m_warmUpTime;                 ///< `WarmUpTime` attribute.
+    EventId m_installEvent;            ///< Postponed DoInstall() during warm-up.
+    uint32_t m_samplingRatio;          ///< `SamplingRatio` attribute.
+    SamplingMode_t m_samplingMode;     ///< `SamplingMode` attribute.
+    uint64_t m_sampleCounter;          ///< Samples seen in `PACKETS` mode.
+    uint32_t m_samplingSalt;           ///< Hash of the seed and run number.
     bool m_isInstalled;                ///<
 
 }; // end of class ApplicationStatsHelper
@@ -0,0 +1,63 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "application-stats-plt-helper.h"
+
+#include "ns3/log.h"
+
+#include <string>
+
+NS_LOG_COMPONENT_DEFINE("ApplicationStatsPltHelper");
+
+namespace ns3
+{
+
+NS_OBJECT_ENSURE_REGISTERED(ApplicationStatsPltHelper);
+
+ApplicationStatsPltHelper::ApplicationStatsPltHelper()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+ApplicationStatsPltHelper::~ApplicationStatsPltHelper()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TypeId // static
+ApplicationStatsPltHelper::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::ApplicationStatsPltHelper")
+                            .SetParent<ApplicationStatsDelayHelper>();
+    return tid;
+}
+
+std::string
+ApplicationStatsPltHelper::GetHeadingLabel() const
+{
+    return "plt_sec";
+}
+
+std::string
+ApplicationStatsPltHelper::GetLegendLabel() const
+{
+    return "Page load time";
+}
+
+} // end of namespace ns3
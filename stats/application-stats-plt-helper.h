@@ -0,0 +1,68 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef APPLICATION_STATS_PLT_HELPER_H
+#define APPLICATION_STATS_PLT_HELPER_H
+
+#include "application-stats-delay-helper.h"
+
+#include <string>
+
+namespace ns3
+{
+
+/**
+ * @ingroup applicationstats
+ * @brief Produce page load time statistics of web browsing applications.
+ *
+ * The samples are received from a trace source with the signature
+ * `void (const Time &, const Address &)` which is fired once a web page
+ * (i.e., a main object and all of its embedded objects) has been completely
+ * received. The second argument is the address of the server which has sent
+ * the page. ThreeGppHttpSatelliteClient exports such trace source as `RxPlt`.
+ *
+ * Apart from the labels of the output, the processing of the samples is
+ * identical to ApplicationStatsDelayHelper, including the supported
+ * identifier types, output types, and the averaging mode.
+ *
+ * ApplicationStatsHelperContainer connects the instances it creates to the
+ * `RxPlt` trace source, regardless of its own `TraceSourceName` attribute.
+ */
+class ApplicationStatsPltHelper : public ApplicationStatsDelayHelper
+{
+  public:
+    // inherited from ApplicationStatsHelper base class
+    ApplicationStatsPltHelper();
+
+    /// Destructor.
+    virtual ~ApplicationStatsPltHelper();
+
+    // inherited from ObjectBase base class
+    static TypeId GetTypeId();
+
+  protected:
+    // inherited from ApplicationStatsDelayHelper base class
+    virtual std::string GetHeadingLabel() const;
+    virtual std::string GetLegendLabel() const;
+
+}; // end of class ApplicationStatsPltHelper
+
+} // end of namespace ns3
+
+#endif /* APPLICATION_STATS_PLT_HELPER_H */
@@ -0,0 +1,63 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "application-stats-rtt-helper.h"
+
+#include "ns3/log.h"
+
+#include <string>
+
+NS_LOG_COMPONENT_DEFINE("ApplicationStatsRttHelper");
+
+namespace ns3
+{
+
+NS_OBJECT_ENSURE_REGISTERED(ApplicationStatsRttHelper);
+
+ApplicationStatsRttHelper::ApplicationStatsRttHelper()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+ApplicationStatsRttHelper::~ApplicationStatsRttHelper()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TypeId // static
+ApplicationStatsRttHelper::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::ApplicationStatsRttHelper")
+                            .SetParent<ApplicationStatsDelayHelper>();
+    return tid;
+}
+
+std::string
+ApplicationStatsRttHelper::GetHeadingLabel() const
+{
+    return "rtt_sec";
+}
+
+std::string
+ApplicationStatsRttHelper::GetLegendLabel() const
+{
+    return "Round trip time";
+}
+
+} // end of namespace ns3
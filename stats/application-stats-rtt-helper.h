@@ -0,0 +1,68 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef APPLICATION_STATS_RTT_HELPER_H
+#define APPLICATION_STATS_RTT_HELPER_H
+
+#include "application-stats-delay-helper.h"
+
+#include <string>
+
+namespace ns3
+{
+
+/**
+ * @ingroup applicationstats
+ * @brief Produce round trip time statistics of request-response applications.
+ *
+ * The samples are received from a trace source with the signature
+ * `void (const Time &, const Address &)` which is fired upon receiving a
+ * response, carrying the time elapsed since the corresponding request was
+ * sent. The second argument is the address of the sender of the response.
+ * ThreeGppHttpSatelliteClient exports such trace source as `RxRtt`.
+ *
+ * Apart from the labels of the output, the processing of the samples is
+ * identical to ApplicationStatsDelayHelper, including the supported
+ * identifier types, output types, and the averaging mode.
+ *
+ * ApplicationStatsHelperContainer connects the instances it creates to the
+ * `RxRtt` trace source, regardless of its own `TraceSourceName` attribute.
+ */
+class ApplicationStatsRttHelper : public ApplicationStatsDelayHelper
+{
+  public:
+    // inherited from ApplicationStatsHelper base class
+    ApplicationStatsRttHelper();
+
+    /// Destructor.
+    virtual ~ApplicationStatsRttHelper();
+
+    // inherited from ObjectBase base class
+    static TypeId GetTypeId();
+
+  protected:
+    // inherited from ApplicationStatsDelayHelper base class
+    virtual std::string GetHeadingLabel() const;
+    virtual std::string GetLegendLabel() const;
+
+}; // end of class ApplicationStatsRttHelper
+
+} // end of namespace ns3
+
+#endif /* APPLICATION_STATS_RTT_HELPER_H */
@@ -21,28 +21,27 @@
 
 #include "application-stats-throughput-helper.h"
 
+#include "application-throughput-collector.h"
+
 #include "ns3/application-container.h"
-#include "ns3/application-packet-probe.h"
 #include "ns3/boolean.h"
 #include "ns3/data-collection-object.h"
 #include "ns3/distribution-collector.h"
 #include "ns3/enum.h"
 #include "ns3/gnuplot-aggregator.h"
 #include "ns3/inet-socket-address.h"
-#include "ns3/interval-rate-collector.h"
 #include "ns3/ipv4.h"
 #include "ns3/log.h"
-#include "ns3/multi-file-aggregator.h"
 #include "ns3/node.h"
 #include "ns3/nstime.h"
-#include "ns3/probe.h"
-#include "ns3/scalar-collector.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
 #include "ns3/string.h"
-#include "ns3/unit-conversion-collector.h"
 
 #include <map>
 #include <sstream>
 #include <string>
+#include <vector>
 
 NS_LOG_COMPONENT_DEFINE("ApplicationStatsThroughputHelper");
 
@@ -92,12 +91,24 @@ ApplicationStatsThroughputHelper::GetAveragingMode() const
     return m_averagingMode;
 }
 
+Ptr<DataCollectionObject>
+ApplicationStatsThroughputHelper::GetAggregator() const
+{
+    return m_aggregator;
+}
+
 void
 ApplicationStatsThroughputHelper::DoInstall()
 {
     NS_LOG_FUNCTION(this);
 
-    // Setup aggregators and collectors.
+    // Setup the collector, with one counter for each identifier.
+    m_collector = CreateObject<ApplicationThroughputCollector>();
+    m_collector->SetIdentifierNames(GetIdentifierNames());
+    NS_LOG_INFO(this << " created " << m_collector->GetNIdentifiers() << " counter(s)"
+                     << " for " << GetIdentifierTypeName(GetIdentifierType()));
+
+    // Setup aggregators.
 
     switch (GetOutputType())
     {
@@ -108,7 +119,7 @@ ApplicationStatsThroughputHelper::DoInstall()
 
     case ApplicationStatsHelper::OUTPUT_SCALAR_FILE: {
         // Setup aggregator.
-        m_aggregator = CreateAggregator("ns3::MultiFileAggregator",
+        m_aggregator = CreateAggregator(GetFileAggregatorTypeName(),
                                         "OutputFileName",
                                         StringValue(GetName()),
                                         "MultiFileMode",
@@ -118,57 +129,32 @@ ApplicationStatsThroughputHelper::DoInstall()
                                         "GeneralHeading",
                                         StringValue("% identifier throughput_kbps"));
 
-        // Setup second-level collectors.
-        m_terminalCollectors.SetType("ns3::ScalarCollector");
-        m_terminalCollectors.SetAttribute("InputDataType",
-                                          EnumValue(ScalarCollector::INPUT_DATA_TYPE_DOUBLE));
-        m_terminalCollectors.SetAttribute(
-            "OutputType",
-            EnumValue(ScalarCollector::OUTPUT_TYPE_AVERAGE_PER_SECOND));
-        CreateCollectorPerIdentifier(m_terminalCollectors);
-        m_terminalCollectors.ConnectToAggregator("Output",
-                                                 m_aggregator,
-                                                 &MultiFileAggregator::Write1d);
-
-        // Setup first-level collectors.
-        m_conversionCollectors.SetType("ns3::UnitConversionCollector");
-        m_conversionCollectors.SetAttribute("ConversionType",
-                                            EnumValue(UnitConversionCollector::FROM_BYTES_TO_KBIT));
-        CreateCollectorPerIdentifier(m_conversionCollectors);
-        m_conversionCollectors.ConnectToCollector("Output",
-                                                  m_terminalCollectors,
-                                                  &ScalarCollector::TraceSinkDouble);
+        // Setup collector.
+        m_collector->SetOutputType(ApplicationThroughputCollector::OUTPUT_TYPE_AVERAGE_PER_SECOND);
+        ConnectToFileAggregator(m_collector, "Output", "", FILE_SINK_WRITE_1D, m_aggregator);
         break;
     }
 
     case ApplicationStatsHelper::OUTPUT_SCATTER_FILE: {
         // Setup aggregator.
-        m_aggregator = CreateAggregator("ns3::MultiFileAggregator",
+        m_aggregator = CreateAggregator(GetFileAggregatorTypeName(),
                                         "OutputFileName",
                                         StringValue(GetName()),
                                         "GeneralHeading",
                                         StringValue("% time_sec throughput_kbps"));
 
-        // Setup second-level collectors.
-        m_terminalCollectors.SetType("ns3::IntervalRateCollector");
-        m_terminalCollectors.SetAttribute("InputDataType",
-                                          EnumValue(IntervalRateCollector::INPUT_DATA_TYPE_DOUBLE));
-        CreateCollectorPerIdentifier(m_terminalCollectors);
-        m_terminalCollectors.ConnectToAggregator("OutputWithTime",
-                                                 m_aggregator,
-                                                 &MultiFileAggregator::Write2d);
-        m_terminalCollectors.ConnectToAggregator("OutputString",
-                                                 m_aggregator,
-                                                 &MultiFileAggregator::AddContextHeading);
-
-        // Setup first-level collectors.
-        m_conversionCollectors.SetType("ns3::UnitConversionCollector");
-        m_conversionCollectors.SetAttribute("ConversionType",
-                                            EnumValue(UnitConversionCollector::FROM_BYTES_TO_KBIT));
-        CreateCollectorPerIdentifier(m_conversionCollectors);
-        m_conversionCollectors.ConnectToCollector("Output",
-                                                  m_terminalCollectors,
-                                                  &IntervalRateCollector::TraceSinkDouble);
+        // Setup collector.
+        m_collector->SetOutputType(ApplicationThroughputCollector::OUTPUT_TYPE_INTERVAL_RATE);
+        ConnectToFileAggregator(m_collector,
+                                "OutputWithTime",
+                                "",
+                                FILE_SINK_WRITE_2D,
+                                m_aggregator);
+        ConnectToFileAggregator(m_collector,
+                                "OutputString",
+                                "",
+                                FILE_SINK_CONTEXT_HEADING,
+                                m_aggregator);
         break;
     }
 
@@ -181,7 +167,7 @@ ApplicationStatsThroughputHelper::DoInstall()
         }
 
         // Setup aggregator.
-        m_aggregator = CreateAggregator("ns3::MultiFileAggregator",
+        m_aggregator = CreateAggregator(GetFileAggregatorTypeName(),
                                         "OutputFileName",
                                         StringValue(GetName()),
                                         "MultiFileMode",
@@ -190,8 +176,6 @@ ApplicationStatsThroughputHelper::DoInstall()
                                         BooleanValue(false),
                                         "GeneralHeading",
                                         StringValue("% throughput_kbps freq"));
-        Ptr<MultiFileAggregator> fileAggregator = m_aggregator->GetObject<MultiFileAggregator>();
-        NS_ASSERT(fileAggregator != nullptr);
 
         // Setup the final-level collector.
         m_averagingCollector = CreateObject<DistributionCollector>();
@@ -207,44 +191,27 @@ ApplicationStatsThroughputHelper::DoInstall()
         }
         m_averagingCollector->SetOutputType(outputType);
         m_averagingCollector->SetName("0");
-        m_averagingCollector->TraceConnect(
-            "Output",
-            "0",
-            MakeCallback(&MultiFileAggregator::Write2d, fileAggregator));
-        m_averagingCollector->TraceConnect(
-            "OutputString",
-            "0",
-            MakeCallback(&MultiFileAggregator::AddContextHeading, fileAggregator));
-        m_averagingCollector->TraceConnect(
-            "Warning",
-            "0",
-            MakeCallback(&MultiFileAggregator::EnableContextWarning, fileAggregator));
-
-        // Setup second-level collectors.
-        m_terminalCollectors.SetType("ns3::ScalarCollector");
-        m_terminalCollectors.SetAttribute("InputDataType",
-                                          EnumValue(ScalarCollector::INPUT_DATA_TYPE_DOUBLE));
-        m_terminalCollectors.SetAttribute(
-            "OutputType",
-            EnumValue(ScalarCollector::OUTPUT_TYPE_AVERAGE_PER_SECOND));
-        CreateCollectorPerIdentifier(m_terminalCollectors);
-        Callback<void, double> callback =
-            MakeCallback(&DistributionCollector::TraceSinkDouble1, m_averagingCollector);
-        for (CollectorMap::Iterator it = m_terminalCollectors.Begin();
-             it != m_terminalCollectors.End();
-             ++it)
-        {
-            it->second->TraceConnectWithoutContext("Output", callback);
-        }
-
-        // Setup first-level collectors.
-        m_conversionCollectors.SetType("ns3::UnitConversionCollector");
-        m_conversionCollectors.SetAttribute("ConversionType",
-                                            EnumValue(UnitConversionCollector::FROM_BYTES_TO_KBIT));
-        CreateCollectorPerIdentifier(m_conversionCollectors);
-        m_conversionCollectors.ConnectToCollector("Output",
-                                                  m_terminalCollectors,
-                                                  &ScalarCollector::TraceSinkDouble);
+        ConnectToFileAggregator(m_averagingCollector,
+                                "Output",
+                                "0",
+                                FILE_SINK_WRITE_2D,
+                                m_aggregator);
+        ConnectToFileAggregator(m_averagingCollector,
+                                "OutputString",
+                                "0",
+                                FILE_SINK_CONTEXT_HEADING,
+                                m_aggregator);
+        ConnectToFileAggregator(m_averagingCollector,
+                                "Warning",
+                                "0",
+                                FILE_SINK_CONTEXT_WARNING,
+                                m_aggregator);
+
+        // Setup collector.
+        m_collector->SetOutputType(ApplicationThroughputCollector::OUTPUT_TYPE_AVERAGE_PER_SECOND);
+        m_collector->TraceConnectWithoutContext(
+            "OutputValue",
+            MakeCallback(&DistributionCollector::TraceSinkDouble1, m_averagingCollector));
         break;
     }
 
@@ -261,32 +228,18 @@ ApplicationStatsThroughputHelper::DoInstall()
         plotAggregator->SetLegend("Time (in seconds)",
                                   "Received throughput (in kilobits per second)");
         plotAggregator->Set2dDatasetDefaultStyle(Gnuplot2dDataset::LINES);
-        m_aggregator = plotAggregator;
-
-        // Setup second-level collectors.
-        m_terminalCollectors.SetType("ns3::IntervalRateCollector");
-        m_terminalCollectors.SetAttribute("InputDataType",
-                                          EnumValue(IntervalRateCollector::INPUT_DATA_TYPE_DOUBLE));
-        CreateCollectorPerIdentifier(m_terminalCollectors);
-        for (CollectorMap::Iterator it = m_terminalCollectors.Begin();
-             it != m_terminalCollectors.End();
-             ++it)
+        const std::vector<std::string> names = GetIdentifierNames();
+        for (std::vector<std::string>::const_iterator it = names.begin(); it != names.end(); ++it)
         {
-            const std::string context = it->second->GetName();
-            plotAggregator->Add2dDataset(context, context);
+            plotAggregator->Add2dDataset(*it, *it);
         }
-        m_terminalCollectors.ConnectToAggregator("OutputWithTime",
-                                                 m_aggregator,
-                                                 &GnuplotAggregator::Write2d);
-
-        // Setup first-level collectors.
-        m_conversionCollectors.SetType("ns3::UnitConversionCollector");
-        m_conversionCollectors.SetAttribute("ConversionType",
-                                            EnumValue(UnitConversionCollector::FROM_BYTES_TO_KBIT));
-        CreateCollectorPerIdentifier(m_conversionCollectors);
-        m_conversionCollectors.ConnectToCollector("Output",
-                                                  m_terminalCollectors,
-                                                  &IntervalRateCollector::TraceSinkDouble);
+        m_aggregator = plotAggregator;
+
+        // Setup collector.
+        m_collector->SetOutputType(ApplicationThroughputCollector::OUTPUT_TYPE_INTERVAL_RATE);
+        m_collector->TraceConnectWithoutContext(
+            "OutputWithTime",
+            MakeCallback(&GnuplotAggregator::Write2d, plotAggregator));
         break;
     }
 
@@ -325,31 +278,11 @@ ApplicationStatsThroughputHelper::DoInstall()
             GetName(),
             MakeCallback(&GnuplotAggregator::Write2d, plotAggregator));
 
-        // Setup second-level collectors.
-        m_terminalCollectors.SetType("ns3::ScalarCollector");
-        m_terminalCollectors.SetAttribute("InputDataType",
-                                          EnumValue(ScalarCollector::INPUT_DATA_TYPE_DOUBLE));
-        m_terminalCollectors.SetAttribute(
-            "OutputType",
-            EnumValue(ScalarCollector::OUTPUT_TYPE_AVERAGE_PER_SECOND));
-        CreateCollectorPerIdentifier(m_terminalCollectors);
-        Callback<void, double> callback =
-            MakeCallback(&DistributionCollector::TraceSinkDouble1, m_averagingCollector);
-        for (CollectorMap::Iterator it = m_terminalCollectors.Begin();
-             it != m_terminalCollectors.End();
-             ++it)
-        {
-            it->second->TraceConnectWithoutContext("Output", callback);
-        }
-
-        // Setup first-level collectors.
-        m_conversionCollectors.SetType("ns3::UnitConversionCollector");
-        m_conversionCollectors.SetAttribute("ConversionType",
-                                            EnumValue(UnitConversionCollector::FROM_BYTES_TO_KBIT));
-        CreateCollectorPerIdentifier(m_conversionCollectors);
-        m_conversionCollectors.ConnectToCollector("Output",
-                                                  m_terminalCollectors,
-                                                  &ScalarCollector::TraceSinkDouble);
+        // Setup collector.
+        m_collector->SetOutputType(ApplicationThroughputCollector::OUTPUT_TYPE_AVERAGE_PER_SECOND);
+        m_collector->TraceConnectWithoutContext(
+            "OutputValue",
+            MakeCallback(&DistributionCollector::TraceSinkDouble1, m_averagingCollector));
         break;
     }
 
@@ -359,22 +292,40 @@ ApplicationStatsThroughputHelper::DoInstall()
 
     } // end of `switch (GetOutputType ())`
 
-    // Setup probes and connect them to the collectors.
+    // Connect the trace sources directly to the collector.
 
     switch (GetIdentifierType())
     {
     case ApplicationStatsHelper::IDENTIFIER_GLOBAL:
     case ApplicationStatsHelper::IDENTIFIER_RECEIVER: {
-        /*
-         * Install a probe on each receiver and connect them to the
-         * first-level collectors.
-         */
-        const uint32_t n = SetupProbesAtReceiver<ApplicationPacketProbe>(
-            "OutputBytes",
-            m_conversionCollectors,
-            &UnitConversionCollector::TraceSinkUinteger32,
-            m_probes);
-        NS_LOG_INFO(this << " created " << n << " instance(s)" << " of ApplicationPacketProbe");
+        // Bind the identifier of each receiver to its callback, so no look-up is needed.
+        uint32_t n = 0;
+        uint32_t identifier = 0;
+        std::map<std::string, ApplicationContainer>::const_iterator it1;
+        for (it1 = m_receiverInfo.begin(); it1 != m_receiverInfo.end(); ++it1)
+        {
+            for (ApplicationContainer::Iterator it2 = it1->second.Begin(); it2 != it1->second.End();
+                 ++it2)
+            {
+                if ((*it2)->GetInstanceTypeId().LookupTraceSourceByName(GetTraceSourceName()) !=
+                        nullptr &&
+                    (*it2)->TraceConnectWithoutContext(
+                        GetTraceSourceName(),
+                        MakeBoundCallback(&ApplicationStatsThroughputHelper::ReceiverRxCallback,
+                                          this,
+                                          identifier)))
+                {
+                    n++;
+                }
+            }
+
+            if (GetIdentifierType() == ApplicationStatsHelper::IDENTIFIER_RECEIVER)
+            {
+                identifier++; // Move to the next counter.
+            }
+        }
+
+        NS_LOG_INFO(this << " connected to " << n << " trace sources");
         break;
     }
 
@@ -406,13 +357,38 @@ ApplicationStatsThroughputHelper::DoInstall()
 
     } // end of `switch (GetIdentifierType ())`
 
+    m_collector->Start();
+
+    // Average outputs are final only when the simulation ends.
+    Simulator::ScheduleDestroy(&ApplicationThroughputCollector::Flush, m_collector);
+
 } // end of `void DoInstall ();`
 
+void // static
+ApplicationStatsThroughputHelper::ReceiverRxCallback(ApplicationStatsThroughputHelper* helper,
+                                                     uint32_t identifier,
+                                                     Ptr<const Packet> packet,
+                                                     const Address& from)
+{
+    if (helper->IsSampled(from))
+    {
+        // Scale up by the sampling ratio to make up for the skipped packets.
+        helper->m_collector->AddBytes(identifier,
+                                      static_cast<uint64_t>(packet->GetSize()) *
+                                          helper->GetSamplingRatio());
+    }
+}
+
 void
 ApplicationStatsThroughputHelper::RxCallback(Ptr<const Packet> packet, const Address& from)
 {
     // NS_LOG_FUNCTION (this << packet->GetSize () << from);
 
+    if (!IsSampled(from))
+    {
+        return; // Skip the look-up as well.
+    }
+
     if (InetSocketAddress::IsMatchingType(from))
     {
         // Determine the identifier associated with the sender address.
@@ -427,15 +403,11 @@ ApplicationStatsThroughputHelper::RxCallback(Ptr<const Packet> packet, const Add
         }
         else
         {
-            // Find the collector with the right identifier.
-            Ptr<DataCollectionObject> collector = m_conversionCollectors.Get(it1->second);
-            NS_ASSERT_MSG(collector != nullptr,
-                          "Unable to find collector with identifier " << it1->second);
-            Ptr<UnitConversionCollector> c = collector->GetObject<UnitConversionCollector>();
-            NS_ASSERT(c != nullptr);
-
-            // Pass the sample to the collector.
-            c->TraceSinkUinteger32(0, packet->GetSize());
+            NS_ASSERT_MSG(it1->second < m_collector->GetNIdentifiers(),
+                          "Unable to find counter with identifier " << it1->second);
+            m_collector->AddBytes(it1->second,
+                                  static_cast<uint64_t>(packet->GetSize()) *
+                                      GetSamplingRatio());
         }
     }
     else
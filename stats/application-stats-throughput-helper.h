@@ -25,10 +25,8 @@
 #include "application-stats-helper.h"
 
 #include "ns3/address.h"
-#include "ns3/collector-map.h"
 #include "ns3/ptr.h"
 
-#include <list>
 #include <map>
 
 namespace ns3
@@ -40,10 +38,31 @@ class Application;
 class Time;
 class DataCollectionObject;
 class DistributionCollector;
+class ApplicationThroughputCollector;
+class Packet;
 
 /**
  * @ingroup applicationstats
- * @brief
+ * @brief Produce throughput statistics from a trace source of the receiver
+ *        applications which reports the received packets and the sender
+ *        address.
+ *
+ * When the `SamplingRatio` attribute is N > 1, only the selected packets (see
+ * ApplicationStatsHelper) are counted, and each of them is counted N times
+ * its size. Since the selection is salted with the seed and run number, each
+ * packet or flow is selected in about one in N replications, and the mean of
+ * the scaled byte counts over many replications approaches the actual byte
+ * count. Within a single run, however, the selection is fixed:
+ * - in `PACKETS` mode, every N-th packet is picked by a counter shared by all
+ *   identifiers. The total number of packets is off by less than N, but an
+ *   identifier whose packets arrive in step with the counter may be counted
+ *   much more or much less than it has received;
+ * - in `FLOWS` mode, each flow is either always or never selected, so the
+ *   byte count of a flow is either N times the actual one or zero, and a sum
+ *   over F flows of similar rates is off by about sqrt(F * (N - 1)) flows.
+ *
+ * Hence sampled throughput of a single run is meaningful only for identifiers
+ * which gather many flows and many packets per interval.
  */
 class ApplicationStatsThroughputHelper : public ApplicationStatsHelper
 {
@@ -67,6 +86,12 @@ class ApplicationStatsThroughputHelper : public ApplicationStatsHelper
      */
     bool GetAveragingMode() const;
 
+    /**
+     * @return the aggregator created by Install(), or a null pointer before
+     *         the installation.
+     */
+    Ptr<DataCollectionObject> GetAggregator() const;
+
     /**
      * @brief Receive inputs from trace sources and determine the right collector
      *        to forward the inputs to.
@@ -98,14 +123,21 @@ class ApplicationStatsThroughputHelper : public ApplicationStatsHelper
      */
     void SaveAddressAndIdentifier(Ptr<Application> application, uint32_t identifier);
 
-    /// Maintains a list of probes created by this helper.
-    std::list<Ptr<Probe>> m_probes;
-
-    /// Maintains a list of first-level collectors created by this helper.
-    CollectorMap m_conversionCollectors;
+    /**
+     * @brief Receive packets from a receiver application with `GLOBAL` or
+     *        `RECEIVER` identifier.
+     * @param helper the helper instance.
+     * @param identifier the identifier associated with the receiver.
+     * @param packet received packet data.
+     * @param from the address of the sender of the packet.
+     */
+    static void ReceiverRxCallback(ApplicationStatsThroughputHelper* helper,
+                                   uint32_t identifier,
+                                   Ptr<const Packet> packet,
+                                   const Address& from);
 
-    /// Maintains a list of second-level collectors created by this helper.
-    CollectorMap m_terminalCollectors;
+    /// The collector which keeps the received bytes of every identifier.
+    Ptr<ApplicationThroughputCollector> m_collector;
 
     /// The final collector utilized in averaged output (histogram, PDF, and CDF).
     Ptr<DistributionCollector> m_averagingCollector;
@@ -0,0 +1,225 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "application-throughput-collector.h"
+
+#include "ns3/enum.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/trace-source-accessor.h"
+
+#include <algorithm>
+#include <sstream>
+
+NS_LOG_COMPONENT_DEFINE("ApplicationThroughputCollector");
+
+namespace ns3
+{
+
+NS_OBJECT_ENSURE_REGISTERED(ApplicationThroughputCollector);
+
+ApplicationThroughputCollector::ApplicationThroughputCollector()
+    : m_outputType(ApplicationThroughputCollector::OUTPUT_TYPE_AVERAGE_PER_SECOND),
+      m_intervalLength(Seconds(1.0))
+{
+    NS_LOG_FUNCTION(this);
+}
+
+ApplicationThroughputCollector::~ApplicationThroughputCollector()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TypeId // static
+ApplicationThroughputCollector::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::ApplicationThroughputCollector")
+            .SetParent<DataCollectionObject>()
+            .AddConstructor<ApplicationThroughputCollector>()
+            .AddAttribute("OutputType",
+                          "The type of output produced by the collector.",
+                          EnumValue(ApplicationThroughputCollector::OUTPUT_TYPE_AVERAGE_PER_SECOND),
+                          MakeEnumAccessor<ApplicationThroughputCollector::OutputType_t>(
+                              &ApplicationThroughputCollector::SetOutputType,
+                              &ApplicationThroughputCollector::GetOutputType),
+                          MakeEnumChecker(
+                              ApplicationThroughputCollector::OUTPUT_TYPE_AVERAGE_PER_SECOND,
+                              "AVERAGE_PER_SECOND",
+                              ApplicationThroughputCollector::OUTPUT_TYPE_INTERVAL_RATE,
+                              "INTERVAL_RATE"))
+            .AddAttribute("IntervalLength",
+                          "Length of the interval in INTERVAL_RATE output type.",
+                          TimeValue(Seconds(1.0)),
+                          MakeTimeAccessor(&ApplicationThroughputCollector::m_intervalLength),
+                          MakeTimeChecker(MilliSeconds(1)))
+            .AddTraceSource("Output",
+                            "The average throughput (in kbps) of an identifier, "
+                            "with the name of the identifier as the context.",
+                            MakeTraceSourceAccessor(&ApplicationThroughputCollector::m_outputTrace),
+                            "ns3::ApplicationThroughputCollector::OutputCallback")
+            .AddTraceSource(
+                "OutputValue",
+                "The average throughput (in kbps) of an identifier, without context.",
+                MakeTraceSourceAccessor(&ApplicationThroughputCollector::m_outputValueTrace),
+                "ns3::TracedValueCallback::Double")
+            .AddTraceSource(
+                "OutputWithTime",
+                "The throughput (in kbps) of an identifier within the interval which has "
+                "just ended, with the name of the identifier as the context.",
+                MakeTraceSourceAccessor(&ApplicationThroughputCollector::m_outputWithTimeTrace),
+                "ns3::ApplicationThroughputCollector::OutputWithTimeCallback")
+            .AddTraceSource(
+                "OutputString",
+                "The summary of an identifier in INTERVAL_RATE output type, emitted "
+                "at the end of simulation, with the name of the identifier as the context.",
+                MakeTraceSourceAccessor(&ApplicationThroughputCollector::m_outputStringTrace),
+                "ns3::ApplicationThroughputCollector::OutputStringCallback");
+    return tid;
+}
+
+void
+ApplicationThroughputCollector::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_intervalEvent.Cancel();
+    m_names.clear();
+    m_bytes.clear();
+    m_overallBytes.clear();
+    DataCollectionObject::DoDispose();
+}
+
+void
+ApplicationThroughputCollector::SetOutputType(OutputType_t outputType)
+{
+    NS_LOG_FUNCTION(this << outputType);
+    m_outputType = outputType;
+}
+
+ApplicationThroughputCollector::OutputType_t
+ApplicationThroughputCollector::GetOutputType() const
+{
+    return m_outputType;
+}
+
+void
+ApplicationThroughputCollector::SetIdentifierNames(const std::vector<std::string>& names)
+{
+    NS_LOG_FUNCTION(this << names.size());
+    m_names = names;
+    m_bytes.assign(names.size(), 0);
+    m_overallBytes.assign(names.size(), 0);
+}
+
+uint32_t
+ApplicationThroughputCollector::GetNIdentifiers() const
+{
+    return m_names.size();
+}
+
+void
+ApplicationThroughputCollector::Start()
+{
+    NS_LOG_FUNCTION(this);
+    std::fill(m_bytes.begin(), m_bytes.end(), 0);
+    std::fill(m_overallBytes.begin(), m_overallBytes.end(), 0);
+    m_startTime = Simulator::Now();
+    m_lastResetTime = m_startTime;
+
+    if (m_outputType == ApplicationThroughputCollector::OUTPUT_TYPE_INTERVAL_RATE)
+    {
+        m_intervalEvent = Simulator::Schedule(m_intervalLength,
+                                              &ApplicationThroughputCollector::EndInterval,
+                                              this);
+    }
+}
+
+void
+ApplicationThroughputCollector::Flush()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (!IsEnabled())
+    {
+        return;
+    }
+
+    if (m_outputType == ApplicationThroughputCollector::OUTPUT_TYPE_INTERVAL_RATE)
+    {
+        // Summarize the whole collection period, including the ongoing interval.
+        const double duration = (Simulator::Now() - m_startTime).GetSeconds();
+        for (uint32_t i = 0; i < m_bytes.size(); i++)
+        {
+            const uint64_t bytes = m_overallBytes[i] + m_bytes[i];
+            std::ostringstream oss;
+            oss << "% interval_length_sec " << m_intervalLength.GetSeconds() << std::endl;
+            oss << "% overall_bytes " << bytes << std::endl;
+            oss << "% overall_throughput_kbps "
+                << (duration > 0.0 ? static_cast<double>(bytes) * 0.008 / duration : 0.0);
+            m_outputStringTrace(m_names[i], oss.str());
+        }
+        return;
+    }
+
+    const double duration = (Simulator::Now() - m_lastResetTime).GetSeconds();
+    if (duration <= 0.0)
+    {
+        NS_LOG_WARN(this << " unable to compute the average throughput"
+                         << " because no time has elapsed since the start");
+        return;
+    }
+
+    for (uint32_t i = 0; i < m_bytes.size(); i++)
+    {
+        // Conversion from bytes to kilobits is done here, once per identifier.
+        const double throughput = static_cast<double>(m_bytes[i]) * 0.008 / duration;
+        m_outputTrace(m_names[i], throughput);
+        m_outputValueTrace(throughput);
+    }
+
+} // end of `void Flush ()`
+
+void
+ApplicationThroughputCollector::EndInterval()
+{
+    // NS_LOG_FUNCTION (this);
+
+    if (IsEnabled())
+    {
+        const double now = Simulator::Now().GetSeconds();
+        const double factor = 0.008 / m_intervalLength.GetSeconds();
+        for (uint32_t i = 0; i < m_bytes.size(); i++)
+        {
+            m_outputWithTimeTrace(m_names[i], now, static_cast<double>(m_bytes[i]) * factor);
+        }
+    }
+
+    for (uint32_t i = 0; i < m_bytes.size(); i++)
+    {
+        m_overallBytes[i] += m_bytes[i];
+    }
+
+    std::fill(m_bytes.begin(), m_bytes.end(), 0);
+    m_lastResetTime = Simulator::Now();
+    m_intervalEvent =
+        Simulator::Schedule(m_intervalLength, &ApplicationThroughputCollector::EndInterval, this);
+
+} // end of `void EndInterval ()`
+
+} // end of namespace ns3
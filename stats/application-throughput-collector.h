@@ -0,0 +1,184 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef APPLICATION_THROUGHPUT_COLLECTOR_H
+#define APPLICATION_THROUGHPUT_COLLECTOR_H
+
+#include "ns3/data-collection-object.h"
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+#include "ns3/traced-callback.h"
+
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup applicationstats
+ * @brief Throughput collector which keeps the state of every identifier in
+ *        contiguous arrays.
+ *
+ * Replaces a chain of one UnitConversionCollector and one ScalarCollector or
+ * IntervalRateCollector per identifier. Each received packet costs a single
+ * addition to a byte counter (see AddBytes()), while the conversion from bytes
+ * to kilobits per second is done only when an output is produced. Thus the
+ * memory usage is a few bytes per identifier, instead of several Objects.
+ *
+ * Two output types are supported:
+ * - `AVERAGE_PER_SECOND`: the average throughput of each identifier, from
+ *   the moment the collector is started until the end of simulation, is
+ *   emitted through the `Output` and `OutputValue` trace sources.
+ * - `INTERVAL_RATE`: the throughput of each identifier within every interval
+ *   of `IntervalLength` is emitted through the `OutputWithTime` trace source.
+ *   At the end of simulation, a summary of each identifier is emitted as a
+ *   string through the `OutputString` trace source, which is meant to be
+ *   used as the heading of the identifier in an output file.
+ *
+ * The context argument of the trace sources is the name of the identifier,
+ * as given to SetIdentifierNames().
+ */
+class ApplicationThroughputCollector : public DataCollectionObject
+{
+  public:
+    /// Types of output produced by the collector.
+    typedef enum
+    {
+        OUTPUT_TYPE_AVERAGE_PER_SECOND = 0,
+        OUTPUT_TYPE_INTERVAL_RATE
+    } OutputType_t;
+
+    /// Creates a new collector instance.
+    ApplicationThroughputCollector();
+
+    /// Destructor.
+    virtual ~ApplicationThroughputCollector();
+
+    // inherited from ObjectBase base class
+    static TypeId GetTypeId();
+
+    /**
+     * @param outputType the type of output produced by the collector.
+     */
+    void SetOutputType(OutputType_t outputType);
+
+    /**
+     * @return the type of output produced by the collector.
+     */
+    OutputType_t GetOutputType() const;
+
+    /**
+     * @brief Create one zeroed counter for each identifier.
+     * @param names the name of each identifier, indexed by the identifier.
+     */
+    void SetIdentifierNames(const std::vector<std::string>& names);
+
+    /**
+     * @return number of identifiers handled by this collector.
+     */
+    uint32_t GetNIdentifiers() const;
+
+    /**
+     * @brief Start collecting. In `INTERVAL_RATE` output type, also schedule
+     *        the end of the first interval.
+     */
+    void Start();
+
+    /**
+     * @brief Emit the final output, i.e., the average throughput in
+     *        `AVERAGE_PER_SECOND` output type or the summary string in
+     *        `INTERVAL_RATE` output type. Called once at the end of simulation.
+     */
+    void Flush();
+
+    /**
+     * @brief Count received bytes towards an identifier.
+     * @param identifier the identifier, must be less than GetNIdentifiers().
+     * @param bytes number of received bytes, possibly scaled up to make up
+     *              for the packets which were not sampled.
+     */
+    inline void AddBytes(uint32_t identifier, uint64_t bytes)
+    {
+        m_bytes[identifier] += bytes;
+    }
+
+    /**
+     * Common signature used by callbacks to this class' `Output` trace source.
+     * @param context the name of the identifier.
+     * @param throughput the average throughput, in kbps.
+     */
+    typedef void (*OutputCallback)(std::string context, double throughput);
+
+    /**
+     * Common signature used by callbacks to this class' `OutputWithTime`
+     * trace source.
+     * @param context the name of the identifier.
+     * @param time the end of the interval, in seconds.
+     * @param throughput the throughput within the interval, in kbps.
+     */
+    typedef void (*OutputWithTimeCallback)(std::string context, double time, double throughput);
+
+    /**
+     * Common signature used by callbacks to this class' `OutputString` trace
+     * source.
+     * @param context the name of the identifier.
+     * @param summary the summary of the identifier, in one or more lines
+     *                starting with a `%` character.
+     */
+    typedef void (*OutputStringCallback)(std::string context, std::string summary);
+
+  protected:
+    // Inherited from Object base class
+    virtual void DoDispose();
+
+  private:
+    /// Emit the throughput of the interval which has just ended and reset the counters.
+    void EndInterval();
+
+    OutputType_t m_outputType; ///< `OutputType` attribute.
+    Time m_intervalLength;     ///< `IntervalLength` attribute.
+
+    /// Name of each identifier.
+    std::vector<std::string> m_names;
+    /// Received bytes of each identifier since the last output.
+    std::vector<uint64_t> m_bytes;
+    /// Received bytes of each identifier in the already ended intervals.
+    std::vector<uint64_t> m_overallBytes;
+    /// Time when the collector was started.
+    Time m_startTime;
+    /// Time when the counters were last reset.
+    Time m_lastResetTime;
+    /// The event marking the end of the current interval.
+    EventId m_intervalEvent;
+
+    /// `Output` trace source.
+    TracedCallback<std::string, double> m_outputTrace;
+    /// `OutputValue` trace source.
+    TracedCallback<double> m_outputValueTrace;
+    /// `OutputWithTime` trace source.
+    TracedCallback<std::string, double, double> m_outputWithTimeTrace;
+    /// `OutputString` trace source.
+    TracedCallback<std::string, std::string> m_outputStringTrace;
+
+}; // end of class ApplicationThroughputCollector
+
+} // end of namespace ns3
+
+#endif /* APPLICATION_THROUGHPUT_COLLECTOR_H */
@@ -0,0 +1,627 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "async-file-aggregator.h"
+
+#include "ns3/boolean.h"
+#include "ns3/log.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+
+#include <cstdio>
+#include <vector>
+
+#if defined(HAVE_ZSTD)
+#include <zstd.h>
+#elif defined(HAVE_ZLIB)
+#include <zlib.h>
+#endif
+
+NS_LOG_COMPONENT_DEFINE("AsyncFileAggregator");
+
+namespace ns3
+{
+
+NS_OBJECT_ENSURE_REGISTERED(AsyncFileAggregator);
+
+#if defined(HAVE_ZSTD)
+
+struct AsyncFileAggregator::Compressor
+{
+    Compressor()
+        : m_context(ZSTD_createCCtx()),
+          m_output(ZSTD_CStreamOutSize())
+    {
+        NS_ASSERT(m_context != nullptr);
+        ZSTD_CCtx_setParameter(m_context, ZSTD_c_compressionLevel, 3);
+    }
+
+    ~Compressor()
+    {
+        ZSTD_freeCCtx(m_context);
+    }
+
+    void Write(const char* data, size_t size, std::ofstream& file)
+    {
+        ZSTD_inBuffer input = {data, size, 0};
+        while (input.pos < input.size)
+        {
+            ZSTD_outBuffer output = {m_output.data(), m_output.size(), 0};
+            const size_t ret = ZSTD_compressStream2(m_context, &output, &input, ZSTD_e_continue);
+            NS_ASSERT_MSG(!ZSTD_isError(ret), ZSTD_getErrorName(ret));
+            file.write(m_output.data(), output.pos);
+        }
+    }
+
+    void Finish(std::ofstream& file)
+    {
+        ZSTD_inBuffer input = {nullptr, 0, 0};
+        size_t remaining = 0;
+        do
+        {
+            ZSTD_outBuffer output = {m_output.data(), m_output.size(), 0};
+            remaining = ZSTD_compressStream2(m_context, &output, &input, ZSTD_e_end);
+            NS_ASSERT_MSG(!ZSTD_isError(remaining), ZSTD_getErrorName(remaining));
+            file.write(m_output.data(), output.pos);
+        } while (remaining != 0);
+    }
+
+    ZSTD_CCtx* m_context;
+    std::vector<char> m_output;
+};
+
+#elif defined(HAVE_ZLIB)
+
+struct AsyncFileAggregator::Compressor
+{
+    Compressor()
+        : m_output(262144)
+    {
+        m_stream.zalloc = Z_NULL;
+        m_stream.zfree = Z_NULL;
+        m_stream.opaque = Z_NULL;
+        // Window bits of 15 + 16 produces a gzip stream instead of a raw zlib stream.
+        const int ret = deflateInit2(&m_stream,
+                                     Z_DEFAULT_COMPRESSION,
+                                     Z_DEFLATED,
+                                     15 + 16,
+                                     8,
+                                     Z_DEFAULT_STRATEGY);
+        NS_ASSERT(ret == Z_OK);
+        NS_UNUSED(ret);
+    }
+
+    ~Compressor()
+    {
+        deflateEnd(&m_stream);
+    }
+
+    void Write(const char* data, size_t size, std::ofstream& file)
+    {
+        m_stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+        m_stream.avail_in = size;
+        do
+        {
+            m_stream.next_out = reinterpret_cast<Bytef*>(m_output.data());
+            m_stream.avail_out = m_output.size();
+            deflate(&m_stream, Z_NO_FLUSH);
+            file.write(m_output.data(), m_output.size() - m_stream.avail_out);
+        } while (m_stream.avail_out == 0);
+    }
+
+    void Finish(std::ofstream& file)
+    {
+        m_stream.next_in = Z_NULL;
+        m_stream.avail_in = 0;
+        int ret = Z_OK;
+        do
+        {
+            m_stream.next_out = reinterpret_cast<Bytef*>(m_output.data());
+            m_stream.avail_out = m_output.size();
+            ret = deflate(&m_stream, Z_FINISH);
+            file.write(m_output.data(), m_output.size() - m_stream.avail_out);
+        } while (ret != Z_STREAM_END);
+    }
+
+    z_stream m_stream;
+    std::vector<char> m_output;
+};
+
+#else
+
+struct AsyncFileAggregator::Compressor
+{
+    void Write(const char* data, size_t size, std::ofstream& file)
+    {
+        file.write(data, size);
+    }
+
+    void Finish(std::ofstream& /* file */)
+    {
+    }
+};
+
+#endif
+
+bool // static
+AsyncFileAggregator::IsCompressionSupported()
+{
+#if defined(HAVE_ZSTD) || defined(HAVE_ZLIB)
+    return true;
+#else
+    return false;
+#endif
+}
+
+std::string // static
+AsyncFileAggregator::GetCompressedFileExtension()
+{
+#if defined(HAVE_ZSTD)
+    return ".zst";
+#elif defined(HAVE_ZLIB)
+    return ".gz";
+#else
+    return "";
+#endif
+}
+
+AsyncFileAggregator::AsyncFileAggregator()
+    : m_outputFileName("untitled"),
+      m_isMultiFileMode(true),
+      m_isContextPrinted(false),
+      m_generalHeading(""),
+      m_ringCapacity(65536),
+      m_blockSize(1048576),
+      m_isAsynchronous(true),
+      m_isCompressed(false),
+      m_isDisposed(false),
+      m_head(0),
+      m_tail(0),
+      m_isStopRequested(false),
+      m_isWriterWaiting(false)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+AsyncFileAggregator::~AsyncFileAggregator()
+{
+    NS_LOG_FUNCTION(this);
+    StopWriter();
+    FlushAndClose();
+}
+
+TypeId // static
+AsyncFileAggregator::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::AsyncFileAggregator")
+            .SetParent<DataCollectionObject>()
+            .AddConstructor<AsyncFileAggregator>()
+            .AddAttribute("OutputFileName",
+                          "The path to the output file. In multi-file mode, the context "
+                          "name is appended to the path.",
+                          StringValue("untitled"),
+                          MakeStringAccessor(&AsyncFileAggregator::m_outputFileName),
+                          MakeStringChecker())
+            .AddAttribute("MultiFileMode",
+                          "If true, each context is written to a separate file.",
+                          BooleanValue(true),
+                          MakeBooleanAccessor(&AsyncFileAggregator::m_isMultiFileMode),
+                          MakeBooleanChecker())
+            .AddAttribute("EnableContextPrinting",
+                          "If true, the context name is printed as the first column of "
+                          "every line.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&AsyncFileAggregator::m_isContextPrinted),
+                          MakeBooleanChecker())
+            .AddAttribute("GeneralHeading",
+                          "A line written at the beginning of every output file.",
+                          StringValue(""),
+                          MakeStringAccessor(&AsyncFileAggregator::m_generalHeading),
+                          MakeStringChecker())
+            .AddAttribute("RingCapacity",
+                          "Number of records which can be queued for the writer thread. "
+                          "Rounded up to a power of two.",
+                          UintegerValue(65536),
+                          MakeUintegerAccessor(&AsyncFileAggregator::m_ringCapacity),
+                          MakeUintegerChecker<uint32_t>(2))
+            .AddAttribute("BlockSize",
+                          "Number of bytes accumulated for a file before they are "
+                          "written to disk.",
+                          UintegerValue(1048576),
+                          MakeUintegerAccessor(&AsyncFileAggregator::m_blockSize),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("Asynchronous",
+                          "If true, formatting and writing are done by a background thread. "
+                          "Otherwise they are done immediately in the simulation thread.",
+                          BooleanValue(true),
+                          MakeBooleanAccessor(&AsyncFileAggregator::m_isAsynchronous),
+                          MakeBooleanChecker())
+            .AddAttribute("Compressed",
+                          "If true, the output files are compressed using the streaming "
+                          "compressor available at build time (zstd or zlib).",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&AsyncFileAggregator::m_isCompressed),
+                          MakeBooleanChecker());
+    return tid;
+}
+
+void
+AsyncFileAggregator::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    StopWriter();
+    FlushAndClose();
+    m_isDisposed = true;
+    DataCollectionObject::DoDispose();
+}
+
+void
+AsyncFileAggregator::Write1d(std::string context, double v1)
+{
+    if (IsEnabled())
+    {
+        Record record;
+        record.type = AsyncFileAggregator::RECORD_1D;
+        record.context = GetContextIndex(context);
+        record.v1 = v1;
+        record.v2 = 0.0;
+        Push(record);
+    }
+}
+
+void
+AsyncFileAggregator::Write2d(std::string context, double v1, double v2)
+{
+    if (IsEnabled())
+    {
+        Record record;
+        record.type = AsyncFileAggregator::RECORD_2D;
+        record.context = GetContextIndex(context);
+        record.v1 = v1;
+        record.v2 = v2;
+        Push(record);
+    }
+}
+
+void
+AsyncFileAggregator::AddContextHeading(std::string context, std::string heading)
+{
+    NS_LOG_FUNCTION(this << context << heading);
+
+    Record record;
+    record.type = AsyncFileAggregator::RECORD_HEADING;
+    record.context = GetContextIndex(context);
+    record.v1 = 0.0;
+    record.v2 = 0.0;
+    record.text = heading;
+    Push(record);
+}
+
+void
+AsyncFileAggregator::EnableContextWarning(std::string context, bool isEnabled)
+{
+    NS_LOG_FUNCTION(this << context << isEnabled);
+
+    if (isEnabled)
+    {
+        Record record;
+        record.type = AsyncFileAggregator::RECORD_WARNING;
+        record.context = GetContextIndex(context);
+        record.v1 = 0.0;
+        record.v2 = 0.0;
+        Push(record);
+    }
+}
+
+uint32_t
+AsyncFileAggregator::GetContextIndex(const std::string& context)
+{
+    std::map<std::string, uint32_t>::const_iterator it = m_contextIndex.find(context);
+
+    if (it != m_contextIndex.end())
+    {
+        return it->second;
+    }
+
+    const uint32_t index = m_contextIndex.size();
+    m_contextIndex[context] = index;
+    NS_LOG_INFO(this << " new context " << context << " with index " << index);
+
+    Record record;
+    record.type = AsyncFileAggregator::RECORD_OPEN_CONTEXT;
+    record.context = index;
+    record.v1 = 0.0;
+    record.v2 = 0.0;
+    record.text = context;
+    Push(record);
+    return index;
+}
+
+void
+AsyncFileAggregator::Push(Record& record)
+{
+    if (m_isDisposed)
+    {
+        // The files have already been closed, so append the record right away.
+        Process(record);
+        FlushAndClose();
+        return;
+    }
+
+    if (!m_isAsynchronous)
+    {
+        // There is no writer thread, so process the record right away.
+        Process(record);
+        return;
+    }
+
+    if (m_ring.empty())
+    {
+        // Round the capacity up to a power of two, so that positions can be masked.
+        uint32_t capacity = 1;
+        while (capacity < m_ringCapacity)
+        {
+            capacity <<= 1;
+        }
+
+        m_ring.resize(capacity);
+        m_writer = std::thread(&AsyncFileAggregator::WriterLoop, this);
+        NS_LOG_INFO(this << " started writer thread with ring capacity " << capacity);
+    }
+
+    const uint64_t head = m_head.load(std::memory_order_relaxed);
+    while (head - m_tail.load(std::memory_order_acquire) >= m_ring.size())
+    {
+        // The ring is full, wait until the writer thread has consumed a record.
+        std::this_thread::yield();
+    }
+
+    m_ring[head & (m_ring.size() - 1)] = std::move(record);
+
+    /*
+     * Both this store and the load below are sequentially consistent, and so
+     * are their counterparts in WriterLoop(). Either the writer sees the new
+     * record before it sleeps, or this thread sees that the writer sleeps.
+     */
+    m_head.store(head + 1);
+    if (m_isWriterWaiting.load())
+    {
+        std::lock_guard<std::mutex> lock(m_wakeUpMutex);
+        m_wakeUp.notify_one();
+    }
+}
+
+void
+AsyncFileAggregator::WriterLoop()
+{
+    while (true)
+    {
+        if (!PopAndProcess())
+        {
+            if (m_isStopRequested.load(std::memory_order_acquire))
+            {
+                // Check once more, the producer may have pushed before requesting the stop.
+                while (PopAndProcess())
+                {
+                }
+                break;
+            }
+
+            // Sleep until the simulation thread pushes a record or requests a stop.
+            std::unique_lock<std::mutex> lock(m_wakeUpMutex);
+            m_isWriterWaiting.store(true);
+            m_wakeUp.wait(lock, [this]() {
+                return m_isStopRequested.load() ||
+                       m_tail.load(std::memory_order_relaxed) != m_head.load();
+            });
+            m_isWriterWaiting.store(false);
+        }
+    }
+}
+
+bool
+AsyncFileAggregator::PopAndProcess()
+{
+    const uint64_t tail = m_tail.load(std::memory_order_relaxed);
+
+    if (tail == m_head.load(std::memory_order_acquire))
+    {
+        return false;
+    }
+
+    Record& record = m_ring[tail & (m_ring.size() - 1)];
+    Process(record);
+    record.text.clear();
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+void
+AsyncFileAggregator::Process(const Record& record)
+{
+    if (record.type == AsyncFileAggregator::RECORD_OPEN_CONTEXT)
+    {
+        NS_ASSERT(record.context == m_contexts.size());
+        std::string fileName = m_isMultiFileMode ? m_outputFileName + "-" + record.text + ".txt"
+                                                 : m_outputFileName + ".txt";
+        const bool isCompressed = m_isCompressed && IsCompressionSupported();
+        if (isCompressed)
+        {
+            fileName += GetCompressedFileExtension();
+        }
+        else if (m_isCompressed)
+        {
+            NS_LOG_WARN(this << " compression is not available in this build,"
+                             << " writing " << fileName << " as plain text");
+        }
+
+        std::map<std::string, FileState>::iterator it = m_files.find(fileName);
+
+        if (it == m_files.end())
+        {
+            it = m_files.insert(std::make_pair(fileName, FileState())).first;
+            it->second.compressor = isCompressed ? new Compressor() : nullptr;
+            it->second.file.open(fileName.c_str(), std::ios::out | std::ios::binary);
+
+            if (!it->second.file.is_open())
+            {
+                NS_FATAL_ERROR("Unable to open output file " << fileName);
+            }
+
+            if (!m_generalHeading.empty())
+            {
+                it->second.buffer.append(m_generalHeading);
+                it->second.buffer.push_back('\n');
+            }
+        }
+
+        ContextState c;
+        c.name = record.text;
+        c.file = &it->second;
+        m_contexts.push_back(c);
+        return;
+    }
+
+    NS_ASSERT(record.context < m_contexts.size());
+    const ContextState& c = m_contexts[record.context];
+    char line[64];
+
+    switch (record.type)
+    {
+    case AsyncFileAggregator::RECORD_1D:
+        std::snprintf(line, sizeof(line), "%g", record.v1);
+        AppendLine(c, line);
+        break;
+
+    case AsyncFileAggregator::RECORD_2D:
+        std::snprintf(line, sizeof(line), "%g %g", record.v1, record.v2);
+        AppendLine(c, line);
+        break;
+
+    case AsyncFileAggregator::RECORD_HEADING:
+        c.file->buffer.append(record.text);
+        c.file->buffer.push_back('\n');
+        break;
+
+    case AsyncFileAggregator::RECORD_WARNING:
+        c.file->buffer.append("% WARNING: some samples are outside of the output range of ");
+        c.file->buffer.append(c.name);
+        c.file->buffer.push_back('\n');
+        break;
+
+    default:
+        NS_FATAL_ERROR("AsyncFileAggregator - Invalid record type");
+        break;
+    }
+
+} // end of `void Process (const Record &)`
+
+void
+AsyncFileAggregator::AppendLine(const ContextState& c, const std::string& line)
+{
+    std::string& buffer = c.file->buffer;
+
+    if (m_isContextPrinted)
+    {
+        buffer.append(c.name);
+        buffer.push_back(' ');
+    }
+
+    buffer.append(line);
+    buffer.push_back('\n');
+
+    if (buffer.size() >= m_blockSize && c.file->file.is_open())
+    {
+        WriteBlock(*c.file);
+    }
+}
+
+void
+AsyncFileAggregator::WriteBlock(FileState& f)
+{
+    if (f.compressor == nullptr)
+    {
+        f.file.write(f.buffer.data(), f.buffer.size());
+    }
+    else
+    {
+        f.compressor->Write(f.buffer.data(), f.buffer.size(), f.file);
+    }
+
+    f.buffer.clear();
+}
+
+void
+AsyncFileAggregator::FlushAndClose()
+{
+    for (std::map<std::string, FileState>::iterator it = m_files.begin(); it != m_files.end();
+         ++it)
+    {
+        if (!it->second.file.is_open() && !it->second.buffer.empty())
+        {
+            // Input received after disposal. Reopen the file and append to it; a
+            // compressed file then continues with a new, concatenated stream.
+            it->second.file.open(it->first.c_str(),
+                                 std::ios::out | std::ios::app | std::ios::binary);
+
+            if (!it->second.file.is_open())
+            {
+                NS_FATAL_ERROR("Unable to reopen output file " << it->first);
+            }
+
+            if (m_isCompressed && IsCompressionSupported())
+            {
+                it->second.compressor = new Compressor();
+            }
+        }
+
+        if (it->second.file.is_open())
+        {
+            WriteBlock(it->second);
+
+            if (it->second.compressor != nullptr)
+            {
+                it->second.compressor->Finish(it->second.file);
+                delete it->second.compressor;
+                it->second.compressor = nullptr;
+            }
+
+            it->second.file.close();
+        }
+    }
+}
+
+void
+AsyncFileAggregator::StopWriter()
+{
+    if (m_writer.joinable())
+    {
+        NS_LOG_INFO(this << " stopping writer thread");
+        {
+            // Under the lock, so that the writer cannot miss the request.
+            std::lock_guard<std::mutex> lock(m_wakeUpMutex);
+            m_isStopRequested.store(true);
+        }
+        m_wakeUp.notify_one();
+        m_writer.join();
+    }
+}
+
+} // end of namespace ns3
@@ -0,0 +1,265 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef ASYNC_FILE_AGGREGATOR_H
+#define ASYNC_FILE_AGGREGATOR_H
+
+#include "ns3/data-collection-object.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup applicationstats
+ * @brief Text file aggregator which offloads formatting and file I/O to a
+ *        dedicated background thread.
+ *
+ * Accepts the same inputs and produces the same text output as
+ * MultiFileAggregator, i.e., one file per context in multi-file mode, or a
+ * single file with optional context column otherwise.
+ *
+ * The simulation thread only pushes fixed-size records into a lock-free
+ * single-producer single-consumer ring buffer. The writer thread pops the
+ * records, formats them into per-file block buffers, and flushes a block to
+ * disk only when it is full. Thus the event loop never waits for the file
+ * system, unless the ring buffer is full, in which case the simulation thread
+ * yields until the writer thread catches up. When the ring buffer is empty,
+ * the writer thread sleeps on a condition variable, and the simulation thread
+ * wakes it up only if it is actually sleeping.
+ *
+ * The writer thread is started upon the first input and is stopped (after
+ * draining the ring buffer) when the aggregator is disposed, at which point
+ * every file is flushed and closed. Inputs received after disposal are
+ * appended to their files immediately. If the `Asynchronous` attribute is
+ * disabled, the records are processed immediately in the simulation thread
+ * instead.
+ *
+ * If the `Compressed` attribute is enabled, every block is passed through a
+ * streaming compressor before being written to disk. The compressor is chosen
+ * at build time: zstd (`.txt.zst` files) if available, otherwise zlib
+ * (`.txt.gz` files). Without either library, the output is written as plain
+ * text.
+ */
+class AsyncFileAggregator : public DataCollectionObject
+{
+  public:
+    /// Creates a new aggregator instance.
+    AsyncFileAggregator();
+
+    /// Destructor.
+    virtual ~AsyncFileAggregator();
+
+    // inherited from ObjectBase base class
+    static TypeId GetTypeId();
+
+    /**
+     * @brief Write a single value to the file of the given context.
+     * @param context specifies which file.
+     * @param v1 the value.
+     */
+    void Write1d(std::string context, double v1);
+
+    /**
+     * @brief Write a pair of values to the file of the given context.
+     * @param context specifies which file.
+     * @param v1 the first value.
+     * @param v2 the second value.
+     */
+    void Write2d(std::string context, double v1, double v2);
+
+    /**
+     * @brief Add a heading line to the file of the given context.
+     * @param context specifies which file.
+     * @param heading the content of the heading line.
+     */
+    void AddContextHeading(std::string context, std::string heading);
+
+    /**
+     * @brief Add a warning line to the file of the given context.
+     * @param context specifies which file.
+     * @param isEnabled whether the warning is written.
+     */
+    void EnableContextWarning(std::string context, bool isEnabled);
+
+    /**
+     * @return true if this build supports the `Compressed` attribute.
+     */
+    static bool IsCompressionSupported();
+
+    /**
+     * @return the file name extension appended after `.txt` when the
+     *         `Compressed` attribute is enabled, e.g., `.zst` or `.gz`.
+     */
+    static std::string GetCompressedFileExtension();
+
+  protected:
+    // Inherited from Object base class
+    virtual void DoDispose();
+
+  private:
+    /// Types of record carried by the ring buffer.
+    typedef enum
+    {
+        RECORD_OPEN_CONTEXT = 0,
+        RECORD_1D,
+        RECORD_2D,
+        RECORD_HEADING,
+        RECORD_WARNING
+    } RecordType_t;
+
+    /// A single entry of the ring buffer.
+    struct Record
+    {
+        RecordType_t type; ///< Determines which of the fields below are valid.
+        uint32_t context;  ///< Index of the context.
+        double v1;         ///< First value (1d and 2d records).
+        double v2;         ///< Second value (2d records).
+        std::string text;  ///< Context name or heading (rare records only).
+    };
+
+    /// Streaming compressor of a single file, defined according to the build.
+    struct Compressor;
+
+    /// An open output file and its block buffer, owned by the writer thread.
+    struct FileState
+    {
+        std::ofstream file;     ///< The output file.
+        std::string buffer;     ///< Formatted lines not yet written to the file.
+        Compressor* compressor; ///< Null if the file is written as plain text.
+    };
+
+    /// Output state of a single context, owned by the writer thread.
+    struct ContextState
+    {
+        std::string name; ///< Name of the context.
+        FileState* file;  ///< The file this context is written to.
+    };
+
+    /**
+     * @brief Translate a context name into its index, announcing new contexts
+     *        to the writer thread.
+     * @param context name of the context.
+     * @return index of the context.
+     */
+    uint32_t GetContextIndex(const std::string& context);
+
+    /**
+     * @brief Push a record to the ring buffer, starting the writer thread if
+     *        necessary.
+     * @param record the record to be moved into the ring buffer.
+     *
+     * Only invoked from the simulation thread. After the aggregator has been
+     * disposed, the record is processed synchronously and appended to its
+     * file, which is then closed again.
+     */
+    void Push(Record& record);
+
+    /// Main loop of the writer thread.
+    void WriterLoop();
+
+    /**
+     * @brief Pop a record from the ring buffer and process it.
+     * @return false if the ring buffer is empty.
+     */
+    bool PopAndProcess();
+
+    /**
+     * @brief Format a record into the block buffer of its context.
+     * @param record the record.
+     */
+    void Process(const Record& record);
+
+    /**
+     * @brief Append a line to the block buffer of a context, writing the
+     *        block to disk if it has become full.
+     * @param c the context.
+     * @param line the line, without the newline character.
+     */
+    void AppendLine(const ContextState& c, const std::string& line);
+
+    /**
+     * @brief Write the block buffer of a file to disk, through the compressor
+     *        if there is one.
+     * @param f the file.
+     */
+    void WriteBlock(FileState& f);
+
+    /// Write every block buffer to disk and close all files, reopening a closed
+    /// file in append mode if its block buffer is not empty.
+    void FlushAndClose();
+
+    /// Stop the writer thread after it has drained the ring buffer.
+    void StopWriter();
+
+    std::string m_outputFileName; ///< `OutputFileName` attribute.
+    bool m_isMultiFileMode;       ///< `MultiFileMode` attribute.
+    bool m_isContextPrinted;      ///< `EnableContextPrinting` attribute.
+    std::string m_generalHeading; ///< `GeneralHeading` attribute.
+    uint32_t m_ringCapacity;      ///< `RingCapacity` attribute.
+    uint32_t m_blockSize;         ///< `BlockSize` attribute.
+    bool m_isAsynchronous;        ///< `Asynchronous` attribute.
+    bool m_isCompressed;          ///< `Compressed` attribute.
+
+    // Simulation thread only.
+
+    /// Map of context names and their indices.
+    std::map<std::string, uint32_t> m_contextIndex;
+    /// True after DoDispose(); inputs are then appended synchronously.
+    bool m_isDisposed;
+
+    // Shared between the simulation thread and the writer thread.
+
+    /// The ring buffer, sized to a power of two at the first input.
+    std::vector<Record> m_ring;
+    /// Producer position (written by the simulation thread only).
+    std::atomic<uint64_t> m_head;
+    /// Consumer position (written by the writer thread only).
+    std::atomic<uint64_t> m_tail;
+    /// Set by the simulation thread to request the writer thread to stop.
+    std::atomic<bool> m_isStopRequested;
+    /// Set by the writer thread while it sleeps on #m_wakeUp.
+    std::atomic<bool> m_isWriterWaiting;
+    /// Protects the sleep of the writer thread against missed wake-ups.
+    std::mutex m_wakeUpMutex;
+    /// Wakes the writer thread up when a record is pushed or a stop is requested.
+    std::condition_variable m_wakeUp;
+    /// The writer thread.
+    std::thread m_writer;
+
+    // Writer thread only (or simulation thread after the writer has stopped).
+
+    /// Output state of every context, indexed by the context index.
+    std::vector<ContextState> m_contexts;
+    /// Open files, indexed by file name.
+    std::map<std::string, FileState> m_files;
+
+}; // end of class AsyncFileAggregator
+
+} // end of namespace ns3
+
+#endif /* ASYNC_FILE_AGGREGATOR_H */
@@ -0,0 +1,1305 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+/**
+ * @file application-stats-test.cc
+ * @ingroup applicationstats
+ * @brief Test cases for the application statistics helpers and their
+ *        collectors and aggregators, grouped in `application-stats` test
+ *        suite.
+ */
+
+#include "ns3/admission-ramp-controller.h"
+#include "ns3/application-container.h"
+#include "ns3/application-stats-delay-helper.h"
+#include "ns3/application-stats-plt-helper.h"
+#include "ns3/application-stats-rtt-helper.h"
+#include "ns3/application-stats-throughput-helper.h"
+#include "ns3/application-throughput-collector.h"
+#include "ns3/application.h"
+#include "ns3/async-file-aggregator.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/enum.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/interval-rate-collector.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-address.h"
+#include "ns3/ipv4-interface-container.h"
+#include "ns3/log.h"
+#include "ns3/net-device-container.h"
+#include "ns3/node-container.h"
+#include "ns3/nstime.h"
+#include "ns3/packet.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/scalar-collector.h"
+#include "ns3/simple-channel.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/traced-callback.h"
+#include "ns3/uinteger.h"
+#include "ns3/unit-conversion-collector.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <vector>
+
+#if defined(HAVE_ZSTD)
+#include <zstd.h>
+#elif defined(HAVE_ZLIB)
+#include <zlib.h>
+#endif
+
+NS_LOG_COMPONENT_DEFINE("ApplicationStatsTest");
+
+using namespace ns3;
+
+/**
+ * @brief Read a whole file into a string.
+ * @param fileName path to the file.
+ * @return the content of the file, or an empty string if it cannot be read.
+ */
+static std::string
+ApplicationStatsTestReadFile(const std::string& fileName)
+{
+    std::ifstream ifs(fileName.c_str(), std::ios::in | std::ios::binary);
+    std::ostringstream oss;
+    oss << ifs.rdbuf();
+    return oss.str();
+}
+
+/**
+ * @brief Read the data lines of a text file, i.e., those which are not empty
+ *        and do not begin with `%`.
+ * @param fileName path to the file.
+ * @return the lines, split into their numeric columns.
+ */
+static std::vector<std::vector<double>>
+ApplicationStatsTestReadDataLines(const std::string& fileName)
+{
+    std::ifstream ifs(fileName.c_str());
+    std::vector<std::vector<double>> lines;
+    std::string line;
+
+    while (std::getline(ifs, line))
+    {
+        if (!line.empty() && line[0] != '%')
+        {
+            std::istringstream iss(line);
+            std::vector<double> columns;
+            double value;
+            while (iss >> value)
+            {
+                columns.push_back(value);
+            }
+            lines.push_back(columns);
+        }
+    }
+
+    return lines;
+}
+
+/**
+ * @brief Read the value of the first data line of a scalar file written with
+ *        context printing, i.e., a line made of an identifier and a value.
+ * @param fileName path to the file.
+ * @return the value, or a negative number if the file holds no such line.
+ */
+static double
+ApplicationStatsTestReadScalar(const std::string& fileName)
+{
+    std::ifstream ifs(fileName.c_str());
+    std::string line;
+
+    while (std::getline(ifs, line))
+    {
+        if (!line.empty() && line[0] != '%')
+        {
+            std::istringstream iss(line);
+            std::string identifier;
+            double value;
+            if (iss >> identifier >> value)
+            {
+                return value;
+            }
+        }
+    }
+
+    return -1.0;
+}
+
+namespace ns3
+{
+
+/**
+ * @ingroup applicationstats
+ * @brief An application without any traffic, which fires the trace sources
+ *        listened to by the application statistics helpers on demand.
+ */
+class ApplicationStatsTestApplication : public Application
+{
+  public:
+    // inherited from ObjectBase base class
+    static TypeId GetTypeId();
+
+    /**
+     * @brief Fire the `RxDelay` trace source.
+     * @param delay the delay sample.
+     * @param from the address of the sender.
+     */
+    void FireRxDelay(Time delay, Address from);
+
+    /**
+     * @brief Fire the `RxPlt` trace source.
+     * @param plt the page load time sample.
+     * @param from the address of the sender.
+     */
+    void FireRxPlt(Time plt, Address from);
+
+    /**
+     * @brief Fire the `RxRtt` trace source.
+     * @param rtt the round trip time sample.
+     * @param from the address of the sender.
+     */
+    void FireRxRtt(Time rtt, Address from);
+
+    /**
+     * @brief Fire the `Rx` trace source with a new packet.
+     * @param size the size of the packet, in bytes.
+     * @param from the address of the sender.
+     */
+    void FireRx(uint32_t size, Address from);
+
+  private:
+    /// The `RxDelay` trace source.
+    TracedCallback<const Time&, const Address&> m_rxDelayTrace;
+    /// The `RxPlt` trace source.
+    TracedCallback<const Time&, const Address&> m_rxPltTrace;
+    /// The `RxRtt` trace source.
+    TracedCallback<const Time&, const Address&> m_rxRttTrace;
+    /// The `Rx` trace source.
+    TracedCallback<Ptr<const Packet>, const Address&> m_rxTrace;
+
+}; // end of `class ApplicationStatsTestApplication`
+
+NS_OBJECT_ENSURE_REGISTERED(ApplicationStatsTestApplication);
+
+TypeId // static
+ApplicationStatsTestApplication::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::ApplicationStatsTestApplication")
+            .SetParent<Application>()
+            .AddConstructor<ApplicationStatsTestApplication>()
+            .AddTraceSource(
+                "RxDelay",
+                "Delay sample fired on demand.",
+                MakeTraceSourceAccessor(&ApplicationStatsTestApplication::m_rxDelayTrace),
+                "ns3::Application::PacketDelayAddressCallback")
+            .AddTraceSource(
+                "RxPlt",
+                "Page load time sample fired on demand.",
+                MakeTraceSourceAccessor(&ApplicationStatsTestApplication::m_rxPltTrace),
+                "ns3::Application::PacketDelayAddressCallback")
+            .AddTraceSource(
+                "RxRtt",
+                "Round trip time sample fired on demand.",
+                MakeTraceSourceAccessor(&ApplicationStatsTestApplication::m_rxRttTrace),
+                "ns3::Application::PacketDelayAddressCallback")
+            .AddTraceSource("Rx",
+                            "Packet fired on demand.",
+                            MakeTraceSourceAccessor(&ApplicationStatsTestApplication::m_rxTrace),
+                            "ns3::Packet::AddressTracedCallback");
+    return tid;
+}
+
+void
+ApplicationStatsTestApplication::FireRxDelay(Time delay, Address from)
+{
+    m_rxDelayTrace(delay, from);
+}
+
+void
+ApplicationStatsTestApplication::FireRxPlt(Time plt, Address from)
+{
+    m_rxPltTrace(plt, from);
+}
+
+void
+ApplicationStatsTestApplication::FireRxRtt(Time rtt, Address from)
+{
+    m_rxRttTrace(rtt, from);
+}
+
+void
+ApplicationStatsTestApplication::FireRx(uint32_t size, Address from)
+{
+    m_rxTrace(Create<Packet>(size), from);
+}
+
+} // end of namespace ns3
+
+/**
+ * @brief Decompress the content of a file written by AsyncFileAggregator
+ *        with the `Compressed` attribute enabled.
+ * @param data the compressed content, possibly made of several concatenated
+ *             streams.
+ * @return the decompressed content, or an empty string on a decoding error.
+ *
+ * Without a compressor in this build, the content is returned as it is.
+ */
+static std::string
+ApplicationStatsTestDecompress(const std::string& data)
+{
+    std::string result;
+    std::vector<char> output(65536);
+
+#if defined(HAVE_ZSTD)
+    ZSTD_DCtx* context = ZSTD_createDCtx();
+    ZSTD_inBuffer input = {data.data(), data.size(), 0};
+    bool isOutputFull = false;
+    while (input.pos < input.size || isOutputFull)
+    {
+        ZSTD_outBuffer out = {output.data(), output.size(), 0};
+        const size_t ret = ZSTD_decompressStream(context, &out, &input);
+        if (ZSTD_isError(ret))
+        {
+            result.clear();
+            break;
+        }
+        result.append(output.data(), out.pos);
+        isOutputFull = (out.pos == out.size);
+    }
+    ZSTD_freeDCtx(context);
+#elif defined(HAVE_ZLIB)
+    z_stream stream;
+    stream.zalloc = Z_NULL;
+    stream.zfree = Z_NULL;
+    stream.opaque = Z_NULL;
+    stream.next_in = Z_NULL;
+    stream.avail_in = 0;
+    // Window bits of 15 + 32 detects the gzip header automatically.
+    inflateInit2(&stream, 15 + 32);
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    stream.avail_in = data.size();
+    while (stream.avail_in > 0)
+    {
+        stream.next_out = reinterpret_cast<Bytef*>(output.data());
+        stream.avail_out = output.size();
+        const int ret = inflate(&stream, Z_NO_FLUSH);
+        if (ret != Z_OK && ret != Z_STREAM_END)
+        {
+            result.clear();
+            break;
+        }
+        result.append(output.data(), output.size() - stream.avail_out);
+        if (ret == Z_STREAM_END)
+        {
+            // The next gzip member, if any, continues the content.
+            inflateReset(&stream);
+        }
+    }
+    inflateEnd(&stream);
+#else
+    result = data;
+#endif
+
+    return result;
+}
+
+/**
+ * @ingroup applicationstats
+ * @brief Verifies that AsyncFileAggregator writes the inputs which are still
+ *        in its block buffers to disk when it is disposed, and that inputs
+ *        received after disposal are appended to the files.
+ *
+ * Only a few lines are written, i.e., far less than the `BlockSize`
+ * attribute, so none of them reaches the disk before the disposal. The files
+ * are read back while the aggregator object is still alive.
+ */
+class AsyncFileAggregatorDisposeTestCase : public TestCase
+{
+  public:
+    /**
+     * @brief Construct a new test case.
+     * @param name the test case name, which will be printed on the report
+     * @param isAsynchronous the `Asynchronous` attribute of the aggregator
+     */
+    AsyncFileAggregatorDisposeTestCase(std::string name, bool isAsynchronous);
+
+  private:
+    virtual void DoRun();
+
+    bool m_isAsynchronous;
+
+}; // end of `class AsyncFileAggregatorDisposeTestCase`
+
+AsyncFileAggregatorDisposeTestCase::AsyncFileAggregatorDisposeTestCase(std::string name,
+                                                                       bool isAsynchronous)
+    : TestCase(name),
+      m_isAsynchronous(isAsynchronous)
+{
+    NS_LOG_FUNCTION(this << name << isAsynchronous);
+}
+
+void
+AsyncFileAggregatorDisposeTestCase::DoRun()
+{
+    NS_LOG_FUNCTION(this << GetName());
+
+    const std::string outputFileName = CreateTempDirFilename("async-file-aggregator");
+
+    Ptr<AsyncFileAggregator> aggregator = CreateObject<AsyncFileAggregator>();
+    aggregator->SetAttribute("OutputFileName", StringValue(outputFileName));
+    aggregator->SetAttribute("MultiFileMode", BooleanValue(true));
+    aggregator->SetAttribute("GeneralHeading", StringValue("% general heading"));
+    aggregator->SetAttribute("Asynchronous", BooleanValue(m_isAsynchronous));
+
+    aggregator->AddContextHeading("first", "% time value");
+    aggregator->Write2d("first", 0.5, 100);
+    aggregator->Write1d("second", 2.25);
+    aggregator->Write2d("first", 1.0, 1500);
+    aggregator->Write1d("second", -3);
+
+    aggregator->Dispose();
+
+    NS_TEST_ASSERT_MSG_EQ(ApplicationStatsTestReadFile(outputFileName + "-first.txt"),
+                          "% general heading\n% time value\n0.5 100\n1 1500\n",
+                          "Unexpected content of the first file after disposal");
+    NS_TEST_ASSERT_MSG_EQ(ApplicationStatsTestReadFile(outputFileName + "-second.txt"),
+                          "% general heading\n2.25\n-3\n",
+                          "Unexpected content of the second file after disposal");
+
+    // Late inputs are appended to the existing file, or open a new one.
+    aggregator->Write2d("first", 2.0, 40);
+    aggregator->Write1d("third", 7);
+
+    NS_TEST_ASSERT_MSG_EQ(ApplicationStatsTestReadFile(outputFileName + "-first.txt"),
+                          "% general heading\n% time value\n0.5 100\n1 1500\n2 40\n",
+                          "Unexpected content of the first file after a late input");
+    NS_TEST_ASSERT_MSG_EQ(ApplicationStatsTestReadFile(outputFileName + "-third.txt"),
+                          "% general heading\n7\n",
+                          "Unexpected content of the third file after a late input");
+
+    aggregator = nullptr;
+    Simulator::Destroy();
+
+} // end of `void DoRun ()`
+
+/**
+ * @ingroup applicationstats
+ * @brief Verifies that the output of AsyncFileAggregator with the
+ *        `Compressed` attribute enabled decompresses into the same text as
+ *        without compression.
+ *
+ * A tiny `BlockSize` passes many blocks through the streaming compressor. An
+ * input received after disposal appends a second, concatenated stream to the
+ * file. In a build without a compressor, the plain text output is verified.
+ */
+class AsyncFileAggregatorCompressionTestCase : public TestCase
+{
+  public:
+    /**
+     * @brief Construct a new test case.
+     * @param name the test case name, which will be printed on the report
+     * @param blockSize the `BlockSize` attribute of the aggregator
+     */
+    AsyncFileAggregatorCompressionTestCase(std::string name, uint32_t blockSize);
+
+  private:
+    virtual void DoRun();
+
+    uint32_t m_blockSize;
+
+}; // end of `class AsyncFileAggregatorCompressionTestCase`
+
+AsyncFileAggregatorCompressionTestCase::AsyncFileAggregatorCompressionTestCase(
+    std::string name,
+    uint32_t blockSize)
+    : TestCase(name),
+      m_blockSize(blockSize)
+{
+    NS_LOG_FUNCTION(this << name << blockSize);
+}
+
+void
+AsyncFileAggregatorCompressionTestCase::DoRun()
+{
+    NS_LOG_FUNCTION(this << GetName());
+
+    const std::string outputFileName = CreateTempDirFilename("async-file-aggregator-compressed");
+
+    Ptr<AsyncFileAggregator> aggregator = CreateObject<AsyncFileAggregator>();
+    aggregator->SetAttribute("OutputFileName", StringValue(outputFileName));
+    aggregator->SetAttribute("MultiFileMode", BooleanValue(false));
+    aggregator->SetAttribute("EnableContextPrinting", BooleanValue(true));
+    aggregator->SetAttribute("BlockSize", UintegerValue(m_blockSize));
+    aggregator->SetAttribute("Compressed", BooleanValue(true));
+
+    std::ostringstream expected;
+
+    for (uint32_t i = 0; i < 500; i++)
+    {
+        const std::string context = (i % 3 == 0) ? "first" : "second";
+        aggregator->Write2d(context, i * 0.125, i % 7);
+        expected << context << ' ' << i * 0.125 << ' ' << i % 7 << '\n';
+    }
+
+    aggregator->Dispose();
+    aggregator->Write1d("late", 42);
+    expected << "late 42\n";
+
+    const std::string fileName =
+        outputFileName + ".txt" + AsyncFileAggregator::GetCompressedFileExtension();
+    const std::string data = ApplicationStatsTestReadFile(fileName);
+
+    if (AsyncFileAggregator::IsCompressionSupported())
+    {
+        NS_TEST_ASSERT_MSG_LT(data.size(),
+                              expected.str().size(),
+                              "The output file " << fileName << " is not compressed");
+    }
+
+    NS_TEST_ASSERT_MSG_EQ(ApplicationStatsTestDecompress(data),
+                          expected.str(),
+                          "Unexpected decompressed content of " << fileName);
+
+    aggregator = nullptr;
+    Simulator::Destroy();
+
+} // end of `void DoRun ()`
+
+/**
+ * @ingroup applicationstats
+ * @brief Verifies that ApplicationStatsDelayHelper in averaging mode outputs
+ *        the distribution of the mean delay of each receiver.
+ *
+ * The first receiver gets delays of 100 to 400 ms and the second receiver
+ * gets 600 and 700 ms, so the histogram must hold exactly two samples, in the
+ * bins of 250 and 650 ms. The third receiver gets nothing and must not
+ * contribute to the histogram.
+ */
+class AveragedDelayTestCase : public TestCase
+{
+  public:
+    /// Construct a new test case.
+    AveragedDelayTestCase();
+
+  private:
+    virtual void DoRun();
+
+}; // end of `class AveragedDelayTestCase`
+
+AveragedDelayTestCase::AveragedDelayTestCase()
+    : TestCase("averaged delay distribution of each receiver")
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+AveragedDelayTestCase::DoRun()
+{
+    NS_LOG_FUNCTION(this << GetName());
+
+    const std::string outputFileName = CreateTempDirFilename("averaged-delay");
+
+    std::map<std::string, ApplicationContainer> receiverInfo;
+    std::vector<Ptr<ApplicationStatsTestApplication>> receivers;
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        receivers.push_back(CreateObject<ApplicationStatsTestApplication>());
+        std::ostringstream oss;
+        oss << "receiver-" << i;
+        receiverInfo[oss.str()] = ApplicationContainer(receivers.back());
+    }
+
+    Ptr<ApplicationStatsDelayHelper> stat = CreateObject<ApplicationStatsDelayHelper>();
+    stat->SetName("averaged-delay");
+    stat->SetTraceSourceName("RxDelay");
+    stat->SetIdentifierType(ApplicationStatsHelper::IDENTIFIER_RECEIVER);
+    stat->SetOutputType(ApplicationStatsHelper::OUTPUT_HISTOGRAM_FILE);
+    stat->SetAveragingMode(true);
+    stat->SetAsyncFileOutput(true);
+    stat->SetReceiverInformation(receiverInfo);
+    stat->Install();
+    NS_TEST_ASSERT_MSG_NE(stat->GetAggregator(), nullptr, "Missing aggregator");
+    stat->GetAggregator()->SetAttribute("OutputFileName", StringValue(outputFileName));
+
+    const Address from = InetSocketAddress(Ipv4Address("10.1.1.1"), 80);
+    receivers[0]->FireRxDelay(MilliSeconds(100), from);
+    receivers[0]->FireRxDelay(MilliSeconds(200), from);
+    receivers[0]->FireRxDelay(MilliSeconds(300), from);
+    receivers[0]->FireRxDelay(MilliSeconds(400), from);
+    receivers[1]->FireRxDelay(MilliSeconds(600), from);
+    receivers[1]->FireRxDelay(MilliSeconds(700), from);
+
+    // The means reach the collector at Simulator::Destroy, and the histogram
+    // reaches the file when the collector and the aggregator are disposed.
+    Simulator::Destroy();
+    stat = nullptr;
+
+    const std::vector<std::vector<double>> lines =
+        ApplicationStatsTestReadDataLines(outputFileName + ".txt");
+    NS_TEST_ASSERT_MSG_GT(lines.size(), 0, "Missing histogram in " << outputFileName);
+
+    double total = 0.0;
+    for (std::vector<std::vector<double>>::const_iterator it = lines.begin(); it != lines.end();
+         ++it)
+    {
+        NS_TEST_ASSERT_MSG_EQ(it->size(), 2, "Unexpected number of columns");
+
+        if ((*it)[1] > 0.0)
+        {
+            const bool isFirstMean = std::abs((*it)[0] - 0.25) <= 0.05;
+            const bool isSecondMean = std::abs((*it)[0] - 0.65) <= 0.05;
+            NS_TEST_ASSERT_MSG_EQ((isFirstMean || isSecondMean),
+                                  true,
+                                  "Unexpected histogram bin " << (*it)[0]);
+            total += (*it)[1];
+        }
+    }
+
+    NS_TEST_ASSERT_MSG_EQ_TOL(total, 2.0, 1e-9, "Histogram must hold one mean per receiver");
+
+} // end of `void DoRun ()`
+
+/**
+ * @ingroup applicationstats
+ * @brief Verifies the scatter output of ApplicationStatsPltHelper per sender
+ *        and ApplicationStatsRttHelper per receiver.
+ *
+ * Two senders and a receiver are given IPv4 addresses. The receiver fires
+ * page load times tagged with either a bare IPv4 address or a socket address
+ * of a sender, as well as one from an unknown address, which must be
+ * discarded. It also fires round trip times, which must reach only the RTT
+ * helper.
+ */
+class PltRttTestCase : public TestCase
+{
+  public:
+    /// Construct a new test case.
+    PltRttTestCase();
+
+  private:
+    virtual void DoRun();
+
+}; // end of `class PltRttTestCase`
+
+PltRttTestCase::PltRttTestCase()
+    : TestCase("page load time per sender and round trip time per receiver")
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+PltRttTestCase::DoRun()
+{
+    NS_LOG_FUNCTION(this << GetName());
+
+    const std::string pltFileName = CreateTempDirFilename("plt");
+    const std::string rttFileName = CreateTempDirFilename("rtt");
+
+    NodeContainer nodes;
+    nodes.Create(3);
+    InternetStackHelper internet;
+    internet.Install(nodes);
+
+    Ptr<SimpleChannel> channel = CreateObject<SimpleChannel>();
+    NetDeviceContainer devices;
+    std::vector<Ptr<ApplicationStatsTestApplication>> apps;
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice>();
+        nodes.Get(i)->AddDevice(device);
+        device->SetChannel(channel);
+        devices.Add(device);
+
+        apps.push_back(CreateObject<ApplicationStatsTestApplication>());
+        nodes.Get(i)->AddApplication(apps.back());
+    }
+
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = ipv4.Assign(devices);
+
+    std::map<std::string, ApplicationContainer> senderInfo;
+    senderInfo["sender-0"] = ApplicationContainer(apps[0]);
+    senderInfo["sender-1"] = ApplicationContainer(apps[1]);
+    std::map<std::string, ApplicationContainer> receiverInfo;
+    receiverInfo["receiver"] = ApplicationContainer(apps[2]);
+
+    Ptr<ApplicationStatsPltHelper> pltStat = CreateObject<ApplicationStatsPltHelper>();
+    pltStat->SetName("plt");
+    pltStat->SetTraceSourceName("RxPlt");
+    pltStat->SetIdentifierType(ApplicationStatsHelper::IDENTIFIER_SENDER);
+    pltStat->SetOutputType(ApplicationStatsHelper::OUTPUT_SCATTER_FILE);
+    pltStat->SetAsyncFileOutput(true);
+    pltStat->SetSenderInformation(senderInfo);
+    pltStat->SetReceiverInformation(receiverInfo);
+    pltStat->Install();
+    pltStat->GetAggregator()->SetAttribute("OutputFileName", StringValue(pltFileName));
+
+    Ptr<ApplicationStatsRttHelper> rttStat = CreateObject<ApplicationStatsRttHelper>();
+    rttStat->SetName("rtt");
+    rttStat->SetTraceSourceName("RxRtt");
+    rttStat->SetIdentifierType(ApplicationStatsHelper::IDENTIFIER_RECEIVER);
+    rttStat->SetOutputType(ApplicationStatsHelper::OUTPUT_SCATTER_FILE);
+    rttStat->SetAsyncFileOutput(true);
+    rttStat->SetSenderInformation(senderInfo);
+    rttStat->SetReceiverInformation(receiverInfo);
+    rttStat->Install();
+    rttStat->GetAggregator()->SetAttribute("OutputFileName", StringValue(rttFileName));
+
+    const Ipv4Address sender0 = interfaces.GetAddress(0);
+    const Ipv4Address sender1 = interfaces.GetAddress(1);
+    Ptr<ApplicationStatsTestApplication> receiver = apps[2];
+    Simulator::Schedule(Seconds(1),
+                        &ApplicationStatsTestApplication::FireRxPlt,
+                        receiver,
+                        MilliSeconds(500),
+                        Address(sender0));
+    Simulator::Schedule(Seconds(1.5),
+                        &ApplicationStatsTestApplication::FireRxRtt,
+                        receiver,
+                        MilliSeconds(100),
+                        Address(InetSocketAddress(sender0, 80)));
+    Simulator::Schedule(Seconds(2),
+                        &ApplicationStatsTestApplication::FireRxPlt,
+                        receiver,
+                        Seconds(2),
+                        Address(InetSocketAddress(sender1, 80)));
+    Simulator::Schedule(Seconds(2.5),
+                        &ApplicationStatsTestApplication::FireRxRtt,
+                        receiver,
+                        MilliSeconds(200),
+                        Address(InetSocketAddress(sender1, 80)));
+    Simulator::Schedule(Seconds(3),
+                        &ApplicationStatsTestApplication::FireRxPlt,
+                        receiver,
+                        MilliSeconds(1250),
+                        Address(sender0));
+    Simulator::Schedule(Seconds(4),
+                        &ApplicationStatsTestApplication::FireRxPlt,
+                        receiver,
+                        Seconds(9),
+                        Address(Ipv4Address("10.9.9.9")));
+
+    Simulator::Run();
+    Simulator::Destroy();
+    pltStat = nullptr;
+    rttStat = nullptr;
+
+    NS_TEST_ASSERT_MSG_EQ(ApplicationStatsTestReadFile(pltFileName + "-sender-0.txt"),
+                          "% time_sec plt_sec\n1 0.5\n3 1.25\n",
+                          "Unexpected page load times of the first sender");
+    NS_TEST_ASSERT_MSG_EQ(ApplicationStatsTestReadFile(pltFileName + "-sender-1.txt"),
+                          "% time_sec plt_sec\n2 2\n",
+                          "Unexpected page load times of the second sender");
+    NS_TEST_ASSERT_MSG_EQ(ApplicationStatsTestReadFile(rttFileName + "-receiver.txt"),
+                          "% time_sec rtt_sec\n1.5 0.1\n2.5 0.2\n",
+                          "Unexpected round trip times of the receiver");
+
+} // end of `void DoRun ()`
+
+/**
+ * @ingroup applicationstats
+ * @brief Verifies that ApplicationThroughputCollector produces the same
+ *        output as the chain of UnitConversionCollector and ScalarCollector
+ *        or IntervalRateCollector which it replaces.
+ *
+ * The same byte schedule is passed to both, and the output of both is
+ * compared with each other and with the throughput computed by hand. The
+ * final output is produced at 3.5 seconds, before Simulator::Destroy, by
+ * flushing the fused collector and disposing the old chain.
+ */
+class ThroughputCollectorTestCase : public TestCase
+{
+  public:
+    /**
+     * @brief Construct a new test case.
+     * @param name the test case name, which will be printed on the report
+     * @param outputType the output type of the fused collector
+     */
+    ThroughputCollectorTestCase(std::string name,
+                                ApplicationThroughputCollector::OutputType_t outputType);
+
+  private:
+    virtual void DoRun();
+
+    /**
+     * @brief Pass received bytes to both the fused collector and the old chain.
+     * @param bytes number of received bytes.
+     */
+    void ReceiveBytes(uint32_t bytes);
+
+    /**
+     * @brief Record an average throughput output.
+     * @param context `old` or the identifier name of the fused collector.
+     * @param throughput the throughput, in kbps.
+     */
+    void RecordAverage(std::string context, double throughput);
+
+    /**
+     * @brief Record an interval throughput output.
+     * @param context `old` or the identifier name of the fused collector.
+     * @param time the end of the interval, in seconds.
+     * @param throughput the throughput within the interval, in kbps.
+     */
+    void RecordInterval(std::string context, double time, double throughput);
+
+    ApplicationThroughputCollector::OutputType_t m_outputType;
+    Ptr<ApplicationThroughputCollector> m_fusedCollector;
+    Ptr<UnitConversionCollector> m_conversionCollector;
+    std::map<std::string, std::vector<double>> m_averages;
+    std::map<std::string, std::vector<std::pair<double, double>>> m_intervals;
+
+}; // end of `class ThroughputCollectorTestCase`
+
+ThroughputCollectorTestCase::ThroughputCollectorTestCase(
+    std::string name,
+    ApplicationThroughputCollector::OutputType_t outputType)
+    : TestCase(name),
+      m_outputType(outputType)
+{
+    NS_LOG_FUNCTION(this << name << outputType);
+}
+
+void
+ThroughputCollectorTestCase::DoRun()
+{
+    NS_LOG_FUNCTION(this << GetName());
+
+    // The fused collector, with a single identifier named `new`.
+    m_fusedCollector = CreateObject<ApplicationThroughputCollector>();
+    m_fusedCollector->SetOutputType(m_outputType);
+    m_fusedCollector->SetIdentifierNames(std::vector<std::string>(1, "new"));
+    m_fusedCollector->TraceConnectWithoutContext(
+        "Output",
+        MakeCallback(&ThroughputCollectorTestCase::RecordAverage, this));
+    m_fusedCollector->TraceConnectWithoutContext(
+        "OutputWithTime",
+        MakeCallback(&ThroughputCollectorTestCase::RecordInterval, this));
+    m_fusedCollector->Start();
+
+    // The old chain, configured as ApplicationStatsThroughputHelper used to.
+    Ptr<DataCollectionObject> terminalCollector;
+    if (m_outputType == ApplicationThroughputCollector::OUTPUT_TYPE_AVERAGE_PER_SECOND)
+    {
+        Ptr<ScalarCollector> c = CreateObject<ScalarCollector>();
+        c->SetAttribute("InputDataType", EnumValue(ScalarCollector::INPUT_DATA_TYPE_DOUBLE));
+        c->SetAttribute("OutputType", EnumValue(ScalarCollector::OUTPUT_TYPE_AVERAGE_PER_SECOND));
+        c->TraceConnect("Output",
+                        "old",
+                        MakeCallback(&ThroughputCollectorTestCase::RecordAverage, this));
+        terminalCollector = c;
+        m_conversionCollector = CreateObject<UnitConversionCollector>();
+        m_conversionCollector->TraceConnectWithoutContext(
+            "Output",
+            MakeCallback(&ScalarCollector::TraceSinkDouble, c));
+    }
+    else
+    {
+        Ptr<IntervalRateCollector> c = CreateObject<IntervalRateCollector>();
+        c->SetAttribute("InputDataType",
+                        EnumValue(IntervalRateCollector::INPUT_DATA_TYPE_DOUBLE));
+        c->TraceConnect("OutputWithTime",
+                        "old",
+                        MakeCallback(&ThroughputCollectorTestCase::RecordInterval, this));
+        terminalCollector = c;
+        m_conversionCollector = CreateObject<UnitConversionCollector>();
+        m_conversionCollector->TraceConnectWithoutContext(
+            "Output",
+            MakeCallback(&IntervalRateCollector::TraceSinkDouble, c));
+    }
+    m_conversionCollector->SetAttribute("ConversionType",
+                                        EnumValue(UnitConversionCollector::FROM_BYTES_TO_KBIT));
+
+    // 1500 bytes in the first second, 3000 in the second, and 1500 in the third.
+    const double times[5] = {0.1, 0.5, 1.2, 2.7, 2.9};
+    const uint32_t bytes[5] = {1000, 500, 3000, 250, 1250};
+    for (uint32_t i = 0; i < 5; i++)
+    {
+        Simulator::Schedule(Seconds(times[i]),
+                            &ThroughputCollectorTestCase::ReceiveBytes,
+                            this,
+                            bytes[i]);
+    }
+
+    const Time stopTime = Seconds(3.5);
+    Simulator::Schedule(stopTime, &ApplicationThroughputCollector::Flush, m_fusedCollector);
+    Simulator::Schedule(stopTime, &Object::Dispose, terminalCollector);
+    Simulator::Stop(stopTime);
+    Simulator::Run();
+    Simulator::Destroy();
+
+    if (m_outputType == ApplicationThroughputCollector::OUTPUT_TYPE_AVERAGE_PER_SECOND)
+    {
+        NS_TEST_ASSERT_MSG_EQ(m_averages["new"].size(), 1, "Expected one fused output");
+        NS_TEST_ASSERT_MSG_EQ(m_averages["old"].size(), 1, "Expected one old chain output");
+        NS_TEST_ASSERT_MSG_EQ_TOL(m_averages["new"][0],
+                                  48.0 / 3.5,
+                                  1e-9,
+                                  "Unexpected fused average throughput");
+        NS_TEST_ASSERT_MSG_EQ_TOL(m_averages["new"][0],
+                                  m_averages["old"][0],
+                                  1e-9,
+                                  "The fused collector differs from the old chain");
+    }
+    else
+    {
+        const double expected[3] = {12.0, 24.0, 12.0};
+        NS_TEST_ASSERT_MSG_EQ(m_intervals["new"].size(), 3, "Expected three fused intervals");
+        NS_TEST_ASSERT_MSG_EQ(m_intervals["old"].size(),
+                              3,
+                              "Expected three old chain intervals");
+
+        for (uint32_t i = 0; i < 3; i++)
+        {
+            NS_TEST_ASSERT_MSG_EQ_TOL(m_intervals["new"][i].first,
+                                      i + 1.0,
+                                      1e-9,
+                                      "Unexpected end of fused interval #" << i);
+            NS_TEST_ASSERT_MSG_EQ_TOL(m_intervals["new"][i].second,
+                                      expected[i],
+                                      1e-9,
+                                      "Unexpected fused throughput in interval #" << i);
+            NS_TEST_ASSERT_MSG_EQ_TOL(m_intervals["new"][i].first,
+                                      m_intervals["old"][i].first,
+                                      1e-9,
+                                      "The end of interval #" << i << " differs");
+            NS_TEST_ASSERT_MSG_EQ_TOL(m_intervals["new"][i].second,
+                                      m_intervals["old"][i].second,
+                                      1e-9,
+                                      "The throughput in interval #" << i << " differs");
+        }
+    }
+
+    m_fusedCollector = nullptr;
+    m_conversionCollector = nullptr;
+
+} // end of `void DoRun ()`
+
+void
+ThroughputCollectorTestCase::ReceiveBytes(uint32_t bytes)
+{
+    NS_LOG_FUNCTION(this << bytes);
+    m_fusedCollector->AddBytes(0, bytes);
+    m_conversionCollector->TraceSinkUinteger32(0, bytes);
+}
+
+void
+ThroughputCollectorTestCase::RecordAverage(std::string context, double throughput)
+{
+    NS_LOG_FUNCTION(this << context << throughput);
+    m_averages[context].push_back(throughput);
+}
+
+void
+ThroughputCollectorTestCase::RecordInterval(std::string context, double time, double throughput)
+{
+    NS_LOG_FUNCTION(this << context << time << throughput);
+    m_intervals[context].push_back(std::make_pair(time, throughput));
+}
+
+/**
+ * @ingroup applicationstats
+ * @brief Verifies that AdmissionRampController spreads the start times of the
+ *        clients, and that an ApplicationStatsHelper given its warm-up time
+ *        postpones the installation until then.
+ *
+ * Four clients are admitted from 0.5 seconds on, at 4 clients per second,
+ * with a settle time of 0.75 seconds, so the warm-up is complete at 2
+ * seconds. A delay sample fired before that moment must not reach the
+ * output, while the installation is reported as pending and the settings of
+ * the helper are locked.
+ */
+class WarmUpTestCase : public TestCase
+{
+  public:
+    /// Construct a new test case.
+    WarmUpTestCase();
+
+  private:
+    virtual void DoRun();
+    virtual void DoTeardown();
+
+    /// Verify the helper during the warm-up period.
+    void CheckBeforeWarmUp();
+
+    /// Verify the helper after the warm-up period, and redirect its output.
+    void CheckAfterWarmUp();
+
+    /// Connected with the `WarmUpComplete` trace source of the controller.
+    void WarmUpCompleteCallback();
+
+    Ptr<ApplicationStatsDelayHelper> m_stat;
+    std::string m_outputFileName;
+    /// Times when the `WarmUpComplete` trace source has fired.
+    std::vector<Time> m_warmUpCompleteTimes;
+
+}; // end of `class WarmUpTestCase`
+
+WarmUpTestCase::WarmUpTestCase()
+    : TestCase("admission ramp and postponed statistics installation")
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+WarmUpTestCase::DoRun()
+{
+    NS_LOG_FUNCTION(this << GetName());
+
+    m_outputFileName = CreateTempDirFilename("warm-up");
+
+    ApplicationContainer clients;
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        clients.Add(CreateObject<ApplicationStatsTestApplication>());
+    }
+
+    Ptr<AdmissionRampController> ramp = CreateObject<AdmissionRampController>();
+    ramp->SetAttribute("StartTime", TimeValue(MilliSeconds(500)));
+    ramp->SetAttribute("AdmissionRate", DoubleValue(4.0));
+    ramp->SetAttribute("SettleTime", TimeValue(MilliSeconds(750)));
+    ramp->TraceConnectWithoutContext("WarmUpComplete",
+                                     MakeCallback(&WarmUpTestCase::WarmUpCompleteCallback, this));
+    ramp->Admit(clients);
+
+    NS_TEST_ASSERT_MSG_EQ(ramp->GetNAdmitted(), 4, "Unexpected number of admitted clients");
+    NS_TEST_ASSERT_MSG_EQ(ramp->GetWarmUpTime(), Seconds(2), "Unexpected warm-up time");
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        TimeValue startTime;
+        clients.Get(i)->GetAttribute("StartTime", startTime);
+        NS_TEST_ASSERT_MSG_EQ(startTime.Get(),
+                              MilliSeconds(500 + 250 * i),
+                              "Unexpected start time of client " << i);
+        NS_TEST_ASSERT_MSG_EQ(ramp->GetAdmissionTime(i),
+                              startTime.Get(),
+                              "Start time of client " << i << " differs from its admission time");
+    }
+
+    Ptr<ApplicationStatsTestApplication> receiver =
+        CreateObject<ApplicationStatsTestApplication>();
+    std::map<std::string, ApplicationContainer> receiverInfo;
+    receiverInfo["receiver"] = ApplicationContainer(receiver);
+
+    m_stat = CreateObject<ApplicationStatsDelayHelper>();
+    m_stat->SetName("warm-up");
+    m_stat->SetTraceSourceName("RxDelay");
+    m_stat->SetIdentifierType(ApplicationStatsHelper::IDENTIFIER_RECEIVER);
+    m_stat->SetOutputType(ApplicationStatsHelper::OUTPUT_SCATTER_FILE);
+    m_stat->SetAsyncFileOutput(true);
+    m_stat->SetWarmUpTime(ramp->GetWarmUpTime());
+    m_stat->SetReceiverInformation(receiverInfo);
+    m_stat->Install();
+
+    const Address from = InetSocketAddress(Ipv4Address("10.1.1.1"), 80);
+    Simulator::Schedule(MilliSeconds(1500),
+                        &ApplicationStatsTestApplication::FireRxDelay,
+                        receiver,
+                        MilliSeconds(100),
+                        from);
+    Simulator::Schedule(MilliSeconds(1900), &WarmUpTestCase::CheckBeforeWarmUp, this);
+    Simulator::Schedule(MilliSeconds(2100), &WarmUpTestCase::CheckAfterWarmUp, this);
+    Simulator::Schedule(MilliSeconds(2500),
+                        &ApplicationStatsTestApplication::FireRxDelay,
+                        receiver,
+                        MilliSeconds(200),
+                        from);
+    Simulator::Schedule(MilliSeconds(3000),
+                        &ApplicationStatsTestApplication::FireRxDelay,
+                        receiver,
+                        MilliSeconds(300),
+                        from);
+
+    Simulator::Run();
+    Simulator::Destroy();
+    m_stat = nullptr;
+
+    NS_TEST_ASSERT_MSG_EQ(m_warmUpCompleteTimes.size(), 1, "WarmUpComplete must fire once");
+    NS_TEST_ASSERT_MSG_EQ(m_warmUpCompleteTimes.front(),
+                          Seconds(2),
+                          "WarmUpComplete must fire at the warm-up time");
+    NS_TEST_ASSERT_MSG_EQ(ApplicationStatsTestReadFile(m_outputFileName + "-receiver.txt"),
+                          "% time_sec delay_sec\n2.5 0.2\n3 0.3\n",
+                          "Only the samples after the warm-up time are expected");
+
+} // end of `void DoRun ()`
+
+void
+WarmUpTestCase::DoTeardown()
+{
+    NS_LOG_FUNCTION(this);
+    m_stat = nullptr;
+}
+
+void
+WarmUpTestCase::CheckBeforeWarmUp()
+{
+    NS_LOG_FUNCTION(this);
+    NS_TEST_EXPECT_MSG_EQ(m_stat->IsInstallPending(), true, "Installation must be pending");
+    NS_TEST_EXPECT_MSG_EQ(m_stat->IsInstalled(), false, "Installed before the warm-up time");
+    NS_TEST_EXPECT_MSG_EQ(m_stat->GetAggregator(), nullptr, "Aggregator before the warm-up time");
+
+    // The pending installation locks the settings.
+    m_stat->SetOutputType(ApplicationStatsHelper::OUTPUT_HISTOGRAM_FILE);
+    NS_TEST_EXPECT_MSG_EQ(m_stat->GetOutputType(),
+                          ApplicationStatsHelper::OUTPUT_SCATTER_FILE,
+                          "Output type modified while the installation is pending");
+}
+
+void
+WarmUpTestCase::CheckAfterWarmUp()
+{
+    NS_LOG_FUNCTION(this);
+    NS_TEST_EXPECT_MSG_EQ(m_stat->IsInstallPending(), false, "Installation still pending");
+    NS_TEST_EXPECT_MSG_EQ(m_stat->IsInstalled(), true, "Not installed after the warm-up time");
+    NS_TEST_ASSERT_MSG_NE(m_stat->GetAggregator(), nullptr, "Missing aggregator");
+    m_stat->GetAggregator()->SetAttribute("OutputFileName", StringValue(m_outputFileName));
+}
+
+void
+WarmUpTestCase::WarmUpCompleteCallback()
+{
+    NS_LOG_FUNCTION(this);
+    m_warmUpCompleteTimes.push_back(Simulator::Now());
+}
+
+/**
+ * @ingroup applicationstats
+ * @brief Verifies that ApplicationStatsThroughputHelper with a sampling ratio
+ *        of 4 estimates the global throughput of an unsampled helper.
+ *
+ * In each of several replications, a receiver gets 10 packets from each of
+ * 64 flows. In `PACKETS` mode, the estimate of every run must be off by less
+ * than 4 packets. In `FLOWS` mode, the estimate of a single run may be far
+ * off, but it must vary across runs, as the selection is salted with the run
+ * number, and its mean over the runs must be close to the actual throughput.
+ */
+class SampledThroughputTestCase : public TestCase
+{
+  public:
+    /// Construct a new test case.
+    SampledThroughputTestCase();
+
+  private:
+    virtual void DoRun();
+
+    /**
+     * @brief Create and install a throughput helper with `GLOBAL` identifier.
+     * @param name the name of the helper.
+     * @param samplingRatio the value of the `SamplingRatio` attribute.
+     * @param samplingMode the value of the `SamplingMode` attribute.
+     * @param receiverInfo the receiver applications to listen to.
+     * @param outputFileName the name of the output file, without extension.
+     * @return the installed helper.
+     */
+    static Ptr<ApplicationStatsThroughputHelper> InstallHelper(
+        const std::string& name,
+        uint32_t samplingRatio,
+        ApplicationStatsHelper::SamplingMode_t samplingMode,
+        const std::map<std::string, ApplicationContainer>& receiverInfo,
+        const std::string& outputFileName);
+
+}; // end of `class SampledThroughputTestCase`
+
+SampledThroughputTestCase::SampledThroughputTestCase()
+    : TestCase("sampled throughput over replications")
+{
+    NS_LOG_FUNCTION(this);
+}
+
+Ptr<ApplicationStatsThroughputHelper> // static
+SampledThroughputTestCase::InstallHelper(
+    const std::string& name,
+    uint32_t samplingRatio,
+    ApplicationStatsHelper::SamplingMode_t samplingMode,
+    const std::map<std::string, ApplicationContainer>& receiverInfo,
+    const std::string& outputFileName)
+{
+    Ptr<ApplicationStatsThroughputHelper> stat = CreateObject<ApplicationStatsThroughputHelper>();
+    stat->SetName(name);
+    stat->SetSamplingRatio(samplingRatio);
+    stat->SetSamplingMode(samplingMode);
+    stat->SetTraceSourceName("Rx");
+    stat->SetIdentifierType(ApplicationStatsHelper::IDENTIFIER_GLOBAL);
+    stat->SetOutputType(ApplicationStatsHelper::OUTPUT_SCALAR_FILE);
+    stat->SetAsyncFileOutput(true);
+    stat->SetReceiverInformation(receiverInfo);
+    stat->Install();
+    stat->GetAggregator()->SetAttribute("OutputFileName", StringValue(outputFileName));
+    return stat;
+}
+
+void
+SampledThroughputTestCase::DoRun()
+{
+    NS_LOG_FUNCTION(this << GetName());
+
+    const uint32_t nRuns = 16;
+    const uint32_t nFlows = 64;
+    const uint32_t nPackets = 10;
+    const uint32_t packetSize = 100;
+    const uint32_t samplingRatio = 4;
+    const uint64_t originalRun = RngSeedManager::GetRun();
+
+    std::vector<double> actual;
+    std::vector<double> packetsEstimates;
+    std::vector<double> flowsEstimates;
+
+    for (uint32_t r = 1; r <= nRuns; r++)
+    {
+        RngSeedManager::SetRun(r);
+
+        Ptr<ApplicationStatsTestApplication> receiver =
+            CreateObject<ApplicationStatsTestApplication>();
+        std::map<std::string, ApplicationContainer> receiverInfo;
+        receiverInfo["receiver"] = ApplicationContainer(receiver);
+
+        std::ostringstream oss;
+        oss << "sampled-throughput-" << r;
+        const std::string actualFileName = CreateTempDirFilename(oss.str() + "-actual");
+        const std::string packetsFileName = CreateTempDirFilename(oss.str() + "-packets");
+        const std::string flowsFileName = CreateTempDirFilename(oss.str() + "-flows");
+
+        Ptr<ApplicationStatsThroughputHelper> actualStat =
+            InstallHelper("actual",
+                          1,
+                          ApplicationStatsHelper::SAMPLING_PACKETS,
+                          receiverInfo,
+                          actualFileName);
+        Ptr<ApplicationStatsThroughputHelper> packetsStat =
+            InstallHelper("packets",
+                          samplingRatio,
+                          ApplicationStatsHelper::SAMPLING_PACKETS,
+                          receiverInfo,
+                          packetsFileName);
+        Ptr<ApplicationStatsThroughputHelper> flowsStat =
+            InstallHelper("flows",
+                          samplingRatio,
+                          ApplicationStatsHelper::SAMPLING_FLOWS,
+                          receiverInfo,
+                          flowsFileName);
+
+        // Interleave the flows, so the packet counter cycles through them.
+        for (uint32_t j = 0; j < nPackets; j++)
+        {
+            for (uint32_t i = 0; i < nFlows; i++)
+            {
+                Simulator::Schedule(MilliSeconds(1 + 50 * j + i),
+                                    &ApplicationStatsTestApplication::FireRx,
+                                    receiver,
+                                    packetSize,
+                                    InetSocketAddress(Ipv4Address("10.1.1.1"), 1000 + i));
+            }
+        }
+
+        // The averages reach the aggregators at Simulator::Destroy.
+        Simulator::Stop(Seconds(1));
+        Simulator::Run();
+        Simulator::Destroy();
+        actualStat = nullptr;
+        packetsStat = nullptr;
+        flowsStat = nullptr;
+
+        actual.push_back(ApplicationStatsTestReadScalar(actualFileName + ".txt"));
+        packetsEstimates.push_back(ApplicationStatsTestReadScalar(packetsFileName + ".txt"));
+        flowsEstimates.push_back(ApplicationStatsTestReadScalar(flowsFileName + ".txt"));
+    }
+
+    RngSeedManager::SetRun(originalRun);
+
+    // Throughput in kbps of all packets, and of the packets of a single flow.
+    const double expected = nFlows * nPackets * packetSize * 0.008;
+    const double perFlow = nPackets * packetSize * 0.008;
+    double flowsSum = 0.0;
+    double flowsMin = flowsEstimates.front();
+    double flowsMax = flowsEstimates.front();
+
+    for (uint32_t r = 0; r < nRuns; r++)
+    {
+        NS_TEST_ASSERT_MSG_EQ_TOL(actual[r], expected, 1e-6, "Unexpected actual throughput");
+        NS_TEST_ASSERT_MSG_EQ_TOL(packetsEstimates[r],
+                                  actual[r],
+                                  samplingRatio * packetSize * 0.008,
+                                  "Packet sampling in run " << r + 1
+                                                            << " is off by 4 packets or more");
+        flowsSum += flowsEstimates[r];
+        flowsMin = std::min(flowsMin, flowsEstimates[r]);
+        flowsMax = std::max(flowsMax, flowsEstimates[r]);
+    }
+
+    NS_TEST_ASSERT_MSG_GT(flowsMax - flowsMin,
+                          perFlow,
+                          "Flow sampling does not vary across runs");
+    NS_TEST_ASSERT_MSG_EQ_TOL(flowsSum / nRuns,
+                              expected,
+                              0.2 * expected,
+                              "Mean of flow sampling over the runs is far from the actual value");
+
+} // end of `void DoRun ()`
+
+/**
+ * @brief Test suite `application-stats`, verifying the application
+ *        statistics helpers and their collectors and aggregators.
+ */
+class ApplicationStatsTestSuite : public TestSuite
+{
+  public:
+    ApplicationStatsTestSuite();
+};
+
+ApplicationStatsTestSuite::ApplicationStatsTestSuite()
+    : TestSuite("application-stats", Type::UNIT)
+{
+    AddTestCase(new AsyncFileAggregatorDisposeTestCase("file aggregator disposal, asynchronous",
+                                                       true),
+                TestCase::Duration::QUICK);
+    AddTestCase(new AsyncFileAggregatorDisposeTestCase("file aggregator disposal, synchronous",
+                                                       false),
+                TestCase::Duration::QUICK);
+    AddTestCase(new AsyncFileAggregatorCompressionTestCase("compressed output, small blocks", 64),
+                TestCase::Duration::QUICK);
+    AddTestCase(new AsyncFileAggregatorCompressionTestCase("compressed output, single block",
+                                                           1048576),
+                TestCase::Duration::QUICK);
+    AddTestCase(new AveragedDelayTestCase(), TestCase::Duration::QUICK);
+    AddTestCase(new PltRttTestCase(), TestCase::Duration::QUICK);
+    AddTestCase(new ThroughputCollectorTestCase(
+                    "fused throughput collector, average",
+                    ApplicationThroughputCollector::OUTPUT_TYPE_AVERAGE_PER_SECOND),
+                TestCase::Duration::QUICK);
+    AddTestCase(new ThroughputCollectorTestCase(
+                    "fused throughput collector, interval",
+                    ApplicationThroughputCollector::OUTPUT_TYPE_INTERVAL_RATE),
+                TestCase::Duration::QUICK);
+    AddTestCase(new WarmUpTestCase(), TestCase::Duration::QUICK);
+    AddTestCase(new SampledThroughputTestCase(), TestCase::Duration::QUICK);
+
+} // end of `ApplicationStatsTestSuite ()`
+
+static ApplicationStatsTestSuite g_applicationStatsTestSuiteInstance;
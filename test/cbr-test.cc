@@ -18,8 +18,12 @@
  * Author: Sami Rantanen <sami.rantanen@magister.fi>
  */
 
+#include "ns3/boolean.h"
 #include "ns3/cbr-application.h"
+#include "ns3/cbr-device-injector.h"
+#include "ns3/cbr-fluid-source.h"
 #include "ns3/cbr-helper.h"
+#include "ns3/double.h"
 #include "ns3/inet-socket-address.h"
 #include "ns3/internet-stack-helper.h"
 #include "ns3/ipv4-address-helper.h"
@@ -31,6 +35,13 @@
 #include "ns3/simulator.h"
 #include "ns3/string.h"
 #include "ns3/test.h"
+#include "ns3/traffic-time-tag.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <vector>
+
+NS_LOG_COMPONENT_DEFINE("CbrTest");
 
 using namespace ns3;
 
@@ -112,6 +123,289 @@ CbrTestCase1::DoRun(void)
     NS_TEST_ASSERT_MSG_EQ(sink->GetTotalRx(), sender->GetSent(), "Packets were lost !");
 }
 
+/**
+ * @ingroup traffic
+ * @brief Verifies that the packets injected by CbrDeviceInjector are received
+ *        by a PacketSink as ordinary UDP packets.
+ *
+ * The injector sends 300-byte packets every 100 ms over a SimpleChannel,
+ * either through the traffic control layer of the node or directly to the
+ * device. The sink must receive every injected byte from the IPv4 address of
+ * the sending device, and every packet must carry a TrafficTimeTag.
+ */
+class CbrDeviceInjectorTestCase : public TestCase
+{
+  public:
+    /**
+     * @brief Construct a new test case.
+     * @param name the test case name, which will be printed on the report
+     * @param isTrafficControlEnabled the `UseTrafficControl` attribute
+     */
+    CbrDeviceInjectorTestCase(std::string name, bool isTrafficControlEnabled);
+
+  private:
+    virtual void DoRun();
+
+    // CALLBACK FUNCTIONS
+    void TxCallback(Ptr<const Packet> packet);
+    void RxCallback(Ptr<const Packet> packet, const Address& from);
+
+    bool m_isTrafficControlEnabled;
+    /// Number of packets injected.
+    uint32_t m_numOfTx;
+    /// Number of injected packets with a time tag.
+    uint32_t m_numOfTimeTags;
+    /// Source address of each received packet.
+    std::vector<Ipv4Address> m_rxSources;
+
+}; // end of `class CbrDeviceInjectorTestCase`
+
+CbrDeviceInjectorTestCase::CbrDeviceInjectorTestCase(std::string name,
+                                                     bool isTrafficControlEnabled)
+    : TestCase(name),
+      m_isTrafficControlEnabled(isTrafficControlEnabled),
+      m_numOfTx(0),
+      m_numOfTimeTags(0)
+{
+    NS_LOG_FUNCTION(this << name << isTrafficControlEnabled);
+}
+
+void
+CbrDeviceInjectorTestCase::DoRun()
+{
+    NS_LOG_FUNCTION(this << GetName());
+
+    NodeContainer nodes;
+    nodes.Create(2);
+
+    InternetStackHelper internet;
+    internet.Install(nodes);
+
+    Ptr<SimpleNetDevice> txDev = CreateObject<SimpleNetDevice>();
+    Ptr<SimpleNetDevice> rxDev = CreateObject<SimpleNetDevice>();
+    nodes.Get(0)->AddDevice(txDev);
+    nodes.Get(1)->AddDevice(rxDev);
+    Ptr<SimpleChannel> channel = CreateObject<SimpleChannel>();
+    txDev->SetChannel(channel);
+    rxDev->SetChannel(channel);
+    NetDeviceContainer devices;
+    devices.Add(txDev);
+    devices.Add(rxDev);
+
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = ipv4.Assign(devices);
+
+    const uint16_t port = 4000;
+    PacketSinkHelper sinkHelper("ns3::UdpSocketFactory",
+                                InetSocketAddress(Ipv4Address::GetAny(), port));
+    ApplicationContainer sinkApps = sinkHelper.Install(nodes.Get(1));
+    Ptr<PacketSink> sink = DynamicCast<PacketSink>(sinkApps.Get(0));
+    sink->TraceConnectWithoutContext("Rx",
+                                     MakeCallback(&CbrDeviceInjectorTestCase::RxCallback, this));
+
+    // Stopped between two packets, so that exactly 4 packets are sent.
+    const uint32_t packetSize = 300;
+    Ptr<CbrDeviceInjector> injector = CreateObject<CbrDeviceInjector>();
+    injector->SetAttribute("Remote",
+                           AddressValue(InetSocketAddress(interfaces.GetAddress(1), port)));
+    injector->SetAttribute("PacketSize", UintegerValue(packetSize));
+    injector->SetAttribute("Interval", TimeValue(MilliSeconds(100)));
+    injector->SetAttribute("UseTrafficControl", BooleanValue(m_isTrafficControlEnabled));
+    injector->SetAttribute("EnableStatisticsTags", BooleanValue(true));
+    injector->SetStartTime(Seconds(1));
+    injector->SetStopTime(MilliSeconds(1450));
+    injector->TraceConnectWithoutContext(
+        "Tx",
+        MakeCallback(&CbrDeviceInjectorTestCase::TxCallback, this));
+    nodes.Get(0)->AddApplication(injector);
+
+    Simulator::Stop(Seconds(2));
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(injector->GetDevice(), txDev, "Unexpected default device");
+    NS_TEST_ASSERT_MSG_EQ(m_numOfTx, 4, "Unexpected number of injected packets");
+    NS_TEST_ASSERT_MSG_EQ(m_numOfTimeTags, m_numOfTx, "Some packets have no time tag");
+    NS_TEST_ASSERT_MSG_EQ(injector->GetSent(), 4 * packetSize, "Unexpected number of sent bytes");
+    NS_TEST_ASSERT_MSG_EQ(sink->GetTotalRx(), injector->GetSent(), "Packets were lost");
+    NS_TEST_ASSERT_MSG_EQ(m_rxSources.size(), m_numOfTx, "Unexpected number of received packets");
+    for (uint32_t i = 0; i < m_rxSources.size(); i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(m_rxSources[i],
+                              interfaces.GetAddress(0),
+                              "Packet " << i << " has an unexpected source address");
+    }
+
+    Simulator::Destroy();
+
+} // end of `void DoRun ()`
+
+void
+CbrDeviceInjectorTestCase::TxCallback(Ptr<const Packet> packet)
+{
+    NS_LOG_FUNCTION(this << packet << packet->GetSize());
+    m_numOfTx++;
+
+    TrafficTimeTag timeTag;
+    if (packet->PeekPacketTag(timeTag))
+    {
+        m_numOfTimeTags++;
+    }
+}
+
+void
+CbrDeviceInjectorTestCase::RxCallback(Ptr<const Packet> packet, const Address& from)
+{
+    NS_LOG_FUNCTION(this << packet << packet->GetSize() << from);
+    m_rxSources.push_back(InetSocketAddress::ConvertFrom(from).GetIpv4());
+}
+
+/**
+ * @ingroup traffic
+ * @brief Verifies the rate of CbrFluidSource and that it carries the bytes
+ *        which do not make a whole byte over to the next update.
+ *
+ * Three flows of 100-byte packets every 70 ms make 300 / 0.07 bytes per
+ * second, i.e., 42.857... bytes per 10-ms update, injected in aggregate
+ * packets of at most 20 bytes of payload. After every update, the number of
+ * bytes sent must be the number generated so far, rounded down, and the sink
+ * must receive all of them.
+ */
+class CbrFluidSourceTestCase : public TestCase
+{
+  public:
+    /**
+     * @brief Construct a new test case.
+     * @param name the test case name, which will be printed on the report
+     */
+    CbrFluidSourceTestCase(std::string name);
+
+  private:
+    virtual void DoRun();
+
+    /**
+     * @brief Record the number of bytes sent so far by the source.
+     * @param source the fluid source.
+     */
+    void SampleSent(Ptr<CbrFluidSource> source);
+
+    // CALLBACK FUNCTIONS
+    void TxCallback(Ptr<const Packet> packet);
+
+    /// Number of bytes sent by the source after each update.
+    std::vector<uint64_t> m_sent;
+    /// Size of the largest packet injected, including its headers.
+    uint32_t m_maxTxSize;
+
+}; // end of `class CbrFluidSourceTestCase`
+
+CbrFluidSourceTestCase::CbrFluidSourceTestCase(std::string name)
+    : TestCase(name),
+      m_maxTxSize(0)
+{
+    NS_LOG_FUNCTION(this << name);
+}
+
+void
+CbrFluidSourceTestCase::DoRun()
+{
+    NS_LOG_FUNCTION(this << GetName());
+
+    NodeContainer nodes;
+    nodes.Create(2);
+
+    InternetStackHelper internet;
+    internet.Install(nodes);
+
+    Ptr<SimpleNetDevice> txDev = CreateObject<SimpleNetDevice>();
+    Ptr<SimpleNetDevice> rxDev = CreateObject<SimpleNetDevice>();
+    nodes.Get(0)->AddDevice(txDev);
+    nodes.Get(1)->AddDevice(rxDev);
+    Ptr<SimpleChannel> channel = CreateObject<SimpleChannel>();
+    txDev->SetChannel(channel);
+    rxDev->SetChannel(channel);
+    NetDeviceContainer devices;
+    devices.Add(txDev);
+    devices.Add(rxDev);
+
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = ipv4.Assign(devices);
+
+    const uint16_t port = 4000;
+    PacketSinkHelper sinkHelper("ns3::UdpSocketFactory",
+                                InetSocketAddress(Ipv4Address::GetAny(), port));
+    ApplicationContainer sinkApps = sinkHelper.Install(nodes.Get(1));
+
+    const Time startTime = Seconds(1);
+    const Time updatePeriod = MilliSeconds(10);
+    const uint32_t numOfUpdates = 50;
+    const uint32_t maxAggregateSize = 20;
+    Ptr<CbrFluidSource> source = CreateObject<CbrFluidSource>();
+    source->SetAttribute("Remote", AddressValue(InetSocketAddress(interfaces.GetAddress(1), port)));
+    source->SetAttribute("NumOfFlows", UintegerValue(3));
+    source->SetAttribute("PacketSize", UintegerValue(100));
+    source->SetAttribute("Interval", TimeValue(MilliSeconds(70)));
+    source->SetAttribute("UpdatePeriod", TimeValue(updatePeriod));
+    source->SetAttribute("MaxAggregateSize", UintegerValue(maxAggregateSize));
+    source->SetAttribute("UseTrafficControl", BooleanValue(false));
+    source->SetStartTime(startTime);
+    source->SetStopTime(startTime + updatePeriod * numOfUpdates + MicroSeconds(500));
+    source->TraceConnectWithoutContext("Tx",
+                                       MakeCallback(&CbrFluidSourceTestCase::TxCallback, this));
+    nodes.Get(0)->AddApplication(source);
+
+    // Sample shortly after every update.
+    for (uint32_t k = 1; k <= numOfUpdates; k++)
+    {
+        Simulator::Schedule(startTime + updatePeriod * k + MicroSeconds(1),
+                            &CbrFluidSourceTestCase::SampleSent,
+                            this,
+                            source);
+    }
+
+    Simulator::Stop(Seconds(2));
+    Simulator::Run();
+
+    const double rate = 300.0 / 0.07; // bytes per second
+    NS_TEST_ASSERT_MSG_EQ_TOL(source->GetRate(), rate, 1e-9, "Unexpected rate");
+    NS_TEST_ASSERT_MSG_EQ(m_sent.size(), numOfUpdates, "Unexpected number of samples");
+
+    for (uint32_t k = 1; k <= numOfUpdates; k++)
+    {
+        // The generated bytes, with a margin for the rounding of the backlog.
+        const double generated = rate * updatePeriod.GetSeconds() * k;
+        NS_TEST_ASSERT_MSG_LT_OR_EQ(static_cast<double>(m_sent[k - 1]),
+                                    generated + 1e-6,
+                                    "More bytes than generated are sent after update " << k);
+        NS_TEST_ASSERT_MSG_GT(static_cast<double>(m_sent[k - 1]),
+                              generated - 1.0,
+                              "A whole byte is held back after update " << k);
+    }
+
+    // Without traffic control, the injected packets include the IPv4 header.
+    NS_TEST_ASSERT_MSG_EQ(m_maxTxSize, maxAggregateSize + 28, "Unexpected aggregate size");
+    Ptr<PacketSink> sink = DynamicCast<PacketSink>(sinkApps.Get(0));
+    NS_TEST_ASSERT_MSG_EQ(sink->GetTotalRx(), source->GetSent(), "Packets were lost");
+
+    Simulator::Destroy();
+
+} // end of `void DoRun ()`
+
+void
+CbrFluidSourceTestCase::SampleSent(Ptr<CbrFluidSource> source)
+{
+    NS_LOG_FUNCTION(this << source->GetSent());
+    m_sent.push_back(source->GetSent());
+}
+
+void
+CbrFluidSourceTestCase::TxCallback(Ptr<const Packet> packet)
+{
+    NS_LOG_FUNCTION(this << packet << packet->GetSize());
+    m_maxTxSize = std::max(m_maxTxSize, packet->GetSize());
+}
+
 // The CbrTestSuite class names the TestSuite as cbr-test, identifies what type of TestSuite
 // (Type::UNIT), and enables the TestCases to be run CbrTestCase1.
 //
@@ -125,6 +419,12 @@ CbrTestSuite::CbrTestSuite()
     : TestSuite("cbr-test", Type::UNIT)
 {
     AddTestCase(new CbrTestCase1, TestCase::Duration::QUICK);
+    AddTestCase(new CbrDeviceInjectorTestCase("device injector, traffic control", true),
+                TestCase::Duration::QUICK);
+    AddTestCase(new CbrDeviceInjectorTestCase("device injector, device", false),
+                TestCase::Duration::QUICK);
+    AddTestCase(new CbrFluidSourceTestCase("fluid source, rate and backlog"),
+                TestCase::Duration::QUICK);
 }
 
 // Allocate an instance of this TestSuite
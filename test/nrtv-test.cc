@@ -28,20 +28,33 @@
  */
 
 #include "ns3/application.h"
+#include "ns3/boolean.h"
 #include "ns3/config.h"
 #include "ns3/data-rate.h"
+#include "ns3/double.h"
+#include "ns3/enum.h"
+#include "ns3/inet-socket-address.h"
 #include "ns3/integer.h"
 #include "ns3/internet-stack-helper.h"
 #include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-global-routing-helper.h"
 #include "ns3/ipv4-interface-container.h"
 #include "ns3/log.h"
 #include "ns3/net-device-container.h"
 #include "ns3/node-container.h"
+#include "ns3/nrtv-catalog.h"
 #include "ns3/nrtv-header.h"
 #include "ns3/nrtv-helper.h"
+#include "ns3/nrtv-tcp-client.h"
+#include "ns3/nrtv-tcp-server.h"
+#include "ns3/nrtv-udp-server.h"
+#include "ns3/nrtv-variables.h"
+#include "ns3/nrtv-video-worker.h"
 #include "ns3/nstime.h"
 #include "ns3/point-to-point-helper.h"
+#include "ns3/pointer.h"
 #include "ns3/simulator.h"
+#include "ns3/socket.h"
 #include "ns3/string.h"
 #include "ns3/tcp-socket-factory.h"
 #include "ns3/test.h"
@@ -49,8 +62,14 @@
 #include "ns3/udp-socket-factory.h"
 #include "ns3/uinteger.h"
 
+#include <algorithm>
 #include <list>
+#include <map>
+#include <set>
 #include <sstream>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 NS_LOG_COMPONENT_DEFINE("NrtvTest");
 
@@ -77,12 +96,14 @@ class NrtvClientRxBufferTestCase : public TestCase
      * @param channelDelay fixed transmission delay to be set on the
      *                     point-to-point channel
      * @param duration length of simulation
+     * @param isCompactHeader whether the server sends compact NRTV headers
      */
     NrtvClientRxBufferTestCase(std::string name,
                                uint32_t rngRun,
                                TypeId protocolTypeId,
                                Time channelDelay,
-                               Time duration);
+                               Time duration,
+                               bool isCompactHeader = false);
 
   private:
     virtual void DoRun();
@@ -99,6 +120,7 @@ class NrtvClientRxBufferTestCase : public TestCase
     TypeId m_protocolTypeId;
     Time m_channelDelay;
     Time m_duration;
+    bool m_isCompactHeader;
 
 }; // end of `class NrtvClientRxBufferTestCase`
 
@@ -106,12 +128,14 @@ NrtvClientRxBufferTestCase::NrtvClientRxBufferTestCase(std::string name,
                                                        uint32_t rngRun,
                                                        TypeId protocolTypeId,
                                                        Time channelDelay,
-                                                       Time duration)
+                                                       Time duration,
+                                                       bool isCompactHeader)
     : TestCase(name),
       m_rngRun(rngRun),
       m_protocolTypeId(protocolTypeId),
       m_channelDelay(channelDelay),
-      m_duration(duration)
+      m_duration(duration),
+      m_isCompactHeader(isCompactHeader)
 {
     NS_LOG_FUNCTION(this << name << rngRun);
 }
@@ -123,6 +147,7 @@ NrtvClientRxBufferTestCase::DoRun()
 
     Config::SetGlobal("RngRun", UintegerValue(m_rngRun));
     Config::SetDefault("ns3::TcpL4Protocol::SocketType", StringValue("ns3::TcpNewReno"));
+    Config::SetDefault("ns3::NrtvVideoWorker::CompactHeader", BooleanValue(m_isCompactHeader));
 
     NodeContainer nodes;
     nodes.Create(2);
@@ -166,6 +191,7 @@ NrtvClientRxBufferTestCase::DoRun()
 
     // return default values to their default
     Config::SetGlobal("RngRun", UintegerValue(1));
+    Config::SetDefault("ns3::NrtvVideoWorker::CompactHeader", BooleanValue(false));
 
 } // end of `void DoRun ()`
 
@@ -247,6 +273,1310 @@ NrtvClientRxBufferTestCase::RxSliceCallback(std::string context, Ptr<const Packe
     m_packetsInTransit.pop_front();
 }
 
+/**
+ * @ingroup applications
+ * @brief Verifies the send queue of NRTV video worker under each overflow
+ *        policy.
+ *
+ * Runs a single NrtvVideoWorker over a point-to-point link which is much
+ * slower than the video, so that the send queue keeps overflowing. The test
+ * case verifies that:
+ * - every encoded slice is either handed to the socket or reported by the
+ *   `Drop` trace source, exactly once and in the order of encoding;
+ * - `DROP_FRAME` never sends a slice of a frame after it has started to
+ *   discard the frame, and `BLOCK_ENCODER` never discards a slice;
+ * - every frame of a completed video is either encoded or reported by the
+ *   `SkippedFrame` trace source, which `BLOCK_ENCODER` fires for the frames
+ *   elapsing while the encoder is paused;
+ * - the video completed callback is invoked once, after the last slice has
+ *   been handed to the socket;
+ * - if the worker is stopped in the middle of the video, the slices left in
+ *   the queue are reported by the `Drop` trace source.
+ */
+class NrtvVideoWorkerQueueTestCase : public TestCase
+{
+  public:
+    /**
+     * @brief Construct a new test case.
+     * @param name the test case name, which will be printed on the report
+     * @param overflowPolicy the `QueueOverflowPolicy` attribute of the worker
+     * @param stopTime time to stop the worker in the middle of the video, or
+     *                 zero to let the video complete
+     */
+    NrtvVideoWorkerQueueTestCase(std::string name,
+                                 NrtvVideoWorker::QueueOverflowPolicy_t overflowPolicy,
+                                 Time stopTime);
+
+  private:
+    virtual void DoRun();
+    virtual void DoTeardown();
+
+    // CALLBACK FUNCTIONS
+    void NewConnectionCallback(Ptr<Socket> socket, const Address& address);
+    void ReceivedDataCallback(Ptr<Socket> socket);
+    void TxCallback(Ptr<Socket> socket, Ptr<const Packet> packet);
+    void DropCallback(Ptr<const Packet> packet);
+    void SkippedFrameCallback(uint32_t frameNumber);
+    void VideoCompletedCallback(Ptr<Socket> socket);
+    void StopWorker();
+
+    /**
+     * @brief Record the fate of a slice.
+     * @param packet the slice, including its NrtvHeader
+     * @return the frame number of the slice
+     */
+    uint32_t RecordSlice(Ptr<const Packet> packet);
+
+    NrtvVideoWorker::QueueOverflowPolicy_t m_overflowPolicy;
+    Time m_stopTime;
+    Ptr<NrtvVideoWorker> m_worker;
+    /// Slice numbers handed to the socket or dropped, for each frame number.
+    std::map<uint32_t, std::set<uint16_t>> m_slices;
+    /// Frames which have had at least one slice dropped.
+    std::set<uint32_t> m_droppedFrames;
+    /// Frames reported by the `SkippedFrame` trace source.
+    std::set<uint32_t> m_skippedFrames;
+    /// Frame and slice number of the last slice handed to the socket.
+    std::pair<uint32_t, uint16_t> m_lastTxSlice;
+    uint32_t m_numOfTx;
+    uint32_t m_numOfDrops;
+    uint32_t m_numOfDropsAtStop;
+    uint32_t m_numOfCompleted;
+
+}; // end of `class NrtvVideoWorkerQueueTestCase`
+
+NrtvVideoWorkerQueueTestCase::NrtvVideoWorkerQueueTestCase(
+    std::string name,
+    NrtvVideoWorker::QueueOverflowPolicy_t overflowPolicy,
+    Time stopTime)
+    : TestCase(name),
+      m_overflowPolicy(overflowPolicy),
+      m_stopTime(stopTime),
+      m_lastTxSlice(0, 0),
+      m_numOfTx(0),
+      m_numOfDrops(0),
+      m_numOfDropsAtStop(0),
+      m_numOfCompleted(0)
+{
+    NS_LOG_FUNCTION(this << name << overflowPolicy << stopTime.GetSeconds());
+}
+
+void
+NrtvVideoWorkerQueueTestCase::DoRun()
+{
+    NS_LOG_FUNCTION(this << GetName());
+
+    Config::SetDefault("ns3::TcpL4Protocol::SocketType", StringValue("ns3::TcpNewReno"));
+    Config::SetDefault("ns3::TcpSocket::SndBufSize", UintegerValue(2000));
+    // Videos of 2 to 4 seconds.
+    Config::SetDefault("ns3::NrtvVariables::NumOfFramesMean", UintegerValue(30));
+    Config::SetDefault("ns3::NrtvVariables::NumOfFramesStdDev", UintegerValue(5));
+    Config::SetDefault("ns3::NrtvVariables::NumOfFramesMin", UintegerValue(20));
+    Config::SetDefault("ns3::NrtvVariables::NumOfFramesMax", UintegerValue(40));
+    Config::SetDefault("ns3::NrtvVideoWorker::MaxQueueSize", UintegerValue(4));
+    Config::SetDefault("ns3::NrtvVideoWorker::QueueOverflowPolicy", EnumValue(m_overflowPolicy));
+
+    NodeContainer nodes;
+    nodes.Create(2);
+
+    // Roughly a third of the average bit rate of the video.
+    PointToPointHelper pointToPoint;
+    pointToPoint.SetDeviceAttribute("DataRate", DataRateValue(DataRate("32kbps")));
+    pointToPoint.SetChannelAttribute("Delay", TimeValue(MilliSeconds(10)));
+
+    NetDeviceContainer devices;
+    devices = pointToPoint.Install(nodes);
+
+    InternetStackHelper stack;
+    stack.Install(nodes);
+
+    Ipv4AddressHelper address;
+    address.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = address.Assign(devices);
+
+    Ptr<Socket> listener = Socket::CreateSocket(nodes.Get(0), TcpSocketFactory::GetTypeId());
+    listener->Bind(InetSocketAddress(Ipv4Address::GetAny(), 1935));
+    listener->Listen();
+    listener->SetAcceptCallback(
+        MakeNullCallback<bool, Ptr<Socket>, const Address&>(),
+        MakeCallback(&NrtvVideoWorkerQueueTestCase::NewConnectionCallback, this));
+
+    Ptr<Socket> client = Socket::CreateSocket(nodes.Get(1), TcpSocketFactory::GetTypeId());
+    client->Bind();
+    client->Connect(InetSocketAddress(interfaces.GetAddress(0), 1935));
+    client->SetRecvCallback(
+        MakeCallback(&NrtvVideoWorkerQueueTestCase::ReceivedDataCallback, this));
+
+    if (!m_stopTime.IsZero())
+    {
+        Simulator::Schedule(m_stopTime, &NrtvVideoWorkerQueueTestCase::StopWorker, this);
+    }
+
+    Simulator::Stop(Seconds(60));
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ((m_worker != nullptr), true, "No connection has been accepted");
+    NS_TEST_ASSERT_MSG_GT(m_numOfTx, 0, "No slice has been sent");
+    NS_TEST_ASSERT_MSG_EQ(m_numOfCompleted, 1, "Video completed callback is not invoked once");
+
+    for (std::map<uint32_t, std::set<uint16_t>>::const_iterator it = m_slices.begin();
+         it != m_slices.end();
+         ++it)
+    {
+        // Slices are numbered from 1 within each frame, so none is unaccounted for.
+        NS_TEST_ASSERT_MSG_EQ(*it->second.rbegin(),
+                              it->second.size(),
+                              "Some slices of frame " << it->first << " are missing");
+    }
+
+    if (m_stopTime.IsZero())
+    {
+        // Every frame up to the last one seen is either encoded or skipped.
+        uint32_t lastFrame = m_slices.empty() ? 0 : m_slices.rbegin()->first;
+        if (!m_skippedFrames.empty())
+        {
+            lastFrame = std::max(lastFrame, *m_skippedFrames.rbegin());
+        }
+        for (uint32_t frameNumber = 1; frameNumber <= lastFrame; frameNumber++)
+        {
+            NS_TEST_ASSERT_MSG_EQ(m_slices.count(frameNumber) + m_skippedFrames.count(frameNumber),
+                                  1,
+                                  "Frame " << frameNumber << " is neither encoded nor skipped");
+        }
+    }
+
+    if (m_overflowPolicy == NrtvVideoWorker::BLOCK_ENCODER && m_stopTime.IsZero())
+    {
+        NS_TEST_ASSERT_MSG_EQ(m_numOfDrops, 0, "The encoder should have been blocked instead");
+        NS_TEST_ASSERT_MSG_GT(m_skippedFrames.size(),
+                              0,
+                              "The encoder has never been blocked for a whole frame");
+    }
+    else
+    {
+        NS_TEST_ASSERT_MSG_GT(m_numOfDrops, 0, "The queue has never overflowed");
+    }
+
+    if (!m_stopTime.IsZero())
+    {
+        NS_TEST_ASSERT_MSG_GT(m_numOfDropsAtStop,
+                              0,
+                              "Queued slices have been discarded without the Drop trace");
+    }
+
+    m_worker->Dispose();
+    Simulator::Destroy();
+
+    // return default values to their default
+    Config::SetDefault("ns3::TcpSocket::SndBufSize", UintegerValue(131072));
+    Config::SetDefault("ns3::NrtvVariables::NumOfFramesMean", UintegerValue(3000));
+    Config::SetDefault("ns3::NrtvVariables::NumOfFramesStdDev", UintegerValue(2400));
+    Config::SetDefault("ns3::NrtvVariables::NumOfFramesMin", UintegerValue(200));
+    Config::SetDefault("ns3::NrtvVariables::NumOfFramesMax", UintegerValue(36000));
+    Config::SetDefault("ns3::NrtvVideoWorker::MaxQueueSize", UintegerValue(64));
+    Config::SetDefault("ns3::NrtvVideoWorker::QueueOverflowPolicy",
+                       EnumValue(NrtvVideoWorker::DROP_OLDEST));
+
+} // end of `void DoRun ()`
+
+void
+NrtvVideoWorkerQueueTestCase::DoTeardown()
+{
+    NS_LOG_FUNCTION(this << GetName());
+    m_worker = nullptr;
+}
+
+void
+NrtvVideoWorkerQueueTestCase::NewConnectionCallback(Ptr<Socket> socket, const Address& address)
+{
+    NS_LOG_FUNCTION(this << socket << address);
+    NS_ASSERT_MSG(m_worker == nullptr, "Only one connection is expected");
+    m_worker = CreateObject<NrtvVideoWorker>(socket);
+    m_worker->SetTxCallback(MakeCallback(&NrtvVideoWorkerQueueTestCase::TxCallback, this));
+    m_worker->SetVideoCompletedCallback(
+        MakeCallback(&NrtvVideoWorkerQueueTestCase::VideoCompletedCallback, this));
+    m_worker->TraceConnectWithoutContext(
+        "Drop",
+        MakeCallback(&NrtvVideoWorkerQueueTestCase::DropCallback, this));
+    m_worker->TraceConnectWithoutContext(
+        "SkippedFrame",
+        MakeCallback(&NrtvVideoWorkerQueueTestCase::SkippedFrameCallback, this));
+    m_worker->ChangeState(NrtvVideoWorker::READY);
+}
+
+void
+NrtvVideoWorkerQueueTestCase::ReceivedDataCallback(Ptr<Socket> socket)
+{
+    NS_LOG_FUNCTION(this << socket);
+    Ptr<Packet> packet;
+    while ((packet = socket->Recv()) && packet->GetSize() > 0)
+    {
+        NS_LOG_LOGIC(this << " received " << packet->GetSize() << " bytes");
+    }
+}
+
+uint32_t
+NrtvVideoWorkerQueueTestCase::RecordSlice(Ptr<const Packet> packet)
+{
+    Ptr<Packet> copy = packet->Copy();
+    NrtvHeader nrtvHeader;
+    copy->RemoveHeader(nrtvHeader);
+    const uint32_t frameNumber = nrtvHeader.GetFrameNumber();
+    const uint16_t sliceNumber = nrtvHeader.GetSliceNumber();
+    NS_LOG_FUNCTION(this << frameNumber << sliceNumber);
+
+    const bool isNew = m_slices[frameNumber].insert(sliceNumber).second;
+    NS_TEST_EXPECT_MSG_EQ(isNew,
+                          true,
+                          "Slice " << sliceNumber << " of frame " << frameNumber
+                                   << " is sent or dropped twice");
+    return frameNumber;
+}
+
+void
+NrtvVideoWorkerQueueTestCase::TxCallback(Ptr<Socket> socket, Ptr<const Packet> packet)
+{
+    NS_LOG_FUNCTION(this << socket << packet);
+    NS_TEST_EXPECT_MSG_EQ(m_numOfCompleted, 0, "A slice is sent after the video has completed");
+
+    Ptr<Packet> copy = packet->Copy();
+    NrtvHeader nrtvHeader;
+    copy->RemoveHeader(nrtvHeader);
+    const std::pair<uint32_t, uint16_t> slice(nrtvHeader.GetFrameNumber(),
+                                              nrtvHeader.GetSliceNumber());
+    NS_TEST_EXPECT_MSG_EQ((m_lastTxSlice < slice),
+                          true,
+                          "Slice " << slice.second << " of frame " << slice.first
+                                   << " is sent out of order");
+    m_lastTxSlice = slice;
+
+    const uint32_t frameNumber = RecordSlice(packet);
+    if (m_overflowPolicy == NrtvVideoWorker::DROP_FRAME)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_droppedFrames.count(frameNumber),
+                              0u,
+                              "Frame " << frameNumber << " is sent after being discarded");
+    }
+    m_numOfTx++;
+}
+
+void
+NrtvVideoWorkerQueueTestCase::DropCallback(Ptr<const Packet> packet)
+{
+    NS_LOG_FUNCTION(this << packet);
+    NS_TEST_EXPECT_MSG_EQ(m_numOfCompleted, 0, "A slice is dropped after the video has completed");
+    m_droppedFrames.insert(RecordSlice(packet));
+    m_numOfDrops++;
+
+    if (!m_stopTime.IsZero() && Simulator::Now() == m_stopTime)
+    {
+        m_numOfDropsAtStop++;
+    }
+}
+
+void
+NrtvVideoWorkerQueueTestCase::SkippedFrameCallback(uint32_t frameNumber)
+{
+    NS_LOG_FUNCTION(this << frameNumber);
+    NS_TEST_EXPECT_MSG_EQ(m_numOfCompleted, 0, "A frame is skipped after the video has completed");
+    const bool isNew = m_skippedFrames.insert(frameNumber).second;
+    NS_TEST_EXPECT_MSG_EQ(isNew, true, "Frame " << frameNumber << " is skipped twice");
+}
+
+void
+NrtvVideoWorkerQueueTestCase::VideoCompletedCallback(Ptr<Socket> socket)
+{
+    NS_LOG_FUNCTION(this << socket);
+    m_numOfCompleted++;
+}
+
+void
+NrtvVideoWorkerQueueTestCase::StopWorker()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(m_worker != nullptr);
+    m_worker->ChangeState(NrtvVideoWorker::NOT_READY);
+}
+
+/**
+ * @ingroup applications
+ * @brief Verifies that the `StateTransitionEnum` trace sources of the NRTV
+ *        TCP client and server report the same transitions as their string
+ *        based `StateTransition` trace sources.
+ *
+ * Runs an NRTV client and server over TCP for a few seconds. The test case
+ * verifies that both trace sources fire equally often, that the state names
+ * obtained by GetStateString() from the enum values are the names given by
+ * `StateTransition`, that each transition starts from the state which the
+ * previous one has ended in, and that the last transition ends in the
+ * current state of the application.
+ */
+class NrtvStateTransitionTestCase : public TestCase
+{
+  public:
+    /**
+     * @brief Construct a new test case.
+     * @param name the test case name, which will be printed on the report
+     */
+    NrtvStateTransitionTestCase(std::string name);
+
+  private:
+    /// A state transition, as a pair of old and new state names.
+    typedef std::pair<std::string, std::string> Transition_t;
+
+    virtual void DoRun();
+
+    /**
+     * @brief Verify two records of the same transitions.
+     * @param strings the transitions reported by `StateTransition`
+     * @param enums the transitions reported by `StateTransitionEnum`
+     * @param currentState name of the current state of the application
+     * @param role `client` or `server`, for the messages
+     */
+    void VerifyTransitions(const std::vector<Transition_t>& strings,
+                           const std::vector<Transition_t>& enums,
+                           const std::string& currentState,
+                           const std::string& role);
+
+    // CALLBACK FUNCTIONS
+    void ClientStringCallback(std::string oldState, std::string newState);
+    void ClientEnumCallback(NrtvTcpClient::State_t oldState, NrtvTcpClient::State_t newState);
+    void ServerStringCallback(std::string oldState, std::string newState);
+    void ServerEnumCallback(NrtvTcpServer::State_t oldState, NrtvTcpServer::State_t newState);
+
+    std::vector<Transition_t> m_clientStrings;
+    std::vector<Transition_t> m_clientEnums;
+    std::vector<Transition_t> m_serverStrings;
+    std::vector<Transition_t> m_serverEnums;
+
+}; // end of `class NrtvStateTransitionTestCase`
+
+NrtvStateTransitionTestCase::NrtvStateTransitionTestCase(std::string name)
+    : TestCase(name)
+{
+    NS_LOG_FUNCTION(this << name);
+}
+
+void
+NrtvStateTransitionTestCase::DoRun()
+{
+    NS_LOG_FUNCTION(this << GetName());
+
+    Config::SetDefault("ns3::TcpL4Protocol::SocketType", StringValue("ns3::TcpNewReno"));
+
+    NodeContainer nodes;
+    nodes.Create(2);
+
+    PointToPointHelper pointToPoint;
+    pointToPoint.SetDeviceAttribute("DataRate", DataRateValue(DataRate("5Mbps")));
+    pointToPoint.SetChannelAttribute("Delay", TimeValue(MilliSeconds(10)));
+
+    NetDeviceContainer devices;
+    devices = pointToPoint.Install(nodes);
+
+    InternetStackHelper stack;
+    stack.Install(nodes);
+
+    Ipv4AddressHelper address;
+    address.SetBase("10.1.1.0", "255.255.255.0");
+    address.Assign(devices);
+
+    NrtvHelper helper(TcpSocketFactory::GetTypeId());
+    helper.InstallUsingIpv4(nodes.Get(0), nodes.Get(1));
+    Ptr<NrtvTcpServer> server = DynamicCast<NrtvTcpServer>(helper.GetServer().Get(0));
+    Ptr<NrtvTcpClient> client = DynamicCast<NrtvTcpClient>(helper.GetClients().Get(0));
+    NS_TEST_ASSERT_MSG_NE(server, nullptr, "Expected an NRTV TCP server");
+    NS_TEST_ASSERT_MSG_NE(client, nullptr, "Expected an NRTV TCP client");
+    server->SetStartTime(MilliSeconds(1));
+    client->SetStartTime(MilliSeconds(2));
+
+    client->TraceConnectWithoutContext(
+        "StateTransition",
+        MakeCallback(&NrtvStateTransitionTestCase::ClientStringCallback, this));
+    client->TraceConnectWithoutContext(
+        "StateTransitionEnum",
+        MakeCallback(&NrtvStateTransitionTestCase::ClientEnumCallback, this));
+    server->TraceConnectWithoutContext(
+        "StateTransition",
+        MakeCallback(&NrtvStateTransitionTestCase::ServerStringCallback, this));
+    server->TraceConnectWithoutContext(
+        "StateTransitionEnum",
+        MakeCallback(&NrtvStateTransitionTestCase::ServerEnumCallback, this));
+
+    Simulator::Stop(Seconds(5));
+    Simulator::Run();
+
+    VerifyTransitions(m_clientStrings, m_clientEnums, client->GetStateString(), "client");
+    VerifyTransitions(m_serverStrings, m_serverEnums, server->GetStateString(), "server");
+
+    Simulator::Destroy();
+
+} // end of `void DoRun ()`
+
+void
+NrtvStateTransitionTestCase::VerifyTransitions(const std::vector<Transition_t>& strings,
+                                               const std::vector<Transition_t>& enums,
+                                               const std::string& currentState,
+                                               const std::string& role)
+{
+    NS_LOG_FUNCTION(this << role << strings.size() << enums.size());
+
+    NS_TEST_ASSERT_MSG_GT(strings.size(), 0, "The " << role << " has never changed state");
+    NS_TEST_ASSERT_MSG_EQ(enums.size(),
+                          strings.size(),
+                          "Both trace sources of the " << role << " must fire equally often");
+
+    for (uint32_t i = 0; i < strings.size(); i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(enums[i].first,
+                              strings[i].first,
+                              "Unexpected old state of " << role << " transition #" << i);
+        NS_TEST_ASSERT_MSG_EQ(enums[i].second,
+                              strings[i].second,
+                              "Unexpected new state of " << role << " transition #" << i);
+
+        if (i > 0)
+        {
+            NS_TEST_ASSERT_MSG_EQ(enums[i].first,
+                                  enums[i - 1].second,
+                                  "The " << role << " transition #" << i
+                                         << " does not start where the previous one ended");
+        }
+    }
+
+    NS_TEST_ASSERT_MSG_EQ(enums.back().second,
+                          currentState,
+                          "The last " << role << " transition does not end in the current state");
+}
+
+void
+NrtvStateTransitionTestCase::ClientStringCallback(std::string oldState, std::string newState)
+{
+    NS_LOG_FUNCTION(this << oldState << newState);
+    m_clientStrings.push_back(Transition_t(oldState, newState));
+}
+
+void
+NrtvStateTransitionTestCase::ClientEnumCallback(NrtvTcpClient::State_t oldState,
+                                                NrtvTcpClient::State_t newState)
+{
+    NS_LOG_FUNCTION(this << oldState << newState);
+    m_clientEnums.push_back(Transition_t(NrtvTcpClient::GetStateString(oldState),
+                                         NrtvTcpClient::GetStateString(newState)));
+}
+
+void
+NrtvStateTransitionTestCase::ServerStringCallback(std::string oldState, std::string newState)
+{
+    NS_LOG_FUNCTION(this << oldState << newState);
+    m_serverStrings.push_back(Transition_t(oldState, newState));
+}
+
+void
+NrtvStateTransitionTestCase::ServerEnumCallback(NrtvTcpServer::State_t oldState,
+                                                NrtvTcpServer::State_t newState)
+{
+    NS_LOG_FUNCTION(this << oldState << newState);
+    m_serverEnums.push_back(Transition_t(NrtvTcpServer::GetStateString(oldState),
+                                         NrtvTcpServer::GetStateString(newState)));
+}
+
+/**
+ * @ingroup applications
+ * @brief Verifies the `KeepAlive` attribute of NRTV TCP client.
+ *
+ * Runs an NRTV TCP client with keep-alive enabled against an NRTV TCP server
+ * long enough for two short videos. The test case verifies that both videos
+ * are completed over a single connection, i.e., the client enters the
+ * `CONNECTING` state once and goes from `RECEIVING` to `IDLE` once for each
+ * video.
+ */
+class NrtvKeepAliveTestCase : public TestCase
+{
+  public:
+    /**
+     * @brief Construct a new test case.
+     * @param name the test case name, which will be printed on the report
+     */
+    NrtvKeepAliveTestCase(std::string name);
+
+  private:
+    virtual void DoRun();
+
+    // CALLBACK FUNCTIONS
+    void StateTransitionCallback(NrtvTcpClient::State_t oldState, NrtvTcpClient::State_t newState);
+
+    /// Number of times the client has started to open a connection.
+    uint32_t m_numOfConnections;
+    /// Number of videos received by the client in full.
+    uint32_t m_numOfCompletedVideos;
+
+}; // end of `class NrtvKeepAliveTestCase`
+
+NrtvKeepAliveTestCase::NrtvKeepAliveTestCase(std::string name)
+    : TestCase(name),
+      m_numOfConnections(0),
+      m_numOfCompletedVideos(0)
+{
+    NS_LOG_FUNCTION(this << name);
+}
+
+void
+NrtvKeepAliveTestCase::DoRun()
+{
+    NS_LOG_FUNCTION(this << GetName());
+
+    Config::SetDefault("ns3::TcpL4Protocol::SocketType", StringValue("ns3::TcpNewReno"));
+    // Videos of exactly 2 seconds, with short pauses in between.
+    Config::SetDefault("ns3::NrtvVariables::NumOfFramesMean", UintegerValue(20));
+    Config::SetDefault("ns3::NrtvVariables::NumOfFramesStdDev", UintegerValue(1));
+    Config::SetDefault("ns3::NrtvVariables::NumOfFramesMin", UintegerValue(20));
+    Config::SetDefault("ns3::NrtvVariables::NumOfFramesMax", UintegerValue(20));
+    Config::SetDefault("ns3::NrtvVariables::IdleTimeMean", TimeValue(MilliSeconds(500)));
+
+    NodeContainer nodes;
+    nodes.Create(2);
+
+    PointToPointHelper pointToPoint;
+    pointToPoint.SetDeviceAttribute("DataRate", DataRateValue(DataRate("5Mbps")));
+    pointToPoint.SetChannelAttribute("Delay", TimeValue(MilliSeconds(10)));
+
+    NetDeviceContainer devices;
+    devices = pointToPoint.Install(nodes);
+
+    InternetStackHelper stack;
+    stack.Install(nodes);
+
+    Ipv4AddressHelper address;
+    address.SetBase("10.1.1.0", "255.255.255.0");
+    address.Assign(devices);
+
+    NrtvHelper helper(TcpSocketFactory::GetTypeId());
+    helper.InstallUsingIpv4(nodes.Get(0), nodes.Get(1));
+    Ptr<NrtvTcpClient> client = DynamicCast<NrtvTcpClient>(helper.GetClients().Get(0));
+    NS_TEST_ASSERT_MSG_NE(client, nullptr, "Expected an NRTV TCP client");
+    client->SetAttribute("KeepAlive", BooleanValue(true));
+    helper.GetServer().Get(0)->SetStartTime(MilliSeconds(1));
+    client->SetStartTime(MilliSeconds(2));
+    client->TraceConnectWithoutContext(
+        "StateTransitionEnum",
+        MakeCallback(&NrtvKeepAliveTestCase::StateTransitionCallback, this));
+
+    Simulator::Stop(Seconds(30));
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(m_numOfConnections, 1, "The connection is not kept across videos");
+    NS_TEST_ASSERT_MSG_GT_OR_EQ(m_numOfCompletedVideos,
+                                2,
+                                "Less than two videos have been completed");
+
+    Simulator::Destroy();
+
+    // return default values to their default
+    Config::SetDefault("ns3::NrtvVariables::NumOfFramesMean", UintegerValue(3000));
+    Config::SetDefault("ns3::NrtvVariables::NumOfFramesStdDev", UintegerValue(2400));
+    Config::SetDefault("ns3::NrtvVariables::NumOfFramesMin", UintegerValue(200));
+    Config::SetDefault("ns3::NrtvVariables::NumOfFramesMax", UintegerValue(36000));
+    Config::SetDefault("ns3::NrtvVariables::IdleTimeMean", TimeValue(Seconds(5)));
+
+} // end of `void DoRun ()`
+
+void
+NrtvKeepAliveTestCase::StateTransitionCallback(NrtvTcpClient::State_t oldState,
+                                               NrtvTcpClient::State_t newState)
+{
+    NS_LOG_FUNCTION(this << oldState << newState);
+
+    if (newState == NrtvTcpClient::CONNECTING)
+    {
+        m_numOfConnections++;
+    }
+    else if (oldState == NrtvTcpClient::RECEIVING && newState == NrtvTcpClient::IDLE)
+    {
+        m_numOfCompletedVideos++;
+    }
+}
+
+/**
+ * @ingroup applications
+ * @brief Verifies the addresses used by NrtvHelper when installing many
+ *        clients at once.
+ *
+ * Runs an NRTV server connected to three clients, each through its own
+ * point-to-point link and subnet. Hence the server has one address on each
+ * link, and the first of them is expected to be used. The test case verifies
+ * that:
+ * - over TCP, every client is given the first address of the server;
+ * - over UDP, every client listens on its own address, which the server has
+ *   recorded through the `ReserveClients` and `AddClient` path;
+ * - every client receives video packets.
+ */
+class NrtvBulkInstallTestCase : public TestCase
+{
+  public:
+    /**
+     * @brief Construct a new test case.
+     * @param name the test case name, which will be printed on the report
+     * @param protocolTypeId determines the socket type (TCP or UDP)
+     */
+    NrtvBulkInstallTestCase(std::string name, TypeId protocolTypeId);
+
+  private:
+    virtual void DoRun();
+
+    // CALLBACK FUNCTIONS
+    void RxCallback(std::string context, Ptr<const Packet> packet, const Address& from);
+
+    TypeId m_protocolTypeId;
+    /// Number of bytes received, indexed by the context string of each client.
+    std::map<std::string, uint64_t> m_rxBytes;
+
+}; // end of `class NrtvBulkInstallTestCase`
+
+NrtvBulkInstallTestCase::NrtvBulkInstallTestCase(std::string name, TypeId protocolTypeId)
+    : TestCase(name),
+      m_protocolTypeId(protocolTypeId)
+{
+    NS_LOG_FUNCTION(this << name << protocolTypeId.GetName());
+}
+
+void
+NrtvBulkInstallTestCase::DoRun()
+{
+    NS_LOG_FUNCTION(this << GetName());
+
+    Config::SetDefault("ns3::TcpL4Protocol::SocketType", StringValue("ns3::TcpNewReno"));
+    const bool isTcp = (m_protocolTypeId == TcpSocketFactory::GetTypeId());
+    const uint32_t numOfClients = 3;
+
+    Ptr<Node> serverNode = CreateObject<Node>();
+    NodeContainer clientNodes;
+    clientNodes.Create(numOfClients);
+
+    InternetStackHelper stack;
+    stack.Install(serverNode);
+    stack.Install(clientNodes);
+
+    PointToPointHelper pointToPoint;
+    pointToPoint.SetDeviceAttribute("DataRate", DataRateValue(DataRate("5Mbps")));
+    pointToPoint.SetChannelAttribute("Delay", TimeValue(MilliSeconds(10)));
+
+    Ipv4AddressHelper address;
+    std::vector<Ipv4InterfaceContainer> links;
+    for (uint32_t i = 0; i < numOfClients; i++)
+    {
+        std::ostringstream oss;
+        oss << "10.1." << (i + 1) << ".0";
+        address.SetBase(oss.str().c_str(), "255.255.255.0");
+        links.push_back(address.Assign(pointToPoint.Install(serverNode, clientNodes.Get(i))));
+    }
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+
+    // The first link is set up first, so its address comes first in the server.
+    const Ipv4Address serverAddress = links[0].GetAddress(0);
+
+    NrtvHelper helper(m_protocolTypeId);
+    helper.InstallUsingIpv4(serverNode, clientNodes);
+    ApplicationContainer clients = helper.GetClients();
+    NS_TEST_ASSERT_MSG_EQ(clients.GetN(), numOfClients, "Unexpected number of clients");
+    helper.GetServer().Get(0)->SetStartTime(MilliSeconds(1));
+
+    for (uint32_t i = 0; i < numOfClients; i++)
+    {
+        Ptr<Application> client = clients.Get(i);
+        NS_TEST_ASSERT_MSG_EQ(client->GetNode(), clientNodes.Get(i), "Client on a wrong node");
+        client->SetStartTime(MilliSeconds(2));
+
+        if (isTcp)
+        {
+            AddressValue remoteAddress;
+            client->GetAttribute("RemoteServerAddress", remoteAddress);
+            NS_TEST_ASSERT_MSG_EQ(Ipv4Address::ConvertFrom(remoteAddress.Get()),
+                                  serverAddress,
+                                  "Client " << i << " is not given the first server address");
+        }
+        else
+        {
+            Ptr<NrtvUdpServer> server = DynamicCast<NrtvUdpServer>(helper.GetServer().Get(0));
+            NS_TEST_ASSERT_MSG_NE(server, nullptr, "Expected an NRTV UDP server");
+            AddressValue localAddress;
+            client->GetAttribute("Local", localAddress);
+            const InetSocketAddress local = InetSocketAddress::ConvertFrom(localAddress.Get());
+            NS_TEST_ASSERT_MSG_EQ(local.GetIpv4(),
+                                  links[i].GetAddress(1),
+                                  "Client " << i << " does not listen on its own address");
+            NS_TEST_ASSERT_MSG_EQ(local.GetPort(),
+                                  server->GetRemotePort(),
+                                  "Client " << i << " does not listen on the server port");
+        }
+
+        std::ostringstream context;
+        context << i;
+        m_rxBytes[context.str()] = 0;
+        client->TraceConnect("Rx",
+                             context.str(),
+                             MakeCallback(&NrtvBulkInstallTestCase::RxCallback, this));
+    }
+
+    Simulator::Stop(Seconds(5));
+    Simulator::Run();
+
+    for (std::map<std::string, uint64_t>::const_iterator it = m_rxBytes.begin();
+         it != m_rxBytes.end();
+         ++it)
+    {
+        NS_TEST_ASSERT_MSG_GT(it->second, 0, "Client " << it->first << " has received nothing");
+    }
+
+    Simulator::Destroy();
+
+} // end of `void DoRun ()`
+
+void
+NrtvBulkInstallTestCase::RxCallback(std::string context,
+                                    Ptr<const Packet> packet,
+                                    const Address& from)
+{
+    NS_LOG_FUNCTION(this << context << packet << packet->GetSize() << from);
+    m_rxBytes[context] += packet->GetSize();
+}
+
+/**
+ * @ingroup applications
+ * @brief Verifies that NrtvUdpServer holds a socket and a video worker for a
+ *        client only while a video is streamed to it.
+ *
+ * Runs an NRTV UDP server streaming three short videos to a single client,
+ * with idle time in between. The number of active videos of the server is
+ * sampled periodically. The test case verifies that it is at most one, that
+ * it drops back to zero between the videos, i.e., it rises from zero once
+ * for each video, and that it is zero after the last video.
+ */
+class NrtvUdpServerIdleTestCase : public TestCase
+{
+  public:
+    /**
+     * @brief Construct a new test case.
+     * @param name the test case name, which will be printed on the report
+     */
+    NrtvUdpServerIdleTestCase(std::string name);
+
+  private:
+    virtual void DoRun();
+    virtual void DoTeardown();
+
+    /// Sample the number of active videos of the server and re-schedule itself.
+    void SampleActiveVideos();
+
+    Ptr<NrtvUdpServer> m_server;
+    /// The last sample.
+    uint32_t m_numOfActiveVideos;
+    /// The largest sample.
+    uint32_t m_maxNumOfActiveVideos;
+    /// Number of times the samples have risen from zero.
+    uint32_t m_numOfStartedVideos;
+
+}; // end of `class NrtvUdpServerIdleTestCase`
+
+NrtvUdpServerIdleTestCase::NrtvUdpServerIdleTestCase(std::string name)
+    : TestCase(name),
+      m_numOfActiveVideos(0),
+      m_maxNumOfActiveVideos(0),
+      m_numOfStartedVideos(0)
+{
+    NS_LOG_FUNCTION(this << name);
+}
+
+void
+NrtvUdpServerIdleTestCase::DoRun()
+{
+    NS_LOG_FUNCTION(this << GetName());
+
+    // Three videos of exactly 2 seconds, with short pauses in between.
+    Config::SetDefault("ns3::NrtvVariables::NumOfFramesMean", UintegerValue(20));
+    Config::SetDefault("ns3::NrtvVariables::NumOfFramesStdDev", UintegerValue(1));
+    Config::SetDefault("ns3::NrtvVariables::NumOfFramesMin", UintegerValue(20));
+    Config::SetDefault("ns3::NrtvVariables::NumOfFramesMax", UintegerValue(20));
+    Config::SetDefault("ns3::NrtvVariables::IdleTimeMean", TimeValue(MilliSeconds(500)));
+    Config::SetDefault("ns3::NrtvVariables::NumberOfVideos",
+                       StringValue("ns3::ConstantRandomVariable[Constant=3]"));
+
+    NodeContainer nodes;
+    nodes.Create(2);
+
+    PointToPointHelper pointToPoint;
+    pointToPoint.SetDeviceAttribute("DataRate", DataRateValue(DataRate("5Mbps")));
+    pointToPoint.SetChannelAttribute("Delay", TimeValue(MilliSeconds(10)));
+
+    NetDeviceContainer devices;
+    devices = pointToPoint.Install(nodes);
+
+    InternetStackHelper stack;
+    stack.Install(nodes);
+
+    Ipv4AddressHelper address;
+    address.SetBase("10.1.1.0", "255.255.255.0");
+    address.Assign(devices);
+
+    NrtvHelper helper(UdpSocketFactory::GetTypeId());
+    helper.InstallUsingIpv4(nodes.Get(0), nodes.Get(1));
+    m_server = DynamicCast<NrtvUdpServer>(helper.GetServer().Get(0));
+    NS_TEST_ASSERT_MSG_NE(m_server, nullptr, "Expected an NRTV UDP server");
+    NS_TEST_ASSERT_MSG_EQ(m_server->GetNActiveVideos(),
+                          0,
+                          "A video is active before the server has started");
+
+    Simulator::Schedule(MilliSeconds(1), &NrtvUdpServerIdleTestCase::SampleActiveVideos, this);
+    Simulator::Stop(Seconds(30));
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(m_maxNumOfActiveVideos, 1, "Unexpected number of active videos");
+    NS_TEST_ASSERT_MSG_EQ(m_numOfStartedVideos,
+                          3,
+                          "The socket and the worker are not released between the videos");
+    NS_TEST_ASSERT_MSG_EQ(m_numOfActiveVideos,
+                          0,
+                          "The socket and the worker are not released after the last video");
+
+    Simulator::Destroy();
+
+    // return default values to their default
+    Config::SetDefault("ns3::NrtvVariables::NumOfFramesMean", UintegerValue(3000));
+    Config::SetDefault("ns3::NrtvVariables::NumOfFramesStdDev", UintegerValue(2400));
+    Config::SetDefault("ns3::NrtvVariables::NumOfFramesMin", UintegerValue(200));
+    Config::SetDefault("ns3::NrtvVariables::NumOfFramesMax", UintegerValue(36000));
+    Config::SetDefault("ns3::NrtvVariables::IdleTimeMean", TimeValue(Seconds(5)));
+    Config::SetDefault("ns3::NrtvVariables::NumberOfVideos",
+                       StringValue("ns3::ConstantRandomVariable[Constant=1]"));
+
+} // end of `void DoRun ()`
+
+void
+NrtvUdpServerIdleTestCase::DoTeardown()
+{
+    NS_LOG_FUNCTION(this << GetName());
+    m_server = nullptr;
+}
+
+void
+NrtvUdpServerIdleTestCase::SampleActiveVideos()
+{
+    const uint32_t numOfActiveVideos = m_server->GetNActiveVideos();
+    NS_LOG_FUNCTION(this << numOfActiveVideos);
+
+    if (m_numOfActiveVideos == 0 && numOfActiveVideos > 0)
+    {
+        m_numOfStartedVideos++;
+    }
+    m_numOfActiveVideos = numOfActiveVideos;
+    m_maxNumOfActiveVideos = std::max(m_maxNumOfActiveVideos, numOfActiveVideos);
+
+    Simulator::Schedule(MilliSeconds(1), &NrtvUdpServerIdleTestCase::SampleActiveVideos, this);
+}
+
+/**
+ * @ingroup applications
+ * @brief Verifies that every viewer of a live channel of NrtvUdpServer
+ *        receives each slice of the channel.
+ *
+ * Runs an NRTV UDP server with two live channels, fanned out to two viewers
+ * each, every viewer connected to the server through its own point-to-point
+ * link. The test case verifies that the viewers of the same channel receive
+ * the same slices in the same order, and that every slice sent by the server
+ * is received by a viewer.
+ */
+class NrtvLiveChannelTestCase : public TestCase
+{
+  public:
+    /**
+     * @brief Construct a new test case.
+     * @param name the test case name, which will be printed on the report
+     */
+    NrtvLiveChannelTestCase(std::string name);
+
+  private:
+    /// Frame number, slice number, and slice size of a received slice.
+    typedef std::tuple<uint32_t, uint16_t, uint32_t> Slice_t;
+
+    virtual void DoRun();
+
+    // CALLBACK FUNCTIONS
+    void TxCallback(Ptr<const Packet> packet);
+    void RxCallback(std::string context, Ptr<const Packet> packet, const Address& from);
+
+    /// Number of packets sent by the server.
+    uint32_t m_numOfTx;
+    /// Number of packets received by all the viewers.
+    uint32_t m_numOfRx;
+    /// Slices received by each viewer, indexed by the context string of the viewer.
+    std::map<std::string, std::vector<Slice_t>> m_rxSlices;
+
+}; // end of `class NrtvLiveChannelTestCase`
+
+NrtvLiveChannelTestCase::NrtvLiveChannelTestCase(std::string name)
+    : TestCase(name),
+      m_numOfTx(0),
+      m_numOfRx(0)
+{
+    NS_LOG_FUNCTION(this << name);
+}
+
+void
+NrtvLiveChannelTestCase::DoRun()
+{
+    NS_LOG_FUNCTION(this << GetName());
+
+    const uint32_t numOfChannels = 2;
+    const uint32_t numOfViewers = 4;
+
+    Ptr<Node> serverNode = CreateObject<Node>();
+    NodeContainer viewerNodes;
+    viewerNodes.Create(numOfViewers);
+
+    InternetStackHelper stack;
+    stack.Install(serverNode);
+    stack.Install(viewerNodes);
+
+    PointToPointHelper pointToPoint;
+    pointToPoint.SetDeviceAttribute("DataRate", DataRateValue(DataRate("5Mbps")));
+    pointToPoint.SetChannelAttribute("Delay", TimeValue(MilliSeconds(10)));
+
+    Ipv4AddressHelper address;
+    for (uint32_t i = 0; i < numOfViewers; i++)
+    {
+        std::ostringstream oss;
+        oss << "10.1." << (i + 1) << ".0";
+        address.SetBase(oss.str().c_str(), "255.255.255.0");
+        address.Assign(pointToPoint.Install(serverNode, viewerNodes.Get(i)));
+    }
+
+    NrtvHelper helper(UdpSocketFactory::GetTypeId());
+    helper.SetLiveChannels(numOfChannels);
+    helper.InstallUsingIpv4(serverNode, viewerNodes);
+    Ptr<NrtvUdpServer> server = DynamicCast<NrtvUdpServer>(helper.GetServer().Get(0));
+    NS_TEST_ASSERT_MSG_NE(server, nullptr, "Expected an NRTV UDP server");
+    NS_TEST_ASSERT_MSG_EQ(server->GetNLiveChannels(), numOfChannels, "Unexpected channels");
+    server->SetStartTime(MilliSeconds(1));
+    server->SetStopTime(Seconds(3)); // leave time for the last slices to arrive
+    server->TraceConnectWithoutContext("Tx",
+                                       MakeCallback(&NrtvLiveChannelTestCase::TxCallback, this));
+
+    ApplicationContainer viewers = helper.GetClients();
+    NS_TEST_ASSERT_MSG_EQ(viewers.GetN(), numOfViewers, "Unexpected number of viewers");
+    for (uint32_t i = 0; i < numOfViewers; i++)
+    {
+        std::ostringstream context;
+        context << i;
+        viewers.Get(i)->TraceConnect("Rx",
+                                     context.str(),
+                                     MakeCallback(&NrtvLiveChannelTestCase::RxCallback, this));
+    }
+
+    Simulator::Stop(Seconds(4));
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_GT(m_numOfTx, 0, "No slice has been sent");
+    NS_TEST_ASSERT_MSG_EQ(m_numOfRx, m_numOfTx, "Some slices have not reached a viewer");
+
+    for (uint32_t i = 0; i < numOfViewers; i++)
+    {
+        std::ostringstream viewer;
+        viewer << i;
+        NS_TEST_ASSERT_MSG_GT(m_rxSlices[viewer.str()].size(),
+                              0,
+                              "Viewer " << i << " has received nothing");
+
+        if (i >= numOfChannels)
+        {
+            // Viewer i watches channel i modulo the number of channels.
+            std::ostringstream first;
+            first << (i % numOfChannels);
+            NS_TEST_ASSERT_MSG_EQ((m_rxSlices[viewer.str()] == m_rxSlices[first.str()]),
+                                  true,
+                                  "Viewers " << first.str() << " and " << i << " of channel "
+                                             << (i % numOfChannels)
+                                             << " have received different slices");
+        }
+    }
+
+    Simulator::Destroy();
+
+} // end of `void DoRun ()`
+
+void
+NrtvLiveChannelTestCase::TxCallback(Ptr<const Packet> packet)
+{
+    NS_LOG_FUNCTION(this << packet << packet->GetSize());
+    m_numOfTx++;
+}
+
+void
+NrtvLiveChannelTestCase::RxCallback(std::string context,
+                                    Ptr<const Packet> packet,
+                                    const Address& from)
+{
+    NS_LOG_FUNCTION(this << context << packet << packet->GetSize() << from);
+
+    // Over UDP, every packet carries exactly one slice.
+    Ptr<Packet> copy = packet->Copy();
+    NrtvHeader nrtvHeader;
+    copy->RemoveHeader(nrtvHeader);
+    m_rxSlices[context].push_back(Slice_t(nrtvHeader.GetFrameNumber(),
+                                          nrtvHeader.GetSliceNumber(),
+                                          nrtvHeader.GetSliceSize()));
+    m_numOfRx++;
+}
+
+/**
+ * @ingroup nrtv
+ * @brief Verifies that the video workers of a server play the titles of a
+ *        shared NrtvCatalog.
+ *
+ * An NrtvUdpServer with a catalog of a single, short title streams a video to
+ * each of two clients. Every slice received by a client must have the size of
+ * the same slice in the title, both clients must receive the same slices, and
+ * the title must have been generated only once.
+ */
+class NrtvCatalogSharingTestCase : public TestCase
+{
+  public:
+    /**
+     * @brief Construct a new test case.
+     * @param name the test case name, which will be printed on the report
+     */
+    NrtvCatalogSharingTestCase(std::string name);
+
+  private:
+    /// Frame number, slice number, and slice size of a received slice.
+    typedef std::tuple<uint32_t, uint16_t, uint32_t> Slice_t;
+
+    virtual void DoRun();
+
+    // CALLBACK FUNCTIONS
+    void RxCallback(std::string context, Ptr<const Packet> packet, const Address& from);
+
+    /// Slices received by each client, indexed by the context string of the client.
+    std::map<std::string, std::vector<Slice_t>> m_rxSlices;
+
+}; // end of `class NrtvCatalogSharingTestCase`
+
+NrtvCatalogSharingTestCase::NrtvCatalogSharingTestCase(std::string name)
+    : TestCase(name)
+{
+    NS_LOG_FUNCTION(this << name);
+}
+
+void
+NrtvCatalogSharingTestCase::DoRun()
+{
+    NS_LOG_FUNCTION(this << GetName());
+
+    const uint32_t numOfClients = 2;
+
+    Ptr<Node> serverNode = CreateObject<Node>();
+    NodeContainer clientNodes;
+    clientNodes.Create(numOfClients);
+
+    InternetStackHelper stack;
+    stack.Install(serverNode);
+    stack.Install(clientNodes);
+
+    PointToPointHelper pointToPoint;
+    pointToPoint.SetDeviceAttribute("DataRate", DataRateValue(DataRate("5Mbps")));
+    pointToPoint.SetChannelAttribute("Delay", TimeValue(MilliSeconds(10)));
+
+    Ipv4AddressHelper address;
+    for (uint32_t i = 0; i < numOfClients; i++)
+    {
+        std::ostringstream oss;
+        oss << "10.1." << (i + 1) << ".0";
+        address.SetBase(oss.str().c_str(), "255.255.255.0");
+        address.Assign(pointToPoint.Install(serverNode, clientNodes.Get(i)));
+    }
+
+    // A single title of 10 to 40 frames, i.e., at most 4 seconds of video.
+    Ptr<NrtvVariables> titleVariables = CreateObject<NrtvVariables>();
+    titleVariables->SetAttribute("NumOfFramesMean", UintegerValue(20));
+    titleVariables->SetAttribute("NumOfFramesStdDev", UintegerValue(5));
+    titleVariables->SetAttribute("NumOfFramesMin", UintegerValue(10));
+    titleVariables->SetAttribute("NumOfFramesMax", UintegerValue(40));
+    Ptr<NrtvCatalog> catalog = CreateObject<NrtvCatalog>();
+    catalog->SetAttribute("NumOfTitles", UintegerValue(1));
+    catalog->SetAttribute("Variables", PointerValue(titleVariables));
+
+    NrtvHelper helper(UdpSocketFactory::GetTypeId());
+    helper.InstallUsingIpv4(serverNode, clientNodes);
+    Ptr<NrtvUdpServer> server = DynamicCast<NrtvUdpServer>(helper.GetServer().Get(0));
+    NS_TEST_ASSERT_MSG_NE(server, nullptr, "Expected an NRTV UDP server");
+    server->SetAttribute("Catalog", PointerValue(catalog));
+
+    ApplicationContainer clients = helper.GetClients();
+    NS_TEST_ASSERT_MSG_EQ(clients.GetN(), numOfClients, "Unexpected number of clients");
+    for (uint32_t i = 0; i < numOfClients; i++)
+    {
+        std::ostringstream context;
+        context << i;
+        clients.Get(i)->TraceConnect("Rx",
+                                     context.str(),
+                                     MakeCallback(&NrtvCatalogSharingTestCase::RxCallback, this));
+    }
+
+    Simulator::Stop(Seconds(8));
+    Simulator::Run();
+
+    const NrtvCatalog::Title& title = catalog->GetTitle(0);
+    NS_TEST_ASSERT_MSG_EQ(catalog->GetMemoryUsage(),
+                          title.slices.capacity() * sizeof(NrtvCatalog::Slice),
+                          "The catalog should hold exactly one title");
+
+    for (uint32_t i = 0; i < numOfClients; i++)
+    {
+        std::ostringstream client;
+        client << i;
+        const std::vector<Slice_t>& slices = m_rxSlices[client.str()];
+        NS_TEST_ASSERT_MSG_GT(slices.size(), 0, "Client " << i << " has received nothing");
+
+        for (std::vector<Slice_t>::const_iterator it = slices.begin(); it != slices.end(); ++it)
+        {
+            const uint32_t frameNumber = std::get<0>(*it);
+            const uint16_t sliceNumber = std::get<1>(*it);
+            NS_TEST_ASSERT_MSG_LT_OR_EQ(frameNumber,
+                                        title.numOfFrames,
+                                        "Client " << i << " has received a frame beyond the title");
+            NS_TEST_ASSERT_MSG_EQ(std::get<2>(*it),
+                                  title.GetSlice(frameNumber, sliceNumber).size,
+                                  "Client " << i << " has received slice " << sliceNumber
+                                            << " of frame " << frameNumber
+                                            << " with a size not from the title");
+        }
+    }
+
+    NS_TEST_ASSERT_MSG_EQ((m_rxSlices["0"] == m_rxSlices["1"]),
+                          true,
+                          "The clients have received different slices of the same title");
+
+    Simulator::Destroy();
+
+} // end of `void DoRun ()`
+
+void
+NrtvCatalogSharingTestCase::RxCallback(std::string context,
+                                       Ptr<const Packet> packet,
+                                       const Address& from)
+{
+    NS_LOG_FUNCTION(this << context << packet << packet->GetSize() << from);
+
+    // Over UDP, every packet carries exactly one slice.
+    Ptr<Packet> copy = packet->Copy();
+    NrtvHeader nrtvHeader;
+    copy->RemoveHeader(nrtvHeader);
+    m_rxSlices[context].push_back(Slice_t(nrtvHeader.GetFrameNumber(),
+                                          nrtvHeader.GetSliceNumber(),
+                                          nrtvHeader.GetSliceSize()));
+}
+
+/**
+ * @ingroup nrtv
+ * @brief Verifies that NrtvCatalog accepts slice sizes and encoding delays up
+ *        to the 16-bit limit of its slices and stores them without loss.
+ *
+ * The `SliceSizeMax` and `SliceEncodingDelayMax` attributes of the variables
+ * of the catalog are set to 65535 bytes and milliseconds, the largest values
+ * allowed, with scales which make most values larger than 32767. The titles
+ * must hold exactly the values drawn by an identical NrtvVariables object on
+ * the same stream.
+ */
+class NrtvCatalogSliceRangeTestCase : public TestCase
+{
+  public:
+    /**
+     * @brief Construct a new test case.
+     * @param name the test case name, which will be printed on the report
+     */
+    NrtvCatalogSliceRangeTestCase(std::string name);
+
+  private:
+    virtual void DoRun();
+
+    /**
+     * @return a new variables object with the largest slices allowed by the
+     *         catalog and short videos.
+     */
+    static Ptr<NrtvVariables> CreateVariables();
+
+}; // end of `class NrtvCatalogSliceRangeTestCase`
+
+NrtvCatalogSliceRangeTestCase::NrtvCatalogSliceRangeTestCase(std::string name)
+    : TestCase(name)
+{
+    NS_LOG_FUNCTION(this << name);
+}
+
+Ptr<NrtvVariables> // static
+NrtvCatalogSliceRangeTestCase::CreateVariables()
+{
+    Ptr<NrtvVariables> variables = CreateObject<NrtvVariables>();
+    variables->SetAttribute("NumOfFramesMean", UintegerValue(20));
+    variables->SetAttribute("NumOfFramesStdDev", UintegerValue(5));
+    variables->SetAttribute("NumOfFramesMin", UintegerValue(10));
+    variables->SetAttribute("NumOfFramesMax", UintegerValue(40));
+    variables->SetAttribute("SliceSizeMax", UintegerValue(65535));
+    variables->SetAttribute("SliceSizeScale", DoubleValue(30000.0));
+    variables->SetAttribute("SliceEncodingDelayMax", TimeValue(MilliSeconds(65535)));
+    variables->SetAttribute("SliceEncodingDelayScale", DoubleValue(30000.0));
+    return variables;
+}
+
+void
+NrtvCatalogSliceRangeTestCase::DoRun()
+{
+    NS_LOG_FUNCTION(this << GetName());
+
+    const int64_t stream = 10;
+    Ptr<NrtvCatalog> catalog = CreateObject<NrtvCatalog>();
+    catalog->SetAttribute("NumOfTitles", UintegerValue(2));
+    catalog->SetAttribute("Variables", PointerValue(CreateVariables()));
+    catalog->AssignStreams(stream);
+
+    // Same draws as NrtvCatalog, in the same order.
+    Ptr<NrtvVariables> reference = CreateVariables();
+    reference->SetStream(stream);
+    uint32_t numOfUpperHalfSizes = 0;
+
+    for (uint32_t i = 0; i < catalog->GetNumOfTitles(); i++)
+    {
+        const NrtvCatalog::Title& title = catalog->GetTitle(i);
+        NS_TEST_ASSERT_MSG_EQ(title.numOfFrames,
+                              reference->GetNumOfFrames(),
+                              "Unexpected length of title " << i);
+        NS_TEST_ASSERT_MSG_EQ(title.numOfSlices,
+                              reference->GetNumOfSlices(),
+                              "Unexpected number of slices of title " << i);
+
+        for (uint32_t j = 0; j < title.slices.size(); j++)
+        {
+            const uint32_t size = reference->GetSliceSize();
+            const int64_t encodingDelay = reference->GetSliceEncodingDelay().GetMilliSeconds();
+            NS_TEST_ASSERT_MSG_EQ(title.slices[j].size,
+                                  size,
+                                  "Slice " << j << " of title " << i << " has lost its size");
+            NS_TEST_ASSERT_MSG_EQ(title.slices[j].encodingDelay,
+                                  encodingDelay,
+                                  "Slice " << j << " of title " << i
+                                           << " has lost its encoding delay");
+            if (size > 32767)
+            {
+                numOfUpperHalfSizes++;
+            }
+        }
+    }
+
+    NS_TEST_ASSERT_MSG_GT(numOfUpperHalfSizes, 0, "No slice size has used the 16th bit");
+
+    Simulator::Destroy();
+
+} // end of `void DoRun ()`
+
 /**
  * @brief Test suite `nrtv`, verifying the NRTV traffic model.
  */
@@ -287,6 +1617,52 @@ NrtvTestSuite::NrtvTestSuite()
         }
     }
 
+    // The same over TCP, with slices preceded by compact headers.
+    for (uint8_t j = 0; j < 3; j++)
+    {
+        std::ostringstream oss;
+        oss << tcp.GetName() << ", " << "delay=" << delayMs[j] << "ms, " << "compact header";
+        AddTestCase(new NrtvClientRxBufferTestCase(oss.str(),
+                                                   rngRun[0],
+                                                   tcp,
+                                                   MilliSeconds(delayMs[j]),
+                                                   Seconds(5),
+                                                   true),
+                    TestCase::Duration::QUICK);
+    }
+
+    // The send queue of the video worker, with each overflow policy.
+    const NrtvVideoWorker::QueueOverflowPolicy_t policies[3] = {NrtvVideoWorker::DROP_OLDEST,
+                                                                NrtvVideoWorker::DROP_FRAME,
+                                                                NrtvVideoWorker::BLOCK_ENCODER};
+    const char* policyNames[3] = {"DROP_OLDEST", "DROP_FRAME", "BLOCK_ENCODER"};
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        AddTestCase(new NrtvVideoWorkerQueueTestCase(std::string("queue, ") + policyNames[i],
+                                                     policies[i],
+                                                     Seconds(0)),
+                    TestCase::Duration::QUICK);
+        AddTestCase(new NrtvVideoWorkerQueueTestCase(std::string("queue, ") + policyNames[i] +
+                                                         ", stopped",
+                                                     policies[i],
+                                                     MilliSeconds(1550)),
+                    TestCase::Duration::QUICK);
+    }
+
+    AddTestCase(new NrtvStateTransitionTestCase("state transitions, enum and string"),
+                TestCase::Duration::QUICK);
+    AddTestCase(new NrtvKeepAliveTestCase("keep-alive, two videos"), TestCase::Duration::QUICK);
+    AddTestCase(new NrtvBulkInstallTestCase("bulk install, TCP", tcp), TestCase::Duration::QUICK);
+    AddTestCase(new NrtvBulkInstallTestCase("bulk install, UDP", udp), TestCase::Duration::QUICK);
+    AddTestCase(new NrtvUdpServerIdleTestCase("UDP server, idle clients"),
+                TestCase::Duration::QUICK);
+    AddTestCase(new NrtvLiveChannelTestCase("UDP server, live channels"),
+                TestCase::Duration::QUICK);
+    AddTestCase(new NrtvCatalogSharingTestCase("catalog, shared title"),
+                TestCase::Duration::QUICK);
+    AddTestCase(new NrtvCatalogSliceRangeTestCase("catalog, 16-bit slices"),
+                TestCase::Duration::QUICK);
+
 } // end of `NrtvTestSuite ()`
 
 static NrtvTestSuite g_nrtvTestSuiteInstance;
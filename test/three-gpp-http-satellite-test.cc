@@ -0,0 +1,957 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+
+/**
+ * @file three-gpp-http-satellite-test.cc
+ * @ingroup http
+ * @brief Test cases for ThreeGppHttpSatelliteClient and
+ *        ThreeGppHttpSatelliteServer, grouped in `three-gpp-http-satellite`
+ *        test suite.
+ */
+
+#include "ns3/address.h"
+#include "ns3/boolean.h"
+#include "ns3/config.h"
+#include "ns3/data-rate.h"
+#include "ns3/enum.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-interface-container.h"
+#include "ns3/log.h"
+#include "ns3/net-device-container.h"
+#include "ns3/node-container.h"
+#include "ns3/nstime.h"
+#include "ns3/packet.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/pointer.h"
+#include "ns3/simulator.h"
+#include "ns3/socket.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/three-gpp-http-header.h"
+#include "ns3/three-gpp-http-satellite-client.h"
+#include "ns3/three-gpp-http-satellite-server.h"
+#include "ns3/three-gpp-http-satellite-variables.h"
+#include "ns3/three-gpp-http-stream-header.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+NS_LOG_COMPONENT_DEFINE("ThreeGppHttpSatelliteTest");
+
+using namespace ns3;
+
+/**
+ * @ingroup http
+ * @brief Base class of the test cases which run a ThreeGppHttpSatelliteClient
+ *        against a ThreeGppHttpSatelliteServer for a few web pages.
+ *
+ * The client and the server share a ThreeGppHttpSatelliteVariables instance
+ * whose number of embedded objects, object sizes, parsing times, and reading
+ * times are pre-generated by the test case, so every web page is known in
+ * advance. The simulation stops once the client has completely received the
+ * last web page.
+ *
+ * The base class verifies that every web page is completed with its expected
+ * number of embedded objects, and that every object is received with the
+ * length announced by its ThreeGppHttpHeader. Child classes configure the
+ * applications for the feature under test and verify the rest.
+ */
+class ThreeGppHttpSatelliteTestCase : public TestCase
+{
+  public:
+    /**
+     * @brief Construct a new test case.
+     * @param name the test case name, which will be printed on the report
+     * @param numOfEmbeddedObjects the number of embedded objects of each web page
+     */
+    ThreeGppHttpSatelliteTestCase(std::string name, std::vector<uint32_t> numOfEmbeddedObjects);
+
+  protected:
+    /**
+     * @brief Configure the applications before the simulation starts.
+     * @param client the client application
+     * @param server the server application
+     */
+    virtual void ConfigureApplications(Ptr<ThreeGppHttpSatelliteClient> client,
+                                       Ptr<ThreeGppHttpSatelliteServer> server) = 0;
+
+    /// Verify the outcome of the simulation, after it has stopped.
+    virtual void VerifyResults() = 0;
+
+    /// Number of embedded objects of each web page.
+    std::vector<uint32_t> m_numOfEmbeddedObjects;
+    /// Size of the embedded objects generated by the server, in order of generation.
+    std::vector<uint32_t> m_embeddedObjectSizes;
+    /// Reading time after each web page.
+    std::vector<Time> m_readingTimes;
+
+    /// Content length of the embedded objects received by the client, in order of reception.
+    std::vector<uint32_t> m_rxEmbeddedObjectSizes;
+    /// Number of embedded objects received by the client for each web page.
+    std::vector<uint32_t> m_rxEmbeddedObjectsPerPage;
+    /// Number of main objects received by the client.
+    uint32_t m_numOfMainObjects;
+    /// Number of web pages completely received by the client.
+    uint32_t m_numOfPages;
+    /// Number of requests for embedded objects sent by the client.
+    uint32_t m_numOfEmbeddedObjectRequests;
+    /// Number of embedded objects generated by the server.
+    uint32_t m_numOfEmbeddedObjectsGenerated;
+    /// The sockets of the connections accepted by the server, in order of acceptance.
+    std::vector<Ptr<Socket>> m_serverSockets;
+
+  private:
+    virtual void DoRun();
+
+    /**
+     * @brief Connected with `ConnectionEstablished` trace source of the server.
+     * @param httpServer the server application
+     * @param socket the socket of the accepted connection
+     */
+    void ServerConnectionEstablishedCallback(Ptr<const ThreeGppHttpSatelliteServer> httpServer,
+                                             Ptr<Socket> socket);
+
+    /**
+     * @brief Connected with `EmbeddedObject` trace source of the server.
+     * @param size size of the generated embedded object in bytes
+     */
+    void ServerEmbeddedObjectCallback(uint32_t size);
+
+    /**
+     * @brief Connected with `TxEmbeddedObjectRequest` trace source of the client.
+     * @param packet the request packet
+     */
+    void ClientTxEmbeddedObjectRequestCallback(Ptr<const Packet> packet);
+
+    /**
+     * @brief Connected with `RxMainObject` trace source of the client.
+     * @param httpClient the client application
+     * @param packet the whole main object, including its header
+     */
+    void ClientRxMainObjectCallback(Ptr<const ThreeGppHttpSatelliteClient> httpClient,
+                                    Ptr<const Packet> packet);
+
+    /**
+     * @brief Connected with `RxEmbeddedObject` trace source of the client.
+     * @param httpClient the client application
+     * @param packet the whole embedded object, including its header
+     */
+    void ClientRxEmbeddedObjectCallback(Ptr<const ThreeGppHttpSatelliteClient> httpClient,
+                                        Ptr<const Packet> packet);
+
+    /**
+     * @brief Connected with `StateTransitionEnum` trace source of the client.
+     *        Counts the web pages and stops the simulation after the last one.
+     * @param oldState the previous state
+     * @param newState the current state
+     */
+    void ClientStateTransitionCallback(ThreeGppHttpSatelliteClient::State_t oldState,
+                                       ThreeGppHttpSatelliteClient::State_t newState);
+
+    /**
+     * @brief Verify that an object received by the client is as long as the
+     *        content length in its ThreeGppHttpHeader.
+     * @param packet the whole object, including its header
+     * @param contentLength output argument which receives the content length
+     */
+    void VerifyObject(Ptr<const Packet> packet, uint32_t& contentLength);
+
+}; // end of `class ThreeGppHttpSatelliteTestCase`
+
+ThreeGppHttpSatelliteTestCase::ThreeGppHttpSatelliteTestCase(
+    std::string name,
+    std::vector<uint32_t> numOfEmbeddedObjects)
+    : TestCase(name),
+      m_numOfEmbeddedObjects(numOfEmbeddedObjects),
+      m_readingTimes(numOfEmbeddedObjects.size(), Seconds(1)),
+      m_rxEmbeddedObjectsPerPage(numOfEmbeddedObjects.size() + 1, 0),
+      m_numOfMainObjects(0),
+      m_numOfPages(0),
+      m_numOfEmbeddedObjectRequests(0),
+      m_numOfEmbeddedObjectsGenerated(0)
+{
+    NS_LOG_FUNCTION(this << name);
+}
+
+void
+ThreeGppHttpSatelliteTestCase::DoRun()
+{
+    NS_LOG_FUNCTION(this << GetName());
+
+    Config::SetDefault("ns3::TcpL4Protocol::SocketType", StringValue("ns3::TcpNewReno"));
+
+    NodeContainer nodes;
+    nodes.Create(2);
+
+    PointToPointHelper pointToPoint;
+    pointToPoint.SetDeviceAttribute("DataRate", DataRateValue(DataRate("10Mbps")));
+    pointToPoint.SetChannelAttribute("Delay", TimeValue(MilliSeconds(10)));
+
+    NetDeviceContainer devices;
+    devices = pointToPoint.Install(nodes);
+
+    InternetStackHelper stack;
+    stack.Install(nodes);
+
+    Ipv4AddressHelper address;
+    address.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = address.Assign(devices);
+
+    // Every web page is known in advance.
+    std::vector<int64_t> numOfEmbeddedObjects;
+    std::vector<int64_t> parsingTimes;
+    std::vector<int64_t> readingTimes;
+    std::vector<int64_t> mainObjectSizes;
+    for (uint32_t i = 0; i < m_numOfEmbeddedObjects.size(); i++)
+    {
+        numOfEmbeddedObjects.push_back(m_numOfEmbeddedObjects[i]);
+        parsingTimes.push_back(MilliSeconds(100).GetNanoSeconds());
+        readingTimes.push_back(m_readingTimes[i].GetNanoSeconds());
+        mainObjectSizes.push_back(10000);
+    }
+
+    std::vector<int64_t> embeddedObjectSizes(m_embeddedObjectSizes.begin(),
+                                             m_embeddedObjectSizes.end());
+
+    Ptr<ThreeGppHttpSatelliteVariables> variables =
+        CreateObject<ThreeGppHttpSatelliteVariables>();
+    variables->AppendPregeneratedWorkload(
+        ThreeGppHttpSatelliteVariables::WORKLOAD_NUM_OF_EMBEDDED_OBJECTS,
+        numOfEmbeddedObjects);
+    variables->AppendPregeneratedWorkload(ThreeGppHttpSatelliteVariables::WORKLOAD_PARSING_TIME,
+                                          parsingTimes);
+    variables->AppendPregeneratedWorkload(ThreeGppHttpSatelliteVariables::WORKLOAD_READING_TIME,
+                                          readingTimes);
+    variables->AppendPregeneratedWorkload(
+        ThreeGppHttpSatelliteVariables::WORKLOAD_MAIN_OBJECT_SIZE,
+        mainObjectSizes);
+    variables->AppendPregeneratedWorkload(
+        ThreeGppHttpSatelliteVariables::WORKLOAD_EMBEDDED_OBJECT_SIZE,
+        embeddedObjectSizes);
+
+    Ptr<ThreeGppHttpSatelliteServer> server = CreateObject<ThreeGppHttpSatelliteServer>();
+    server->SetAttribute("Variables", PointerValue(variables));
+    server->SetAttribute("LocalAddress", AddressValue(interfaces.GetAddress(0)));
+    server->SetStartTime(MilliSeconds(1));
+    nodes.Get(0)->AddApplication(server);
+
+    Ptr<ThreeGppHttpSatelliteClient> client = CreateObject<ThreeGppHttpSatelliteClient>();
+    client->SetAttribute("Variables", PointerValue(variables));
+    client->SetAttribute("RemoteServerAddress", AddressValue(interfaces.GetAddress(0)));
+    client->SetStartTime(MilliSeconds(2));
+    nodes.Get(1)->AddApplication(client);
+
+    server->TraceConnectWithoutContext(
+        "ConnectionEstablished",
+        MakeCallback(&ThreeGppHttpSatelliteTestCase::ServerConnectionEstablishedCallback, this));
+    server->TraceConnectWithoutContext(
+        "EmbeddedObject",
+        MakeCallback(&ThreeGppHttpSatelliteTestCase::ServerEmbeddedObjectCallback, this));
+    client->TraceConnectWithoutContext(
+        "TxEmbeddedObjectRequest",
+        MakeCallback(&ThreeGppHttpSatelliteTestCase::ClientTxEmbeddedObjectRequestCallback, this));
+    client->TraceConnectWithoutContext(
+        "RxMainObject",
+        MakeCallback(&ThreeGppHttpSatelliteTestCase::ClientRxMainObjectCallback, this));
+    client->TraceConnectWithoutContext(
+        "RxEmbeddedObject",
+        MakeCallback(&ThreeGppHttpSatelliteTestCase::ClientRxEmbeddedObjectCallback, this));
+    client->TraceConnectWithoutContext(
+        "StateTransitionEnum",
+        MakeCallback(&ThreeGppHttpSatelliteTestCase::ClientStateTransitionCallback, this));
+
+    ConfigureApplications(client, server);
+
+    // Normally stopped much earlier, after the last web page.
+    Simulator::Stop(Seconds(300));
+    Simulator::Run();
+
+    const uint32_t numOfPages = m_numOfEmbeddedObjects.size();
+    NS_TEST_ASSERT_MSG_EQ(m_numOfPages, numOfPages, "Unexpected number of web pages completed");
+    NS_TEST_ASSERT_MSG_EQ(m_numOfMainObjects, numOfPages, "Unexpected number of main objects");
+    for (uint32_t i = 0; i < numOfPages; i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(m_rxEmbeddedObjectsPerPage[i],
+                              m_numOfEmbeddedObjects[i],
+                              "Unexpected number of embedded objects in web page " << i);
+    }
+
+    VerifyResults();
+
+    m_serverSockets.clear();
+    Simulator::Destroy();
+
+} // end of `void DoRun ()`
+
+void
+ThreeGppHttpSatelliteTestCase::ServerConnectionEstablishedCallback(
+    Ptr<const ThreeGppHttpSatelliteServer> httpServer,
+    Ptr<Socket> socket)
+{
+    NS_LOG_FUNCTION(this << httpServer << socket);
+    m_serverSockets.push_back(socket);
+}
+
+void
+ThreeGppHttpSatelliteTestCase::ServerEmbeddedObjectCallback(uint32_t size)
+{
+    NS_LOG_FUNCTION(this << size);
+    m_numOfEmbeddedObjectsGenerated++;
+}
+
+void
+ThreeGppHttpSatelliteTestCase::ClientTxEmbeddedObjectRequestCallback(Ptr<const Packet> packet)
+{
+    NS_LOG_FUNCTION(this << packet);
+    m_numOfEmbeddedObjectRequests++;
+}
+
+void
+ThreeGppHttpSatelliteTestCase::ClientRxMainObjectCallback(
+    Ptr<const ThreeGppHttpSatelliteClient> httpClient,
+    Ptr<const Packet> packet)
+{
+    NS_LOG_FUNCTION(this << httpClient << packet);
+
+    uint32_t contentLength;
+    VerifyObject(packet, contentLength);
+    m_numOfMainObjects++;
+}
+
+void
+ThreeGppHttpSatelliteTestCase::ClientRxEmbeddedObjectCallback(
+    Ptr<const ThreeGppHttpSatelliteClient> httpClient,
+    Ptr<const Packet> packet)
+{
+    NS_LOG_FUNCTION(this << httpClient << packet);
+
+    uint32_t contentLength;
+    VerifyObject(packet, contentLength);
+    m_rxEmbeddedObjectSizes.push_back(contentLength);
+    m_rxEmbeddedObjectsPerPage[m_numOfPages]++;
+}
+
+void
+ThreeGppHttpSatelliteTestCase::ClientStateTransitionCallback(
+    ThreeGppHttpSatelliteClient::State_t oldState,
+    ThreeGppHttpSatelliteClient::State_t newState)
+{
+    NS_LOG_FUNCTION(this << ThreeGppHttpSatelliteClient::GetStateString(oldState)
+                         << ThreeGppHttpSatelliteClient::GetStateString(newState));
+
+    if (newState == ThreeGppHttpSatelliteClient::READING)
+    {
+        m_numOfPages++;
+        NS_LOG_INFO(this << " web page " << m_numOfPages << " completed at "
+                         << Simulator::Now().GetSeconds() << "s");
+
+        if (m_numOfPages == m_numOfEmbeddedObjects.size())
+        {
+            Simulator::Stop();
+        }
+    }
+}
+
+void
+ThreeGppHttpSatelliteTestCase::VerifyObject(Ptr<const Packet> packet, uint32_t& contentLength)
+{
+    static const uint32_t httpHeaderSize = ThreeGppHttpHeader().GetSerializedSize();
+
+    contentLength = 0;
+    NS_TEST_ASSERT_MSG_EQ((packet != nullptr), true, "An object is received with excess bytes");
+    NS_TEST_ASSERT_MSG_GT_OR_EQ(packet->GetSize(),
+                                httpHeaderSize,
+                                "An object is received without its header");
+
+    ThreeGppHttpHeader httpHeader;
+    packet->PeekHeader(httpHeader);
+    contentLength = httpHeader.GetContentLength();
+    NS_TEST_ASSERT_MSG_EQ(packet->GetSize() - httpHeaderSize,
+                          contentLength,
+                          "The size of a received object differs from its content length");
+}
+
+/**
+ * @ingroup http
+ * @brief Verifies that ThreeGppHttpSatelliteClient fetches the embedded objects
+ *        of a web page over a pool of parallel connections.
+ *
+ * Web pages of 6, 0, and 3 embedded objects are fetched with at most 4
+ * connections, so the client is expected to open 3 and 2 additional
+ * connections for the first and the last web page, and to close them in
+ * between.
+ *
+ * Optionally, the server closes the first additional connection while its
+ * embedded object is still being sent. The object is then expected to be
+ * requested again on the remaining connections, and the web page to be
+ * completed nevertheless.
+ */
+class ThreeGppHttpSatellitePoolTestCase : public ThreeGppHttpSatelliteTestCase
+{
+  public:
+    /**
+     * @brief Construct a new test case.
+     * @param name the test case name, which will be printed on the report
+     * @param isClosingMidPage whether the server closes a connection in the
+     *                         middle of the first web page
+     */
+    ThreeGppHttpSatellitePoolTestCase(std::string name, bool isClosingMidPage);
+
+  private:
+    virtual void ConfigureApplications(Ptr<ThreeGppHttpSatelliteClient> client,
+                                       Ptr<ThreeGppHttpSatelliteServer> server);
+    virtual void VerifyResults();
+
+    /**
+     * @brief Connected with `ConnectionEstablished` trace source of the server.
+     *        Schedules CloseServerSocket() for the first additional connection.
+     * @param httpServer the server application
+     * @param socket the socket of the accepted connection
+     */
+    void ConnectionEstablishedCallback(Ptr<const ThreeGppHttpSatelliteServer> httpServer,
+                                       Ptr<Socket> socket);
+
+    /**
+     * @brief Close an accepted connection behind the back of the server, so that
+     *        the rest of the object being sent is never sent.
+     * @param socket the socket of the connection
+     */
+    void CloseServerSocket(Ptr<Socket> socket);
+
+    bool m_isClosingMidPage;
+    /// Number of embedded objects received before the connection was closed.
+    uint32_t m_numOfEmbeddedObjectsBeforeClose;
+    bool m_isClosed;
+
+}; // end of `class ThreeGppHttpSatellitePoolTestCase`
+
+ThreeGppHttpSatellitePoolTestCase::ThreeGppHttpSatellitePoolTestCase(std::string name,
+                                                                     bool isClosingMidPage)
+    : ThreeGppHttpSatelliteTestCase(name, {6, 0, 3}),
+      m_isClosingMidPage(isClosingMidPage),
+      m_numOfEmbeddedObjectsBeforeClose(0),
+      m_isClosed(false)
+{
+    NS_LOG_FUNCTION(this << name << isClosingMidPage);
+
+    // Larger than the transmit buffer, so a closed connection cuts an object off.
+    m_embeddedObjectSizes.assign(10, 400000);
+}
+
+void
+ThreeGppHttpSatellitePoolTestCase::ConfigureApplications(Ptr<ThreeGppHttpSatelliteClient> client,
+                                                         Ptr<ThreeGppHttpSatelliteServer> server)
+{
+    NS_LOG_FUNCTION(this << client << server);
+
+    client->SetAttribute("MaxParallelConnections", UintegerValue(4));
+
+    if (m_isClosingMidPage)
+    {
+        server->TraceConnectWithoutContext(
+            "ConnectionEstablished",
+            MakeCallback(&ThreeGppHttpSatellitePoolTestCase::ConnectionEstablishedCallback, this));
+    }
+}
+
+void
+ThreeGppHttpSatellitePoolTestCase::VerifyResults()
+{
+    NS_LOG_FUNCTION(this << GetName());
+
+    // The primary connection, then 3 and 2 additional connections.
+    NS_TEST_ASSERT_MSG_EQ(m_serverSockets.size(), 6, "Unexpected number of connections");
+
+    if (m_isClosingMidPage)
+    {
+        NS_TEST_ASSERT_MSG_EQ(m_isClosed, true, "The connection has not been closed");
+        NS_TEST_ASSERT_MSG_LT(m_numOfEmbeddedObjectsBeforeClose,
+                              m_numOfEmbeddedObjects[0],
+                              "The connection has been closed after the first web page");
+        // The object cut off by the closed connection is requested once more.
+        NS_TEST_ASSERT_MSG_EQ(m_numOfEmbeddedObjectRequests,
+                              10,
+                              "Unexpected number of embedded object requests");
+        NS_TEST_ASSERT_MSG_EQ(m_numOfEmbeddedObjectsGenerated,
+                              10,
+                              "Unexpected number of embedded objects generated");
+    }
+    else
+    {
+        NS_TEST_ASSERT_MSG_EQ(m_numOfEmbeddedObjectRequests,
+                              9,
+                              "Unexpected number of embedded object requests");
+        NS_TEST_ASSERT_MSG_EQ(m_numOfEmbeddedObjectsGenerated,
+                              9,
+                              "Unexpected number of embedded objects generated");
+    }
+}
+
+void
+ThreeGppHttpSatellitePoolTestCase::ConnectionEstablishedCallback(
+    Ptr<const ThreeGppHttpSatelliteServer> httpServer,
+    Ptr<Socket> socket)
+{
+    NS_LOG_FUNCTION(this << httpServer << socket);
+
+    if (m_serverSockets.size() == 2)
+    {
+        // Give the request time to arrive, but not the whole object to be sent.
+        Simulator::Schedule(MilliSeconds(50),
+                            &ThreeGppHttpSatellitePoolTestCase::CloseServerSocket,
+                            this,
+                            socket);
+    }
+}
+
+void
+ThreeGppHttpSatellitePoolTestCase::CloseServerSocket(Ptr<Socket> socket)
+{
+    NS_LOG_FUNCTION(this << socket);
+
+    socket->SetRecvCallback(MakeNullCallback<void, Ptr<Socket>>());
+    socket->SetSendCallback(MakeNullCallback<void, Ptr<Socket>, uint32_t>());
+    socket->Close();
+    m_isClosed = true;
+    m_numOfEmbeddedObjectsBeforeClose = m_rxEmbeddedObjectSizes.size();
+}
+
+/**
+ * @ingroup http
+ * @brief Verifies that ThreeGppHttpSatelliteClient in `PIPELINED` request mode
+ *        and the queueing ThreeGppHttpSatelliteServer exchange every object
+ *        over a single connection, in the order of the requests.
+ *
+ * The TCP segment size is chosen so that the byte stream of the requests is
+ * cut in the middle of a ThreeGppHttpHeader. The server is then expected to
+ * keep the first part of the header until the rest arrives, and the client
+ * to find the boundaries of the back-to-back responses likewise.
+ */
+class ThreeGppHttpSatellitePipeliningTestCase : public ThreeGppHttpSatelliteTestCase
+{
+  public:
+    /**
+     * @brief Construct a new test case.
+     * @param name the test case name, which will be printed on the report
+     */
+    ThreeGppHttpSatellitePipeliningTestCase(std::string name);
+
+  private:
+    virtual void ConfigureApplications(Ptr<ThreeGppHttpSatelliteClient> client,
+                                       Ptr<ThreeGppHttpSatelliteServer> server);
+    virtual void VerifyResults();
+    virtual void DoTeardown();
+
+    /**
+     * @brief Connected with `Tx` trace source of the client.
+     * @param packet the request packet
+     */
+    void ClientTxCallback(Ptr<const Packet> packet);
+
+    /**
+     * @brief Connected with `Rx` trace source of the server.
+     * @param packet the received packet
+     * @param from the address of the client
+     */
+    void ServerRxCallback(Ptr<const Packet> packet, const Address& from);
+
+    /// Size of every request sent by the client, in order.
+    std::vector<uint32_t> m_requestSizes;
+    /// Size of every packet received by the server, in order.
+    std::vector<uint32_t> m_serverRxSizes;
+
+}; // end of `class ThreeGppHttpSatellitePipeliningTestCase`
+
+ThreeGppHttpSatellitePipeliningTestCase::ThreeGppHttpSatellitePipeliningTestCase(std::string name)
+    : ThreeGppHttpSatelliteTestCase(name, {5, 2})
+{
+    NS_LOG_FUNCTION(this << name);
+
+    const uint32_t sizes[7] = {1000, 3333, 50, 12000, 7, 2500, 600};
+    m_embeddedObjectSizes.assign(sizes, sizes + 7);
+}
+
+void
+ThreeGppHttpSatellitePipeliningTestCase::ConfigureApplications(
+    Ptr<ThreeGppHttpSatelliteClient> client,
+    Ptr<ThreeGppHttpSatelliteServer> server)
+{
+    NS_LOG_FUNCTION(this << client << server);
+
+    // Slightly longer than a request, so that the next request header is cut.
+    Config::SetDefault("ns3::TcpSocket::SegmentSize", UintegerValue(380));
+
+    client->SetAttribute("RequestMode", EnumValue(ThreeGppHttpSatelliteClient::PIPELINED));
+    client->TraceConnectWithoutContext(
+        "Tx",
+        MakeCallback(&ThreeGppHttpSatellitePipeliningTestCase::ClientTxCallback, this));
+    server->TraceConnectWithoutContext(
+        "Rx",
+        MakeCallback(&ThreeGppHttpSatellitePipeliningTestCase::ServerRxCallback, this));
+}
+
+void
+ThreeGppHttpSatellitePipeliningTestCase::VerifyResults()
+{
+    NS_LOG_FUNCTION(this << GetName());
+
+    static const uint32_t httpHeaderSize = ThreeGppHttpHeader().GetSerializedSize();
+
+    NS_TEST_ASSERT_MSG_EQ(m_serverSockets.size(), 1, "Unexpected number of connections");
+    NS_TEST_ASSERT_MSG_EQ(m_numOfEmbeddedObjectRequests,
+                          7,
+                          "Unexpected number of embedded object requests");
+
+    // The responses follow the order of the requests.
+    NS_TEST_ASSERT_MSG_EQ(m_rxEmbeddedObjectSizes.size(),
+                          m_embeddedObjectSizes.size(),
+                          "Unexpected number of embedded objects");
+    for (uint32_t i = 0; i < m_embeddedObjectSizes.size(); i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(m_rxEmbeddedObjectSizes[i],
+                              m_embeddedObjectSizes[i],
+                              "Embedded object " << i << " is received out of order");
+    }
+
+    // Find a packet which ends in the middle of a request header.
+    bool isHeaderSplit = false;
+    uint64_t requestStart = 0;
+    uint32_t request = 0;
+    uint64_t rxEnd = 0;
+    for (uint32_t i = 0; i < m_serverRxSizes.size() && request < m_requestSizes.size(); i++)
+    {
+        rxEnd += m_serverRxSizes[i];
+        while (request < m_requestSizes.size() && requestStart + m_requestSizes[request] <= rxEnd)
+        {
+            requestStart += m_requestSizes[request];
+            request++;
+        }
+
+        if (rxEnd > requestStart && rxEnd < requestStart + httpHeaderSize)
+        {
+            isHeaderSplit = true;
+        }
+    }
+
+    NS_TEST_ASSERT_MSG_EQ(isHeaderSplit, true, "No request header is split across segments");
+}
+
+void
+ThreeGppHttpSatellitePipeliningTestCase::DoTeardown()
+{
+    NS_LOG_FUNCTION(this << GetName());
+    Config::SetDefault("ns3::TcpSocket::SegmentSize", UintegerValue(536));
+}
+
+void
+ThreeGppHttpSatellitePipeliningTestCase::ClientTxCallback(Ptr<const Packet> packet)
+{
+    NS_LOG_FUNCTION(this << packet << packet->GetSize());
+    m_requestSizes.push_back(packet->GetSize());
+}
+
+void
+ThreeGppHttpSatellitePipeliningTestCase::ServerRxCallback(Ptr<const Packet> packet,
+                                                          const Address& from)
+{
+    NS_LOG_FUNCTION(this << packet << packet->GetSize() << from);
+    m_serverRxSizes.push_back(packet->GetSize());
+}
+
+/**
+ * @ingroup http
+ * @brief Verifies that ThreeGppHttpSatelliteClient in `MULTIPLEXED` request
+ *        mode and ThreeGppHttpSatelliteServer with `Multiplexing` enabled
+ *        exchange every object in its own stream over a single connection.
+ *
+ * Every packet sent by the server is expected to be a frame which begins with
+ * a ThreeGppHttpStreamHeader and is not longer than `FrameSize`. The first
+ * embedded object of the first web page is much larger than the others, and
+ * the transmit buffer is small, so the frames of the smaller objects are
+ * expected to be interleaved with it and the large object to complete last.
+ */
+class ThreeGppHttpSatelliteMultiplexingTestCase : public ThreeGppHttpSatelliteTestCase
+{
+  public:
+    /**
+     * @brief Construct a new test case.
+     * @param name the test case name, which will be printed on the report
+     */
+    ThreeGppHttpSatelliteMultiplexingTestCase(std::string name);
+
+  private:
+    virtual void ConfigureApplications(Ptr<ThreeGppHttpSatelliteClient> client,
+                                       Ptr<ThreeGppHttpSatelliteServer> server);
+    virtual void VerifyResults();
+    virtual void DoTeardown();
+
+    /**
+     * @brief Connected with `Tx` trace source of the server.
+     * @param packet the sent frame
+     */
+    void ServerTxCallback(Ptr<const Packet> packet);
+
+    /// The stream IDs of the frames sent by the server.
+    std::set<uint32_t> m_streamIds;
+
+}; // end of `class ThreeGppHttpSatelliteMultiplexingTestCase`
+
+/// The `FrameSize` attribute of the server in ThreeGppHttpSatelliteMultiplexingTestCase.
+static const uint32_t THREE_GPP_HTTP_SATELLITE_TEST_FRAME_SIZE = 1000;
+
+ThreeGppHttpSatelliteMultiplexingTestCase::ThreeGppHttpSatelliteMultiplexingTestCase(
+    std::string name)
+    : ThreeGppHttpSatelliteTestCase(name, {4, 3})
+{
+    NS_LOG_FUNCTION(this << name);
+
+    const uint32_t sizes[7] = {20000, 100, 200, 300, 5000, 5000, 5000};
+    m_embeddedObjectSizes.assign(sizes, sizes + 7);
+}
+
+void
+ThreeGppHttpSatelliteMultiplexingTestCase::ConfigureApplications(
+    Ptr<ThreeGppHttpSatelliteClient> client,
+    Ptr<ThreeGppHttpSatelliteServer> server)
+{
+    NS_LOG_FUNCTION(this << client << server);
+
+    // A few frames at a time, so that the later requests find the large object unfinished.
+    Config::SetDefault("ns3::TcpSocket::SndBufSize", UintegerValue(4000));
+
+    client->SetAttribute("RequestMode", EnumValue(ThreeGppHttpSatelliteClient::MULTIPLEXED));
+    server->SetAttribute("Multiplexing", BooleanValue(true));
+    server->SetAttribute("FrameSize", UintegerValue(THREE_GPP_HTTP_SATELLITE_TEST_FRAME_SIZE));
+    server->TraceConnectWithoutContext(
+        "Tx",
+        MakeCallback(&ThreeGppHttpSatelliteMultiplexingTestCase::ServerTxCallback, this));
+}
+
+void
+ThreeGppHttpSatelliteMultiplexingTestCase::VerifyResults()
+{
+    NS_LOG_FUNCTION(this << GetName());
+
+    NS_TEST_ASSERT_MSG_EQ(m_serverSockets.size(), 1, "Unexpected number of connections");
+
+    // A stream for the main object and for each embedded object of both web pages.
+    NS_TEST_ASSERT_MSG_EQ(m_streamIds.size(), 9, "Unexpected number of streams");
+
+    std::vector<uint32_t> expectedSizes = m_embeddedObjectSizes;
+    std::vector<uint32_t> rxSizes = m_rxEmbeddedObjectSizes;
+    std::sort(expectedSizes.begin(), expectedSizes.end());
+    std::sort(rxSizes.begin(), rxSizes.end());
+    NS_TEST_ASSERT_MSG_EQ((rxSizes == expectedSizes),
+                          true,
+                          "The received embedded objects differ from the generated ones");
+
+    NS_TEST_ASSERT_MSG_EQ(m_rxEmbeddedObjectSizes[m_numOfEmbeddedObjects[0] - 1],
+                          m_embeddedObjectSizes[0],
+                          "The large object has held back the smaller ones");
+}
+
+void
+ThreeGppHttpSatelliteMultiplexingTestCase::DoTeardown()
+{
+    NS_LOG_FUNCTION(this << GetName());
+    Config::SetDefault("ns3::TcpSocket::SndBufSize", UintegerValue(131072));
+}
+
+void
+ThreeGppHttpSatelliteMultiplexingTestCase::ServerTxCallback(Ptr<const Packet> packet)
+{
+    NS_LOG_FUNCTION(this << packet << packet->GetSize());
+
+    static const uint32_t streamHeaderSize = ThreeGppHttpStreamHeader::GetStaticSerializedSize();
+    NS_TEST_ASSERT_MSG_GT_OR_EQ(packet->GetSize(),
+                                streamHeaderSize,
+                                "A frame is shorter than its header");
+
+    ThreeGppHttpStreamHeader streamHeader;
+    packet->PeekHeader(streamHeader);
+    NS_TEST_ASSERT_MSG_EQ(streamHeader.GetFrameLength(),
+                          packet->GetSize() - streamHeaderSize,
+                          "The frame length differs from the size of the frame");
+    NS_TEST_ASSERT_MSG_LT_OR_EQ(streamHeader.GetFrameLength(),
+                                THREE_GPP_HTTP_SATELLITE_TEST_FRAME_SIZE,
+                                "A frame is longer than the frame size");
+    m_streamIds.insert(streamHeader.GetStreamId());
+}
+
+/**
+ * @ingroup http
+ * @brief Verifies the `KeepAlive` and `IdleTimeout` attributes of
+ *        ThreeGppHttpSatelliteClient.
+ *
+ * Three web pages of 3 embedded objects each are fetched with at most 3
+ * connections. The first reading time is shorter than the idle timeout and
+ * the second one is longer, so the idle timeout, if enabled, closes every
+ * connection once, and the primary connection is expected to be opened again
+ * before the last web page. The test case verifies the number of connections
+ * accepted by the server and the number of connections closed by the idle
+ * timeout, which reports each of them with the `ConnectionClosed` trace source.
+ */
+class ThreeGppHttpSatelliteKeepAliveTestCase : public ThreeGppHttpSatelliteTestCase
+{
+  public:
+    /**
+     * @brief Construct a new test case.
+     * @param name the test case name, which will be printed on the report
+     * @param isKeepAlive the `KeepAlive` attribute of the client
+     * @param idleTimeout the `IdleTimeout` attribute of the client
+     * @param numOfConnections the expected number of connections accepted by
+     *                         the server
+     */
+    ThreeGppHttpSatelliteKeepAliveTestCase(std::string name,
+                                           bool isKeepAlive,
+                                           Time idleTimeout,
+                                           uint32_t numOfConnections);
+
+  private:
+    virtual void ConfigureApplications(Ptr<ThreeGppHttpSatelliteClient> client,
+                                       Ptr<ThreeGppHttpSatelliteServer> server);
+    virtual void VerifyResults();
+
+    /**
+     * @brief Connected with `ConnectionClosed` trace source of the client.
+     * @param httpClient the client application
+     */
+    void ConnectionClosedCallback(Ptr<const ThreeGppHttpSatelliteClient> httpClient);
+
+    bool m_isKeepAlive;
+    Time m_idleTimeout;
+    uint32_t m_numOfConnections;
+    /// Number of `ConnectionClosed` traces of the client.
+    uint32_t m_numOfClosedConnections;
+
+}; // end of `class ThreeGppHttpSatelliteKeepAliveTestCase`
+
+ThreeGppHttpSatelliteKeepAliveTestCase::ThreeGppHttpSatelliteKeepAliveTestCase(
+    std::string name,
+    bool isKeepAlive,
+    Time idleTimeout,
+    uint32_t numOfConnections)
+    : ThreeGppHttpSatelliteTestCase(name, {3, 3, 3}),
+      m_isKeepAlive(isKeepAlive),
+      m_idleTimeout(idleTimeout),
+      m_numOfConnections(numOfConnections),
+      m_numOfClosedConnections(0)
+{
+    NS_LOG_FUNCTION(this << name << isKeepAlive << idleTimeout.GetSeconds() << numOfConnections);
+
+    m_embeddedObjectSizes.assign(9, 20000);
+    m_readingTimes[0] = MilliSeconds(500);
+    m_readingTimes[1] = Seconds(5);
+}
+
+void
+ThreeGppHttpSatelliteKeepAliveTestCase::ConfigureApplications(
+    Ptr<ThreeGppHttpSatelliteClient> client,
+    Ptr<ThreeGppHttpSatelliteServer> server)
+{
+    NS_LOG_FUNCTION(this << client << server);
+
+    client->SetAttribute("MaxParallelConnections", UintegerValue(3));
+    client->SetAttribute("KeepAlive", BooleanValue(m_isKeepAlive));
+    client->SetAttribute("IdleTimeout", TimeValue(m_idleTimeout));
+    client->TraceConnectWithoutContext(
+        "ConnectionClosed",
+        MakeCallback(&ThreeGppHttpSatelliteKeepAliveTestCase::ConnectionClosedCallback, this));
+}
+
+void
+ThreeGppHttpSatelliteKeepAliveTestCase::VerifyResults()
+{
+    NS_LOG_FUNCTION(this << GetName());
+
+    NS_TEST_ASSERT_MSG_EQ(m_serverSockets.size(),
+                          m_numOfConnections,
+                          "Unexpected number of connections");
+    NS_TEST_ASSERT_MSG_EQ(m_numOfEmbeddedObjectRequests,
+                          9,
+                          "Unexpected number of embedded object requests");
+
+    /*
+     * Only the idle timeout fires the trace, after the second web page. With
+     * keep-alive, it closes the whole pool of 3 connections; otherwise the
+     * parallel connections are already gone and only the primary one is left.
+     */
+    const uint32_t numOfIdleConnections = m_isKeepAlive ? 3 : 1;
+    NS_TEST_ASSERT_MSG_EQ(m_numOfClosedConnections,
+                          (m_idleTimeout.IsZero() ? 0 : numOfIdleConnections),
+                          "Unexpected number of connections closed by the idle timeout");
+}
+
+void
+ThreeGppHttpSatelliteKeepAliveTestCase::ConnectionClosedCallback(
+    Ptr<const ThreeGppHttpSatelliteClient> httpClient)
+{
+    NS_LOG_FUNCTION(this << httpClient);
+    m_numOfClosedConnections++;
+}
+
+/**
+ * @brief Test suite `three-gpp-http-satellite`, verifying the connection pool,
+ *        the request modes, and the connection management of
+ *        ThreeGppHttpSatelliteClient together with ThreeGppHttpSatelliteServer.
+ */
+class ThreeGppHttpSatelliteTestSuite : public TestSuite
+{
+  public:
+    ThreeGppHttpSatelliteTestSuite();
+};
+
+ThreeGppHttpSatelliteTestSuite::ThreeGppHttpSatelliteTestSuite()
+    : TestSuite("three-gpp-http-satellite", Type::SYSTEM)
+{
+    AddTestCase(new ThreeGppHttpSatellitePoolTestCase("pool", false), TestCase::Duration::QUICK);
+    AddTestCase(new ThreeGppHttpSatellitePoolTestCase("pool, connection closed mid-page", true),
+                TestCase::Duration::QUICK);
+    AddTestCase(new ThreeGppHttpSatellitePipeliningTestCase("pipelining"),
+                TestCase::Duration::QUICK);
+    AddTestCase(new ThreeGppHttpSatelliteMultiplexingTestCase("multiplexing"),
+                TestCase::Duration::QUICK);
+
+    /*
+     * Each web page takes 3 connections. Without keep-alive, the 2 additional
+     * connections are opened again for the second and the third web page. The
+     * idle timeout closes every connection before the third web page.
+     */
+    AddTestCase(new ThreeGppHttpSatelliteKeepAliveTestCase("no keep-alive", false, Seconds(0), 7),
+                TestCase::Duration::QUICK);
+    AddTestCase(new ThreeGppHttpSatelliteKeepAliveTestCase("keep-alive", true, Seconds(0), 3),
+                TestCase::Duration::QUICK);
+    AddTestCase(new ThreeGppHttpSatelliteKeepAliveTestCase("no keep-alive, idle timeout",
+                                                           false,
+                                                           Seconds(2),
+                                                           8),
+                TestCase::Duration::QUICK);
+    AddTestCase(new ThreeGppHttpSatelliteKeepAliveTestCase("keep-alive, idle timeout",
+                                                           true,
+                                                           Seconds(2),
+                                                           6),
+                TestCase::Duration::QUICK);
+
+} // end of `ThreeGppHttpSatelliteTestSuite ()`
+
+static ThreeGppHttpSatelliteTestSuite g_threeGppHttpSatelliteTestSuiteInstance;
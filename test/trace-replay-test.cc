@@ -0,0 +1,573 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+
+/**
+ * @file trace-replay-test.cc
+ * @ingroup traffic
+ * @brief Test cases for trace replay, grouped in `trace-replay` test suite.
+ */
+
+#include "ns3/address.h"
+#include "ns3/application-container.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-interface-container.h"
+#include "ns3/log.h"
+#include "ns3/net-device-container.h"
+#include "ns3/node-container.h"
+#include "ns3/nstime.h"
+#include "ns3/packet-sink-helper.h"
+#include "ns3/packet-sink.h"
+#include "ns3/packet.h"
+#include "ns3/simple-channel.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/trace-replay-application.h"
+#include "ns3/trace-replay-file.h"
+#include "ns3/traffic-source.h"
+#include "ns3/traffic-time-tag.h"
+#include "ns3/uinteger.h"
+
+#include <sstream>
+#include <utility>
+#include <vector>
+
+NS_LOG_COMPONENT_DEFINE("TraceReplayTest");
+
+using namespace ns3;
+
+/// Text trace used by every test case, with its heading and a comment.
+static const char* const TRACE_REPLAY_TEST_TEXT = "time,size\n"
+                                                  "# captured on a test bench\n"
+                                                  "0.5,100\n"
+                                                  "0.75,200\n"
+                                                  "\n"
+                                                  "1.0 300\n"
+                                                  "1.0,0\n"
+                                                  "2.5,400\n";
+
+/// Number of records in #TRACE_REPLAY_TEST_TEXT.
+static const uint32_t TRACE_REPLAY_TEST_N_RECORDS = 5;
+
+/// Time of each record in #TRACE_REPLAY_TEST_TEXT, relative to the first record, in ms.
+static const int64_t TRACE_REPLAY_TEST_TIMES_MS[TRACE_REPLAY_TEST_N_RECORDS] =
+    {0, 250, 500, 500, 2000};
+
+/// Packet size of each record in #TRACE_REPLAY_TEST_TEXT.
+static const uint32_t TRACE_REPLAY_TEST_SIZES[TRACE_REPLAY_TEST_N_RECORDS] =
+    {100, 200, 300, 0, 400};
+
+/**
+ * @ingroup traffic
+ * @brief Verifies that a text trace converted by
+ *        TraceReplayFile::ConvertFromText() is read back by TraceReplayFile.
+ *
+ * The heading, the comment and the empty line of the text trace are skipped,
+ * the timestamps become relative to the first record, and Open() shares the
+ * mapping of a file which is already open.
+ */
+class TraceReplayFileTestCase : public TestCase
+{
+  public:
+    /// Construct a new test case.
+    TraceReplayFileTestCase();
+
+  private:
+    virtual void DoRun();
+
+}; // end of `class TraceReplayFileTestCase`
+
+TraceReplayFileTestCase::TraceReplayFileTestCase()
+    : TestCase("convert a text trace and read it back")
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+TraceReplayFileTestCase::DoRun()
+{
+    NS_LOG_FUNCTION(this << GetName());
+
+    const std::string path = CreateTempDirFilename("trace-replay-file-test.bin");
+    std::istringstream input(TRACE_REPLAY_TEST_TEXT);
+    NS_TEST_ASSERT_MSG_EQ(TraceReplayFile::ConvertFromText(input, path),
+                          TRACE_REPLAY_TEST_N_RECORDS,
+                          "Unexpected number of converted records");
+
+    Ptr<TraceReplayFile> file = TraceReplayFile::Open(path);
+    NS_TEST_ASSERT_MSG_EQ(file->GetNRecords(),
+                          TRACE_REPLAY_TEST_N_RECORDS,
+                          "Unexpected number of mapped records");
+
+    for (uint32_t i = 0; i < TRACE_REPLAY_TEST_N_RECORDS; i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(file->GetTime(i),
+                              MilliSeconds(TRACE_REPLAY_TEST_TIMES_MS[i]),
+                              "Unexpected time of record " << i);
+        NS_TEST_ASSERT_MSG_EQ(file->GetSize(i),
+                              TRACE_REPLAY_TEST_SIZES[i],
+                              "Unexpected size of record " << i);
+    }
+
+    Ptr<TraceReplayFile> sharedFile = TraceReplayFile::Open(path);
+    NS_TEST_ASSERT_MSG_EQ((PeekPointer(sharedFile) == PeekPointer(file)),
+                          true,
+                          "The mapping of an open file is not shared");
+
+} // end of `void DoRun ()`
+
+/**
+ * @ingroup traffic
+ * @brief Verifies that TraceReplayFile::ConvertFromText() skips the lines
+ *        with an invalid packet size or a decreasing timestamp.
+ *
+ * The rejected lines are interleaved with valid ones, including a first line
+ * which is rejected before any record is written, so that it must not become
+ * the reference of the relative timestamps. Only the valid lines are
+ * expected in the binary trace.
+ */
+class TraceReplayRejectedLineTestCase : public TestCase
+{
+  public:
+    /// Construct a new test case.
+    TraceReplayRejectedLineTestCase();
+
+  private:
+    virtual void DoRun();
+
+}; // end of `class TraceReplayRejectedLineTestCase`
+
+TraceReplayRejectedLineTestCase::TraceReplayRejectedLineTestCase()
+    : TestCase("skip the lines with an invalid size or a decreasing timestamp")
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+TraceReplayRejectedLineTestCase::DoRun()
+{
+    NS_LOG_FUNCTION(this << GetName());
+
+    const std::string path = CreateTempDirFilename("trace-replay-rejected-test.bin");
+    std::istringstream input("0.1,-5\n"          // negative size, before the first record
+                             "0.5,100\n"         // the first record
+                             "0.75,5000000000\n" // size beyond 32 bits
+                             "1.0,200\n"
+                             "0.9,300\n"         // earlier than the previous record
+                             "0.25,400\n"        // earlier than the first record
+                             "1.0,500\n");       // equal timestamps are accepted
+    NS_TEST_ASSERT_MSG_EQ(TraceReplayFile::ConvertFromText(input, path),
+                          3,
+                          "The rejected lines must not be converted");
+
+    Ptr<TraceReplayFile> file = TraceReplayFile::Open(path);
+    NS_TEST_ASSERT_MSG_EQ(file->GetNRecords(), 3, "Unexpected number of mapped records");
+
+    const int64_t timesMs[3] = {0, 500, 500};
+    const uint32_t sizes[3] = {100, 200, 500};
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(file->GetTime(i),
+                              MilliSeconds(timesMs[i]),
+                              "Unexpected time of record " << i);
+        NS_TEST_ASSERT_MSG_EQ(file->GetSize(i), sizes[i], "Unexpected size of record " << i);
+    }
+
+} // end of `void DoRun ()`
+
+/**
+ * @ingroup traffic
+ * @brief Verifies the packet sizes and send times of TraceReplayApplication.
+ *
+ * The application replays a converted trace over UDP towards a PacketSink.
+ * Every record from `FirstRecord` onwards, except the empty one, is expected
+ * to be sent with its size, `TimeShift` after the application has started
+ * plus the time of the record relative to the first replayed record.
+ */
+class TraceReplayApplicationTestCase : public TestCase
+{
+  public:
+    /**
+     * @brief Construct a new test case.
+     * @param name the test case name, which will be printed on the report
+     * @param firstRecord the `FirstRecord` attribute of the application
+     * @param timeShift the `TimeShift` attribute of the application
+     */
+    TraceReplayApplicationTestCase(std::string name, uint64_t firstRecord, Time timeShift);
+
+  private:
+    virtual void DoRun();
+
+    /**
+     * @brief Record the time and the size of a sent packet.
+     * @param packet the sent packet
+     */
+    void TxCallback(Ptr<const Packet> packet);
+
+    uint64_t m_firstRecord;
+    Time m_timeShift;
+    /// Time and size of every sent packet.
+    std::vector<std::pair<Time, uint32_t>> m_sent;
+
+}; // end of `class TraceReplayApplicationTestCase`
+
+TraceReplayApplicationTestCase::TraceReplayApplicationTestCase(std::string name,
+                                                               uint64_t firstRecord,
+                                                               Time timeShift)
+    : TestCase(name),
+      m_firstRecord(firstRecord),
+      m_timeShift(timeShift)
+{
+    NS_LOG_FUNCTION(this << name << firstRecord << timeShift.GetSeconds());
+}
+
+void
+TraceReplayApplicationTestCase::DoRun()
+{
+    NS_LOG_FUNCTION(this << GetName());
+
+    const std::string path = CreateTempDirFilename("trace-replay-application-test.bin");
+    std::istringstream input(TRACE_REPLAY_TEST_TEXT);
+    TraceReplayFile::ConvertFromText(input, path);
+
+    NodeContainer nodes;
+    nodes.Create(2);
+
+    InternetStackHelper internet;
+    internet.Install(nodes);
+
+    Ptr<SimpleNetDevice> txDev = CreateObject<SimpleNetDevice>();
+    Ptr<SimpleNetDevice> rxDev = CreateObject<SimpleNetDevice>();
+    nodes.Get(0)->AddDevice(txDev);
+    nodes.Get(1)->AddDevice(rxDev);
+    Ptr<SimpleChannel> channel = CreateObject<SimpleChannel>();
+    txDev->SetChannel(channel);
+    rxDev->SetChannel(channel);
+    NetDeviceContainer devices;
+    devices.Add(txDev);
+    devices.Add(rxDev);
+
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = ipv4.Assign(devices);
+
+    const uint16_t port = 4000;
+    PacketSinkHelper sinkHelper("ns3::UdpSocketFactory",
+                                InetSocketAddress(Ipv4Address::GetAny(), port));
+    ApplicationContainer sinkApps = sinkHelper.Install(nodes.Get(1));
+
+    const Time startTime = Seconds(1);
+    Ptr<TraceReplayApplication> replay = CreateObject<TraceReplayApplication>();
+    replay->SetAttribute("TraceFile", StringValue(path));
+    replay->SetAttribute("Remote", AddressValue(InetSocketAddress(interfaces.GetAddress(1), port)));
+    replay->SetAttribute("FirstRecord", UintegerValue(m_firstRecord));
+    replay->SetAttribute("TimeShift", TimeValue(m_timeShift));
+    replay->SetStartTime(startTime);
+    replay->TraceConnectWithoutContext(
+        "Tx",
+        MakeCallback(&TraceReplayApplicationTestCase::TxCallback, this));
+    nodes.Get(0)->AddApplication(replay);
+
+    Simulator::Stop(Seconds(10));
+    Simulator::Run();
+
+    // The expected packets, from the first replayed record onwards.
+    std::vector<std::pair<Time, uint32_t>> expected;
+    uint64_t expectedBytes = 0;
+    for (uint64_t i = m_firstRecord; i < TRACE_REPLAY_TEST_N_RECORDS; i++)
+    {
+        if (TRACE_REPLAY_TEST_SIZES[i] > 0)
+        {
+            const Time offset = MilliSeconds(TRACE_REPLAY_TEST_TIMES_MS[i] -
+                                             TRACE_REPLAY_TEST_TIMES_MS[m_firstRecord]);
+            expected.push_back(
+                std::make_pair(startTime + m_timeShift + offset, TRACE_REPLAY_TEST_SIZES[i]));
+            expectedBytes += TRACE_REPLAY_TEST_SIZES[i];
+        }
+    }
+
+    NS_TEST_ASSERT_MSG_EQ(m_sent.size(), expected.size(), "Unexpected number of sent packets");
+    for (uint32_t i = 0; i < expected.size(); i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(m_sent[i].first,
+                              expected[i].first,
+                              "Packet " << i << " is sent at an unexpected time");
+        NS_TEST_ASSERT_MSG_EQ(m_sent[i].second,
+                              expected[i].second,
+                              "Packet " << i << " has an unexpected size");
+    }
+
+    NS_TEST_ASSERT_MSG_EQ(replay->GetSent(), expectedBytes, "Unexpected number of sent bytes");
+    Ptr<PacketSink> sink = DynamicCast<PacketSink>(sinkApps.Get(0));
+    NS_TEST_ASSERT_MSG_EQ(sink->GetTotalRx(), expectedBytes, "Packets were lost");
+
+    Simulator::Destroy();
+
+} // end of `void DoRun ()`
+
+void
+TraceReplayApplicationTestCase::TxCallback(Ptr<const Packet> packet)
+{
+    NS_LOG_FUNCTION(this << packet << packet->GetSize());
+    m_sent.push_back(std::make_pair(Simulator::Now(), packet->GetSize()));
+}
+
+/**
+ * @ingroup traffic
+ * @brief Verifies the packets sent by TrafficSource with trace and constant
+ *        policies.
+ *
+ * A TraceTrafficSource must send one packet per record of the trace, at the
+ * time and with the size of the record, each with a TrafficTimeTag holding the
+ * time it was sent, and then stop although the application keeps running. A
+ * `TrafficSource<ConstantArrival, ConstantSize, NoTagging>`, which is not
+ * registered by the module, must send untagged packets of `PacketSize` bytes
+ * every `Interval` until it is stopped. Both send to a PacketSink over a
+ * lossless channel.
+ */
+class TrafficSourceTestCase : public TestCase
+{
+  public:
+    /// Construct a new test case.
+    TrafficSourceTestCase();
+
+  private:
+    virtual void DoRun();
+
+    /**
+     * @brief Invoked when the trace source sends a packet.
+     * @param packet the sent packet.
+     */
+    void TraceTxCallback(Ptr<const Packet> packet);
+
+    /**
+     * @brief Invoked when the constant source sends a packet.
+     * @param packet the sent packet.
+     */
+    void ConstantTxCallback(Ptr<const Packet> packet);
+
+    /// Time and size of each packet sent by the trace source.
+    std::vector<std::pair<Time, uint32_t>> m_traceSent;
+
+    /// Time and size of each packet sent by the constant source.
+    std::vector<std::pair<Time, uint32_t>> m_constantSent;
+
+    /// Number of packets of the trace source tagged with their sending time.
+    uint32_t m_nTraceTimeTags;
+
+    /// Number of packets of the constant source with a time tag.
+    uint32_t m_nConstantTimeTags;
+
+}; // end of `class TrafficSourceTestCase`
+
+TrafficSourceTestCase::TrafficSourceTestCase()
+    : TestCase("trace and constant traffic sources"),
+      m_nTraceTimeTags(0),
+      m_nConstantTimeTags(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+TrafficSourceTestCase::DoRun()
+{
+    NS_LOG_FUNCTION(this << GetName());
+
+    const std::string path = CreateTempDirFilename("traffic-source-test.bin");
+    std::istringstream input(TRACE_REPLAY_TEST_TEXT);
+    TraceReplayFile::ConvertFromText(input, path);
+
+    NodeContainer nodes;
+    nodes.Create(2);
+
+    InternetStackHelper internet;
+    internet.Install(nodes);
+
+    Ptr<SimpleNetDevice> txDev = CreateObject<SimpleNetDevice>();
+    Ptr<SimpleNetDevice> rxDev = CreateObject<SimpleNetDevice>();
+    nodes.Get(0)->AddDevice(txDev);
+    nodes.Get(1)->AddDevice(rxDev);
+    Ptr<SimpleChannel> channel = CreateObject<SimpleChannel>();
+    txDev->SetChannel(channel);
+    rxDev->SetChannel(channel);
+    NetDeviceContainer devices;
+    devices.Add(txDev);
+    devices.Add(rxDev);
+
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = ipv4.Assign(devices);
+
+    const uint16_t tracePort = 4000;
+    const uint16_t constantPort = 4001;
+    PacketSinkHelper traceSinkHelper("ns3::UdpSocketFactory",
+                                     InetSocketAddress(Ipv4Address::GetAny(), tracePort));
+    PacketSinkHelper constantSinkHelper("ns3::UdpSocketFactory",
+                                        InetSocketAddress(Ipv4Address::GetAny(), constantPort));
+    ApplicationContainer sinkApps = traceSinkHelper.Install(nodes.Get(1));
+    sinkApps.Add(constantSinkHelper.Install(nodes.Get(1)));
+
+    const Time startTime = Seconds(1);
+    Ptr<TraceTrafficSource> traceSource = CreateObject<TraceTrafficSource>();
+    traceSource->SetAttribute("ArrivalTrace", StringValue(path));
+    traceSource->SetAttribute("SizeTrace", StringValue(path));
+    traceSource->SetAttribute("Remote",
+                              AddressValue(InetSocketAddress(interfaces.GetAddress(1), tracePort)));
+    traceSource->SetStartTime(startTime);
+    traceSource->TraceConnectWithoutContext(
+        "Tx",
+        MakeCallback(&TrafficSourceTestCase::TraceTxCallback, this));
+    nodes.Get(0)->AddApplication(traceSource);
+
+    // Stopped between two packets, so that exactly 4 packets are sent.
+    typedef TrafficSource<ConstantArrival, ConstantSize, NoTagging> UntaggedConstantSource;
+    const Time interval = MilliSeconds(100);
+    const uint32_t packetSize = 300;
+    Ptr<UntaggedConstantSource> constantSource = CreateObject<UntaggedConstantSource>();
+    constantSource->SetAttribute("Interval", TimeValue(interval));
+    constantSource->SetAttribute("PacketSize", UintegerValue(packetSize));
+    constantSource->SetAttribute(
+        "Remote",
+        AddressValue(InetSocketAddress(interfaces.GetAddress(1), constantPort)));
+    constantSource->SetStartTime(startTime);
+    constantSource->SetStopTime(startTime + MilliSeconds(450));
+    constantSource->TraceConnectWithoutContext(
+        "Tx",
+        MakeCallback(&TrafficSourceTestCase::ConstantTxCallback, this));
+    nodes.Get(0)->AddApplication(constantSource);
+
+    Simulator::Stop(Seconds(10));
+    Simulator::Run();
+
+    // The trace source sends every record, including the empty one.
+    uint64_t traceBytes = 0;
+    NS_TEST_ASSERT_MSG_EQ(m_traceSent.size(),
+                          TRACE_REPLAY_TEST_N_RECORDS,
+                          "Unexpected number of packets sent by the trace source");
+    for (uint32_t i = 0; i < TRACE_REPLAY_TEST_N_RECORDS; i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(m_traceSent[i].first,
+                              startTime + MilliSeconds(TRACE_REPLAY_TEST_TIMES_MS[i]),
+                              "Trace packet " << i << " is sent at an unexpected time");
+        NS_TEST_ASSERT_MSG_EQ(m_traceSent[i].second,
+                              TRACE_REPLAY_TEST_SIZES[i],
+                              "Trace packet " << i << " has an unexpected size");
+        traceBytes += TRACE_REPLAY_TEST_SIZES[i];
+    }
+
+    NS_TEST_ASSERT_MSG_EQ(m_nTraceTimeTags,
+                          TRACE_REPLAY_TEST_N_RECORDS,
+                          "Every trace packet should carry its sending time");
+    NS_TEST_ASSERT_MSG_EQ(traceSource->GetSent(),
+                          traceBytes,
+                          "Unexpected number of bytes sent by the trace source");
+    Ptr<PacketSink> traceSink = DynamicCast<PacketSink>(sinkApps.Get(0));
+    NS_TEST_ASSERT_MSG_EQ(traceSink->GetTotalRx(), traceBytes, "Trace packets were lost");
+
+    // The constant source sends one interval after starting, until stopped.
+    NS_TEST_ASSERT_MSG_EQ(m_constantSent.size(),
+                          4,
+                          "Unexpected number of packets sent by the constant source");
+    for (uint32_t i = 0; i < m_constantSent.size(); i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(m_constantSent[i].first,
+                              startTime + interval * (i + 1),
+                              "Constant packet " << i << " is sent at an unexpected time");
+        NS_TEST_ASSERT_MSG_EQ(m_constantSent[i].second,
+                              packetSize,
+                              "Constant packet " << i << " has an unexpected size");
+    }
+
+    NS_TEST_ASSERT_MSG_EQ(m_nConstantTimeTags, 0, "NoTagging should not add a time tag");
+    NS_TEST_ASSERT_MSG_EQ(constantSource->GetSent(),
+                          4 * packetSize,
+                          "Unexpected number of bytes sent by the constant source");
+    Ptr<PacketSink> constantSink = DynamicCast<PacketSink>(sinkApps.Get(1));
+    NS_TEST_ASSERT_MSG_EQ(constantSink->GetTotalRx(),
+                          4 * packetSize,
+                          "Constant packets were lost");
+
+    Simulator::Destroy();
+
+} // end of `void DoRun ()`
+
+void
+TrafficSourceTestCase::TraceTxCallback(Ptr<const Packet> packet)
+{
+    NS_LOG_FUNCTION(this << packet << packet->GetSize());
+    m_traceSent.push_back(std::make_pair(Simulator::Now(), packet->GetSize()));
+
+    TrafficTimeTag timeTag;
+    if (packet->PeekPacketTag(timeTag) && (timeTag.GetSenderTimestamp() == Simulator::Now()))
+    {
+        m_nTraceTimeTags++;
+    }
+}
+
+void
+TrafficSourceTestCase::ConstantTxCallback(Ptr<const Packet> packet)
+{
+    NS_LOG_FUNCTION(this << packet << packet->GetSize());
+    m_constantSent.push_back(std::make_pair(Simulator::Now(), packet->GetSize()));
+
+    TrafficTimeTag timeTag;
+    if (packet->PeekPacketTag(timeTag))
+    {
+        m_nConstantTimeTags++;
+    }
+}
+
+/**
+ * @brief Test suite `trace-replay`, verifying the trace replay application,
+ *        its binary trace file and the policy-based traffic sources.
+ */
+class TraceReplayTestSuite : public TestSuite
+{
+  public:
+    TraceReplayTestSuite();
+};
+
+TraceReplayTestSuite::TraceReplayTestSuite()
+    : TestSuite("trace-replay", Type::UNIT)
+{
+    AddTestCase(new TraceReplayFileTestCase(), TestCase::Duration::QUICK);
+    AddTestCase(new TraceReplayRejectedLineTestCase(), TestCase::Duration::QUICK);
+    AddTestCase(new TraceReplayApplicationTestCase("replay from the start", 0, Seconds(0)),
+                TestCase::Duration::QUICK);
+    AddTestCase(new TraceReplayApplicationTestCase("replay from the second record, shifted",
+                                                   1,
+                                                   MilliSeconds(300)),
+                TestCase::Duration::QUICK);
+    AddTestCase(new TraceReplayApplicationTestCase("replay only the last record, shifted",
+                                                   4,
+                                                   Seconds(1)),
+                TestCase::Duration::QUICK);
+    AddTestCase(new TraceReplayApplicationTestCase("first record beyond the end",
+                                                   TRACE_REPLAY_TEST_N_RECORDS,
+                                                   Seconds(0)),
+                TestCase::Duration::QUICK);
+    AddTestCase(new TrafficSourceTestCase(), TestCase::Duration::QUICK);
+
+} // end of `TraceReplayTestSuite ()`
+
+static TraceReplayTestSuite g_traceReplayTestSuiteInstance;
@@ -0,0 +1,316 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+/**
+ * @file workload-test.cc
+ * @ingroup traffic
+ * @brief Test cases for workload pre-generation, grouped in `workload` test
+ *        suite.
+ */
+
+#include "ns3/application-container.h"
+#include "ns3/application.h"
+#include "ns3/boolean.h"
+#include "ns3/config.h"
+#include "ns3/integer.h"
+#include "ns3/log.h"
+#include "ns3/nrtv-tcp-client.h"
+#include "ns3/nrtv-variables.h"
+#include "ns3/nstime.h"
+#include "ns3/object-factory.h"
+#include "ns3/pointer.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/three-gpp-http-satellite-client.h"
+#include "ns3/three-gpp-http-satellite-variables.h"
+#include "ns3/uinteger.h"
+#include "ns3/workload-pregenerator.h"
+#include "ns3/workload-tape.h"
+
+#include <sstream>
+#include <vector>
+
+NS_LOG_COMPONENT_DEFINE("WorkloadTest");
+
+using namespace ns3;
+
+/**
+ * @ingroup traffic
+ * @brief Verifies that the values handed out by variables objects after
+ *        WorkloadPregenerator::Generate() are the same as those drawn by
+ *        identical variables objects without pre-generation.
+ *
+ * NRTV and HTTP clients are registered with AddClients(). Reference variables
+ * objects are given the same stream numbers as the pre-generator assigns to
+ * the clients' variables objects, and then every channel of both is read a few
+ * times more than was pre-generated, so that the continuation from the random
+ * number generators is verified as well.
+ */
+class WorkloadPregeneratorTestCase : public TestCase
+{
+  public:
+    /**
+     * @brief Construct a new test case.
+     * @param name the test case name, which will be printed on the report
+     * @param threads the `Threads` attribute of the pre-generator
+     * @param sessions the number of sessions pre-generated for each client
+     */
+    WorkloadPregeneratorTestCase(std::string name, uint32_t threads, uint32_t sessions);
+
+  private:
+    virtual void DoRun();
+
+    uint32_t m_threads;
+    uint32_t m_sessions;
+
+}; // end of `class WorkloadPregeneratorTestCase`
+
+WorkloadPregeneratorTestCase::WorkloadPregeneratorTestCase(std::string name,
+                                                           uint32_t threads,
+                                                           uint32_t sessions)
+    : TestCase(name),
+      m_threads(threads),
+      m_sessions(sessions)
+{
+    NS_LOG_FUNCTION(this << name << threads << sessions);
+}
+
+void
+WorkloadPregeneratorTestCase::DoRun()
+{
+    NS_LOG_FUNCTION(this << GetName());
+
+    const int64_t firstStream = 100;
+    const uint32_t extraDraws = 3; // Draws after the pre-generated values run out.
+
+    ApplicationContainer apps;
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        apps.Add(CreateObject<NrtvTcpClient>());
+        apps.Add(CreateObject<ThreeGppHttpSatelliteClient>());
+    }
+
+    Ptr<WorkloadPregenerator> pregen = CreateObject<WorkloadPregenerator>();
+    pregen->SetAttribute("Threads", UintegerValue(m_threads));
+    pregen->SetAttribute("Stream", IntegerValue(firstStream));
+    pregen->AddClients(apps, m_sessions);
+    pregen->Generate();
+
+    // Same stream numbers as the pre-generator, in the order of registration.
+    int64_t stream = firstStream;
+
+    for (ApplicationContainer::Iterator it = apps.Begin(); it != apps.End(); ++it)
+    {
+        PointerValue pointer;
+
+        if (DynamicCast<NrtvTcpClient>(*it) != nullptr)
+        {
+            (*it)->GetAttribute("NrtvConfigurationVariables", pointer);
+            Ptr<NrtvVariables> variables = pointer.Get<NrtvVariables>();
+            Ptr<NrtvVariables> reference = CreateObject<NrtvVariables>();
+            reference->SetStream(stream);
+            stream++;
+
+            for (uint32_t n = 0; n < 1 + extraDraws; n++)
+            {
+                NS_TEST_ASSERT_MSG_EQ(variables->GetConnectionOpenDelay(),
+                                      reference->GetConnectionOpenDelay(),
+                                      "Unexpected connection open delay #" << n);
+            }
+
+            for (uint32_t n = 0; n < m_sessions + extraDraws; n++)
+            {
+                NS_TEST_ASSERT_MSG_EQ(variables->GetIdleTime(),
+                                      reference->GetIdleTime(),
+                                      "Unexpected idle time #" << n);
+            }
+        }
+        else
+        {
+            (*it)->GetAttribute("Variables", pointer);
+            Ptr<ThreeGppHttpSatelliteVariables> variables =
+                pointer.Get<ThreeGppHttpSatelliteVariables>();
+            NS_TEST_ASSERT_MSG_EQ((variables != nullptr), true, "Missing HTTP variables");
+            Ptr<ThreeGppHttpSatelliteVariables> reference =
+                CreateObject<ThreeGppHttpSatelliteVariables>();
+            stream += reference->AssignStreams(stream);
+
+            for (uint32_t n = 0; n < m_sessions + extraDraws; n++)
+            {
+                NS_TEST_ASSERT_MSG_EQ(variables->GetParsingTime(),
+                                      reference->GetParsingTime(),
+                                      "Unexpected parsing time #" << n);
+                NS_TEST_ASSERT_MSG_EQ(variables->GetNumOfEmbeddedObjects(),
+                                      reference->GetNumOfEmbeddedObjects(),
+                                      "Unexpected number of embedded objects #" << n);
+                NS_TEST_ASSERT_MSG_EQ(variables->GetReadingTime(),
+                                      reference->GetReadingTime(),
+                                      "Unexpected reading time #" << n);
+            }
+        }
+    }
+
+    Simulator::Destroy();
+
+} // end of `void DoRun ()`
+
+/**
+ * @ingroup traffic
+ * @brief Verifies that the values recorded by WorkloadTape in `CAPTURE` mode
+ *        are handed out again in `REPLAY` mode.
+ *
+ * Each run creates an NrtvVariables and a ThreeGppHttpSatelliteVariables
+ * object, plus an NrtvVariables object with the `EnableWorkloadTape` attribute
+ * disabled, as the NRTV video workers do. The replay run gives the objects
+ * other stream numbers and creates the disabled object at another position, so
+ * the replayed values must come from the file and the keys of the other
+ * objects must not depend on the disabled one. A third run without the tape
+ * verifies that the other stream numbers would have given another workload.
+ */
+class WorkloadTapeTestCase : public TestCase
+{
+  public:
+    /**
+     * @brief Construct a new test case.
+     * @param name the test case name, which will be printed on the report
+     */
+    WorkloadTapeTestCase(std::string name);
+
+  private:
+    virtual void DoRun();
+
+    /**
+     * @brief Create the variables objects of one run and read their values.
+     * @param stream the first stream number assigned to the objects.
+     * @param isUntapedFirst whether the object kept off the tape is created
+     *                       before or after the others.
+     * @return the values read from the objects on the tape, with times in
+     *         nanoseconds.
+     */
+    std::vector<int64_t> DrawWorkload(int64_t stream, bool isUntapedFirst);
+
+}; // end of `class WorkloadTapeTestCase`
+
+WorkloadTapeTestCase::WorkloadTapeTestCase(std::string name)
+    : TestCase(name)
+{
+    NS_LOG_FUNCTION(this << name);
+}
+
+std::vector<int64_t>
+WorkloadTapeTestCase::DrawWorkload(int64_t stream, bool isUntapedFirst)
+{
+    NS_LOG_FUNCTION(this << stream << isUntapedFirst);
+
+    Ptr<NrtvVariables> untaped;
+    if (isUntapedFirst)
+    {
+        untaped =
+            CreateObjectWithAttributes<NrtvVariables>("EnableWorkloadTape", BooleanValue(false));
+    }
+
+    Ptr<NrtvVariables> nrtv = CreateObject<NrtvVariables>();
+    nrtv->SetStream(stream);
+    Ptr<ThreeGppHttpSatelliteVariables> http = CreateObject<ThreeGppHttpSatelliteVariables>();
+    http->AssignStreams(stream + 1);
+
+    if (!isUntapedFirst)
+    {
+        untaped =
+            CreateObjectWithAttributes<NrtvVariables>("EnableWorkloadTape", BooleanValue(false));
+    }
+    untaped->SetStream(stream + 50);
+
+    std::vector<int64_t> values;
+    for (uint32_t n = 0; n < 5; n++)
+    {
+        values.push_back(nrtv->GetSliceSize());
+        untaped->GetSliceSize(); // Must not consume or record any value.
+        values.push_back(nrtv->GetIdleTime().GetNanoSeconds());
+        values.push_back(http->GetMainObjectSize());
+        values.push_back(http->GetReadingTime().GetNanoSeconds());
+    }
+
+    return values;
+
+} // end of `std::vector<int64_t> DrawWorkload (int64_t, bool)`
+
+void
+WorkloadTapeTestCase::DoRun()
+{
+    NS_LOG_FUNCTION(this << GetName());
+
+    Config::SetDefault("ns3::WorkloadTape::FileName",
+                       StringValue(CreateTempDirFilename("workload.bin")));
+
+    Config::SetDefault("ns3::WorkloadTape::Mode", StringValue("CAPTURE"));
+    const std::vector<int64_t> captured = DrawWorkload(100, false);
+    Simulator::Destroy(); // Saves the tape to the file.
+
+    Config::SetDefault("ns3::WorkloadTape::Mode", StringValue("REPLAY"));
+    const std::vector<int64_t> replayed = DrawWorkload(200, true);
+    Simulator::Destroy();
+
+    Config::SetDefault("ns3::WorkloadTape::Mode", StringValue("OFF"));
+    const std::vector<int64_t> drawn = DrawWorkload(200, true);
+    Simulator::Destroy();
+
+    Config::SetDefault("ns3::WorkloadTape::FileName", StringValue("workload.bin"));
+
+    NS_TEST_ASSERT_MSG_EQ(replayed.size(), captured.size(), "Unexpected number of values");
+    for (uint32_t i = 0; i < captured.size(); i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(replayed[i], captured[i], "Value #" << i << " was not replayed");
+    }
+
+    NS_TEST_ASSERT_MSG_EQ((drawn != captured),
+                          true,
+                          "Other stream numbers should have given another workload");
+
+} // end of `void DoRun ()`
+
+/**
+ * @brief Test suite `workload`, verifying the workload pre-generation, capture
+ *        and replay.
+ */
+class WorkloadTestSuite : public TestSuite
+{
+  public:
+    WorkloadTestSuite();
+};
+
+WorkloadTestSuite::WorkloadTestSuite()
+    : TestSuite("workload", Type::UNIT)
+{
+    const uint32_t threads[3] = {1, 4, 0};
+
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        std::ostringstream oss;
+        oss << "pre-generation, threads=" << threads[i];
+        AddTestCase(new WorkloadPregeneratorTestCase(oss.str(), threads[i], 5),
+                    TestCase::Duration::QUICK);
+    }
+
+    AddTestCase(new WorkloadTapeTestCase("capture and replay"), TestCase::Duration::QUICK);
+
+} // end of `WorkloadTestSuite ()`
+
+static WorkloadTestSuite g_workloadTestSuiteInstance;